@@ -36,6 +36,7 @@ def main():
                         }
                         if MACHINE == Machines.LASSEN:
                             defines["CMAKE_CXX_FLAGS"] = "-maltivec -mabi=altivec"
+                            defines["LEGION_SOLVERS_ARCH_FLAGS"] = "-mcpu=native"
                         cmake(build_name, defines, build=False,
                               test=False, install=False, cmake_cmd=("cmake", ".."))
 
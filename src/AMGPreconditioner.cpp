@@ -0,0 +1,1245 @@
+#include "AMGPreconditioner.hpp"
+
+#include <algorithm> // for std::clamp, std::max
+#include <cassert>   // for assert
+#include <cstring>   // for std::memcpy
+#include <iostream>  // for std::cout, std::endl
+#include <map>       // for std::map
+#include <utility>   // for std::move
+
+#include "AMGPreconditionerTasks.hpp" // for AMG*Task, AMGLevelArgs, ...
+#include "LegionUtilities.hpp"        // for create_field_space
+#include "LibraryOptions.hpp"         // for LEGION_SOLVERS_USE_*, ...
+#include "SELLMatrixTasks.hpp"        // for sell_extent
+#include "Scalar.hpp"                 // for Scalar
+#include "TaskIDs.hpp"                // for LEGION_REDOP_SUM
+
+using LegionSolvers::AMGAggregate;
+using LegionSolvers::AMGAggregateTask;
+using LegionSolvers::AMGCoarseFactorArgs;
+using LegionSolvers::AMGCoarseFactorTask;
+using LegionSolvers::AMGCoarseSolveTask;
+using LegionSolvers::AMGGalerkinFillTask;
+using LegionSolvers::AMGGalerkinSizeTask;
+using LegionSolvers::AMGLevelArgs;
+using LegionSolvers::AMGLevelInfo;
+using LegionSolvers::AMGLevelSource;
+using LegionSolvers::AMGPieceInfo;
+using LegionSolvers::AMGPreconditioner;
+using LegionSolvers::AMGProlongator;
+using LegionSolvers::AMGProlongatorTask;
+using LegionSolvers::AMGProlongTask;
+using LegionSolvers::AMGRestrictTask;
+using LegionSolvers::EigenvalueBounds;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::Scalar;
+using LegionSolvers::SparseFormat;
+using LegionSolvers::sell_extent;
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::AMGProlongator(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AMGLevelSource &source,
+    Legion::LogicalRegion aggregate_region,
+    Legion::FieldID aggregate_fid,
+    Legion::FieldID weight_fid,
+    Legion::IndexPartition ghost_partition,
+    const std::vector<std::uint64_t> &offsets,
+    double damping,
+    Legion::IndexSpace coarse_space
+)
+    : ctx(ctx), rt(rt), fine_space(source.range_space),
+      fine_partition(source.range_partition), coarse_space(coarse_space),
+      kernel_partition(source.kernel_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, fine_partition)
+      ) {
+    assert(source.requirements.size() == 3);
+    const Legion::FieldSpace field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(Legion::Point<FINE_DIM, COORD_T>),
+         sizeof(Legion::Point<1, COORD_T>),
+         sizeof(ENTRY_T)},
+        {ROW_FID, COL_FID, ENTRY_FID}
+    );
+    kernel_region =
+        rt->create_logical_region(ctx, source.kernel_space, field_space);
+
+    AMGLevelArgs args;
+    args.source_format = source.format;
+    args.range_partition = source.range_partition;
+    args.strength_threshold = 0.0;
+    args.damping = damping;
+    args.num_pieces = offsets.size();
+    std::vector<char> buffer(
+        sizeof(AMGLevelArgs) + offsets.size() * sizeof(std::uint64_t)
+    );
+    std::memcpy(buffer.data(), &args, sizeof(AMGLevelArgs));
+    std::memcpy(
+        buffer.data() + sizeof(AMGLevelArgs),
+        offsets.data(),
+        offsets.size() * sizeof(std::uint64_t)
+    );
+
+    Legion::IndexLauncher launcher{
+        AMGProlongatorTask<ENTRY_T, FINE_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{buffer.data(), buffer.size()},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : source.requirements) {
+        launcher.add_region_requirement(requirement);
+    }
+    const Legion::LogicalPartition ghost_logical_partition =
+        rt->get_logical_partition(ctx, aggregate_region, ghost_partition);
+    for (const Legion::FieldID fid : {aggregate_fid, weight_fid}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                ghost_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                aggregate_region})
+            .add_field(fid);
+    }
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid : {ROW_FID, COL_FID, ENTRY_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, launcher);
+
+    coarse_partition = rt->create_partition_by_image(
+        ctx,
+        coarse_space,
+        kernel_logical_partition,
+        kernel_region,
+        COL_FID,
+        color_space
+    );
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::~AMGProlongator() {
+    rt->destroy_index_partition(ctx, coarse_partition);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, kernel_region.get_field_space());
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+std::size_t AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::num_bytes() const {
+    const std::size_t num_nonzeros =
+        rt->get_index_space_domain(ctx, kernel_region.get_index_space())
+            .get_volume();
+    return num_nonzeros * (sizeof(Legion::Point<FINE_DIM, COORD_T>) +
+                           sizeof(Legion::Point<1, COORD_T>) + sizeof(ENTRY_T));
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+Legion::IndexPartition AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, range_partition);
+    const Legion::IndexPartition nonzeros = rt->create_partition_by_preimage(
+        ctx, range_partition, kernel_region, kernel_region, ROW_FID, colors
+    );
+    const Legion::IndexPartition result = rt->create_partition_by_image(
+        ctx,
+        domain_space,
+        rt->get_logical_partition(ctx, kernel_region, nonzeros),
+        kernel_region,
+        COL_FID,
+        colors
+    );
+    rt->destroy_index_partition(ctx, nonzeros);
+    return result;
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+Legion::IndexPartition AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, domain_partition);
+    const Legion::IndexPartition nonzeros = rt->create_partition_by_preimage(
+        ctx, domain_partition, kernel_region, kernel_region, COL_FID, colors
+    );
+    const Legion::IndexPartition result = rt->create_partition_by_image(
+        ctx,
+        range_space,
+        rt->get_logical_partition(ctx, kernel_region, nonzeros),
+        kernel_region,
+        ROW_FID,
+        colors
+    );
+    rt->destroy_index_partition(ctx, nonzeros);
+    return result;
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+void AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == fine_space);
+    assert(input_region.get_index_space() == coarse_space);
+    Legion::IndexLauncher launcher{
+        AMGProlongTask<ENTRY_T, FINE_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, fine_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid : {ROW_FID, COL_FID, ENTRY_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, coarse_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+void AMGProlongator<ENTRY_T, FINE_DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == coarse_space);
+    assert(input_region.get_index_space() == fine_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    Legion::IndexLauncher launcher{
+        AMGRestrictTask<ENTRY_T, FINE_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, coarse_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid : {ROW_FID, COL_FID, ENTRY_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, fine_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+AMGPreconditioner<ENTRY_T, DIM, COORD_T>::AMGPreconditioner(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+    const AMGOptions &options,
+    bool verbose
+)
+    : ctx(ctx), rt(rt), options(options), matrix(matrix),
+      partition(matrix.get_range_partition()),
+      owned_kernel_partition(Legion::IndexPartition::NO_PART),
+      factor_region(Legion::LogicalRegion::NO_REGION),
+      pivot_region(Legion::LogicalRegion::NO_REGION),
+      coarse_solve_task_id(0), setup_seconds(0.0) {
+    assert(matrix.get_domain_space() == matrix.get_range_space());
+    assert(rt->is_index_partition_disjoint(ctx, partition));
+    const Legion::LogicalRegion rowptr_region = matrix.get_rowptr_region();
+    const Legion::LogicalRegion kernel_region = matrix.get_kernel_region();
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(
+            ctx, kernel_region, matrix.get_kernel_partition()
+        );
+    AMGLevelSource source;
+    source.format = SparseFormat::CSR;
+    source.requirements = {
+        Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region},
+        Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region},
+        Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region}};
+    source.requirements[0].add_field(matrix.get_fid_rowptr());
+    source.requirements[1].add_field(matrix.get_fid_col());
+    source.requirements[2].add_field(matrix.get_fid_entry());
+    source.range_space = matrix.get_range_space();
+    source.range_partition = partition;
+    source.kernel_space = matrix.get_kernel_space();
+    source.kernel_partition = matrix.get_kernel_partition();
+    setup(source, verbose);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+AMGPreconditioner<ENTRY_T, DIM, COORD_T>::AMGPreconditioner(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const COOMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+    Legion::IndexPartition range_partition,
+    const AMGOptions &options,
+    bool verbose
+)
+    : ctx(ctx), rt(rt), options(options), matrix(matrix),
+      partition(range_partition),
+      owned_kernel_partition(
+          matrix.kernel_partition_from_range_partition(range_partition)
+      ),
+      factor_region(Legion::LogicalRegion::NO_REGION),
+      pivot_region(Legion::LogicalRegion::NO_REGION),
+      coarse_solve_task_id(0), setup_seconds(0.0) {
+    assert(matrix.get_domain_space() == matrix.get_range_space());
+    assert(
+        rt->get_parent_index_space(ctx, range_partition) ==
+        matrix.get_range_space()
+    );
+    assert(rt->is_index_partition_disjoint(ctx, range_partition));
+    const Legion::LogicalRegion kernel_region = matrix.get_kernel_region();
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, owned_kernel_partition);
+    AMGLevelSource source;
+    source.format = SparseFormat::COO;
+    for (const Legion::FieldID fid :
+         {matrix.get_fid_row(), matrix.get_fid_col(), matrix.get_fid_entry()}) {
+        source.requirements.push_back(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region});
+        source.requirements.back().add_field(fid);
+    }
+    source.range_space = matrix.get_range_space();
+    source.range_partition = range_partition;
+    source.kernel_space = matrix.get_kernel_space();
+    source.kernel_partition = owned_kernel_partition;
+    setup(source, verbose);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+AMGPreconditioner<ENTRY_T, DIM, COORD_T>::~AMGPreconditioner() {
+    // Operators and vectors first, since prolongators hold partitions of the
+    // space of the next level.
+    smoother.reset();
+    prolongator.reset();
+    residual.reset();
+    correction.reset();
+    for (const auto &level : coarse_levels) {
+        level->smoother.reset();
+        level->prolongator.reset();
+        level->matrix.reset();
+        level->rhs.reset();
+        level->solution.reset();
+        level->residual.reset();
+        level->correction.reset();
+    }
+    for (const auto &level : coarse_levels) {
+        rt->destroy_index_partition(ctx, level->kernel_partition);
+        rt->destroy_index_partition(ctx, level->partition);
+        rt->destroy_logical_region(ctx, level->kernel_region);
+        rt->destroy_field_space(ctx, level->kernel_region.get_field_space());
+        rt->destroy_index_space(ctx, level->kernel_region.get_index_space());
+        rt->destroy_index_space(ctx, level->color_space);
+        rt->destroy_index_space(ctx, level->space);
+    }
+    for (const Legion::LogicalRegion region : {factor_region, pivot_region}) {
+        if (region == Legion::LogicalRegion::NO_REGION) { continue; }
+        rt->destroy_logical_region(ctx, region);
+        rt->destroy_field_space(ctx, region.get_field_space());
+        rt->destroy_index_space(ctx, region.get_index_space());
+    }
+    if (owned_kernel_partition != Legion::IndexPartition::NO_PART) {
+        rt->destroy_index_partition(ctx, owned_kernel_partition);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::setup(
+    const AMGLevelSource &source, bool verbose
+) {
+    assert(options.max_levels > 0);
+    assert(options.min_rows_per_piece > 0);
+    assert(options.smoother_degree > 0);
+    assert(options.coarse_degree > 0);
+    const Legion::Future start = rt->get_current_time_in_microseconds(
+        ctx, rt->issue_execution_fence(ctx)
+    );
+
+    const auto num_rows = [&](Legion::IndexSpace space) {
+        return rt->get_index_space_domain(ctx, space).get_volume();
+    };
+    const auto bounds = [](ENTRY_T max_row_sum) {
+        return EigenvalueBounds<ENTRY_T>{
+            max_row_sum / static_cast<ENTRY_T>(30), max_row_sum};
+    };
+
+    ENTRY_T max_row_sum = static_cast<ENTRY_T>(0);
+    std::unique_ptr<CoarseLevel> next;
+    if ((num_rows(source.range_space) > options.max_coarse_size) &&
+        (options.max_levels > 1)) {
+        next = coarsen<DIM>(source, matrix, prolongator, max_row_sum);
+    }
+    if (next) {
+        smoother = std::make_unique<Smoother<DIM>>(
+            ctx,
+            rt,
+            matrix,
+            partition,
+            options.smoother_degree,
+            bounds(max_row_sum)
+        );
+        residual = std::make_unique<Vector<DIM>>(ctx, rt, partition);
+        correction = std::make_unique<Vector<DIM>>(ctx, rt, partition);
+        coarse_levels.push_back(std::move(next));
+        while (true) {
+            CoarseLevel &level = *coarse_levels.back();
+            const AMGLevelSource level_source = coarse_source(level);
+            if ((num_rows(level.space) > options.max_coarse_size) &&
+                (coarse_levels.size() + 1 < options.max_levels)) {
+                next = coarsen<1>(
+                    level_source, *level.matrix, level.prolongator, max_row_sum
+                );
+            }
+            if (!next) {
+                finish<1>(level_source, *level.matrix, level.smoother);
+                break;
+            }
+            level.smoother = std::make_unique<Smoother<1>>(
+                ctx,
+                rt,
+                *level.matrix,
+                level.partition,
+                options.smoother_degree,
+                bounds(max_row_sum)
+            );
+            level.residual = std::make_unique<Vector<1>>(
+                ctx, rt, level.partition
+            );
+            level.correction = std::make_unique<Vector<1>>(
+                ctx, rt, level.partition
+            );
+            coarse_levels.push_back(std::move(next));
+        }
+    } else {
+        finish<DIM>(source, matrix, smoother);
+    }
+
+    const Legion::Future stop = rt->get_current_time_in_microseconds(
+        ctx, rt->issue_execution_fence(ctx)
+    );
+    const long long elapsed =
+        stop.get_result<long long>() - start.get_result<long long>();
+    setup_seconds = 1.0e-6 * static_cast<double>(elapsed);
+
+    // Work vectors: residual and correction of the cycle on every level but
+    // the coarsest, the three vectors of the smoother on every smoothed
+    // level, and right-hand side and solution on every coarse level.
+    const auto level_info_of = [&](Legion::IndexSpace space,
+                                   Legion::IndexSpace kernel_space,
+                                   Legion::IndexPartition level_partition,
+                                   bool coarsest,
+                                   bool smoothed,
+                                   bool coarse) {
+        AMGLevelInfo info;
+        info.num_rows = num_rows(space);
+        info.num_nonzeros = num_rows(kernel_space);
+        info.num_pieces = num_rows(
+            rt->get_index_partition_color_space_name(ctx, level_partition)
+        );
+        info.matrix_bytes = 0;
+        info.prolongator_bytes = 0;
+        info.stopped_early = coarsest && smoothed;
+        std::size_t num_vectors =
+            (coarsest ? 0 : 2) + (smoothed ? 3 : 0) + (coarse ? 2 : 0);
+        info.work_bytes = num_vectors * info.num_rows * sizeof(ENTRY_T);
+        if (coarsest && !smoothed) {
+            info.work_bytes += info.num_rows * info.num_rows * sizeof(ENTRY_T) +
+                               info.num_rows * sizeof(std::uint64_t);
+        }
+        return info;
+    };
+    level_info.push_back(level_info_of(
+        source.range_space,
+        source.kernel_space,
+        partition,
+        !prolongator,
+        static_cast<bool>(smoother),
+        false
+    ));
+    if (prolongator) {
+        level_info.back().prolongator_bytes = prolongator->num_bytes();
+    }
+    for (const auto &level : coarse_levels) {
+        level_info.push_back(level_info_of(
+            level->space,
+            level->kernel_region.get_index_space(),
+            level->partition,
+            !level->prolongator,
+            static_cast<bool>(level->smoother),
+            true
+        ));
+        level_info.back().matrix_bytes =
+            level_info.back().num_nonzeros *
+            (2 * sizeof(Legion::Point<1, COORD_T>) + sizeof(ENTRY_T));
+        if (level->prolongator) {
+            level_info.back().prolongator_bytes =
+                level->prolongator->num_bytes();
+        }
+    }
+
+    if (verbose) {
+        std::cout << "[LegionSolvers] AMG setup: " << level_info.size()
+                  << " levels in " << setup_seconds << " s." << std::endl;
+        for (std::size_t k = 0; k < level_info.size(); ++k) {
+            const AMGLevelInfo &info = level_info[k];
+            std::cout << "[LegionSolvers]   level " << k << ": "
+                      << info.num_rows << " rows, " << info.num_nonzeros
+                      << " nonzeros, " << info.num_pieces << " pieces, "
+                      << info.matrix_bytes << " matrix bytes, "
+                      << info.prolongator_bytes << " prolongator bytes, "
+                      << info.work_bytes << " work bytes"
+                      << (info.stopped_early ? ", stopped early" : "") << "."
+                      << std::endl;
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+template <int LEVEL_DIM>
+std::unique_ptr<typename AMGPreconditioner<ENTRY_T, DIM, COORD_T>::CoarseLevel>
+AMGPreconditioner<ENTRY_T, DIM, COORD_T>::coarsen(
+    const AMGLevelSource &source,
+    const AbstractLinearOperator<ENTRY_T> &level_matrix,
+    std::unique_ptr<Prolongator<LEVEL_DIM>> &level_prolongator,
+    ENTRY_T &max_row_sum
+) {
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+
+    const Legion::IndexSpace color_space =
+        rt->get_index_partition_color_space_name(ctx, source.range_partition);
+    const Legion::Domain colors = rt->get_index_space_domain(ctx, color_space);
+
+    // Aggregation.
+    const Legion::FieldSpace aggregate_field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(AMGAggregate), sizeof(ENTRY_T)},
+        {AGGREGATE_FID, WEIGHT_FID}
+    );
+    const Legion::LogicalRegion aggregate_region = rt->create_logical_region(
+        ctx, source.range_space, aggregate_field_space
+    );
+    AMGLevelArgs args;
+    args.source_format = source.format;
+    args.range_partition = source.range_partition;
+    args.strength_threshold = options.strength_threshold;
+    args.damping = 0.0;
+    args.num_pieces = 0;
+    Legion::IndexLauncher aggregate_launcher{
+        AMGAggregateTask<ENTRY_T, LEVEL_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(AMGLevelArgs)},
+        Legion::ArgumentMap{}};
+    aggregate_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : source.requirements) {
+        aggregate_launcher.add_region_requirement(requirement);
+    }
+    const Legion::LogicalPartition aggregate_partition =
+        rt->get_logical_partition(
+            ctx, aggregate_region, source.range_partition
+        );
+    for (const Legion::FieldID fid : {AGGREGATE_FID, WEIGHT_FID}) {
+        aggregate_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                aggregate_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                aggregate_region})
+            .add_field(fid);
+    }
+    const Legion::FutureMap infos =
+        rt->execute_index_space(ctx, aggregate_launcher);
+
+    std::vector<std::uint64_t> offsets;
+    std::uint64_t num_aggregates = 0;
+    ENTRY_T max_scaled_row_sum = static_cast<ENTRY_T>(0);
+    max_row_sum = static_cast<ENTRY_T>(0);
+    for (Legion::Domain::DomainPointIterator it(colors); it; ++it) {
+        const AMGPieceInfo<ENTRY_T> info =
+            infos.get_result<AMGPieceInfo<ENTRY_T>>(*it);
+        offsets.push_back(num_aggregates);
+        num_aggregates += info.num_aggregates;
+        max_row_sum = std::max(max_row_sum, info.max_row_sum);
+        max_scaled_row_sum =
+            std::max(max_scaled_row_sum, info.max_scaled_row_sum);
+    }
+    const std::size_t num_rows =
+        rt->get_index_space_domain(ctx, source.range_space).get_volume();
+    if ((num_aggregates == 0) || (10 * num_aggregates > 9 * num_rows)) {
+        rt->destroy_logical_region(ctx, aggregate_region);
+        rt->destroy_field_space(ctx, aggregate_field_space);
+        return nullptr;
+    }
+
+    // Smoothed prolongator, with damping 4 / (3 * rho(D^{-1} * A)).
+    auto level = std::make_unique<CoarseLevel>();
+    level->space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, num_aggregates)
+    );
+    const Legion::IndexPartition ghost_partition =
+        level_matrix.domain_partition_from_range_partition(
+            source.range_space, source.range_partition
+        );
+    level_prolongator = std::make_unique<Prolongator<LEVEL_DIM>>(
+        ctx,
+        rt,
+        source,
+        aggregate_region,
+        AGGREGATE_FID,
+        WEIGHT_FID,
+        ghost_partition,
+        offsets,
+        4.0 / (3.0 * static_cast<double>(max_scaled_row_sum)),
+        level->space
+    );
+
+    // Galerkin product, contributed piece by piece.
+    const Legion::LogicalRegion prolongator_region =
+        level_prolongator->get_kernel_region();
+    const Legion::IndexPartition prolongator_ghost_partition =
+        rt->create_partition_by_preimage(
+            ctx,
+            ghost_partition,
+            prolongator_region,
+            prolongator_region,
+            Prolongator<LEVEL_DIM>::ROW_FID,
+            color_space
+        );
+    const Legion::LogicalPartition prolongator_ghost =
+        rt->get_logical_partition(
+            ctx, prolongator_region, prolongator_ghost_partition
+        );
+    std::vector<Legion::RegionRequirement> galerkin_requirements =
+        source.requirements;
+    for (const Legion::FieldID fid :
+         {Prolongator<LEVEL_DIM>::ROW_FID,
+          Prolongator<LEVEL_DIM>::COL_FID,
+          Prolongator<LEVEL_DIM>::ENTRY_FID}) {
+        galerkin_requirements.push_back(Legion::RegionRequirement{
+            prolongator_ghost,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            prolongator_region});
+        galerkin_requirements.back().add_field(fid);
+    }
+    Legion::IndexLauncher size_launcher{
+        AMGGalerkinSizeTask<ENTRY_T, LEVEL_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(AMGLevelArgs)},
+        Legion::ArgumentMap{}};
+    size_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : galerkin_requirements) {
+        size_launcher.add_region_requirement(requirement);
+    }
+    const Legion::FutureMap sizes = rt->execute_index_space(ctx, size_launcher);
+
+    std::map<Legion::DomainPoint, Legion::Domain> contribution_pieces;
+    std::uint64_t num_contributions = 0;
+    for (Legion::Domain::DomainPointIterator it(colors); it; ++it) {
+        const std::uint64_t size = sizes.get_result<std::uint64_t>(*it);
+        contribution_pieces[*it] =
+            sell_extent(static_cast<COORD_T>(num_contributions), size);
+        num_contributions += size;
+    }
+    const Legion::IndexSpace kernel_space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, num_contributions)
+    );
+    const Legion::FieldSpace kernel_field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(CoarseIndex), sizeof(CoarseIndex), sizeof(ENTRY_T)},
+        {ROW_FID, COL_FID, ENTRY_FID}
+    );
+    level->kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::IndexPartition contribution_partition =
+        rt->create_partition_by_domain(
+            ctx,
+            kernel_space,
+            contribution_pieces,
+            color_space,
+            true,
+            LEGION_DISJOINT_COMPLETE_KIND
+        );
+    Legion::IndexLauncher fill_launcher{
+        AMGGalerkinFillTask<ENTRY_T, LEVEL_DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(AMGLevelArgs)},
+        Legion::ArgumentMap{}};
+    fill_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : galerkin_requirements) {
+        fill_launcher.add_region_requirement(requirement);
+    }
+    const Legion::LogicalPartition contribution_logical_partition =
+        rt->get_logical_partition(
+            ctx, level->kernel_region, contribution_partition
+        );
+    for (const Legion::FieldID fid : {ROW_FID, COL_FID, ENTRY_FID}) {
+        fill_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                contribution_logical_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                level->kernel_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, fill_launcher);
+
+    rt->destroy_index_partition(ctx, contribution_partition);
+    rt->destroy_index_partition(ctx, prolongator_ghost_partition);
+    rt->destroy_index_partition(ctx, ghost_partition);
+    rt->destroy_logical_region(ctx, aggregate_region);
+    rt->destroy_field_space(ctx, aggregate_field_space);
+
+    // The rows of the next level are partitioned into fewer pieces, each
+    // holding the aggregates of a contiguous run of pieces of this level.
+    const std::size_t num_pieces = offsets.size();
+    const std::size_t num_coarse_pieces = std::clamp<std::size_t>(
+        num_aggregates / options.min_rows_per_piece, 1, num_pieces
+    );
+    offsets.push_back(num_aggregates);
+    std::map<Legion::DomainPoint, Legion::Domain> coarse_pieces;
+    std::size_t first = 0;
+    for (std::size_t g = 0; g < num_coarse_pieces; ++g) {
+        std::size_t last = first;
+        while ((last < num_pieces) &&
+               (last * num_coarse_pieces / num_pieces == g)) {
+            ++last;
+        }
+        coarse_pieces[Legion::DomainPoint{
+            Legion::Point<1>{static_cast<Legion::coord_t>(g)}}] =
+            sell_extent(
+                static_cast<COORD_T>(offsets[first]),
+                offsets[last] - offsets[first]
+            );
+        first = last;
+    }
+    level->color_space = rt->create_index_space(
+        ctx,
+        Legion::Rect<1>{0, static_cast<Legion::coord_t>(num_coarse_pieces - 1)}
+    );
+    level->partition = rt->create_partition_by_domain(
+        ctx,
+        level->space,
+        coarse_pieces,
+        level->color_space,
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND
+    );
+    level->kernel_partition = rt->create_partition_by_preimage(
+        ctx,
+        level->partition,
+        level->kernel_region,
+        level->kernel_region,
+        ROW_FID,
+        level->color_space
+    );
+    level->matrix = std::make_unique<COOMatrix<ENTRY_T, 1, COORD_T>>(
+        ctx,
+        rt,
+        level->kernel_region,
+        ROW_FID,
+        COL_FID,
+        ENTRY_FID,
+        level->space,
+        level->space,
+        level->kernel_partition
+    );
+    level->rhs = std::make_unique<Vector<1>>(ctx, rt, level->partition);
+    level->solution = std::make_unique<Vector<1>>(ctx, rt, level->partition);
+    return level;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+template <int LEVEL_DIM>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::finish(
+    const AMGLevelSource &source,
+    const AbstractLinearOperator<ENTRY_T> &level_matrix,
+    std::unique_ptr<Smoother<LEVEL_DIM>> &level_smoother
+) {
+    const std::size_t n =
+        rt->get_index_space_domain(ctx, source.range_space).get_volume();
+    if (n <= options.max_coarse_size) {
+        factor<LEVEL_DIM>(source);
+        return;
+    }
+    Vector<LEVEL_DIM> start{ctx, rt, source.range_partition};
+    start.constant_fill(static_cast<ENTRY_T>(1));
+    level_smoother = std::make_unique<Smoother<LEVEL_DIM>>(
+        ctx,
+        rt,
+        level_matrix,
+        source.range_partition,
+        options.coarse_degree,
+        Smoother<LEVEL_DIM>::estimate_eigenvalue_bounds(
+            ctx,
+            rt,
+            level_matrix,
+            start.get_logical_region(),
+            start.get_fid(),
+            source.range_partition,
+            20
+        )
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+template <int LEVEL_DIM>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::factor(
+    const AMGLevelSource &source
+) {
+    const std::size_t n =
+        rt->get_index_space_domain(ctx, source.range_space).get_volume();
+    assert(n <= options.max_coarse_size);
+    const Legion::IndexSpace factor_space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, n * n)
+    );
+    const Legion::IndexSpace pivot_space =
+        rt->create_index_space(ctx, sell_extent(COORD_T{0}, n));
+    factor_region = rt->create_logical_region(
+        ctx,
+        factor_space,
+        create_field_space(ctx, rt, {sizeof(ENTRY_T)}, {FACTOR_FID})
+    );
+    pivot_region = rt->create_logical_region(
+        ctx,
+        pivot_space,
+        create_field_space(ctx, rt, {sizeof(std::uint64_t)}, {FACTOR_FID})
+    );
+
+    const AMGCoarseFactorArgs args{source.format, source.range_space};
+    Legion::TaskLauncher launcher{
+        AMGCoarseFactorTask<ENTRY_T, LEVEL_DIM, COORD_T>::task_id,
+        Legion::TaskArgument{&args, sizeof(AMGCoarseFactorArgs)}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : source.requirements) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                requirement.parent,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                requirement.parent})
+            .add_field(*requirement.privilege_fields.begin());
+    }
+    for (const Legion::LogicalRegion region : {factor_region, pivot_region}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                region, LEGION_WRITE_DISCARD, LEGION_EXCLUSIVE, region})
+            .add_field(FACTOR_FID);
+    }
+    rt->execute_task(ctx, launcher);
+    coarse_solve_task_id =
+        AMGCoarseSolveTask<ENTRY_T, LEVEL_DIM, COORD_T>::task_id;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+AMGLevelSource AMGPreconditioner<ENTRY_T, DIM, COORD_T>::coarse_source(
+    const CoarseLevel &level
+) const {
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(
+            ctx, level.kernel_region, level.kernel_partition
+        );
+    AMGLevelSource result;
+    result.format = SparseFormat::COO;
+    for (const Legion::FieldID fid : {ROW_FID, COL_FID, ENTRY_FID}) {
+        result.requirements.push_back(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            level.kernel_region});
+        result.requirements.back().add_field(fid);
+    }
+    result.range_space = level.space;
+    result.range_partition = level.partition;
+    result.kernel_space = level.kernel_region.get_index_space();
+    result.kernel_partition = level.kernel_partition;
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+template <int LEVEL_DIM>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::cycle(
+    std::size_t next,
+    Vector<LEVEL_DIM> &x,
+    const Vector<LEVEL_DIM> &b,
+    const AbstractLinearOperator<ENTRY_T> &level_matrix,
+    const Smoother<LEVEL_DIM> *level_smoother,
+    const Prolongator<LEVEL_DIM> *level_prolongator,
+    Vector<LEVEL_DIM> *level_residual,
+    Vector<LEVEL_DIM> *level_correction,
+    bool transpose
+) const {
+    const Scalar<ENTRY_T> one{ctx, rt, static_cast<ENTRY_T>(1)};
+    const Scalar<ENTRY_T> minus_one{ctx, rt, static_cast<ENTRY_T>(-1)};
+
+    const auto apply_operator = [&](const AbstractLinearOperator<ENTRY_T> &op,
+                                    Vector<LEVEL_DIM> &output,
+                                    const Vector<LEVEL_DIM> &input) {
+        if (transpose) {
+            op.transpose_matvec(
+                output.get_logical_region(),
+                output.get_fid(),
+                input.get_logical_region(),
+                input.get_fid()
+            );
+        } else {
+            op.matvec(
+                output.get_logical_region(),
+                output.get_fid(),
+                input.get_logical_region(),
+                input.get_fid()
+            );
+        }
+    };
+
+    // The coarsest level is solved by its factors or by its smoother.
+    if (level_prolongator == nullptr) {
+        if (level_smoother != nullptr) {
+            apply_operator(*level_smoother, x, b);
+            return;
+        }
+        Legion::TaskLauncher launcher{
+            coarse_solve_task_id,
+            Legion::TaskArgument{&transpose, sizeof(bool)}};
+        launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                b.get_logical_region(),
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                b.get_logical_region()})
+            .add_field(b.get_fid());
+        for (const Legion::LogicalRegion region :
+             {factor_region, pivot_region}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    region, LEGION_READ_ONLY, LEGION_EXCLUSIVE, region})
+                .add_field(FACTOR_FID);
+        }
+        rt->execute_task(ctx, launcher);
+        return;
+    }
+
+    // Presmoothing from x = 0, then r = b - A * x.
+    apply_operator(*level_smoother, x, b);
+    apply_operator(level_matrix, *level_residual, x);
+    level_residual->xpay(minus_one, b);
+
+    // Coarse-grid correction.
+    const CoarseLevel &level = *coarse_levels[next];
+    level_prolongator->transpose_matvec(
+        level.rhs->get_logical_region(),
+        level.rhs->get_fid(),
+        level_residual->get_logical_region(),
+        level_residual->get_fid()
+    );
+    cycle<1>(
+        next + 1,
+        *level.solution,
+        *level.rhs,
+        *level.matrix,
+        level.smoother.get(),
+        level.prolongator.get(),
+        level.residual.get(),
+        level.correction.get(),
+        transpose
+    );
+    level_prolongator->matvec(
+        level_correction->get_logical_region(),
+        level_correction->get_fid(),
+        level.solution->get_logical_region(),
+        level.solution->get_fid()
+    );
+    x.axpy(one, *level_correction);
+
+    // Postsmoothing.
+    apply_operator(level_matrix, *level_residual, x);
+    level_residual->xpay(minus_one, b);
+    apply_operator(*level_smoother, *level_correction, *level_residual);
+    x.axpy(one, *level_correction);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::apply(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid,
+    bool transpose
+) const {
+    Vector<DIM> x{ctx, rt, output_region, output_fid, partition};
+    const Vector<DIM> b{ctx, rt, input_region, input_fid, partition};
+    cycle<DIM>(
+        0,
+        x,
+        b,
+        matrix,
+        smoother.get(),
+        prolongator.get(),
+        residual.get(),
+        correction.get(),
+        transpose
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+AMGPreconditioner<ENTRY_T, DIM, COORD_T>::whole_partition(
+    Legion::IndexSpace space, Legion::IndexPartition partition
+) const {
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, partition);
+    const Legion::Domain whole = rt->get_index_space_domain(ctx, space);
+    std::map<Legion::DomainPoint, Legion::Domain> pieces;
+    for (Legion::Domain::DomainPointIterator it(
+             rt->get_index_space_domain(ctx, colors)
+         );
+         it;
+         ++it) {
+        pieces[*it] = whole;
+    }
+    return rt->create_partition_by_domain(
+        ctx, space, pieces, colors, true, LEGION_ALIASED_COMPLETE_KIND
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition AMGPreconditioner<ENTRY_T, DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    return whole_partition(domain_space, range_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition AMGPreconditioner<ENTRY_T, DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    return whole_partition(range_space, domain_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGPreconditioner<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, true);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<float, 1, int>;
+            template class LegionSolvers::AMGPreconditioner<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<float, 2, int>;
+            template class LegionSolvers::AMGPreconditioner<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<float, 3, int>;
+            template class LegionSolvers::AMGPreconditioner<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<float, 1, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<float, 2, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<float, 3, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<float, 1, long long>;
+            template class LegionSolvers::AMGPreconditioner<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<float, 2, long long>;
+            template class LegionSolvers::AMGPreconditioner<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<float, 3, long long>;
+            template class LegionSolvers::AMGPreconditioner<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<double, 1, int>;
+            template class LegionSolvers::AMGPreconditioner<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<double, 2, int>;
+            template class LegionSolvers::AMGPreconditioner<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<double, 3, int>;
+            template class LegionSolvers::AMGPreconditioner<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<double, 1, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<double, 2, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<double, 3, unsigned>;
+            template class LegionSolvers::AMGPreconditioner<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::AMGProlongator<double, 1, long long>;
+            template class LegionSolvers::AMGPreconditioner<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::AMGProlongator<double, 2, long long>;
+            template class LegionSolvers::AMGPreconditioner<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::AMGProlongator<double, 3, long long>;
+            template class LegionSolvers::AMGPreconditioner<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,378 @@
+#ifndef LEGION_SOLVERS_AMG_PRECONDITIONER_HPP_INCLUDED
+#define LEGION_SOLVERS_AMG_PRECONDITIONER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp"  // for AbstractLinearOperator
+#include "COOMatrix.hpp"               // for COOMatrix
+#include "CSRMatrix.hpp"               // for CSRMatrix
+#include "ChebyshevPreconditioner.hpp" // for ChebyshevPreconditioner
+#include "DistributedVector.hpp"       // for DistributedVector
+#include "PieceRows.hpp"               // for SparseFormat
+
+namespace LegionSolvers {
+
+
+// Parameters of the hierarchy built by AMGPreconditioner.
+struct AMGOptions {
+    // Largest number of levels, including the finest and the coarsest.
+    std::size_t max_levels = 10;
+    // Levels with at most this many rows are solved directly. Larger
+    // coarsest levels are solved by Chebyshev iteration instead.
+    std::size_t max_coarse_size = 64;
+    // Coarse levels get at most one piece per this many rows (and at least
+    // one piece, and at most as many pieces as the level above).
+    std::size_t min_rows_per_piece = 1024;
+    // Threshold theta of the strength of connection (see AMGAggregateTask).
+    double strength_threshold = 0.08;
+    // Degree of the Chebyshev smoother (see ChebyshevPreconditioner).
+    std::size_t smoother_degree = 2;
+    // Degree of the Chebyshev iteration that solves a coarsest level with
+    // more than max_coarse_size rows.
+    std::size_t coarse_degree = 16;
+}; // struct AMGOptions
+
+
+// Size and storage of one level of an AMGPreconditioner. Storage owned by
+// the application (the matrix of the finest level) is not counted; work
+// storage comprises the vectors of the cycle and the smoother, and the
+// dense factors of the coarsest level. On the coarsest level, stopped_early
+// is set if coarsening stopped above max_coarse_size rows (at the maximum
+// number of levels, or because aggregation stalled), so that the level is
+// solved by Chebyshev iteration rather than factored.
+struct AMGLevelInfo {
+    std::size_t num_rows;
+    std::size_t num_nonzeros;
+    std::size_t num_pieces;
+    std::size_t matrix_bytes;
+    std::size_t prolongator_bytes;
+    std::size_t work_bytes;
+    bool stopped_early;
+}; // struct AMGLevelInfo
+
+
+// A CSR or COO matrix of one level of a smoothed-aggregation hierarchy, as
+// seen by the AMG setup tasks: the first three region requirements of
+// SELLSizeTask (see collect_piece_rows), over the pieces of a disjoint
+// partition of its range space, and the partition of its kernel space into
+// the nonzeros of the rows of each piece.
+struct AMGLevelSource {
+    SparseFormat format;
+    std::vector<Legion::RegionRequirement> requirements;
+    Legion::IndexSpace range_space;
+    Legion::IndexPartition range_partition;
+    Legion::IndexSpace kernel_space;
+    Legion::IndexPartition kernel_partition;
+}; // struct AMGLevelSource
+
+
+// The smoothed prolongator P from the 1D space of the next coarser level to
+// the range space of one level of an AMGPreconditioner, written by
+// AMGProlongatorTask on construction. P has one nonzero per nonzero of the
+// matrix of the level, stored in COO form in a region owned by this object
+// over the kernel space of that matrix, and partitioned as its nonzeros.
+//
+// As an AbstractLinearOperator, this object computes prolongations
+// (matvec, coarse to fine) and restrictions (transpose_matvec, fine to
+// coarse).
+template <typename ENTRY_T, int FINE_DIM, typename COORD_T>
+class AMGProlongator : public AbstractLinearOperator<ENTRY_T> {
+
+  public:
+
+    static constexpr Legion::FieldID ROW_FID = 0;
+    static constexpr Legion::FieldID COL_FID = 1;
+    static constexpr Legion::FieldID ENTRY_FID = 2;
+
+  private:
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::IndexSpace fine_space;
+    const Legion::IndexPartition fine_partition;
+    const Legion::IndexSpace coarse_space;
+    const Legion::IndexPartition kernel_partition;
+    const Legion::IndexSpace color_space;
+    Legion::LogicalRegion kernel_region;
+    Legion::IndexPartition coarse_partition;
+
+  public:
+
+    // Smooths the tentative prolongator given by the aggregates and weights
+    // of the rows of the level (see AMGAggregateTask), in two fields of
+    // aggregate_region, with damping omega. The ghost partition holds the
+    // columns of the rows of each piece of the level, and offsets the first
+    // coarse row of the aggregates of each piece.
+    explicit AMGProlongator(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AMGLevelSource &source,
+        Legion::LogicalRegion aggregate_region,
+        Legion::FieldID aggregate_fid,
+        Legion::FieldID weight_fid,
+        Legion::IndexPartition ghost_partition,
+        const std::vector<std::uint64_t> &offsets,
+        double damping,
+        Legion::IndexSpace coarse_space
+    );
+
+    AMGProlongator(const AMGProlongator &) = delete;
+
+    AMGProlongator &operator=(const AMGProlongator &) = delete;
+
+    virtual ~AMGProlongator();
+
+    Legion::LogicalRegion get_kernel_region() const { return kernel_region; }
+
+    std::size_t num_bytes() const;
+
+    // Coarse columns of the nonzeros of P in the rows of each piece.
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    // Fine rows of the nonzeros of P in the columns of each piece.
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Computes output = P * input (prolongation).
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Computes output = P^T * input (restriction).
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class AMGProlongator
+
+
+// A smoothed-aggregation algebraic multigrid preconditioner M for a square
+// CSR or COO matrix A, typically symmetric positive definite and arising
+// from an elliptic problem, for which the number of iterations of the
+// preconditioned solver stays roughly constant as the mesh is refined.
+//
+// Construction builds a hierarchy of levels, level 0 being A. For each level
+// that is not the coarsest:
+//   * the rows of each piece of its range partition are aggregated
+//     independently, by AMGAggregateTask (one launch over the pieces);
+//   * the tentative prolongator, which maps each coarse row to the rows of
+//     its aggregate, is smoothed by one damped Jacobi step
+//     (AMGProlongatorTask), giving the prolongator P;
+//   * the matrix of the next level is the Galerkin product P^T * A * P,
+//     computed piece by piece (AMGGalerkinSizeTask, AMGGalerkinFillTask)
+//     into a COOMatrix over a new 1D space, whose rows are partitioned into
+//     fewer, contiguous pieces as the levels shrink (see AMGOptions).
+// Coarsening stops at the maximum number of levels, when a level is small
+// enough, or when aggregation no longer reduces the number of rows by 10%.
+// A coarsest level with at most AMGOptions::max_coarse_size rows is factored
+// densely (AMGCoarseFactorTask) in one task; a larger one, where coarsening
+// stopped early, is never factored, and is solved approximately instead, by
+// a Chebyshev iteration of degree AMGOptions::coarse_degree on bounds
+// estimated by Lanczos at setup, as in GMGPreconditioner.
+// Setup blocks on the sizes of each level; its duration and the size and
+// storage of each level are available afterwards (and printed if verbose).
+//
+// Applying M^{-1} is one V-cycle from zero, built from the operators of the
+// levels and the existing vector tasks: on each level, Chebyshev smoothing
+// (ChebyshevPreconditioner on the Gershgorin interval [rho / 30, rho], where
+// rho bounds the largest eigenvalue), the residual, its restriction, the
+// cycle of the next level, the prolongation of its solution, and the same
+// smoothing again; on the coarsest level, a dense solve (AMGCoarseSolveTask)
+// or the Chebyshev iteration.
+// The cycle is symmetric, so M^{-1} is symmetric positive definite for
+// symmetric positive definite A and may precondition the CG solvers; its
+// transpose is the cycle of A^T.
+//
+// A and the partitions of the finest level are used by every apply, so
+// they must outlive this object. Every diagonal entry of A must be
+// positive, and its range partition disjoint.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class AMGPreconditioner : public AbstractLinearOperator<ENTRY_T> {
+
+    static constexpr Legion::FieldID AGGREGATE_FID = 0;
+    static constexpr Legion::FieldID WEIGHT_FID = 1;
+    static constexpr Legion::FieldID ROW_FID = 0;
+    static constexpr Legion::FieldID COL_FID = 1;
+    static constexpr Legion::FieldID ENTRY_FID = 2;
+    static constexpr Legion::FieldID FACTOR_FID = 0;
+
+    template <int LEVEL_DIM>
+    using Vector = DistributedVector<ENTRY_T, LEVEL_DIM, COORD_T>;
+
+    template <int LEVEL_DIM>
+    using Smoother = ChebyshevPreconditioner<ENTRY_T, LEVEL_DIM, COORD_T>;
+
+    template <int LEVEL_DIM>
+    using Prolongator = AMGProlongator<ENTRY_T, LEVEL_DIM, COORD_T>;
+
+    // A level below the finest, with its Galerkin matrix (in a COO kernel
+    // region owned by this object) and the right-hand side and solution of
+    // its cycle. The prolongator and remaining work vectors are absent on
+    // the coarsest level, whose smoother, if any, is its solver.
+    struct CoarseLevel {
+        Legion::IndexSpace space;
+        Legion::IndexSpace color_space;
+        Legion::IndexPartition partition;
+        Legion::LogicalRegion kernel_region;
+        Legion::IndexPartition kernel_partition;
+        std::unique_ptr<COOMatrix<ENTRY_T, 1, COORD_T>> matrix;
+        std::unique_ptr<Smoother<1>> smoother;
+        std::unique_ptr<Prolongator<1>> prolongator;
+        std::unique_ptr<Vector<1>> rhs, solution, residual, correction;
+    }; // struct CoarseLevel
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AMGOptions options;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const Legion::IndexPartition partition;
+    Legion::IndexPartition owned_kernel_partition;
+    std::unique_ptr<Smoother<DIM>> smoother;
+    std::unique_ptr<Prolongator<DIM>> prolongator;
+    std::unique_ptr<Vector<DIM>> residual, correction;
+    std::vector<std::unique_ptr<CoarseLevel>> coarse_levels;
+    Legion::LogicalRegion factor_region;
+    Legion::LogicalRegion pivot_region;
+    Legion::TaskID coarse_solve_task_id;
+    std::vector<AMGLevelInfo> level_info;
+    double setup_seconds;
+
+    // Builds the hierarchy below the finest level.
+    void setup(const AMGLevelSource &source, bool verbose);
+
+    // Aggregates a level, builds its prolongator, and returns the next
+    // level, or nullptr (building nothing) if the level should be the
+    // coarsest. Also returns the Gershgorin bound of the level's spectrum.
+    template <int LEVEL_DIM>
+    std::unique_ptr<CoarseLevel> coarsen(
+        const AMGLevelSource &source,
+        const AbstractLinearOperator<ENTRY_T> &level_matrix,
+        std::unique_ptr<Prolongator<LEVEL_DIM>> &level_prolongator,
+        ENTRY_T &max_row_sum
+    );
+
+    // Sets up the solve of the coarsest level: factors it if it has at most
+    // max_coarse_size rows, and otherwise makes level_smoother its solver.
+    template <int LEVEL_DIM>
+    void finish(
+        const AMGLevelSource &source,
+        const AbstractLinearOperator<ENTRY_T> &level_matrix,
+        std::unique_ptr<Smoother<LEVEL_DIM>> &level_smoother
+    );
+
+    // Factors the coarsest level.
+    template <int LEVEL_DIM>
+    void factor(const AMGLevelSource &source);
+
+    AMGLevelSource coarse_source(const CoarseLevel &level) const;
+
+    // Runs the cycle of one level for x from zero; next is the index of the
+    // next coarser level in coarse_levels.
+    template <int LEVEL_DIM>
+    void cycle(
+        std::size_t next,
+        Vector<LEVEL_DIM> &x,
+        const Vector<LEVEL_DIM> &b,
+        const AbstractLinearOperator<ENTRY_T> &level_matrix,
+        const Smoother<LEVEL_DIM> *level_smoother,
+        const Prolongator<LEVEL_DIM> *level_prolongator,
+        Vector<LEVEL_DIM> *level_residual,
+        Vector<LEVEL_DIM> *level_correction,
+        bool transpose
+    ) const;
+
+    void apply(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid,
+        bool transpose
+    ) const;
+
+    // The partition of space in which every piece is all of space.
+    Legion::IndexPartition whole_partition(
+        Legion::IndexSpace space, Legion::IndexPartition partition
+    ) const;
+
+  public:
+
+    // Builds the hierarchy of a CSR matrix, using its range partition.
+    explicit AMGPreconditioner(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+        const AMGOptions &options = AMGOptions{},
+        bool verbose = false
+    );
+
+    // Builds the hierarchy of a COO matrix, assigning the rows of each piece
+    // of a disjoint range partition to that piece.
+    explicit AMGPreconditioner(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const COOMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+        Legion::IndexPartition range_partition,
+        const AMGOptions &options = AMGOptions{},
+        bool verbose = false
+    );
+
+    AMGPreconditioner(const AMGPreconditioner &) = delete;
+
+    AMGPreconditioner &operator=(const AMGPreconditioner &) = delete;
+
+    virtual ~AMGPreconditioner();
+
+    std::size_t get_num_levels() const { return level_info.size(); }
+
+    const std::vector<AMGLevelInfo> &get_level_info() const {
+        return level_info;
+    }
+
+    // Wall-clock duration of the construction of the hierarchy.
+    double get_setup_seconds() const { return setup_seconds; }
+
+    // Every output entry depends on every input entry.
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Computes output = M^{-1} * input (one V-cycle).
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Computes output = M^{-T} * input (one V-cycle of A^T).
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class AMGPreconditioner
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_AMG_PRECONDITIONER_HPP_INCLUDED
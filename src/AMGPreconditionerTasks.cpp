@@ -0,0 +1,810 @@
+#include "AMGPreconditionerTasks.hpp"
+
+#include <algorithm> // for std::max, std::swap
+#include <cassert>   // for assert
+#include <cmath>     // for std::abs, std::sqrt
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint64_t
+#include <limits>    // for std::numeric_limits
+#include <map>       // for std::map
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineWriter, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+#include "PieceRows.hpp"       // for PieceRows, collect_piece_rows
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineSumAccessor;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::AMGAggregate;
+using LegionSolvers::AMGAggregateTask;
+using LegionSolvers::AMGCoarseFactorArgs;
+using LegionSolvers::AMGCoarseFactorTask;
+using LegionSolvers::AMGCoarseSolveTask;
+using LegionSolvers::AMGGalerkinFillTask;
+using LegionSolvers::AMGGalerkinSizeTask;
+using LegionSolvers::AMGLevelArgs;
+using LegionSolvers::AMGPieceInfo;
+using LegionSolvers::AMGProlongatorTask;
+using LegionSolvers::AMGProlongTask;
+using LegionSolvers::AMGRestrictTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::PieceRows;
+using LegionSolvers::SparseFormat;
+using LegionSolvers::collect_piece_rows;
+
+
+inline const AMGLevelArgs &get_level_args(const Legion::Task *task) {
+    assert(task->arglen >= sizeof(AMGLevelArgs));
+    return *static_cast<const AMGLevelArgs *>(task->args);
+}
+
+
+// The rows of one piece of the range space of a level, collected from the
+// first three regions of an AMG level task.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+PieceRows<ENTRY_T, DIM, COORD_T> collect_level_rows(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    const AMGLevelArgs &args = get_level_args(task);
+    const Legion::IndexSpace range_space =
+        (args.source_format == SparseFormat::COO)
+            ? rt->get_index_subspace(
+                  ctx, args.range_partition, task->index_point
+              )
+            : Legion::IndexSpace::NO_SPACE;
+    return collect_piece_rows<ENTRY_T, DIM, COORD_T>(
+        task, regions, ctx, rt, args.source_format, range_space
+    );
+}
+
+
+// The sum of the nonzeros of row i in its own column.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+ENTRY_T row_diagonal(
+    const PieceRows<ENTRY_T, DIM, COORD_T> &piece, std::size_t i
+) {
+    ENTRY_T result = static_cast<ENTRY_T>(0);
+    for (std::size_t k = piece.offsets[i]; k < piece.offsets[i + 1]; ++k) {
+        if (piece.columns[k] == piece.rows[i]) { result += piece.entries[k]; }
+    }
+    return result;
+}
+
+
+// The number of the point task within its launch, in the order of a
+// Domain::DomainPointIterator over the launch domain.
+inline std::uint64_t linear_piece_number(const Legion::Task *task) {
+    std::uint64_t result = 0;
+    for (Legion::Domain::DomainPointIterator it(task->index_domain); it;
+         ++it, ++result) {
+        if (*it == task->index_point) { return result; }
+    }
+    assert(false);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+AMGPieceInfo<ENTRY_T> AMGAggregateTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    const auto &aggregate_req = task->regions[3];
+    const auto &weight_req = task->regions[4];
+
+    assert(aggregate_req.privilege_fields.size() == 1);
+    const Legion::FieldID aggregate_fid =
+        *aggregate_req.privilege_fields.begin();
+
+    assert(weight_req.privilege_fields.size() == 1);
+    const Legion::FieldID weight_fid = *weight_req.privilege_fields.begin();
+
+    AffineWriter<AMGAggregate, DIM, COORD_T> aggregate_writer{
+        regions[3], aggregate_fid};
+    AffineWriter<ENTRY_T, DIM, COORD_T> weight_writer{regions[4], weight_fid};
+
+    const AMGLevelArgs &args = get_level_args(task);
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_level_rows<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+    const std::size_t n = piece.rows.size();
+
+    std::map<Legion::DomainPoint, std::size_t> number;
+    std::vector<ENTRY_T> diagonal(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        number[Legion::DomainPoint{piece.rows[i]}] = i;
+        diagonal[i] = row_diagonal(piece, i);
+        assert(diagonal[i] > static_cast<ENTRY_T>(0));
+    }
+
+    // Strong neighbours within the piece, with the strength of each.
+    AMGPieceInfo<ENTRY_T> result;
+    result.num_aggregates = 0;
+    result.max_row_sum = static_cast<ENTRY_T>(0);
+    result.max_scaled_row_sum = static_cast<ENTRY_T>(0);
+    const ENTRY_T theta = static_cast<ENTRY_T>(args.strength_threshold);
+    std::vector<std::vector<std::pair<std::size_t, ENTRY_T>>> strong(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::map<Legion::DomainPoint, ENTRY_T> row;
+        for (std::size_t k = piece.offsets[i]; k < piece.offsets[i + 1];
+             ++k) {
+            row[Legion::DomainPoint{piece.columns[k]}] += piece.entries[k];
+        }
+        ENTRY_T row_sum = static_cast<ENTRY_T>(0);
+        for (const auto &[column, value] : row) {
+            const ENTRY_T strength = std::abs(value);
+            row_sum += strength;
+            const auto it = number.find(column);
+            if ((it == number.end()) || (it->second == i)) { continue; }
+            const std::size_t j = it->second;
+            if (strength > theta * std::sqrt(diagonal[i] * diagonal[j])) {
+                strong[i].emplace_back(j, strength);
+            }
+        }
+        result.max_row_sum = std::max(result.max_row_sum, row_sum);
+        result.max_scaled_row_sum =
+            std::max(result.max_scaled_row_sum, row_sum / diagonal[i]);
+    }
+
+    constexpr std::uint64_t NONE = std::numeric_limits<std::uint64_t>::max();
+    std::vector<std::uint64_t> aggregate(n, NONE);
+    std::uint64_t num_aggregates = 0;
+
+    // Aggregates of rows whose strong neighbours are all free.
+    for (std::size_t i = 0; i < n; ++i) {
+        if (aggregate[i] != NONE) { continue; }
+        bool free = true;
+        for (const auto &[j, strength] : strong[i]) {
+            if (aggregate[j] != NONE) { free = false; }
+        }
+        if (!free) { continue; }
+        aggregate[i] = num_aggregates;
+        for (const auto &[j, strength] : strong[i]) {
+            aggregate[j] = num_aggregates;
+        }
+        ++num_aggregates;
+    }
+
+    // Remaining rows join the most strongly connected of those aggregates.
+    std::vector<std::uint64_t> joined = aggregate;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (aggregate[i] != NONE) { continue; }
+        ENTRY_T best = static_cast<ENTRY_T>(0);
+        for (const auto &[j, strength] : strong[i]) {
+            if ((aggregate[j] != NONE) && (strength > best)) {
+                best = strength;
+                joined[i] = aggregate[j];
+            }
+        }
+    }
+    aggregate = joined;
+
+    // Rows without aggregated strong neighbours start new aggregates.
+    for (std::size_t i = 0; i < n; ++i) {
+        if (aggregate[i] != NONE) { continue; }
+        aggregate[i] = num_aggregates;
+        for (const auto &[j, strength] : strong[i]) {
+            if (aggregate[j] == NONE) { aggregate[j] = num_aggregates; }
+        }
+        ++num_aggregates;
+    }
+
+    std::vector<std::size_t> size(num_aggregates, 0);
+    for (std::size_t i = 0; i < n; ++i) { ++size[aggregate[i]]; }
+    const std::uint64_t piece_number = linear_piece_number(task);
+    for (std::size_t i = 0; i < n; ++i) {
+        aggregate_writer[piece.rows[i]] =
+            AMGAggregate{piece_number, aggregate[i]};
+        weight_writer[piece.rows[i]] =
+            static_cast<ENTRY_T>(1) /
+            std::sqrt(static_cast<ENTRY_T>(size[aggregate[i]]));
+    }
+
+    result.num_aggregates = num_aggregates;
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGProlongatorTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+
+    assert(regions.size() == 8);
+    assert(task->regions.size() == 8);
+    std::vector<Legion::FieldID> fids;
+    for (std::size_t r = 3; r < 8; ++r) {
+        assert(task->regions[r].privilege_fields.size() == 1);
+        fids.push_back(*task->regions[r].privilege_fields.begin());
+    }
+
+    AffineReader<AMGAggregate, DIM, COORD_T> aggregate_reader{
+        regions[3], fids[0]};
+    AffineReader<ENTRY_T, DIM, COORD_T> weight_reader{regions[4], fids[1]};
+    AffineWriter<Index, 1, COORD_T> row_writer{regions[5], fids[2]};
+    AffineWriter<CoarseIndex, 1, COORD_T> col_writer{regions[6], fids[3]};
+    AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[7], fids[4]};
+
+    const AMGLevelArgs &args = get_level_args(task);
+    assert(
+        task->arglen ==
+        sizeof(AMGLevelArgs) + args.num_pieces * sizeof(std::uint64_t)
+    );
+    const std::uint64_t *offsets = reinterpret_cast<const std::uint64_t *>(
+        static_cast<const char *>(task->args) + sizeof(AMGLevelArgs)
+    );
+    const ENTRY_T omega = static_cast<ENTRY_T>(args.damping);
+
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_level_rows<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+    for (std::size_t i = 0; i < piece.rows.size(); ++i) {
+        const ENTRY_T diagonal = row_diagonal(piece, i);
+        assert(diagonal > static_cast<ENTRY_T>(0));
+        bool identity_added = false;
+        for (std::size_t k = piece.offsets[i]; k < piece.offsets[i + 1];
+             ++k) {
+            const Index column = piece.columns[k];
+            const AMGAggregate aggregate = aggregate_reader[column];
+            const ENTRY_T weight = weight_reader[column];
+            ENTRY_T value = -omega * piece.entries[k] / diagonal * weight;
+            if ((column == piece.rows[i]) && !identity_added) {
+                value += weight;
+                identity_added = true;
+            }
+            const Legion::Point<1, COORD_T> point = piece.kernel_points[k];
+            row_writer[point] = piece.rows[i];
+            col_writer[point] = CoarseIndex{static_cast<COORD_T>(
+                offsets[aggregate.piece] + aggregate.index
+            )};
+            entry_writer[point] = value;
+        }
+    }
+}
+
+
+// The contribution P_c^T * (A * P)_c of one piece to the Galerkin product
+// (see AMGGalerkinSizeTask), keyed by row and column.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::map<std::pair<COORD_T, COORD_T>, ENTRY_T> galerkin_contribution(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+    using SparseRow = std::map<COORD_T, ENTRY_T>;
+
+    std::vector<Legion::FieldID> fids;
+    for (std::size_t r = 3; r < 6; ++r) {
+        assert(task->regions[r].privilege_fields.size() == 1);
+        fids.push_back(*task->regions[r].privilege_fields.begin());
+    }
+    AffineReader<Index, 1, COORD_T> row_reader{regions[3], fids[0]};
+    AffineReader<CoarseIndex, 1, COORD_T> col_reader{regions[4], fids[1]};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{regions[5], fids[2]};
+
+    // The rows of P that the piece refers to, with repeated columns summed.
+    std::map<Legion::DomainPoint, SparseRow> prolongator_rows;
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[3].region.get_index_space()
+    );
+    for (KernelIterator k(kernel_domain); k(); ++k) {
+        prolongator_rows[Legion::DomainPoint{row_reader[*k]}]
+                        [col_reader[*k][0]] += entry_reader[*k];
+    }
+    const auto prolongator_row = [&](const Index &i) -> const SparseRow & {
+        const auto it = prolongator_rows.find(Legion::DomainPoint{i});
+        assert(it != prolongator_rows.end());
+        return it->second;
+    };
+
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_level_rows<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+    std::map<std::pair<COORD_T, COORD_T>, ENTRY_T> result;
+    for (std::size_t i = 0; i < piece.rows.size(); ++i) {
+        SparseRow product; // row i of A * P
+        for (std::size_t k = piece.offsets[i]; k < piece.offsets[i + 1];
+             ++k) {
+            for (const auto &[J, value] : prolongator_row(piece.columns[k])) {
+                product[J] += piece.entries[k] * value;
+            }
+        }
+        for (const auto &[I, weight] : prolongator_row(piece.rows[i])) {
+            for (const auto &[J, value] : product) {
+                result[{I, J}] += weight * value;
+            }
+        }
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint64_t AMGGalerkinSizeTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 6);
+    assert(task->regions.size() == 6);
+    return galerkin_contribution<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt)
+        .size();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGGalerkinFillTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+
+    assert(regions.size() == 9);
+    assert(task->regions.size() == 9);
+    std::vector<Legion::FieldID> fids;
+    for (std::size_t r = 6; r < 9; ++r) {
+        assert(task->regions[r].privilege_fields.size() == 1);
+        fids.push_back(*task->regions[r].privilege_fields.begin());
+    }
+    AffineWriter<CoarseIndex, 1, COORD_T> row_writer{regions[6], fids[0]};
+    AffineWriter<CoarseIndex, 1, COORD_T> col_writer{regions[7], fids[1]};
+    AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[8], fids[2]};
+
+    const std::map<std::pair<COORD_T, COORD_T>, ENTRY_T> contribution =
+        galerkin_contribution<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[6].region.get_index_space()
+    );
+    assert(kernel_domain.get_volume() == contribution.size());
+    auto it = contribution.begin();
+    for (KernelIterator k(kernel_domain); k(); ++k, ++it) {
+        row_writer[*k] = CoarseIndex{it->first.first};
+        col_writer[*k] = CoarseIndex{it->first.second};
+        entry_writer[*k] = it->second;
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGProlongTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    std::vector<Legion::FieldID> fids;
+    for (const auto &requirement : task->regions) {
+        assert(requirement.privilege_fields.size() == 1);
+        fids.push_back(*requirement.privilege_fields.begin());
+    }
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{regions[0], fids[0]};
+    AffineReader<Index, 1, COORD_T> row_reader{regions[1], fids[1]};
+    AffineReader<CoarseIndex, 1, COORD_T> col_reader{regions[2], fids[2]};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{regions[3], fids[3]};
+    AffineReader<ENTRY_T, 1, COORD_T> input_reader{regions[4], fids[4]};
+
+    const Legion::Domain range_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    for (PointIterator i(range_domain); i(); ++i) {
+        output_writer[*i] = static_cast<ENTRY_T>(0);
+    }
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[1].region.get_index_space()
+    );
+    for (KernelIterator k(kernel_domain); k(); ++k) {
+        output_writer[row_reader[*k]] +=
+            entry_reader[*k] * input_reader[col_reader[*k]];
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGRestrictTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using CoarseIndex = Legion::Point<1, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    std::vector<Legion::FieldID> fids;
+    for (const auto &requirement : task->regions) {
+        assert(requirement.privilege_fields.size() == 1);
+        fids.push_back(*requirement.privilege_fields.begin());
+    }
+
+    AffineSumAccessor<ENTRY_T, 1, COORD_T> output_reducer{
+        regions[0], fids[0], LEGION_REDOP_SUM<ENTRY_T>};
+    AffineReader<Index, 1, COORD_T> row_reader{regions[1], fids[1]};
+    AffineReader<CoarseIndex, 1, COORD_T> col_reader{regions[2], fids[2]};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{regions[3], fids[3]};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{regions[4], fids[4]};
+
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[1].region.get_index_space()
+    );
+    for (KernelIterator k(kernel_domain); k(); ++k) {
+        output_reducer.reduce(
+            col_reader[*k], entry_reader[*k] * input_reader[row_reader[*k]]
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGCoarseFactorTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using KernelIndex = Legion::Point<1, COORD_T>;
+
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    const auto &factor_req = task->regions[3];
+    const auto &pivot_req = task->regions[4];
+
+    assert(factor_req.privilege_fields.size() == 1);
+    const Legion::FieldID factor_fid = *factor_req.privilege_fields.begin();
+
+    assert(pivot_req.privilege_fields.size() == 1);
+    const Legion::FieldID pivot_fid = *pivot_req.privilege_fields.begin();
+
+    AffineWriter<ENTRY_T, 1, COORD_T> factor_writer{regions[3], factor_fid};
+    AffineWriter<std::uint64_t, 1, COORD_T> pivot_writer{
+        regions[4], pivot_fid};
+
+    assert(task->arglen == sizeof(AMGCoarseFactorArgs));
+    const AMGCoarseFactorArgs &args =
+        *static_cast<const AMGCoarseFactorArgs *>(task->args);
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_piece_rows<ENTRY_T, DIM, COORD_T>(
+            task, regions, ctx, rt, args.source_format, args.range_space
+        );
+
+    const std::size_t n = piece.rows.size();
+    std::map<Legion::DomainPoint, std::size_t> number;
+    for (std::size_t i = 0; i < n; ++i) {
+        number[Legion::DomainPoint{piece.rows[i]}] = i;
+    }
+    std::vector<ENTRY_T> lu(n * n, static_cast<ENTRY_T>(0));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = piece.offsets[i]; k < piece.offsets[i + 1];
+             ++k) {
+            const std::size_t j =
+                number.at(Legion::DomainPoint{piece.columns[k]});
+            lu[i * n + j] += piece.entries[k];
+        }
+    }
+
+    for (std::size_t c = 0; c < n; ++c) {
+        std::size_t p = c;
+        for (std::size_t r = c + 1; r < n; ++r) {
+            if (std::abs(lu[r * n + c]) > std::abs(lu[p * n + c])) { p = r; }
+        }
+        assert(lu[p * n + c] != static_cast<ENTRY_T>(0));
+        pivot_writer[KernelIndex{static_cast<COORD_T>(c)}] = p;
+        if (p != c) {
+            for (std::size_t q = 0; q < n; ++q) {
+                std::swap(lu[c * n + q], lu[p * n + q]);
+            }
+        }
+        for (std::size_t r = c + 1; r < n; ++r) {
+            const ENTRY_T l = lu[r * n + c] / lu[c * n + c];
+            lu[r * n + c] = l;
+            for (std::size_t q = c + 1; q < n; ++q) {
+                lu[r * n + q] -= l * lu[c * n + q];
+            }
+        }
+    }
+    for (std::size_t k = 0; k < n * n; ++k) {
+        factor_writer[KernelIndex{static_cast<COORD_T>(k)}] = lu[k];
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AMGCoarseSolveTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using KernelIndex = Legion::Point<1, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+
+    assert(regions.size() == 4);
+    assert(task->regions.size() == 4);
+    std::vector<Legion::FieldID> fids;
+    for (const auto &requirement : task->regions) {
+        assert(requirement.privilege_fields.size() == 1);
+        fids.push_back(*requirement.privilege_fields.begin());
+    }
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{regions[0], fids[0]};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{regions[1], fids[1]};
+    AffineReader<ENTRY_T, 1, COORD_T> factor_reader{regions[2], fids[2]};
+    AffineReader<std::uint64_t, 1, COORD_T> pivot_reader{regions[3], fids[3]};
+
+    assert(task->arglen == sizeof(bool));
+    const bool transpose = *static_cast<const bool *>(task->args);
+
+    const Legion::Domain domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    std::vector<ENTRY_T> y;
+    for (PointIterator i(domain); i(); ++i) { y.push_back(input_reader[*i]); }
+    const std::size_t n = y.size();
+    const ENTRY_T *lu = factor_reader.ptr(KernelIndex{0});
+    std::vector<std::size_t> pivot(n);
+    for (std::size_t c = 0; c < n; ++c) {
+        pivot[c] = pivot_reader[KernelIndex{static_cast<COORD_T>(c)}];
+    }
+
+    if (!transpose) {
+        // A = P^T * L * U: apply P, then solve with L and U.
+        for (std::size_t c = 0; c < n; ++c) { std::swap(y[c], y[pivot[c]]); }
+        for (std::size_t r = 0; r < n; ++r) {
+            for (std::size_t q = 0; q < r; ++q) {
+                y[r] -= lu[r * n + q] * y[q];
+            }
+        }
+        for (std::size_t r = n; r-- > 0;) {
+            for (std::size_t q = r + 1; q < n; ++q) {
+                y[r] -= lu[r * n + q] * y[q];
+            }
+            y[r] /= lu[r * n + r];
+        }
+    } else {
+        // A^T = U^T * L^T * P: solve with U^T and L^T, then apply P^T.
+        for (std::size_t r = 0; r < n; ++r) {
+            for (std::size_t q = 0; q < r; ++q) {
+                y[r] -= lu[q * n + r] * y[q];
+            }
+            y[r] /= lu[r * n + r];
+        }
+        for (std::size_t r = n; r-- > 0;) {
+            for (std::size_t q = r + 1; q < n; ++q) {
+                y[r] -= lu[q * n + r] * y[q];
+            }
+        }
+        for (std::size_t c = n; c-- > 0;) { std::swap(y[c], y[pivot[c]]); }
+    }
+
+    std::size_t k = 0;
+    for (PointIterator i(domain); i(); ++i, ++k) { output_writer[*i] = y[k]; }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<float> AMGAggregateTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<float> AMGAggregateTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<float> AMGAggregateTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<float> AMGAggregateTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<float> AMGAggregateTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<float> AMGAggregateTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<float> AMGAggregateTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<float> AMGAggregateTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<float> AMGAggregateTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<double> AMGAggregateTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<double> AMGAggregateTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<double> AMGAggregateTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<double> AMGAggregateTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<double> AMGAggregateTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<double> AMGAggregateTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template AMGPieceInfo<double> AMGAggregateTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template AMGPieceInfo<double> AMGAggregateTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template AMGPieceInfo<double> AMGAggregateTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongatorTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template std::uint64_t AMGGalerkinSizeTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGGalerkinFillTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGProlongTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGRestrictTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseFactorTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AMGCoarseSolveTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
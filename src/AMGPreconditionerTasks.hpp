@@ -0,0 +1,332 @@
+#ifndef LEGION_SOLVERS_AMG_PRECONDITIONER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_AMG_PRECONDITIONER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint64_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PieceRows.hpp"       // for SparseFormat
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for AMG_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// An aggregate of the rows of one level of a smoothed-aggregation hierarchy:
+// the number of the piece of the range partition of the level that holds it
+// (in the order of a Domain::DomainPointIterator over its color space), and
+// its number within that piece. Aggregates never span pieces; the aggregates
+// of piece p are the rows offset[p], ..., offset[p + 1] - 1 of the next
+// level, where offset[p] is the number of aggregates of the pieces before p.
+struct AMGAggregate {
+    std::uint64_t piece;
+    std::uint64_t index;
+}; // struct AMGAggregate
+
+
+// Task argument of AMGAggregateTask, AMGProlongatorTask, AMGGalerkinSizeTask,
+// and AMGGalerkinFillTask. The range partition is used only for COO sources,
+// to find the rows of each piece. For AMGProlongatorTask, the argument is
+// followed by the offset of each of the num_pieces pieces (as
+// std::uint64_t).
+struct AMGLevelArgs {
+    SparseFormat source_format;
+    Legion::IndexPartition range_partition;
+    double strength_threshold; // AMGAggregateTask
+    double damping;            // AMGProlongatorTask
+    std::uint64_t num_pieces;  // AMGProlongatorTask
+}; // struct AMGLevelArgs
+
+
+// Task argument of AMGCoarseFactorTask.
+struct AMGCoarseFactorArgs {
+    SparseFormat source_format;
+    Legion::IndexSpace range_space;
+}; // struct AMGCoarseFactorArgs
+
+
+// Result of AMGAggregateTask: the number of aggregates of the piece, and the
+// largest row sums of |a_ij| and of |a_ij| / a_ii over its rows, which bound
+// the spectral radii of A and of diag(A)^{-1} * A (Gershgorin).
+template <typename ENTRY_T>
+struct AMGPieceInfo {
+    std::uint64_t num_aggregates;
+    ENTRY_T max_row_sum;
+    ENTRY_T max_scaled_row_sum;
+}; // struct AMGPieceInfo
+
+
+// Aggregates the rows of one piece of the range space of a CSR or COO
+// matrix A. The first three regions are those of SELLSizeTask (see
+// collect_piece_rows); they are followed by the aggregates (AMGAggregate) and
+// the weights (ENTRY_T) of the rows of the piece, both write-discard.
+//
+// Row j is strongly connected to row i if |a_ij| > theta * sqrt(a_ii * a_jj),
+// where theta is the strength threshold; only rows of the same piece are
+// considered. Aggregates are formed greedily, in the order of the rows: first
+// from every row none of whose strong neighbours is aggregated, together
+// with those neighbours; then each remaining row joins the aggregate of its
+// most strongly connected aggregated neighbour; then the rows still left
+// form aggregates with their remaining strong neighbours. The weight of a
+// row is 1 / sqrt(size of its aggregate), so that the tentative prolongator
+// (with entry weight(i) in row i and the column of its aggregate) has
+// orthonormal columns. Duplicate nonzeros are summed. Asserts that every
+// diagonal entry is positive.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGAggregateTask
+    : public TaskTDI<
+          AMG_AGGREGATE_TASK_BLOCK_ID,
+          AMGAggregateTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_aggregate";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = AMGPieceInfo<ENTRY_T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGAggregateTask
+
+
+// Writes the rows of one piece of the smoothed prolongator
+// P = (I - omega * diag(A)^{-1} * A) * T, where T is the tentative
+// prolongator and omega the damping, with one nonzero per nonzero of A: the
+// nonzero a_ij of row i yields (delta_ij - omega * a_ij / a_ii) * weight(j)
+// in row i and the column of the aggregate of row j, a point of the 1D space
+// of the next level. P therefore shares the kernel space of A and may repeat
+// a column within a row. The first three regions are those of SELLSizeTask;
+// they are followed by the aggregates and weights (read-only, the columns of
+// the rows of the piece), and the row indices, column indices, and entries
+// of P (write-discard, at the kernel points of the nonzeros of A).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGProlongatorTask
+    : public TaskTDI<
+          AMG_PROLONGATOR_TASK_BLOCK_ID,
+          AMGProlongatorTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_prolongator";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGProlongatorTask
+
+
+// Counts the distinct nonzeros of the contribution P_c^T * (A * P)_c of one
+// piece c of the range space to the Galerkin product P^T * A * P, where the
+// subscript c denotes the rows of the piece. The first three regions are
+// those of SELLSizeTask; they are followed by the row indices, column
+// indices, and entries of P (read-only, the nonzeros of P in the rows of the
+// columns of the piece).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGGalerkinSizeTask
+    : public TaskTDI<
+          AMG_GALERKIN_SIZE_TASK_BLOCK_ID,
+          AMGGalerkinSizeTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_galerkin_size";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = std::uint64_t;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGGalerkinSizeTask
+
+
+// Writes the contribution counted by AMGGalerkinSizeTask as COO nonzeros,
+// sorted by row and column. The first six regions are those of
+// AMGGalerkinSizeTask; they are followed by the row indices, column indices,
+// and entries of the contribution (write-discard, 1D points of the next
+// level). Contributions of different pieces may share a row and column;
+// COOMatrix sums them.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGGalerkinFillTask
+    : public TaskTDI<
+          AMG_GALERKIN_FILL_TASK_BLOCK_ID,
+          AMGGalerkinFillTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_galerkin_fill";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGGalerkinFillTask
+
+
+// Computes output = P * input for the rows of one piece of the range space
+// of a prolongator P written by AMGProlongatorTask. Regions are output
+// (write-discard, range piece), the row indices, column indices, and entries
+// of P (read-only, the nonzeros of the rows of the piece, one requirement
+// each), and input (read-only, the columns of those nonzeros).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGProlongTask
+    : public TaskTDI<
+          AMG_PROLONG_TASK_BLOCK_ID,
+          AMGProlongTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_prolong";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGProlongTask
+
+
+// Reduces P^T * input, restricted to the nonzeros of P in the rows of one
+// piece of its range space, into output. Regions are output (sum reduction,
+// the columns of those nonzeros), the row indices, column indices, and
+// entries of P (read-only, one requirement each), and input (read-only,
+// range piece).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGRestrictTask
+    : public TaskTDI<
+          AMG_RESTRICT_TASK_BLOCK_ID,
+          AMGRestrictTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_restrict";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGRestrictTask
+
+
+// Computes the dense LU factorization with partial pivoting, P * A = L * U,
+// of a whole (small) CSR or COO matrix A. Its rows and columns are numbered
+// in the order of a PointInDomainIterator over the range space. The first
+// three regions are those of SELLSizeTask, each over its whole region; they
+// are followed by the factors (write-discard, a 1D region of n * n points,
+// row-major, with L strictly below the diagonal) and the pivots
+// (write-discard, a 1D region of n points holding, as a std::uint64_t, the
+// row exchanged with each row in turn). The task argument is an
+// AMGCoarseFactorArgs. Asserts that A is nonsingular.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGCoarseFactorTask
+    : public TaskTDI<
+          AMG_COARSE_FACTOR_TASK_BLOCK_ID,
+          AMGCoarseFactorTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_coarse_factor";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGCoarseFactorTask
+
+
+// Computes output = A^{-1} * input (or A^{-T} * input, if the task argument,
+// a bool, is set) from the factors written by AMGCoarseFactorTask. Regions
+// are output (write-discard), input (read-only), factors (read-only), and
+// pivots (read-only), each over its whole region.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AMGCoarseSolveTask
+    : public TaskTDI<
+          AMG_COARSE_SOLVE_TASK_BLOCK_ID,
+          AMGCoarseSolveTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "amg_coarse_solve";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AMGCoarseSolveTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_AMG_PRECONDITIONER_TASKS_HPP_INCLUDED
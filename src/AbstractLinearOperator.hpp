@@ -1,7 +1,11 @@
 #ifndef LEGION_SOLVERS_ABSTRACT_LINEAR_OPERATOR_HPP_INCLUDED
 #define LEGION_SOLVERS_ABSTRACT_LINEAR_OPERATOR_HPP_INCLUDED
 
-#include <legion.h> // for Legion::IndexSpace, Legion::IndexPartition
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
 
 namespace LegionSolvers {
 
@@ -11,6 +15,8 @@ class AbstractLinearOperator {
 
   public:
 
+    virtual ~AbstractLinearOperator() = default;
+
     virtual Legion::IndexPartition domain_partition_from_range_partition(
         Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
     ) const = 0;
@@ -19,6 +25,41 @@ class AbstractLinearOperator {
         Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
     ) const = 0;
 
+    // Computes output = A * input, where output and input are fields of
+    // logical regions defined over the range and domain spaces of A.
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const = 0;
+
+    // Computes output_fids[j] = A * input_fids[j] for every j, where the
+    // fields belong to logical regions defined over the range and domain
+    // spaces of A, such as the vectors of two MultiVectors. Operators that
+    // can apply A to several vectors in one pass over their data (see
+    // CSRMatmatTask) override this; by default, it is one matvec per vector.
+    virtual void matmat(
+        Legion::LogicalRegion output_region,
+        const std::vector<Legion::FieldID> &output_fids,
+        Legion::LogicalRegion input_region,
+        const std::vector<Legion::FieldID> &input_fids
+    ) const {
+        assert(output_fids.size() == input_fids.size());
+        for (std::size_t j = 0; j < output_fids.size(); ++j) {
+            matvec(output_region, output_fids[j], input_region, input_fids[j]);
+        }
+    }
+
+    // Computes output = A^T * input, where output and input are fields of
+    // logical regions defined over the domain and range spaces of A.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const = 0;
+
 }; // class AbstractLinearOperator
 
 
@@ -0,0 +1,520 @@
+#include "BSRMatrix.hpp"
+
+#include <cassert> // for assert
+#include <cstdint> // for std::uint32_t
+
+#include "LegionUtilities.hpp" // for create_field_space
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*, ...
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+
+using LegionSolvers::BSRExtentTask;
+using LegionSolvers::BSRMatrix;
+using LegionSolvers::BSRMatvecTask;
+using LegionSolvers::BSRTransposeMatvecTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::BSRMatrix(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::LogicalRegion kernel_region,
+    Legion::FieldID fid_col,
+    Legion::FieldID fid_entry,
+    Legion::LogicalRegion rowptr_region,
+    Legion::FieldID fid_rowptr,
+    Legion::IndexSpace block_domain_space,
+    Legion::IndexSpace domain_space,
+    Legion::IndexSpace range_space,
+    Legion::IndexPartition block_range_partition
+)
+    : ctx(ctx), rt(rt), kernel_region(kernel_region), fid_col(fid_col),
+      fid_entry(fid_entry), rowptr_region(rowptr_region),
+      fid_rowptr(fid_rowptr), block_domain_space(block_domain_space),
+      domain_space(domain_space), range_space(range_space),
+      block_range_partition(block_range_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, block_range_partition)
+      ),
+      row_extent_region(
+          create_extent_region(rowptr_region.get_index_space())
+      ),
+      col_extent_region(create_extent_region(block_domain_space)),
+      kernel_partition(rt->create_partition_by_image_range(
+          ctx,
+          kernel_region.get_index_space(),
+          rt->get_logical_partition(ctx, rowptr_region, block_range_partition),
+          rowptr_region,
+          fid_rowptr,
+          color_space
+      )),
+      block_domain_partition(rt->create_partition_by_image(
+          ctx,
+          block_domain_space,
+          rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+          kernel_region,
+          fid_col,
+          color_space
+      )),
+      // Distinct nodes have disjoint extents, so the scalar range partition
+      // is as disjoint as the block range partition.
+      range_partition(scalar_partition(
+          range_space,
+          row_extent_region,
+          block_range_partition,
+          rt->is_index_partition_disjoint(ctx, block_range_partition)
+              ? LEGION_DISJOINT_KIND
+              : LEGION_ALIASED_KIND
+      )),
+      domain_partition(scalar_partition(
+          domain_space, col_extent_region, block_domain_partition
+      )) {
+    assert(
+        rt->get_parent_index_space(ctx, block_range_partition) ==
+        rowptr_region.get_index_space()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::~BSRMatrix() {
+    rt->destroy_index_partition(ctx, domain_partition);
+    rt->destroy_index_partition(ctx, range_partition);
+    rt->destroy_index_partition(ctx, block_domain_partition);
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_logical_region(ctx, col_extent_region);
+    rt->destroy_logical_region(ctx, row_extent_region);
+    rt->destroy_field_space(ctx, col_extent_region.get_field_space());
+    rt->destroy_field_space(ctx, row_extent_region.get_field_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::LogicalRegion
+BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::create_extent_region(
+    Legion::IndexSpace block_space
+) const {
+    const Legion::FieldSpace field_space = create_field_space(
+        ctx, rt, {sizeof(Legion::Rect<DIM, COORD_T>)}, {EXTENT_FID}
+    );
+    const Legion::LogicalRegion extent_region =
+        rt->create_logical_region(ctx, block_space, field_space);
+    const Legion::IndexPartition pieces =
+        rt->create_equal_partition(ctx, block_space, color_space);
+    const std::uint32_t block_size = BLOCK_SIZE;
+    Legion::IndexLauncher launcher{
+        BSRExtentTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&block_size, sizeof(std::uint32_t)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, extent_region, pieces),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            extent_region})
+        .add_field(EXTENT_FID);
+    rt->execute_index_space(ctx, launcher);
+    rt->destroy_index_partition(ctx, pieces);
+    return extent_region;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition
+BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::scalar_partition(
+    Legion::IndexSpace scalar_space,
+    Legion::LogicalRegion extent_region,
+    Legion::IndexPartition block_partition,
+    Legion::PartitionKind kind
+) const {
+    return rt->create_partition_by_image_range(
+        ctx,
+        scalar_space,
+        rt->get_logical_partition(ctx, extent_region, block_partition),
+        extent_region,
+        EXTENT_FID,
+        rt->get_index_partition_color_space_name(ctx, block_partition),
+        kind
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition
+BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::block_partition(
+    Legion::LogicalRegion extent_region,
+    Legion::IndexPartition scalar_partition
+) const {
+    return rt->create_partition_by_preimage_range(
+        ctx,
+        scalar_partition,
+        extent_region,
+        extent_region,
+        EXTENT_FID,
+        rt->get_index_partition_color_space_name(ctx, scalar_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::
+    kernel_partition_from_domain_partition(
+        Legion::IndexPartition domain_partition
+    ) const {
+    const Legion::IndexPartition nodes =
+        block_partition(col_extent_region, domain_partition);
+    const Legion::IndexPartition result = rt->create_partition_by_preimage(
+        ctx,
+        nodes,
+        kernel_region,
+        kernel_region,
+        fid_col,
+        rt->get_index_partition_color_space_name(ctx, domain_partition)
+    );
+    rt->destroy_index_partition(ctx, nodes);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::
+    kernel_partition_from_range_partition(
+        Legion::IndexPartition range_partition
+    ) const {
+    const Legion::IndexPartition nodes =
+        block_partition(row_extent_region, range_partition);
+    const Legion::IndexPartition result = rt->create_partition_by_image_range(
+        ctx,
+        kernel_region.get_index_space(),
+        rt->get_logical_partition(ctx, rowptr_region, nodes),
+        rowptr_region,
+        fid_rowptr,
+        rt->get_index_partition_color_space_name(ctx, range_partition)
+    );
+    rt->destroy_index_partition(ctx, nodes);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::
+    domain_partition_from_kernel_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+    ) const {
+    const Legion::IndexPartition nodes = rt->create_partition_by_image(
+        ctx,
+        block_domain_space,
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+        kernel_region,
+        fid_col,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+    const Legion::IndexPartition result =
+        scalar_partition(domain_space, col_extent_region, nodes);
+    rt->destroy_index_partition(ctx, nodes);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+Legion::IndexPartition BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::
+    range_partition_from_kernel_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+    ) const {
+    const Legion::IndexPartition nodes = rt->create_partition_by_preimage_range(
+        ctx,
+        kernel_partition,
+        rowptr_region,
+        rowptr_region,
+        fid_rowptr,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+    const Legion::IndexPartition result =
+        scalar_partition(range_space, row_extent_region, nodes);
+    rt->destroy_index_partition(ctx, nodes);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+void BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == range_space);
+    assert(input_region.get_index_space() == domain_space);
+    const std::uint32_t block_size = BLOCK_SIZE;
+    Legion::IndexLauncher launcher{
+        BSRMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&block_size, sizeof(std::uint32_t)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, rowptr_region, block_range_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(fid_rowptr);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_col);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_entry);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, domain_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+void BSRMatrix<ENTRY_T, DIM, COORD_T, BLOCK_SIZE>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == domain_space);
+    assert(input_region.get_index_space() == range_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    const std::uint32_t block_size = BLOCK_SIZE;
+    Legion::IndexLauncher launcher{
+        BSRTransposeMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&block_size, sizeof(std::uint32_t)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, domain_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, rowptr_region, block_range_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(fid_rowptr);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_col);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_entry);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<float, 1, int, 2>;
+            template class LegionSolvers::BSRMatrix<float, 1, int, 3>;
+            template class LegionSolvers::BSRMatrix<float, 1, int, 4>;
+            template class LegionSolvers::BSRMatrix<float, 1, int, 5>;
+            template class LegionSolvers::BSRMatrix<float, 1, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<float, 2, int, 2>;
+            template class LegionSolvers::BSRMatrix<float, 2, int, 3>;
+            template class LegionSolvers::BSRMatrix<float, 2, int, 4>;
+            template class LegionSolvers::BSRMatrix<float, 2, int, 5>;
+            template class LegionSolvers::BSRMatrix<float, 2, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<float, 3, int, 2>;
+            template class LegionSolvers::BSRMatrix<float, 3, int, 3>;
+            template class LegionSolvers::BSRMatrix<float, 3, int, 4>;
+            template class LegionSolvers::BSRMatrix<float, 3, int, 5>;
+            template class LegionSolvers::BSRMatrix<float, 3, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<float, 1, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<float, 1, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<float, 1, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<float, 1, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<float, 1, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<float, 2, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<float, 2, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<float, 2, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<float, 2, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<float, 2, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<float, 3, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<float, 3, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<float, 3, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<float, 3, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<float, 3, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<float, 1, long long, 2>;
+            template class LegionSolvers::BSRMatrix<float, 1, long long, 3>;
+            template class LegionSolvers::BSRMatrix<float, 1, long long, 4>;
+            template class LegionSolvers::BSRMatrix<float, 1, long long, 5>;
+            template class LegionSolvers::BSRMatrix<float, 1, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<float, 2, long long, 2>;
+            template class LegionSolvers::BSRMatrix<float, 2, long long, 3>;
+            template class LegionSolvers::BSRMatrix<float, 2, long long, 4>;
+            template class LegionSolvers::BSRMatrix<float, 2, long long, 5>;
+            template class LegionSolvers::BSRMatrix<float, 2, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<float, 3, long long, 2>;
+            template class LegionSolvers::BSRMatrix<float, 3, long long, 3>;
+            template class LegionSolvers::BSRMatrix<float, 3, long long, 4>;
+            template class LegionSolvers::BSRMatrix<float, 3, long long, 5>;
+            template class LegionSolvers::BSRMatrix<float, 3, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<double, 1, int, 2>;
+            template class LegionSolvers::BSRMatrix<double, 1, int, 3>;
+            template class LegionSolvers::BSRMatrix<double, 1, int, 4>;
+            template class LegionSolvers::BSRMatrix<double, 1, int, 5>;
+            template class LegionSolvers::BSRMatrix<double, 1, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<double, 2, int, 2>;
+            template class LegionSolvers::BSRMatrix<double, 2, int, 3>;
+            template class LegionSolvers::BSRMatrix<double, 2, int, 4>;
+            template class LegionSolvers::BSRMatrix<double, 2, int, 5>;
+            template class LegionSolvers::BSRMatrix<double, 2, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<double, 3, int, 2>;
+            template class LegionSolvers::BSRMatrix<double, 3, int, 3>;
+            template class LegionSolvers::BSRMatrix<double, 3, int, 4>;
+            template class LegionSolvers::BSRMatrix<double, 3, int, 5>;
+            template class LegionSolvers::BSRMatrix<double, 3, int, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<double, 1, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<double, 1, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<double, 1, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<double, 1, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<double, 1, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<double, 2, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<double, 2, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<double, 2, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<double, 2, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<double, 2, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<double, 3, unsigned, 2>;
+            template class LegionSolvers::BSRMatrix<double, 3, unsigned, 3>;
+            template class LegionSolvers::BSRMatrix<double, 3, unsigned, 4>;
+            template class LegionSolvers::BSRMatrix<double, 3, unsigned, 5>;
+            template class LegionSolvers::BSRMatrix<double, 3, unsigned, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BSRMatrix<double, 1, long long, 2>;
+            template class LegionSolvers::BSRMatrix<double, 1, long long, 3>;
+            template class LegionSolvers::BSRMatrix<double, 1, long long, 4>;
+            template class LegionSolvers::BSRMatrix<double, 1, long long, 5>;
+            template class LegionSolvers::BSRMatrix<double, 1, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BSRMatrix<double, 2, long long, 2>;
+            template class LegionSolvers::BSRMatrix<double, 2, long long, 3>;
+            template class LegionSolvers::BSRMatrix<double, 2, long long, 4>;
+            template class LegionSolvers::BSRMatrix<double, 2, long long, 5>;
+            template class LegionSolvers::BSRMatrix<double, 2, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BSRMatrix<double, 3, long long, 2>;
+            template class LegionSolvers::BSRMatrix<double, 3, long long, 3>;
+            template class LegionSolvers::BSRMatrix<double, 3, long long, 4>;
+            template class LegionSolvers::BSRMatrix<double, 3, long long, 5>;
+            template class LegionSolvers::BSRMatrix<double, 3, long long, 6>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,178 @@
+#ifndef LEGION_SOLVERS_BSR_MATRIX_HPP_INCLUDED
+#define LEGION_SOLVERS_BSR_MATRIX_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractMatrix.hpp" // for AbstractMatrix
+#include "BSRMatrixTasks.hpp" // for BSRBlock, bsr_scalar_point
+
+namespace LegionSolvers {
+
+
+// A sparse matrix in block compressed sparse row format, for systems with
+// BLOCK_SIZE unknowns per node, stored in place in application-owned
+// regions laid out as for CSRMatrix, but over nodes: the row pointer region
+// is defined over the block range space, and the 1D kernel region has one
+// point per nonzero block, holding its block column index (a
+// Point<DIM, COORD_T> of the block domain space) and its entries (a
+// BSRBlock<ENTRY_T, BLOCK_SIZE>). Storing one column index per block rather
+// than per entry divides the index traffic of a product by
+// BLOCK_SIZE * BLOCK_SIZE.
+//
+// Vectors live in scalar index spaces in which the components of node p are
+// the BLOCK_SIZE consecutive points given by bsr_scalar_point. The matrix
+// keeps, for each node of its block spaces, the Rect of its components, and
+// uses them to translate between block and scalar partitions. Products are
+// computed row-parallel over an application-supplied partition of the block
+// range space; the matching kernel, block domain, and scalar range and
+// domain partitions are derived from it when the matrix is constructed.
+template <typename ENTRY_T, int DIM, typename COORD_T, int BLOCK_SIZE>
+class BSRMatrix : public AbstractMatrix<ENTRY_T> {
+
+    static_assert(
+        (BLOCK_SIZE >= 2) && (BLOCK_SIZE <= 6),
+        "BSRMatvecTask supports block sizes from 2 to 6."
+    );
+
+    static constexpr Legion::FieldID EXTENT_FID = 0;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::LogicalRegion kernel_region;
+    const Legion::FieldID fid_col;
+    const Legion::FieldID fid_entry;
+    const Legion::LogicalRegion rowptr_region;
+    const Legion::FieldID fid_rowptr;
+    const Legion::IndexSpace block_domain_space;
+    const Legion::IndexSpace domain_space;
+    const Legion::IndexSpace range_space;
+    const Legion::IndexPartition block_range_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::LogicalRegion row_extent_region;
+    const Legion::LogicalRegion col_extent_region;
+    const Legion::IndexPartition kernel_partition;
+    const Legion::IndexPartition block_domain_partition;
+    const Legion::IndexPartition range_partition;
+    const Legion::IndexPartition domain_partition;
+
+    // Creates a region over block_space holding the scalar extent of each
+    // node, filled by BSRExtentTask.
+    Legion::LogicalRegion create_extent_region(Legion::IndexSpace block_space
+    ) const;
+
+    // Components of the nodes in each piece (image of the extents).
+    Legion::IndexPartition scalar_partition(
+        Legion::IndexSpace scalar_space,
+        Legion::LogicalRegion extent_region,
+        Legion::IndexPartition block_partition,
+        Legion::PartitionKind kind = LEGION_COMPUTE_KIND
+    ) const;
+
+    // Nodes with a component in each piece (preimage of the extents).
+    Legion::IndexPartition block_partition(
+        Legion::LogicalRegion extent_region,
+        Legion::IndexPartition scalar_partition
+    ) const;
+
+  public:
+
+    explicit BSRMatrix(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::LogicalRegion kernel_region,
+        Legion::FieldID fid_col,
+        Legion::FieldID fid_entry,
+        Legion::LogicalRegion rowptr_region,
+        Legion::FieldID fid_rowptr,
+        Legion::IndexSpace block_domain_space,
+        Legion::IndexSpace domain_space,
+        Legion::IndexSpace range_space,
+        Legion::IndexPartition block_range_partition
+    );
+
+    BSRMatrix(const BSRMatrix &) = delete;
+
+    BSRMatrix &operator=(const BSRMatrix &) = delete;
+
+    virtual ~BSRMatrix();
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_range_space() const { return range_space; }
+
+    Legion::IndexPartition get_block_range_partition() const {
+        return block_range_partition;
+    }
+
+    Legion::IndexPartition get_block_domain_partition() const {
+        return block_domain_partition;
+    }
+
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    Legion::IndexPartition get_domain_partition() const {
+        return domain_partition;
+    }
+
+    virtual Legion::IndexSpace get_kernel_space() const override {
+        return kernel_region.get_index_space();
+    }
+
+    virtual Legion::LogicalRegion get_kernel_region() const override {
+        return kernel_region;
+    }
+
+    virtual std::vector<Legion::LogicalRegion>
+    get_auxiliary_regions() const override {
+        return {rowptr_region, row_extent_region, col_extent_region};
+    }
+
+    // Blocks whose block column has a component in each piece.
+    virtual Legion::IndexPartition kernel_partition_from_domain_partition(
+        Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Blocks in the block rows with a component in each piece.
+    virtual Legion::IndexPartition
+    kernel_partition_from_range_partition(Legion::IndexPartition range_partition
+    ) const override;
+
+    // Components of the block columns of the blocks in each piece.
+    virtual Legion::IndexPartition domain_partition_from_kernel_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Components of the block rows whose blocks intersect each piece.
+    virtual Legion::IndexPartition range_partition_from_kernel_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // As CSRMatrix::transpose_matvec, by BSRTransposeMatvecTask.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class BSRMatrix
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BSR_MATRIX_HPP_INCLUDED
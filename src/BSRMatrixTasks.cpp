@@ -0,0 +1,478 @@
+#include "BSRMatrixTasks.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineSumAccessor, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+#include "SparseKernels.hpp"   // for bsr_row_multiply
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+#include "VectorKernels.hpp"   // for is_dense_rect, for_each_thread_range
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineSumAccessor;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::BSRBlock;
+using LegionSolvers::BSRExtentTask;
+using LegionSolvers::BSRMatvecTask;
+using LegionSolvers::BSRTransposeMatvecTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::bsr_row_multiply;
+using LegionSolvers::bsr_scalar_point;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BSRExtentTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 1);
+    const auto &extent = regions[0];
+
+    assert(task->regions.size() == 1);
+    const auto &extent_req = task->regions[0];
+
+    assert(extent_req.privilege_fields.size() == 1);
+    const Legion::FieldID extent_fid = *extent_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(std::uint32_t));
+    const int block_size = static_cast<int>(
+        *static_cast<const std::uint32_t *>(task->args)
+    );
+
+    using Extent = Legion::Rect<DIM, COORD_T>;
+    AffineWriter<Extent, DIM, COORD_T> extent_writer{extent, extent_fid};
+
+    const Legion::Domain domain =
+        rt->get_index_space_domain(ctx, extent_req.region.get_index_space());
+    for (Legion::PointInDomainIterator<DIM, COORD_T> it(domain); it(); ++it) {
+        extent_writer[*it] = Extent{
+            bsr_scalar_point(*it, block_size, 0),
+            bsr_scalar_point(*it, block_size, block_size - 1)};
+    }
+}
+
+
+// Index of the i-th point of rect, with the first coordinate varying
+// fastest.
+template <int DIM, typename COORD_T>
+Legion::Point<DIM, COORD_T>
+rect_point(const Legion::Rect<DIM, COORD_T> &rect, std::size_t i) {
+    Legion::Point<DIM, COORD_T> result;
+    for (int d = 0; d < DIM; ++d) {
+        const std::size_t extent = rect.hi[d] - rect.lo[d] + 1;
+        result[d] = static_cast<COORD_T>(rect.lo[d] + i % extent);
+        i /= extent;
+    }
+    return result;
+}
+
+
+template <int BLOCK_SIZE, typename ENTRY_T, int DIM, typename COORD_T>
+void bsr_matvec(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    constexpr int B = BLOCK_SIZE;
+
+    const auto &output = regions[0];
+    const auto &rowptr = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    const auto &output_req = task->regions[0];
+    const auto &rowptr_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+    using Block = BSRBlock<ENTRY_T, B>;
+    static_assert(sizeof(Block) == B * B * sizeof(ENTRY_T));
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{output, output_fid};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Column, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<Block, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain row_domain =
+        rt->get_index_space_domain(ctx, rowptr_req.region.get_index_space());
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, col_req.region.get_index_space());
+
+    // As in CSRMatvecTask, the block rows of one piece normally own one
+    // contiguous run of the kernel space, which is streamed by pointer.
+    const Legion::Rect<1, COORD_T> kernel_rect = kernel_domain;
+    const bool dense_kernel =
+        kernel_domain.dense() &&
+        (kernel_rect.empty() ||
+         is_dense_rect(kernel_rect, col_reader, entry_reader));
+    const std::size_t num_blocks = kernel_rect.volume();
+    const Column *col_ptr =
+        (num_blocks > 0) ? col_reader.ptr(kernel_rect.lo) : nullptr;
+    const ENTRY_T *block_ptr =
+        (num_blocks > 0) ? entry_reader.ptr(kernel_rect.lo)->values : nullptr;
+    const auto input_ptr = [&](const Column &j, std::size_t c) {
+        return input_reader.ptr(bsr_scalar_point(j, B, static_cast<int>(c)));
+    };
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (RectIterator rect_iter(row_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        for_each_thread_range(
+            parallel && dense_kernel,
+            rect.volume(),
+            [&](int, std::size_t begin, std::size_t end) {
+                ENTRY_T y[B];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Column row = rect_point(rect, i);
+                    const RowExtent extent = rowptr_reader[row];
+                    if (extent.empty()) {
+                        for (int c = 0; c < B; ++c) {
+                            y[c] = static_cast<ENTRY_T>(0);
+                        }
+                    } else if (dense_kernel) {
+                        bsr_row_multiply<B>(
+                            extent.lo[0] - kernel_rect.lo[0],
+                            extent.hi[0] - kernel_rect.lo[0] + 1,
+                            num_blocks,
+                            block_ptr,
+                            col_ptr,
+                            input_ptr,
+                            y
+                        );
+                    } else {
+                        for (int c = 0; c < B; ++c) {
+                            y[c] = static_cast<ENTRY_T>(0);
+                        }
+                        for (KernelIterator k(extent); k(); ++k) {
+                            const Block block = entry_reader[*k];
+                            const Column j = col_reader[*k];
+                            for (int r = 0; r < B; ++r) {
+                                for (int c = 0; c < B; ++c) {
+                                    y[r] += block.values[r * B + c] *
+                                            input_reader[bsr_scalar_point(
+                                                j, B, c
+                                            )];
+                                }
+                            }
+                        }
+                    }
+                    for (int c = 0; c < B; ++c) {
+                        output_writer[bsr_scalar_point(row, B, c)] = y[c];
+                    }
+                }
+            }
+        );
+    }
+}
+
+
+template <int BLOCK_SIZE, typename ENTRY_T, int DIM, typename COORD_T>
+void bsr_transpose_matvec(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    constexpr int B = BLOCK_SIZE;
+
+    const auto &output = regions[0];
+    const auto &rowptr = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    const auto &output_req = task->regions[0];
+    const auto &rowptr_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+    using Block = BSRBlock<ENTRY_T, B>;
+    static_assert(sizeof(Block) == B * B * sizeof(ENTRY_T));
+
+    AffineSumAccessor<ENTRY_T, DIM, COORD_T> output_reducer{
+        output, output_fid, LEGION_REDOP_SUM<ENTRY_T>};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Column, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<Block, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain row_domain =
+        rt->get_index_space_domain(ctx, rowptr_req.region.get_index_space());
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (RectIterator rect_iter(row_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        // Block rows of different threads may share block columns; the
+        // reduction accessor is non-exclusive, so reductions are atomic.
+        for_each_thread_range(
+            parallel,
+            rect.volume(),
+            [&](int, std::size_t begin, std::size_t end) {
+                ENTRY_T x[B];
+                ENTRY_T y[B];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Column row = rect_point(rect, i);
+                    for (int r = 0; r < B; ++r) {
+                        x[r] = input_reader[bsr_scalar_point(row, B, r)];
+                    }
+                    for (KernelIterator k(rowptr_reader[row]); k(); ++k) {
+                        const ENTRY_T *block = entry_reader.ptr(*k)->values;
+                        for (int c = 0; c < B; ++c) {
+                            y[c] = static_cast<ENTRY_T>(0);
+                        }
+                        for (int r = 0; r < B; ++r) {
+                            for (int c = 0; c < B; ++c) {
+                                y[c] += block[r * B + c] * x[r];
+                            }
+                        }
+                        const Column j = col_reader[*k];
+                        for (int c = 0; c < B; ++c) {
+                            output_reducer.reduce(
+                                bsr_scalar_point(j, B, c), y[c]
+                            );
+                        }
+                    }
+                }
+            }
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BSRMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    assert(task->arglen == sizeof(std::uint32_t));
+    switch (*static_cast<const std::uint32_t *>(task->args)) {
+        case 2:
+            bsr_matvec<2, ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+            break;
+        case 3:
+            bsr_matvec<3, ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+            break;
+        case 4:
+            bsr_matvec<4, ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+            break;
+        case 5:
+            bsr_matvec<5, ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+            break;
+        case 6:
+            bsr_matvec<6, ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+            break;
+        default: assert(false);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BSRTransposeMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    assert(task->arglen == sizeof(std::uint32_t));
+    switch (*static_cast<const std::uint32_t *>(task->args)) {
+        case 2:
+            bsr_transpose_matvec<2, ENTRY_T, DIM, COORD_T>(
+                task, regions, ctx, rt
+            );
+            break;
+        case 3:
+            bsr_transpose_matvec<3, ENTRY_T, DIM, COORD_T>(
+                task, regions, ctx, rt
+            );
+            break;
+        case 4:
+            bsr_transpose_matvec<4, ENTRY_T, DIM, COORD_T>(
+                task, regions, ctx, rt
+            );
+            break;
+        case 5:
+            bsr_transpose_matvec<5, ENTRY_T, DIM, COORD_T>(
+                task, regions, ctx, rt
+            );
+            break;
+        case 6:
+            bsr_transpose_matvec<6, ENTRY_T, DIM, COORD_T>(
+                task, regions, ctx, rt
+            );
+            break;
+        default: assert(false);
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BSRExtentTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BSRExtentTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BSRExtentTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BSRTransposeMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,134 @@
+#ifndef LEGION_SOLVERS_BSR_MATRIX_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_BSR_MATRIX_TASKS_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for BSR_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Entries of one BLOCK_SIZE-by-BLOCK_SIZE block of a BSR matrix, row by row.
+template <typename ENTRY_T, int BLOCK_SIZE>
+struct BSRBlock {
+    ENTRY_T values[BLOCK_SIZE * BLOCK_SIZE];
+}; // struct BSRBlock
+
+
+// Index of component c of block point p in the scalar index space of a
+// vector with block_size unknowns per block: the first coordinate of p is
+// multiplied by block_size and offset by c, so that the unknowns of a block
+// are consecutive.
+template <int DIM, typename COORD_T>
+Legion::Point<DIM, COORD_T> bsr_scalar_point(
+    const Legion::Point<DIM, COORD_T> &p, int block_size, int c
+) {
+    Legion::Point<DIM, COORD_T> result = p;
+    result[0] = static_cast<COORD_T>(block_size * p[0] + c);
+    return result;
+}
+
+
+// Writes, for each point p of a block index space, the Rect<DIM, COORD_T> of
+// scalar indices of its components (see bsr_scalar_point). The only region
+// is the extents (write-discard), and the task argument is the block size,
+// as a std::uint32_t. BSRMatrix derives partitions of scalar index spaces
+// from partitions of block index spaces through these extents.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BSRExtentTask
+    : public TaskTDI<
+          BSR_EXTENT_TASK_BLOCK_ID,
+          BSRExtentTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "bsr_extent";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BSRExtentTask
+
+
+// Computes output = A * input for the block rows of a BSR matrix A in one
+// piece of its block range space. Regions are output (write-discard, scalar
+// range piece), row pointers (read-only, block range piece), block column
+// indices and blocks (read-only, kernel piece, one requirement each), and
+// input (read-only, scalar domain piece). Blocks are BSRBlock<ENTRY_T, B>
+// values, where the block size B is the task argument, as a std::uint32_t.
+// The task dispatches on B to a kernel compiled for that block size.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BSRMatvecTask
+    : public TaskTDI<
+          BSR_MATVEC_TASK_BLOCK_ID,
+          BSRMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "bsr_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BSRMatvecTask
+
+
+// Adds A^T * input to output for the block rows of a BSR matrix A in one
+// piece of its block range space. Regions are output (reduction by
+// LEGION_REDOP_SUM<ENTRY_T>, scalar domain piece), row pointers, block
+// column indices, and blocks as for BSRMatvecTask, and input (read-only,
+// scalar range piece). The task argument is the block size, as for
+// BSRMatvecTask.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BSRTransposeMatvecTask
+    : public TaskTDI<
+          BSR_TRANSPOSE_MATVEC_TASK_BLOCK_ID,
+          BSRTransposeMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "bsr_transpose_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BSRTransposeMatvecTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BSR_MATRIX_TASKS_HPP_INCLUDED
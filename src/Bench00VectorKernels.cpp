@@ -0,0 +1,503 @@
+#include <algorithm> // for std::max
+#include <chrono>    // for std::chrono::*
+#include <cmath>     // for std::pow, std::llround
+#include <cstdlib>   // for std::atoll, std::atoi
+#include <cstring>   // for std::memcpy, std::strcmp
+#include <iostream>  // for std::cout, std::endl
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionSolversMapper.hpp"      // for mapper_registration_callback
+#include "LegionUtilities.hpp"          // for preregister_task, ...
+#include "LibraryOptions.hpp"           // for LEGION_SOLVERS_*
+#include "LinearAlgebraTasks.hpp"       // for ScalTask, AxpyTask, ...
+#include "MetaprogrammingUtilities.hpp" // for ToString
+#include "Scalar.hpp"                   // for Scalar
+#include "ScalarProgram.hpp"            // for ScalarProgram
+#include "SIMDUtilities.hpp"            // for SIMDPack, LEGION_SOLVERS_SIMD_ISA
+#include "TaskRegistration.hpp"         // for preregister_tasks
+#include "VectorKernels.hpp"            // for DotProductMode
+
+enum TaskIDs : Legion::TaskID { TOP_LEVEL_TASK_ID };
+
+enum FieldIDs : Legion::FieldID { FID_X, FID_Y, FID_P, FID_R, FID_Q };
+
+
+struct BenchmarkOptions {
+    long long num_entries = 1LL << 24;
+    int num_trials = 10;
+}; // struct BenchmarkOptions
+
+
+BenchmarkOptions parse_options() {
+    const Legion::InputArgs &args = Legion::Runtime::get_input_args();
+    BenchmarkOptions options;
+    for (int i = 1; i + 1 < args.argc; ++i) {
+        if (std::strcmp(args.argv[i], "-n") == 0) {
+            options.num_entries = std::atoll(args.argv[++i]);
+        } else if (std::strcmp(args.argv[i], "-trials") == 0) {
+            options.num_trials = std::atoi(args.argv[++i]);
+        }
+    }
+    return options;
+}
+
+
+// Best-of-N bandwidth of the STREAM triad a[i] = b[i] + s * c[i], counting
+// two loads and one store per entry, as in the reference STREAM benchmark.
+template <typename ENTRY_T>
+double stream_triad_bandwidth(const BenchmarkOptions &options) {
+    const std::size_t n = static_cast<std::size_t>(options.num_entries);
+    std::vector<ENTRY_T> a(n);
+    std::vector<ENTRY_T> b(n, static_cast<ENTRY_T>(1));
+    std::vector<ENTRY_T> c(n, static_cast<ENTRY_T>(2));
+    const ENTRY_T s = static_cast<ENTRY_T>(3);
+    double best = 0.0;
+    for (int trial = 0; trial < options.num_trials; ++trial) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < n; ++i) { a[i] = b[i] + s * c[i]; }
+        const auto stop = std::chrono::steady_clock::now();
+        const double seconds =
+            std::chrono::duration<double>(stop - start).count();
+        best = std::max(best, 3.0 * n * sizeof(ENTRY_T) / seconds * 1.0e-9);
+    }
+    volatile ENTRY_T sink = a[n / 2];
+    static_cast<void>(sink);
+    return best;
+}
+
+
+// Roughly cube-shaped rect containing about num_entries points.
+template <int DIM, typename COORD_T>
+Legion::Rect<DIM, COORD_T> benchmark_bounds(long long num_entries) {
+    const long long side = std::max(
+        1LL, std::llround(std::pow(double(num_entries), 1.0 / double(DIM)))
+    );
+    long long remaining = num_entries;
+    Legion::Point<DIM, COORD_T> lo = Legion::Point<DIM, COORD_T>::ZEROES();
+    Legion::Point<DIM, COORD_T> hi;
+    for (int d = 0; d < DIM - 1; ++d) {
+        hi[d] = static_cast<COORD_T>(side - 1);
+        remaining /= side;
+    }
+    hi[DIM - 1] = static_cast<COORD_T>(std::max(1LL, remaining) - 1);
+    return Legion::Rect<DIM, COORD_T>{lo, hi};
+}
+
+
+// Average time of one execution of the given sequence of launches.
+double time_launches(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::vector<Legion::TaskLauncher> &launchers,
+    int num_trials
+) {
+    for (const auto &launcher : launchers) { // warm up instances
+        rt->execute_task(ctx, launcher);
+    }
+    const Legion::Future start = rt->get_current_time_in_microseconds(
+        ctx, rt->issue_execution_fence(ctx)
+    );
+    for (int trial = 0; trial < num_trials; ++trial) {
+        for (const auto &launcher : launchers) {
+            rt->execute_task(ctx, launcher);
+        }
+    }
+    const Legion::Future stop = rt->get_current_time_in_microseconds(
+        ctx, rt->issue_execution_fence(ctx)
+    );
+    const long long elapsed =
+        stop.get_result<long long>() - start.get_result<long long>();
+    return 1.0e-6 * static_cast<double>(elapsed) / num_trials;
+}
+
+
+double time_launches(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const Legion::TaskLauncher &launcher,
+    int num_trials
+) {
+    return time_launches(
+        ctx, rt, std::vector<Legion::TaskLauncher>{launcher}, num_trials
+    );
+}
+
+
+void report(
+    const std::string &label,
+    const std::string &kernel,
+    double bytes,
+    double seconds,
+    double triad_bandwidth
+) {
+    const double bandwidth = bytes / seconds * 1.0e-9;
+    std::cout << label << ' ' << kernel << ": " << bandwidth << " GB/s ("
+              << 100.0 * bandwidth / triad_bandwidth << "% of STREAM triad)"
+              << std::endl;
+}
+
+
+// Times the vector updates of one CG iteration, given q = A * p:
+//     x += alpha * p;  r -= alpha * q;  rr = dot(r, r);  p = r + beta * p;
+// as separate tasks and as fused tasks. Traffic is counted in vector-lengths
+// of entries actually loaded or stored (a read-write vector counts twice).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void benchmark_cg_update(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const BenchmarkOptions &options,
+    double triad_bandwidth
+) {
+    using LegionSolvers::AxpyDotTask;
+    using LegionSolvers::AxpyTask;
+    using LegionSolvers::DotProductMode;
+    using LegionSolvers::DotTask;
+    using LegionSolvers::MultiUpdateDotArgs;
+    using LegionSolvers::MultiUpdateDotTask;
+    using LegionSolvers::Scalar;
+    using LegionSolvers::ScalarProgram;
+    using LegionSolvers::VectorUpdateKind;
+    using LegionSolvers::XpayAxpyArgs;
+    using LegionSolvers::XpayAxpyTask;
+    using LegionSolvers::XpayTask;
+
+    const Legion::Rect<DIM, COORD_T> bounds =
+        benchmark_bounds<DIM, COORD_T>(options.num_entries);
+    const Legion::IndexSpace index_space = rt->create_index_space(ctx, bounds);
+    const Legion::FieldSpace field_space = LegionSolvers::create_field_space(
+        ctx,
+        rt,
+        {sizeof(ENTRY_T), sizeof(ENTRY_T), sizeof(ENTRY_T), sizeof(ENTRY_T)},
+        {FID_X, FID_P, FID_R, FID_Q}
+    );
+    const Legion::LogicalRegion region =
+        rt->create_logical_region(ctx, index_space, field_space);
+    for (const Legion::FieldID fid : {FID_X, FID_P, FID_R, FID_Q}) {
+        rt->fill_field<ENTRY_T>(
+            ctx, region, region, fid, static_cast<ENTRY_T>(1)
+        );
+    }
+
+    // alpha = 1 and beta = 1 keep all vectors bounded across trials.
+    const Legion::Future alpha =
+        Legion::Future::from_value(rt, static_cast<ENTRY_T>(1));
+    const Legion::Future minus_alpha =
+        Legion::Future::from_value(rt, static_cast<ENTRY_T>(-1));
+    const Legion::Future beta = alpha;
+    const Legion::RegionRequirement rw{
+        region, LEGION_READ_WRITE, LEGION_EXCLUSIVE, region};
+    const Legion::RegionRequirement ro{
+        region, LEGION_READ_ONLY, LEGION_EXCLUSIVE, region};
+
+    const std::string label = LegionSolvers::ToString<ENTRY_T>::value() + '_' +
+                              std::to_string(DIM) + '_' +
+                              LegionSolvers::ToString<COORD_T>::value();
+    const double entry_bytes =
+        static_cast<double>(bounds.volume()) * sizeof(ENTRY_T);
+
+    Legion::TaskLauncher xpay{
+        XpayTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+    xpay.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+    xpay.add_region_requirement(rw).add_field(FID_P);
+    xpay.add_region_requirement(ro).add_field(FID_R);
+    xpay.add_future(beta);
+
+    {
+        Legion::TaskLauncher update_x{
+            AxpyTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        update_x.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        update_x.add_region_requirement(rw).add_field(FID_X);
+        update_x.add_region_requirement(ro).add_field(FID_P);
+        update_x.add_future(alpha);
+
+        Legion::TaskLauncher update_r{
+            AxpyTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        update_r.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        update_r.add_region_requirement(rw).add_field(FID_R);
+        update_r.add_region_requirement(ro).add_field(FID_Q);
+        update_r.add_future(minus_alpha);
+
+        Legion::TaskLauncher dot{
+            DotTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        dot.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        dot.add_region_requirement(ro).add_field(FID_R);
+        dot.add_region_requirement(ro).add_field(FID_R);
+
+        const double seconds = time_launches(
+            ctx, rt, {update_x, update_r, dot, xpay}, options.num_trials
+        );
+        report(
+            label,
+            "CG update (axpy, axpy, dot, xpay; 10 vectors)",
+            10.0 * entry_bytes,
+            seconds,
+            triad_bandwidth
+        );
+        std::cout << label << " CG update (unfused): " << 1.0e3 * seconds
+                  << " ms" << std::endl;
+    }
+    {
+        Legion::TaskLauncher update_r{
+            AxpyDotTask<ENTRY_T, DIM, COORD_T>::task_id,
+            Legion::TaskArgument{}};
+        update_r.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        update_r.add_region_requirement(rw).add_field(FID_R);
+        update_r.add_region_requirement(ro).add_field(FID_Q);
+        update_r.add_future(minus_alpha);
+
+        const XpayAxpyArgs args{{0, 1}, {1, 1}};
+        Legion::TaskLauncher update_p{
+            XpayAxpyTask<ENTRY_T, DIM, COORD_T>::task_id,
+            Legion::TaskArgument{&args, sizeof(XpayAxpyArgs)}};
+        update_p.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        update_p.add_region_requirement(rw).add_field(FID_P);
+        update_p.add_region_requirement(ro).add_field(FID_R);
+        update_p.add_region_requirement(rw).add_field(FID_X);
+        update_p.add_future(beta);
+        update_p.add_future(alpha);
+
+        const double seconds =
+            time_launches(ctx, rt, {update_r, update_p}, options.num_trials);
+        report(
+            label,
+            "CG update (axpy_dot, xpay_axpy; 8 vectors)",
+            8.0 * entry_bytes,
+            seconds,
+            triad_bandwidth
+        );
+        std::cout << label << " CG update (fused): " << 1.0e3 * seconds
+                  << " ms" << std::endl;
+    }
+    {
+        MultiUpdateDotArgs args{};
+        args.mode = DotProductMode::BLOCKED;
+        args.num_updates = 2;
+        args.num_dot_products = 1;
+        args.num_coefficients = 2;
+        args.updates[0] = {VectorUpdateKind::AXPY, 0, 1, 0};
+        args.updates[1] = {VectorUpdateKind::AXPY, 2, 3, 1};
+        args.dot_products[0] = {2, 2};
+        std::vector<Legion::Future> futures;
+        const ScalarProgram<ENTRY_T> programs[2] = {
+            Scalar<ENTRY_T>{ctx, rt, alpha}.compile(futures),
+            Scalar<ENTRY_T>{ctx, rt, minus_alpha}.compile(futures)};
+        std::vector<char> buffer(sizeof(args) + sizeof(programs));
+        std::memcpy(buffer.data(), &args, sizeof(args));
+        std::memcpy(buffer.data() + sizeof(args), programs, sizeof(programs));
+        Legion::TaskLauncher update{
+            MultiUpdateDotTask<ENTRY_T, DIM, COORD_T>::task_id,
+            Legion::TaskArgument{buffer.data(), buffer.size()}};
+        update.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        update.add_region_requirement(rw).add_field(FID_X);
+        update.add_region_requirement(ro).add_field(FID_P);
+        update.add_region_requirement(rw).add_field(FID_R);
+        update.add_region_requirement(ro).add_field(FID_Q);
+        for (const Legion::Future &future : futures) {
+            update.add_future(future);
+        }
+
+        const double seconds =
+            time_launches(ctx, rt, {update, xpay}, options.num_trials);
+        report(
+            label,
+            "CG update (multi_update_dot, xpay; 9 vectors)",
+            9.0 * entry_bytes,
+            seconds,
+            triad_bandwidth
+        );
+        std::cout << label << " CG update (multi-update): " << 1.0e3 * seconds
+                  << " ms" << std::endl;
+    }
+
+    rt->destroy_logical_region(ctx, region);
+    rt->destroy_field_space(ctx, field_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void benchmark_kernels(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const BenchmarkOptions &options,
+    double triad_bandwidth
+) {
+    using LegionSolvers::AxpyTask;
+    using LegionSolvers::DotProductMode;
+    using LegionSolvers::DotTask;
+    using LegionSolvers::ScalTask;
+    using LegionSolvers::XpayTask;
+
+    const Legion::Rect<DIM, COORD_T> bounds =
+        benchmark_bounds<DIM, COORD_T>(options.num_entries);
+    const Legion::IndexSpace index_space = rt->create_index_space(ctx, bounds);
+    const Legion::FieldSpace field_space = LegionSolvers::create_field_space(
+        ctx, rt, {sizeof(ENTRY_T), sizeof(ENTRY_T)}, {FID_X, FID_Y}
+    );
+    const Legion::LogicalRegion region =
+        rt->create_logical_region(ctx, index_space, field_space);
+    rt->fill_field<ENTRY_T>(
+        ctx, region, region, FID_X, static_cast<ENTRY_T>(1)
+    );
+    rt->fill_field<ENTRY_T>(
+        ctx, region, region, FID_Y, static_cast<ENTRY_T>(2)
+    );
+
+    // alpha = 1 keeps the contents of y bounded across trials.
+    const Legion::Future alpha =
+        Legion::Future::from_value(rt, static_cast<ENTRY_T>(1));
+    const Legion::RegionRequirement y_rw{
+        region, LEGION_READ_WRITE, LEGION_EXCLUSIVE, region};
+    const Legion::RegionRequirement x_ro{
+        region, LEGION_READ_ONLY, LEGION_EXCLUSIVE, region};
+
+    const std::string label = LegionSolvers::ToString<ENTRY_T>::value() + '_' +
+                              std::to_string(DIM) + '_' +
+                              LegionSolvers::ToString<COORD_T>::value();
+    const double entry_bytes =
+        static_cast<double>(bounds.volume()) * sizeof(ENTRY_T);
+
+    {
+        Legion::TaskLauncher launcher{
+            ScalTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher.add_region_requirement(y_rw).add_field(FID_Y);
+        launcher.add_future(alpha);
+        const double seconds =
+            time_launches(ctx, rt, launcher, options.num_trials);
+        report(label, "scal", 2.0 * entry_bytes, seconds, triad_bandwidth);
+    }
+    {
+        Legion::TaskLauncher launcher{
+            AxpyTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher.add_region_requirement(y_rw).add_field(FID_Y);
+        launcher.add_region_requirement(x_ro).add_field(FID_X);
+        launcher.add_future(alpha);
+        const double seconds =
+            time_launches(ctx, rt, launcher, options.num_trials);
+        report(label, "axpy", 3.0 * entry_bytes, seconds, triad_bandwidth);
+    }
+    {
+        Legion::TaskLauncher launcher{
+            XpayTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher.add_region_requirement(y_rw).add_field(FID_Y);
+        launcher.add_region_requirement(x_ro).add_field(FID_X);
+        launcher.add_future(alpha);
+        const double seconds =
+            time_launches(ctx, rt, launcher, options.num_trials);
+        report(label, "xpay", 3.0 * entry_bytes, seconds, triad_bandwidth);
+    }
+    {
+        Legion::TaskLauncher launcher{
+            DotTask<ENTRY_T, DIM, COORD_T>::task_id, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher.add_region_requirement(x_ro).add_field(FID_Y);
+        launcher.add_region_requirement(x_ro).add_field(FID_X);
+        const double seconds =
+            time_launches(ctx, rt, launcher, options.num_trials);
+        report(label, "dot", 2.0 * entry_bytes, seconds, triad_bandwidth);
+    }
+    {
+        const DotProductMode mode = DotProductMode::COMPENSATED;
+        Legion::TaskLauncher launcher{
+            DotTask<ENTRY_T, DIM, COORD_T>::task_id,
+            Legion::TaskArgument{&mode, sizeof(DotProductMode)}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher.add_region_requirement(x_ro).add_field(FID_Y);
+        launcher.add_region_requirement(x_ro).add_field(FID_X);
+        const double seconds =
+            time_launches(ctx, rt, launcher, options.num_trials);
+        report(
+            label,
+            "dot (compensated)",
+            2.0 * entry_bytes,
+            seconds,
+            triad_bandwidth
+        );
+    }
+
+    rt->destroy_logical_region(ctx, region);
+    rt->destroy_field_space(ctx, field_space);
+    rt->destroy_index_space(ctx, index_space);
+
+    benchmark_cg_update<ENTRY_T, DIM, COORD_T>(
+        ctx, rt, options, triad_bandwidth
+    );
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+void benchmark_coord_type(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const BenchmarkOptions &options,
+    double triad_bandwidth
+) {
+#if LEGION_SOLVERS_MAX_DIM >= 1
+    benchmark_kernels<ENTRY_T, 1, COORD_T>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_MAX_DIM >= 1
+#if LEGION_SOLVERS_MAX_DIM >= 2
+    benchmark_kernels<ENTRY_T, 2, COORD_T>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_MAX_DIM >= 2
+#if LEGION_SOLVERS_MAX_DIM >= 3
+    benchmark_kernels<ENTRY_T, 3, COORD_T>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_MAX_DIM >= 3
+}
+
+
+template <typename ENTRY_T>
+void benchmark_entry_type(
+    Legion::Context ctx, Legion::Runtime *rt, const BenchmarkOptions &options
+) {
+    const double triad_bandwidth = stream_triad_bandwidth<ENTRY_T>(options);
+    std::cout << "STREAM triad (" << LegionSolvers::ToString<ENTRY_T>::value()
+              << "): " << triad_bandwidth << " GB/s, SIMD width "
+              << LegionSolvers::SIMDPack<ENTRY_T>::width << std::endl;
+#ifdef LEGION_SOLVERS_USE_S32_INDICES
+    benchmark_coord_type<ENTRY_T, int>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_USE_S32_INDICES
+#ifdef LEGION_SOLVERS_USE_U32_INDICES
+    benchmark_coord_type<ENTRY_T, unsigned>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_USE_U32_INDICES
+#ifdef LEGION_SOLVERS_USE_S64_INDICES
+    benchmark_coord_type<ENTRY_T, long long>(ctx, rt, options, triad_bandwidth);
+#endif // LEGION_SOLVERS_USE_S64_INDICES
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    const BenchmarkOptions options = parse_options();
+    std::cout << "SIMD instruction set: " << LEGION_SOLVERS_SIMD_ISA
+              << ", entries per vector: " << options.num_entries
+              << ", trials: " << options.num_trials << std::endl;
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    benchmark_entry_type<float>(ctx, rt, options);
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    benchmark_entry_type<double>(ctx, rt, options);
+#endif // LEGION_SOLVERS_USE_DOUBLE
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
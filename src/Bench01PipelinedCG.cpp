@@ -0,0 +1,214 @@
+#include <cstddef>  // for std::size_t
+#include <cstdlib>  // for std::atoi
+#include <cstring>  // for std::strcmp
+#include <iostream> // for std::cout, std::endl
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CGSolver.hpp"            // for CGSolver
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task
+#include "PipelinedCGSolver.hpp"   // for PipelinedCGSolver
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+enum TaskIDs : Legion::TaskID { TOP_LEVEL_TASK_ID };
+
+using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+
+
+struct BenchmarkOptions {
+    int grid_size = 512;
+    int num_iterations = 100;
+    int num_trials = 5;
+    int max_pieces = 64;
+}; // struct BenchmarkOptions
+
+
+BenchmarkOptions parse_options() {
+    const Legion::InputArgs &args = Legion::Runtime::get_input_args();
+    BenchmarkOptions options;
+    for (int i = 1; i + 1 < args.argc; ++i) {
+        if (std::strcmp(args.argv[i], "-n") == 0) {
+            options.grid_size = std::atoi(args.argv[++i]);
+        } else if (std::strcmp(args.argv[i], "-it") == 0) {
+            options.num_iterations = std::atoi(args.argv[++i]);
+        } else if (std::strcmp(args.argv[i], "-trials") == 0) {
+            options.num_trials = std::atoi(args.argv[++i]);
+        } else if (std::strcmp(args.argv[i], "-pieces") == 0) {
+            options.max_pieces = std::atoi(args.argv[++i]);
+        }
+    }
+    return options;
+}
+
+
+// Color space of a grid of num_pieces (a power of two) pieces that is as
+// square as possible, with the longer side first.
+Legion::IndexSpace create_piece_space(
+    Legion::Context ctx, Legion::Runtime *rt, int num_pieces
+) {
+    int rows = 1;
+    int cols = 1;
+    for (int k = 1; k < num_pieces; k *= 2) {
+        if (rows == cols) {
+            rows *= 2;
+        } else {
+            cols *= 2;
+        }
+    }
+    return rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {rows - 1, cols - 1}}
+    );
+}
+
+
+// Average time per iteration of num_iterations iterations of SOLVER (which
+// never converges with tolerance zero), including its setup, which is
+// amortized over the iterations. The first solve is not timed, so that
+// instances are allocated before timing starts.
+template <typename SOLVER>
+double time_solver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const BenchmarkOptions &options,
+    const Operator &A,
+    const Operator *preconditioner,
+    const Vector &b,
+    Vector &x,
+    Legion::IndexPartition partition
+) {
+    SOLVER solver{
+        ctx,
+        rt,
+        A,
+        b.get_logical_region(),
+        b.get_fid(),
+        x.get_logical_region(),
+        x.get_fid(),
+        partition,
+        preconditioner,
+        static_cast<std::size_t>(options.num_iterations)};
+    long long elapsed = 0;
+    for (int trial = 0; trial <= options.num_trials; ++trial) {
+        x.constant_fill(0.0);
+        const Legion::Future start = rt->get_current_time_in_microseconds(
+            ctx, rt->issue_execution_fence(ctx)
+        );
+        solver.solve(static_cast<std::size_t>(options.num_iterations), 0.0);
+        const Legion::Future stop = rt->get_current_time_in_microseconds(
+            ctx, rt->issue_execution_fence(ctx)
+        );
+        if (trial > 0) {
+            elapsed +=
+                stop.get_result<long long>() - start.get_result<long long>();
+        }
+    }
+    return 1.0e-6 * static_cast<double>(elapsed) /
+           (options.num_trials * options.num_iterations);
+}
+
+
+// Compares the iteration latency of CG and pipelined CG, each without a
+// preconditioner and with the Jacobi preconditioner, on the 2D Poisson
+// problem (matrix-free 5-point Laplacian) divided into num_pieces pieces.
+// Each piece stands in for one rank of a distributed run; run with as many
+// processors (e.g., -ll:cpu) as the largest number of pieces to give each
+// piece its own.
+void benchmark_pieces(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const BenchmarkOptions &options,
+    int num_pieces
+) {
+    using LegionSolvers::StencilShape;
+
+    const int n = options.grid_size;
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space =
+        create_piece_space(ctx, rt, num_pieces);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator A{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0, -1.0, -1.0, -1.0, -1.0}};
+        const Operator jacobi{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {0.25, 0.0, 0.0, 0.0, 0.0}};
+
+        Vector b{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        b.constant_fill(1.0);
+
+        const std::vector<const Operator *> preconditioners{nullptr, &jacobi};
+        for (const Operator *preconditioner : preconditioners) {
+            const double cg_seconds =
+                time_solver<LegionSolvers::CGSolver<double, 2, int>>(
+                    ctx, rt, options, A, preconditioner, b, x, partition
+                );
+            const double pipelined_seconds =
+                time_solver<LegionSolvers::PipelinedCGSolver<double, 2, int>>(
+                    ctx, rt, options, A, preconditioner, b, x, partition
+                );
+            const std::string label =
+                std::string{preconditioner ? "Jacobi PCG" : "CG"} + ", " +
+                std::to_string(num_pieces) + " pieces";
+            std::cout << label << ": " << 1.0e3 * cg_seconds
+                      << " ms/iteration (classic), "
+                      << 1.0e3 * pipelined_seconds
+                      << " ms/iteration (pipelined), speedup "
+                      << cg_seconds / pipelined_seconds << std::endl;
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    const BenchmarkOptions options = parse_options();
+    std::cout << "grid: " << options.grid_size << 'x' << options.grid_size
+              << ", iterations: " << options.num_iterations
+              << ", trials: " << options.num_trials << std::endl;
+    for (int num_pieces = 1; num_pieces <= options.max_pieces;
+         num_pieces *= 2) {
+        benchmark_pieces(ctx, rt, options, num_pieces);
+    }
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,234 @@
+#include "BiCGStabSolver.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*
+#include "Scalar.hpp"         // for Scalar
+
+using LegionSolvers::BiCGStabSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+BiCGStabSolver<ENTRY_T, DIM, COORD_T>::BiCGStabSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<ENTRY_T> *preconditioner,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), preconditioner(preconditioner),
+      check_interval(check_interval),
+      rhs(ctx, rt, rhs_region, rhs_fid, partition),
+      solution(ctx, rt, solution_region, solution_fid, partition),
+      r(ctx, rt, partition), shadow(ctx, rt, partition),
+      p(ctx, rt, partition), v(ctx, rt, partition), t(ctx, rt, partition),
+      p_hat(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                           : nullptr),
+      s_hat(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                           : nullptr),
+      residual_norm(static_cast<ENTRY_T>(0)) {
+    assert(check_interval > 0);
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+const typename BiCGStabSolver<ENTRY_T, DIM, COORD_T>::Vector &
+BiCGStabSolver<ENTRY_T, DIM, COORD_T>::precondition(
+    Vector *output, const Vector &input
+) {
+    if (!preconditioner) { return input; }
+    preconditioner->matvec(
+        output->get_logical_region(),
+        output->get_fid(),
+        input.get_logical_region(),
+        input.get_fid()
+    );
+    return *output;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BiCGStabSolver<ENTRY_T, DIM, COORD_T>::apply(
+    Vector &output, const Vector &input
+) {
+    matrix.matvec(
+        output.get_logical_region(),
+        output.get_fid(),
+        input.get_logical_region(),
+        input.get_fid()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t BiCGStabSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    // r = b - A * x, using v as scratch space; r0 = p = r.
+    apply(v, solution);
+    r.copy(rhs);
+    r.axpy(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-1)}, v);
+    shadow.copy(r);
+    p.copy(r);
+
+    const ENTRY_T threshold = tolerance * tolerance * rhs.dot(rhs).get_value();
+    Scalar<ENTRY_T> rho{ctx, rt, static_cast<ENTRY_T>(0)};
+
+    std::size_t iteration = 0;
+    while (true) {
+        // v = A * M * p
+        const Vector &p_preconditioned = precondition(p_hat.get(), p);
+        apply(v, p_preconditioned);
+
+        Operations first{ctx, rt};
+        first.dot(shadow, v);
+        first.dot(r, r);
+        if (iteration == 0) { first.dot(shadow, r); }
+        const Legion::Future packed_first = first.execute();
+        if (iteration == 0) {
+            rho = Scalar<ENTRY_T>::packed(ctx, rt, packed_first, 2);
+        }
+
+        const bool last = (iteration == max_iterations);
+        const bool check = last || (iteration % check_interval == 0);
+        if (check) {
+            const ENTRY_T rr_value =
+                Scalar<ENTRY_T>::packed(ctx, rt, packed_first, 1).get_value();
+            residual_norm = std::sqrt(rr_value);
+            if (last || (rr_value <= threshold)) { return iteration; }
+        }
+
+        // s = r - alpha * v, stored in r. If s is small, x + alpha * M * p
+        // is the solution; stop there, since t = A * M * s below vanishes
+        // with s. Between checks, the guarded divisions keep the scalars
+        // finite (and the updates zero) after an exact breakdown.
+        const Scalar<ENTRY_T> alpha = rho.divide_if_nonzero(
+            Scalar<ENTRY_T>::packed(ctx, rt, packed_first, 0)
+        );
+        r.axpy(-alpha, v);
+        if (check) {
+            const ENTRY_T ss_value = r.dot(r).get_value();
+            if (ss_value <= threshold) {
+                solution.axpy(alpha, p_preconditioned);
+                residual_norm = std::sqrt(ss_value);
+                return iteration + 1;
+            }
+        }
+
+        // t = A * M * s.
+        const Vector &s_preconditioned = precondition(s_hat.get(), r);
+        apply(t, s_preconditioned);
+
+        Operations second{ctx, rt};
+        second.dot(t, r);
+        second.dot(t, t);
+        second.dot(shadow, r);
+        second.dot(shadow, t);
+        const Legion::Future packed_second = second.execute();
+        const Scalar<ENTRY_T> omega =
+            Scalar<ENTRY_T>::packed(ctx, rt, packed_second, 0)
+                .divide_if_positive(
+                    Scalar<ENTRY_T>::packed(ctx, rt, packed_second, 1)
+                );
+        const Scalar<ENTRY_T> rho_new =
+            Scalar<ENTRY_T>::packed(ctx, rt, packed_second, 2) -
+            omega * Scalar<ENTRY_T>::packed(ctx, rt, packed_second, 3);
+        const Scalar<ENTRY_T> beta = rho_new.divide_if_nonzero(rho) *
+                                     alpha.divide_if_nonzero(omega);
+
+        // x += alpha * M * p + omega * M * s; r = s - omega * t;
+        // p = r + beta * (p - omega * v).
+        Operations update{ctx, rt};
+        update.axpy(solution, alpha, p_preconditioned);
+        update.axpy(solution, omega, s_preconditioned);
+        update.axpy(r, -omega, t);
+        update.axpy(p, -omega, v);
+        update.xpay(p, beta, r);
+        update.execute();
+
+        rho = rho_new;
+        ++iteration;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BiCGStabSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BiCGStabSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BiCGStabSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
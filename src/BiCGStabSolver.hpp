@@ -0,0 +1,89 @@
+#ifndef LEGION_SOLVERS_BICGSTAB_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_BICGSTAB_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+#include "FusedVectorOperations.hpp"  // for FusedVectorOperations
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a nonsingular, possibly nonsymmetric linear operator
+// A by the (optionally right-preconditioned) biconjugate gradient
+// stabilized method of van der Vorst. Arguments are as in CGSolver, except
+// that the preconditioner M, if any, is applied on the right: the method
+// solves A * M * y = b for y, and x = M * y. Right preconditioning leaves
+// the residual b - A * x, and hence the convergence test, unchanged.
+//
+// Each iteration needs two reductions, each issued as one fused index launch
+// (see FusedVectorOperations): (r0, v) and (r, r) after v = A * M * p, and
+// (t, s), (t, t), (r0, s), and (r0, t) after t = A * M * s. The next value of
+// rho = (r0, r) is derived from the second group, as (r0, s) - omega * (r0,
+// t), instead of being reduced separately; (r, r) is reduced with the first
+// group of the next iteration. Coefficients stay in futures, so the solver
+// blocks only to test convergence, which it does every check_interval
+// iterations. Breakdown (rho or omega vanishing) is not detected.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class BiCGStabSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using Operations = FusedVectorOperations<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const AbstractLinearOperator<ENTRY_T> *const preconditioner;
+    const std::size_t check_interval;
+    const Vector rhs;
+    Vector solution;
+    Vector r, shadow, p, v, t; // shadow = r0, v = A * M * p, t = A * M * s
+    const std::unique_ptr<Vector> p_hat, s_hat; // only with preconditioner
+    ENTRY_T residual_norm;
+
+    // Returns M * input, computed into output, or input itself without a
+    // preconditioner.
+    const Vector &precondition(Vector *output, const Vector &input);
+
+    void apply(Vector &output, const Vector &input);
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 10;
+
+    explicit BiCGStabSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<ENTRY_T> *preconditioner = nullptr,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    BiCGStabSolver(const BiCGStabSolver &) = delete;
+
+    BiCGStabSolver &operator=(const BiCGStabSolver &) = delete;
+
+    // Iterates until the residual norm is at most tolerance times the norm
+    // of b, as observed at a convergence check, or until max_iterations
+    // iterations have been performed. Returns the number of iterations.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norm of the residual b - A * x at the last convergence check, as
+    // updated by the BiCGStab recurrences.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class BiCGStabSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BICGSTAB_SOLVER_HPP_INCLUDED
@@ -0,0 +1,226 @@
+#include "BlockCGSolver.hpp"
+
+#include <algorithm> // for std::max
+#include <cassert>   // for assert
+#include <cmath>     // for std::sqrt
+#include <cstdint>   // for std::uint32_t
+
+#include "LibraryOptions.hpp"   // for LEGION_SOLVERS_USE_*, ...
+#include "MultiVectorTasks.hpp" // for BlockSolveTask, BlockSolveArgs
+#include "PackedScalars.hpp"    // for BlockScalars
+
+using LegionSolvers::BlockCGSolver;
+using LegionSolvers::BlockScalars;
+using LegionSolvers::BlockSolveArgs;
+using LegionSolvers::BlockSolveTask;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+BlockCGSolver<ENTRY_T, DIM, COORD_T>::BlockCGSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    const std::vector<Legion::FieldID> &rhs_fids,
+    Legion::LogicalRegion solution_region,
+    const std::vector<Legion::FieldID> &solution_fids,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<ENTRY_T> *preconditioner,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), preconditioner(preconditioner),
+      check_interval(check_interval),
+      rhs(ctx, rt, rhs_region, rhs_fids, partition),
+      solution(ctx, rt, solution_region, solution_fids, partition),
+      residual(ctx, rt, partition, rhs_fids.size()),
+      direction(ctx, rt, partition, rhs_fids.size()),
+      product(ctx, rt, partition, rhs_fids.size()),
+      preconditioned(
+          preconditioner
+              ? std::make_unique<MultiVec>(ctx, rt, partition, rhs_fids.size())
+              : nullptr
+      ),
+      residual_norms(rhs_fids.size(), static_cast<ENTRY_T>(0)) {
+    assert(check_interval > 0);
+    assert(rhs_fids.size() == solution_fids.size());
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+const typename BlockCGSolver<ENTRY_T, DIM, COORD_T>::MultiVec &
+BlockCGSolver<ENTRY_T, DIM, COORD_T>::precondition() {
+    if (!preconditioner) { return residual; }
+    apply(*preconditioner, *preconditioned, residual);
+    return *preconditioned;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockCGSolver<ENTRY_T, DIM, COORD_T>::apply(
+    const AbstractLinearOperator<ENTRY_T> &op,
+    MultiVec &output,
+    const MultiVec &input
+) const {
+    op.matmat(
+        output.get_logical_region(),
+        output.get_fids(),
+        input.get_logical_region(),
+        input.get_fids()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future BlockCGSolver<ENTRY_T, DIM, COORD_T>::solve_block(
+    const Legion::Future &g, const Legion::Future &h
+) const {
+    const std::uint32_t k = static_cast<std::uint32_t>(rhs.get_num_vectors());
+    const BlockSolveArgs args{k, k};
+    Legion::TaskLauncher launcher{
+        BlockSolveTask<ENTRY_T>::task_id,
+        Legion::TaskArgument{&args, sizeof(BlockSolveArgs)}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_future(g);
+    launcher.add_future(h);
+    return rt->execute_task(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::vector<ENTRY_T> BlockCGSolver<ENTRY_T, DIM, COORD_T>::diagonal(
+    const Legion::Future &block
+) const {
+    const BlockScalars<ENTRY_T> values =
+        block.get_result<BlockScalars<ENTRY_T>>();
+    std::vector<ENTRY_T> result;
+    for (std::size_t j = 0; j < rhs.get_num_vectors(); ++j) {
+        result.push_back(values(j, j));
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t BlockCGSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    const std::size_t k = rhs.get_num_vectors();
+    BlockScalars<ENTRY_T> identity = {};
+    for (std::size_t j = 0; j < k; ++j) {
+        identity(j, j) = static_cast<ENTRY_T>(1);
+    }
+
+    // R = B - A * X
+    apply(matrix, product, solution);
+    residual.copy(rhs);
+    residual.subtract(Legion::Future::from_value(rt, identity), product);
+
+    const MultiVec &z0 = precondition();
+    direction.copy(z0);
+    Legion::Future rz = residual.dot(z0);
+    const std::vector<ENTRY_T> rhs_norms_squared = diagonal(rhs.dot(rhs));
+
+    std::size_t iteration = 0;
+    while (true) {
+        const bool last = (iteration == max_iterations);
+        if (last || (iteration % check_interval == 0)) {
+            const std::vector<ENTRY_T> rr =
+                diagonal(preconditioner ? residual.dot(residual) : rz);
+            bool converged = true;
+            for (std::size_t j = 0; j < k; ++j) {
+                const ENTRY_T threshold =
+                    tolerance * tolerance * rhs_norms_squared[j];
+                residual_norms[j] =
+                    std::sqrt(std::max(rr[j], static_cast<ENTRY_T>(0)));
+                converged = converged && (rr[j] <= threshold);
+            }
+            if (last || converged) { return iteration; }
+        }
+
+        apply(matrix, product, direction);
+        const Legion::Future alpha = solve_block(direction.dot(product), rz);
+        solution.add(alpha, direction);
+        residual.subtract(alpha, product);
+
+        const MultiVec &z = precondition();
+        const Legion::Future rz_new = residual.dot(z);
+        direction.xpay(solve_block(rz, rz_new), z);
+        rz = rz_new;
+        ++iteration;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockCGSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockCGSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockCGSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,113 @@
+#ifndef LEGION_SOLVERS_BLOCK_CG_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_BLOCK_CG_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "MultiVector.hpp"            // for MultiVector
+
+namespace LegionSolvers {
+
+
+// Solves A * X = B for a symmetric positive definite linear operator A and
+// k right-hand sides at once (k at most LEGION_SOLVERS_MAX_BLOCK_SIZE), by
+// the (optionally preconditioned) block conjugate gradient method of
+// O'Leary. The iteration is that of CGSolver with every vector replaced by
+// a MultiVector of k vectors and every scalar coefficient by a k-by-k
+// BlockScalars future:
+//   Q = A * P, alpha = (P^T Q)^{-1} (R^T Z), X = X + P alpha,
+//   R = R - Q alpha, Z = M * R, beta = (R^T Z)^{-1} (R_new^T Z_new),
+//   P = Z + P beta,
+// where the k-by-k solves run in a BlockSolveTask and the products with A
+// (and M) go through AbstractLinearOperator::matmat, which reads the
+// operator once for all k vectors where the operator supports it (see
+// CSRMatrix::matmat). Each iteration thus costs one pass over the matrix
+// instead of k, and, because the search space grows by k directions per
+// iteration, block CG typically needs fewer iterations than CG needs for
+// any single right-hand side. Directions that become linearly dependent,
+// for instance when one right-hand side has converged, are dropped by
+// BlockSolveTask rather than breaking down.
+//
+// B and X are k fields each of application regions over the parent index
+// space of partition; X is updated in place, starting from its initial
+// contents. As for CGSolver, the solver blocks only to test convergence,
+// every check_interval iterations, and it has converged when every
+// residual norm is at most tolerance times the norm of its right-hand side.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class BlockCGSolver {
+
+    using MultiVec = MultiVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const AbstractLinearOperator<ENTRY_T> *const preconditioner;
+    const std::size_t check_interval;
+    const MultiVec rhs;
+    MultiVec solution;
+    MultiVec residual;
+    MultiVec direction;
+    MultiVec product;
+    const std::unique_ptr<MultiVec> preconditioned; // only with preconditioner
+    std::vector<ENTRY_T> residual_norms;
+
+    // Returns M * residual, or the residual itself without a preconditioner.
+    const MultiVec &precondition();
+
+    // Computes output = op * input, for op = A or M.
+    void apply(
+        const AbstractLinearOperator<ENTRY_T> &op,
+        MultiVec &output,
+        const MultiVec &input
+    ) const;
+
+    // Launches a BlockSolveTask for g^{-1} * h, both k-by-k.
+    Legion::Future
+    solve_block(const Legion::Future &g, const Legion::Future &h) const;
+
+    // Diagonal of a k-by-k BlockScalars future; blocks until it is ready.
+    std::vector<ENTRY_T> diagonal(const Legion::Future &block) const;
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 10;
+
+    explicit BlockCGSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        const std::vector<Legion::FieldID> &rhs_fids,
+        Legion::LogicalRegion solution_region,
+        const std::vector<Legion::FieldID> &solution_fids,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<ENTRY_T> *preconditioner = nullptr,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    BlockCGSolver(const BlockCGSolver &) = delete;
+
+    BlockCGSolver &operator=(const BlockCGSolver &) = delete;
+
+    // Iterates until every residual norm is at most tolerance times the
+    // norm of its right-hand side, as observed at a convergence check, or
+    // until max_iterations iterations have been performed. Returns the
+    // number of iterations.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norms of the residuals b_j - A * x_j at the last convergence check,
+    // as updated by the block CG recurrence.
+    const std::vector<ENTRY_T> &get_residual_norms() const {
+        return residual_norms;
+    }
+
+}; // class BlockCGSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BLOCK_CG_SOLVER_HPP_INCLUDED
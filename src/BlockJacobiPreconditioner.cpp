@@ -0,0 +1,325 @@
+#include "BlockJacobiPreconditioner.hpp"
+
+#include <cassert> // for assert
+#include <cstdint> // for std::int64_t
+#include <map>     // for std::map
+
+#include "LegionUtilities.hpp" // for create_field_space
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::BlockJacobiApplyArgs;
+using LegionSolvers::BlockJacobiApplyTask;
+using LegionSolvers::BlockJacobiFactorTask;
+using LegionSolvers::BlockJacobiPreconditioner;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::BlockJacobiPreconditioner(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+    IncompleteFactorization factorization
+)
+    : ctx(ctx), rt(rt), factorization(factorization),
+      rowptr_region(matrix.get_rowptr_region()),
+      fid_rowptr(matrix.get_fid_rowptr()),
+      range_space(matrix.get_range_space()),
+      range_partition(matrix.get_range_partition()),
+      kernel_partition(matrix.get_kernel_partition()),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, range_partition)
+      ) {
+    assert(matrix.get_domain_space() == range_space);
+    assert(rt->is_index_partition_disjoint(ctx, range_partition));
+
+    const Legion::FieldSpace factor_field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(ENTRY_T), sizeof(std::int64_t)},
+        {FACTOR_ENTRY_FID, FACTOR_POSITION_FID}
+    );
+    const Legion::FieldSpace diagonal_field_space = create_field_space(
+        ctx, rt, {sizeof(ENTRY_T)}, {INVERSE_DIAGONAL_FID}
+    );
+    factor_region = rt->create_logical_region(
+        ctx, matrix.get_kernel_space(), factor_field_space
+    );
+    diagonal_region =
+        rt->create_logical_region(ctx, range_space, diagonal_field_space);
+
+    Legion::IndexLauncher launcher{
+        BlockJacobiFactorTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&factorization, sizeof(IncompleteFactorization)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(fid_rowptr);
+    const Legion::LogicalRegion kernel_region = matrix.get_kernel_region();
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid :
+         {matrix.get_fid_col(), matrix.get_fid_entry()}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    const Legion::LogicalPartition factor_partition =
+        rt->get_logical_partition(ctx, factor_region, kernel_partition);
+    for (const Legion::FieldID fid : {FACTOR_ENTRY_FID, FACTOR_POSITION_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                factor_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                factor_region})
+            .add_field(fid);
+    }
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, diagonal_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            diagonal_region})
+        .add_field(INVERSE_DIAGONAL_FID);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::~BlockJacobiPreconditioner() {
+    rt->destroy_logical_region(ctx, diagonal_region);
+    rt->destroy_logical_region(ctx, factor_region);
+    rt->destroy_field_space(ctx, diagonal_region.get_field_space());
+    rt->destroy_field_space(ctx, factor_region.get_field_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::covering_partition(
+    Legion::IndexSpace space, Legion::IndexPartition partition
+) const {
+    assert(space == range_space);
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, partition);
+    const Legion::Domain color_domain =
+        rt->get_index_space_domain(ctx, colors);
+    const Legion::Domain block_colors =
+        rt->get_index_space_domain(ctx, color_space);
+    std::map<Legion::DomainPoint, Legion::Domain> pieces;
+    for (Legion::Domain::DomainPointIterator it(color_domain); it; ++it) {
+        const Legion::Domain piece = rt->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, partition, *it)
+        );
+        const Legion::Rect<DIM, COORD_T> rect = piece.bounds<DIM, COORD_T>();
+        Legion::Rect<DIM, COORD_T> cover = rect;
+        for (Legion::Domain::DomainPointIterator b(block_colors); b; ++b) {
+            const Legion::Domain block = rt->get_index_space_domain(
+                ctx, rt->get_index_subspace(ctx, range_partition, *b)
+            );
+            const Legion::Rect<DIM, COORD_T> block_rect =
+                block.bounds<DIM, COORD_T>();
+            if (!piece.empty() && !block.empty() &&
+                !rect.intersection(block_rect).empty()) {
+                cover = cover.union_bbox(block_rect);
+            }
+        }
+        pieces[*it] = cover;
+    }
+    return rt->create_partition_by_domain(
+        ctx, space, pieces, colors, true, LEGION_COMPUTE_KIND
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    return covering_partition(domain_space, range_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    return covering_partition(range_space, domain_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::apply(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid,
+    bool transpose
+) const {
+    assert(output_region.get_index_space() == range_space);
+    assert(input_region.get_index_space() == range_space);
+    const BlockJacobiApplyArgs args{factorization, transpose};
+    Legion::IndexLauncher launcher{
+        BlockJacobiApplyTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(BlockJacobiApplyArgs)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(fid_rowptr);
+    const Legion::LogicalPartition factor_partition =
+        rt->get_logical_partition(ctx, factor_region, kernel_partition);
+    for (const Legion::FieldID fid : {FACTOR_ENTRY_FID, FACTOR_POSITION_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                factor_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                factor_region})
+            .add_field(fid);
+    }
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, diagonal_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            diagonal_region})
+        .add_field(INVERSE_DIAGONAL_FID);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockJacobiPreconditioner<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, true);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::BlockJacobiPreconditioner<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,115 @@
+#ifndef LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_HPP_INCLUDED
+#define LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_HPP_INCLUDED
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp"         // for AbstractLinearOperator
+#include "BlockJacobiPreconditionerTasks.hpp" // for IncompleteFactorization
+#include "CSRMatrix.hpp"                      // for CSRMatrix
+
+namespace LegionSolvers {
+
+
+// A block-Jacobi preconditioner M for a square CSR matrix A, whose blocks are
+// the diagonal blocks of A that couple the rows of each piece of its range
+// partition to each other. Each block is replaced by its incomplete
+// factorization with zero fill-in (see IncompleteFactorization), computed
+// on construction by one BlockJacobiFactorTask per piece. Applying M^{-1} is
+// one BlockJacobiApplyTask per piece, a forward and a backward sparse
+// triangular solve within the piece, with no communication between pieces.
+//
+// The factors are stored in regions owned by this object, over the kernel
+// and range spaces of A and partitioned by its kernel and range partitions.
+// The row pointers of A, and its partitions, are used by every apply, so A
+// must outlive this object. The range partition of A must be disjoint.
+//
+// As an AbstractLinearOperator, this object maps input to M^{-1} * input,
+// and is passed to the solvers as their preconditioner.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class BlockJacobiPreconditioner : public AbstractLinearOperator<ENTRY_T> {
+
+    static constexpr Legion::FieldID FACTOR_ENTRY_FID = 0;
+    static constexpr Legion::FieldID FACTOR_POSITION_FID = 1;
+    static constexpr Legion::FieldID INVERSE_DIAGONAL_FID = 0;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const IncompleteFactorization factorization;
+    const Legion::LogicalRegion rowptr_region;
+    const Legion::FieldID fid_rowptr;
+    const Legion::IndexSpace range_space;
+    const Legion::IndexPartition range_partition;
+    const Legion::IndexPartition kernel_partition;
+    const Legion::IndexSpace color_space;
+    Legion::LogicalRegion factor_region;
+    Legion::LogicalRegion diagonal_region;
+
+    // Launches one BlockJacobiApplyTask per piece of the range partition.
+    void apply(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid,
+        bool transpose
+    ) const;
+
+    // The partition of space whose piece c is the bounding rectangle of the
+    // blocks that meet piece c of partition.
+    Legion::IndexPartition covering_partition(
+        Legion::IndexSpace space, Legion::IndexPartition partition
+    ) const;
+
+  public:
+
+    explicit BlockJacobiPreconditioner(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+        IncompleteFactorization factorization
+    );
+
+    BlockJacobiPreconditioner(const BlockJacobiPreconditioner &) = delete;
+
+    BlockJacobiPreconditioner &
+    operator=(const BlockJacobiPreconditioner &) = delete;
+
+    virtual ~BlockJacobiPreconditioner();
+
+    IncompleteFactorization get_factorization() const {
+        return factorization;
+    }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Computes output = M^{-1} * input.
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Computes output = M^{-T} * input.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class BlockJacobiPreconditioner
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_HPP_INCLUDED
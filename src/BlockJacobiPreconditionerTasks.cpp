@@ -0,0 +1,404 @@
+#include "BlockJacobiPreconditionerTasks.hpp"
+
+#include <algorithm> // for std::sort
+#include <cassert>   // for assert
+#include <cmath>     // for std::sqrt
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::int64_t
+#include <map>       // for std::map
+#include <vector>    // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineWriter
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::BlockJacobiApplyArgs;
+using LegionSolvers::BlockJacobiApplyTask;
+using LegionSolvers::BlockJacobiFactorTask;
+using LegionSolvers::IncompleteFactorization;
+
+
+// A nonzero of a diagonal block: the number of its column within the piece,
+// and its point in the kernel space.
+template <typename COORD_T>
+struct BlockNonzero {
+    std::int64_t column;
+    Legion::Point<1, COORD_T> point;
+}; // struct BlockNonzero
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockJacobiFactorTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 6);
+    const auto &rowptr = regions[0];
+    const auto &col = regions[1];
+    const auto &entry = regions[2];
+    const auto &factor = regions[3];
+    const auto &position = regions[4];
+    const auto &diagonal = regions[5];
+
+    assert(task->regions.size() == 6);
+    const auto &rowptr_req = task->regions[0];
+    const auto &col_req = task->regions[1];
+    const auto &entry_req = task->regions[2];
+    const auto &factor_req = task->regions[3];
+    const auto &position_req = task->regions[4];
+    const auto &diagonal_req = task->regions[5];
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(factor_req.privilege_fields.size() == 1);
+    const Legion::FieldID factor_fid = *factor_req.privilege_fields.begin();
+
+    assert(position_req.privilege_fields.size() == 1);
+    const Legion::FieldID position_fid =
+        *position_req.privilege_fields.begin();
+
+    assert(diagonal_req.privilege_fields.size() == 1);
+    const Legion::FieldID diagonal_fid =
+        *diagonal_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(IncompleteFactorization));
+    const IncompleteFactorization factorization =
+        *static_cast<const IncompleteFactorization *>(task->args);
+
+    using Index = Legion::Point<DIM, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Index, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineWriter<ENTRY_T, 1, COORD_T> factor_writer{factor, factor_fid};
+    AffineWriter<std::int64_t, 1, COORD_T> position_writer{
+        position, position_fid};
+    AffineWriter<ENTRY_T, DIM, COORD_T> diagonal_writer{
+        diagonal, diagonal_fid};
+
+    const Legion::Domain range_domain =
+        rt->get_index_space_domain(ctx, rowptr_req.region.get_index_space());
+
+    std::vector<Index> rows;
+    std::map<Legion::DomainPoint, std::int64_t> number;
+    for (PointIterator row(range_domain); row(); ++row) {
+        number[Legion::DomainPoint{*row}] =
+            static_cast<std::int64_t>(rows.size());
+        rows.push_back(*row);
+    }
+    const std::size_t num_rows = rows.size();
+
+    // The block in compressed sparse row form, with the nonzeros of each row
+    // sorted by column. Nonzeros outside the block are dropped here.
+    std::vector<std::size_t> offsets{0};
+    std::vector<BlockNonzero<COORD_T>> nonzeros;
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        const std::size_t first = nonzeros.size();
+        for (KernelIterator k(rowptr_reader[rows[i]]); k(); ++k) {
+            const auto it = number.find(Legion::DomainPoint{col_reader[*k]});
+            if (it == number.end()) {
+                factor_writer[*k] = static_cast<ENTRY_T>(0);
+                position_writer[*k] = -1;
+            } else {
+                nonzeros.push_back(BlockNonzero<COORD_T>{it->second, *k});
+            }
+        }
+        std::sort(
+            nonzeros.begin() + first,
+            nonzeros.end(),
+            [](const BlockNonzero<COORD_T> &a, const BlockNonzero<COORD_T> &b
+            ) { return a.column < b.column; }
+        );
+        offsets.push_back(nonzeros.size());
+    }
+    std::vector<ENTRY_T> values(nonzeros.size());
+    for (std::size_t p = 0; p < nonzeros.size(); ++p) {
+        values[p] = entry_reader[nonzeros[p].point];
+    }
+
+    // ILU(0), row by row (IKJ order): each row is eliminated by the rows
+    // above it, with updates outside its pattern discarded. For IC0, the
+    // same factors give C = L * sqrt(diag(U)) when the block is symmetric.
+    const std::size_t NONE = nonzeros.size();
+    std::vector<std::size_t> slot(num_rows, NONE); // of each column in row i
+    std::vector<std::size_t> pivot(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        for (std::size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+            slot[static_cast<std::size_t>(nonzeros[p].column)] = p;
+        }
+        assert(slot[i] != NONE);
+        pivot[i] = slot[i];
+        for (std::size_t p = offsets[i]; p < pivot[i]; ++p) {
+            const std::size_t k = static_cast<std::size_t>(nonzeros[p].column);
+            values[p] /= values[pivot[k]];
+            for (std::size_t q = pivot[k] + 1; q < offsets[k + 1]; ++q) {
+                const std::size_t s =
+                    slot[static_cast<std::size_t>(nonzeros[q].column)];
+                if (s != NONE) { values[s] -= values[p] * values[q]; }
+            }
+        }
+        assert(values[pivot[i]] != static_cast<ENTRY_T>(0));
+        for (std::size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+            slot[static_cast<std::size_t>(nonzeros[p].column)] = NONE;
+        }
+    }
+
+    std::vector<ENTRY_T> root(num_rows);
+    if (factorization == IncompleteFactorization::IC0) {
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            assert(values[pivot[i]] > static_cast<ENTRY_T>(0));
+            root[i] = std::sqrt(values[pivot[i]]);
+        }
+    }
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        const std::int64_t row = static_cast<std::int64_t>(i);
+        for (std::size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+            const std::int64_t j = nonzeros[p].column;
+            ENTRY_T value = values[p];
+            if (factorization == IncompleteFactorization::IC0) {
+                value = (j < row) ? value * root[static_cast<std::size_t>(j)]
+                                  : static_cast<ENTRY_T>(0);
+            }
+            factor_writer[nonzeros[p].point] = value;
+            position_writer[nonzeros[p].point] = j;
+        }
+        diagonal_writer[rows[i]] =
+            static_cast<ENTRY_T>(1) /
+            ((factorization == IncompleteFactorization::IC0)
+                 ? root[i]
+                 : values[pivot[i]]);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockJacobiApplyTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 6);
+    const auto &output = regions[0];
+    const auto &input = regions[1];
+    const auto &rowptr = regions[2];
+    const auto &factor = regions[3];
+    const auto &position = regions[4];
+    const auto &diagonal = regions[5];
+
+    assert(task->regions.size() == 6);
+    const auto &output_req = task->regions[0];
+    const auto &input_req = task->regions[1];
+    const auto &rowptr_req = task->regions[2];
+    const auto &factor_req = task->regions[3];
+    const auto &position_req = task->regions[4];
+    const auto &diagonal_req = task->regions[5];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(factor_req.privilege_fields.size() == 1);
+    const Legion::FieldID factor_fid = *factor_req.privilege_fields.begin();
+
+    assert(position_req.privilege_fields.size() == 1);
+    const Legion::FieldID position_fid =
+        *position_req.privilege_fields.begin();
+
+    assert(diagonal_req.privilege_fields.size() == 1);
+    const Legion::FieldID diagonal_fid =
+        *diagonal_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(BlockJacobiApplyArgs));
+    const BlockJacobiApplyArgs &args =
+        *static_cast<const BlockJacobiApplyArgs *>(task->args);
+
+    using Index = Legion::Point<DIM, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{output, output_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> factor_reader{factor, factor_fid};
+    AffineReader<std::int64_t, 1, COORD_T> position_reader{
+        position, position_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> diagonal_reader{
+        diagonal, diagonal_fid};
+
+    // Rows are numbered in the same order as by BlockJacobiFactorTask.
+    const Legion::Domain range_domain =
+        rt->get_index_space_domain(ctx, rowptr_req.region.get_index_space());
+    std::vector<Index> rows;
+    std::vector<ENTRY_T> y;
+    for (PointIterator row(range_domain); row(); ++row) {
+        rows.push_back(*row);
+        y.push_back(input_reader[*row]);
+    }
+    const std::int64_t num_rows = static_cast<std::int64_t>(rows.size());
+
+    // Solves with the lower (or upper) triangle of the factor by rows,
+    // reading the solved entries before row i (or after it).
+    const auto solve_by_rows = [&](bool lower, bool scale) {
+        for (std::int64_t n = 0; n < num_rows; ++n) {
+            const std::int64_t i = lower ? n : num_rows - 1 - n;
+            const Index &row = rows[static_cast<std::size_t>(i)];
+            ENTRY_T sum = y[static_cast<std::size_t>(i)];
+            for (KernelIterator k(rowptr_reader[row]); k(); ++k) {
+                const std::int64_t j = position_reader[*k];
+                if ((j >= 0) && (lower ? (j < i) : (j > i))) {
+                    sum -= factor_reader[*k] * y[static_cast<std::size_t>(j)];
+                }
+            }
+            y[static_cast<std::size_t>(i)] =
+                scale ? sum * diagonal_reader[row] : sum;
+        }
+    };
+
+    // Solves with the transpose of the lower (or upper) triangle of the
+    // factor by columns, scattering each solved entry into the entries
+    // before it (or after it).
+    const auto solve_by_columns = [&](bool lower, bool scale) {
+        for (std::int64_t n = 0; n < num_rows; ++n) {
+            const std::int64_t i = lower ? num_rows - 1 - n : n;
+            const Index &row = rows[static_cast<std::size_t>(i)];
+            ENTRY_T &value = y[static_cast<std::size_t>(i)];
+            if (scale) { value *= diagonal_reader[row]; }
+            for (KernelIterator k(rowptr_reader[row]); k(); ++k) {
+                const std::int64_t j = position_reader[*k];
+                if ((j >= 0) && (lower ? (j < i) : (j > i))) {
+                    y[static_cast<std::size_t>(j)] -= factor_reader[*k] * value;
+                }
+            }
+        }
+    };
+
+    if (args.factorization == IncompleteFactorization::IC0) {
+        // M = C * C^T is symmetric.
+        solve_by_rows(true, true);
+        solve_by_columns(true, true);
+    } else if (args.transpose) {
+        // M^T = U^T * L^T.
+        solve_by_columns(false, true);
+        solve_by_columns(true, false);
+    } else {
+        // M = L * U.
+        solve_by_rows(true, false);
+        solve_by_rows(false, true);
+    }
+
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        output_writer[rows[i]] = y[i];
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void BlockJacobiFactorTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void BlockJacobiFactorTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void BlockJacobiFactorTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockJacobiApplyTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,111 @@
+#ifndef LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint8_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for BLOCK_JACOBI_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Incomplete factorizations with the sparsity pattern of the factored block
+// (zero fill-in). ILU0 computes A ~ L * U with L unit lower triangular; IC0
+// computes A ~ C * C^T for a symmetric positive definite block with a
+// symmetric pattern, so that the preconditioner stays symmetric positive
+// definite (as required by the CG solvers).
+enum class IncompleteFactorization : std::uint8_t {
+    ILU0,
+    IC0,
+}; // enum class IncompleteFactorization
+
+
+// Task argument of BlockJacobiApplyTask.
+struct BlockJacobiApplyArgs {
+    IncompleteFactorization factorization;
+    bool transpose;
+}; // struct BlockJacobiApplyArgs
+
+
+// Computes the incomplete factorization of the diagonal block of a CSR
+// matrix A that couples the rows of one piece of its range space to each
+// other. Regions are row pointers (read-only, range piece), column indices
+// and entries (read-only, kernel piece, one requirement each), factor
+// entries and factor positions (write-discard, kernel piece, one requirement
+// each), and inverse diagonal (write-discard, range piece). The task
+// argument is an IncompleteFactorization.
+//
+// The rows of the piece are numbered in the order of a PointInDomainIterator
+// over it. The position of each nonzero is the number of its column, or -1
+// (as a std::int64_t) if its column lies outside the piece; such nonzeros
+// get factor entry zero. Nonzeros before the diagonal hold L (or C), and
+// nonzeros after it hold U (ILU0) or zero (IC0); the diagonal of U (or C) is
+// stored inverted. Asserts that every row has a diagonal entry and that no
+// pivot vanishes (or, for IC0, that every pivot is positive).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BlockJacobiFactorTask
+    : public TaskTDI<
+          BLOCK_JACOBI_FACTOR_TASK_BLOCK_ID,
+          BlockJacobiFactorTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "block_jacobi_factor";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BlockJacobiFactorTask
+
+
+// Computes output = M^{-1} * input (or M^{-T} * input, if transpose is set)
+// on one piece of the range space, where M is the factorization of its
+// diagonal block computed by BlockJacobiFactorTask, by one forward and one
+// backward sparse triangular solve. Regions are output (write-discard, range
+// piece), input (read-only, range piece), row pointers (read-only, range
+// piece), factor entries and factor positions (read-only, kernel piece, one
+// requirement each), and inverse diagonal (read-only, range piece). The task
+// argument is a BlockJacobiApplyArgs.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BlockJacobiApplyTask
+    : public TaskTDI<
+          BLOCK_JACOBI_APPLY_TASK_BLOCK_ID,
+          BlockJacobiApplyTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "block_jacobi_apply";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BlockJacobiApplyTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_BLOCK_JACOBI_PRECONDITIONER_TASKS_HPP_INCLUDED
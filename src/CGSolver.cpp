@@ -0,0 +1,182 @@
+#include "CGSolver.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*
+
+using LegionSolvers::CGSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+CGSolver<ENTRY_T, DIM, COORD_T>::CGSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<ENTRY_T> *preconditioner,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), preconditioner(preconditioner),
+      check_interval(check_interval),
+      rhs(ctx, rt, rhs_region, rhs_fid, partition),
+      solution(ctx, rt, solution_region, solution_fid, partition),
+      residual(ctx, rt, partition), direction(ctx, rt, partition),
+      product(ctx, rt, partition),
+      preconditioned(
+          preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                         : nullptr
+      ),
+      residual_norm(static_cast<ENTRY_T>(0)) {
+    assert(check_interval > 0);
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+const typename CGSolver<ENTRY_T, DIM, COORD_T>::Vector &
+CGSolver<ENTRY_T, DIM, COORD_T>::precondition() {
+    if (!preconditioner) { return residual; }
+    preconditioner->matvec(
+        preconditioned->get_logical_region(),
+        preconditioned->get_fid(),
+        residual.get_logical_region(),
+        residual.get_fid()
+    );
+    return *preconditioned;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t CGSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    const Scalar<ENTRY_T> minus_one{ctx, rt, static_cast<ENTRY_T>(-1)};
+
+    // r = b - A * x
+    matrix.matvec(
+        product.get_logical_region(),
+        product.get_fid(),
+        solution.get_logical_region(),
+        solution.get_fid()
+    );
+    residual.copy(rhs);
+    residual.axpy(minus_one, product);
+
+    const Vector &z0 = precondition();
+    direction.copy(z0);
+    Scalar<ENTRY_T> rz = residual.dot(z0);
+    const Scalar<ENTRY_T> rhs_norm_squared = rhs.dot(rhs);
+
+    std::size_t iteration = 0;
+    while (true) {
+        const bool last = (iteration == max_iterations);
+        if (last || (iteration % check_interval == 0)) {
+            const Scalar<ENTRY_T> rr =
+                preconditioner ? residual.dot(residual) : rz;
+            const ENTRY_T rr_value = rr.get_value();
+            const ENTRY_T threshold =
+                tolerance * tolerance * rhs_norm_squared.get_value();
+            residual_norm = std::sqrt(rr_value);
+            if (last || (rr_value <= threshold)) { return iteration; }
+        }
+
+        matrix.matvec(
+            product.get_logical_region(),
+            product.get_fid(),
+            direction.get_logical_region(),
+            direction.get_fid()
+        );
+        // Convergence is only checked every check_interval iterations, so
+        // the residual may already be exactly zero here.
+        const Scalar<ENTRY_T> alpha =
+            rz.divide_if_positive(direction.dot(product));
+        solution.axpy(alpha, direction);
+        residual.axpy(-alpha, product);
+
+        const Vector &z = precondition();
+        const Scalar<ENTRY_T> rz_new = residual.dot(z);
+        direction.xpay(rz_new.divide_if_positive(rz), z);
+        rz = rz_new;
+        ++iteration;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::CGSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::CGSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::CGSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
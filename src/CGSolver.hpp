@@ -0,0 +1,86 @@
+#ifndef LEGION_SOLVERS_CG_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_CG_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+#include "Scalar.hpp"                 // for Scalar
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a symmetric positive definite linear operator A by
+// the (optionally preconditioned) conjugate gradient method. The right-hand
+// side b and the solution x are fields of application regions over the
+// parent index space of an application-supplied partition, which is also
+// used for the solver's work vectors; x is updated in place, starting from
+// its initial contents. The preconditioner, if any, is applied as M * r and
+// must be symmetric positive definite as well.
+//
+// Every vector operation of an iteration is an index launch, and every
+// coefficient (alpha, beta) is a Scalar whose value stays in a future, so
+// iterations are issued without waiting for their dot products. The solver
+// blocks only to test convergence, which it does every check_interval
+// iterations; it may therefore perform up to check_interval - 1 iterations
+// more than needed.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class CGSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const AbstractLinearOperator<ENTRY_T> *const preconditioner;
+    const std::size_t check_interval;
+    const Vector rhs;
+    Vector solution;
+    Vector residual;
+    Vector direction;
+    Vector product;
+    const std::unique_ptr<Vector> preconditioned; // only with preconditioner
+    ENTRY_T residual_norm;
+
+    // Returns M * residual, or the residual itself without a preconditioner.
+    const Vector &precondition();
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 10;
+
+    explicit CGSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<ENTRY_T> *preconditioner = nullptr,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    CGSolver(const CGSolver &) = delete;
+
+    CGSolver &operator=(const CGSolver &) = delete;
+
+    // Iterates until the residual norm is at most tolerance times the norm
+    // of b, as observed at a convergence check, or until max_iterations
+    // iterations have been performed. Returns the number of iterations.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norm of the residual b - A * x at the last convergence check, as
+    // updated by the CG recurrence.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class CGSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_CG_SOLVER_HPP_INCLUDED
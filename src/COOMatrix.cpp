@@ -0,0 +1,323 @@
+#include "COOMatrix.hpp"
+
+#include <cassert> // for assert
+
+#include "COOMatrixTasks.hpp" // for COOMatvecTask
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+#include "TaskIDs.hpp"        // for LEGION_REDOP_SUM
+
+using LegionSolvers::COOMatrix;
+using LegionSolvers::COOMatvecTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+COOMatrix<ENTRY_T, DIM, COORD_T>::COOMatrix(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::LogicalRegion kernel_region,
+    Legion::FieldID fid_row,
+    Legion::FieldID fid_col,
+    Legion::FieldID fid_entry,
+    Legion::IndexSpace domain_space,
+    Legion::IndexSpace range_space,
+    Legion::IndexPartition kernel_partition
+)
+    : ctx(ctx), rt(rt), kernel_region(kernel_region), fid_row(fid_row),
+      fid_col(fid_col), fid_entry(fid_entry), domain_space(domain_space),
+      range_space(range_space), kernel_partition(kernel_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, kernel_partition)
+      ),
+      domain_partition(
+          domain_partition_from_kernel_partition(domain_space, kernel_partition)
+      ),
+      range_partition(
+          range_partition_from_kernel_partition(range_space, kernel_partition)
+      ) {
+    assert(
+        rt->get_parent_index_space(ctx, kernel_partition) ==
+        kernel_region.get_index_space()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+COOMatrix<ENTRY_T, DIM, COORD_T>::~COOMatrix() {
+    rt->destroy_index_partition(ctx, range_partition);
+    rt->destroy_index_partition(ctx, domain_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+COOMatrix<ENTRY_T, DIM, COORD_T>::kernel_partition_from_domain_partition(
+    Legion::IndexPartition domain_partition
+) const {
+    return rt->create_partition_by_preimage(
+        ctx,
+        domain_partition,
+        kernel_region,
+        kernel_region,
+        fid_col,
+        rt->get_index_partition_color_space_name(ctx, domain_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+COOMatrix<ENTRY_T, DIM, COORD_T>::kernel_partition_from_range_partition(
+    Legion::IndexPartition range_partition
+) const {
+    return rt->create_partition_by_preimage(
+        ctx,
+        range_partition,
+        kernel_region,
+        kernel_region,
+        fid_row,
+        rt->get_index_partition_color_space_name(ctx, range_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+COOMatrix<ENTRY_T, DIM, COORD_T>::domain_partition_from_kernel_partition(
+    Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+) const {
+    return rt->create_partition_by_image(
+        ctx,
+        domain_space,
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+        kernel_region,
+        fid_col,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+COOMatrix<ENTRY_T, DIM, COORD_T>::range_partition_from_kernel_partition(
+    Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+) const {
+    return rt->create_partition_by_image(
+        ctx,
+        range_space,
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+        kernel_region,
+        fid_row,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void COOMatrix<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == range_space);
+    assert(input_region.get_index_space() == domain_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    Legion::IndexLauncher launcher{
+        COOMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, range_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_row);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_col);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_entry);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, domain_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void COOMatrix<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == domain_space);
+    assert(input_region.get_index_space() == range_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    Legion::IndexLauncher launcher{
+        COOMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, domain_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_col);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_row);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(fid_entry);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::COOMatrix<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::COOMatrix<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::COOMatrix<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
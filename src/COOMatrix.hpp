@@ -0,0 +1,137 @@
+#ifndef LEGION_SOLVERS_COO_MATRIX_HPP_INCLUDED
+#define LEGION_SOLVERS_COO_MATRIX_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractMatrix.hpp" // for AbstractMatrix
+
+namespace LegionSolvers {
+
+
+// A sparse matrix in coordinate format, stored in place in an
+// application-owned 1D kernel region with one point per nonzero, holding its
+// row index (a Point<DIM, COORD_T> of the range space), its column index (a
+// Point<DIM, COORD_T> of the domain space), and its entry.
+//
+// Products are computed over an application-supplied partition of the kernel
+// space, which need not respect row boundaries: each piece reduces its
+// contributions into the output, so an equal partition of the kernel space
+// balances work by nonzeros regardless of the row length distribution. The
+// (aliased) range and domain partitions touched by each piece are derived
+// from it once, by dependent partitioning, when the matrix is constructed.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class COOMatrix : public AbstractMatrix<ENTRY_T> {
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::LogicalRegion kernel_region;
+    const Legion::FieldID fid_row;
+    const Legion::FieldID fid_col;
+    const Legion::FieldID fid_entry;
+    const Legion::IndexSpace domain_space;
+    const Legion::IndexSpace range_space;
+    const Legion::IndexPartition kernel_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::IndexPartition domain_partition;
+    const Legion::IndexPartition range_partition;
+
+  public:
+
+    explicit COOMatrix(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::LogicalRegion kernel_region,
+        Legion::FieldID fid_row,
+        Legion::FieldID fid_col,
+        Legion::FieldID fid_entry,
+        Legion::IndexSpace domain_space,
+        Legion::IndexSpace range_space,
+        Legion::IndexPartition kernel_partition
+    );
+
+    COOMatrix(const COOMatrix &) = delete;
+
+    COOMatrix &operator=(const COOMatrix &) = delete;
+
+    virtual ~COOMatrix();
+
+    Legion::FieldID get_fid_row() const { return fid_row; }
+
+    Legion::FieldID get_fid_col() const { return fid_col; }
+
+    Legion::FieldID get_fid_entry() const { return fid_entry; }
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_range_space() const { return range_space; }
+
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::IndexPartition get_domain_partition() const {
+        return domain_partition;
+    }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    virtual Legion::IndexSpace get_kernel_space() const override {
+        return kernel_region.get_index_space();
+    }
+
+    virtual Legion::LogicalRegion get_kernel_region() const override {
+        return kernel_region;
+    }
+
+    virtual std::vector<Legion::LogicalRegion>
+    get_auxiliary_regions() const override {
+        return {};
+    }
+
+    // Nonzeros whose column lies in each piece (preimage of the columns).
+    virtual Legion::IndexPartition kernel_partition_from_domain_partition(
+        Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Nonzeros whose row lies in each piece (preimage of the rows).
+    virtual Legion::IndexPartition
+    kernel_partition_from_range_partition(Legion::IndexPartition range_partition
+    ) const override;
+
+    // Columns of the nonzeros in each piece (image of the columns).
+    virtual Legion::IndexPartition domain_partition_from_kernel_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Rows of the nonzeros in each piece (image of the rows).
+    virtual Legion::IndexPartition range_partition_from_kernel_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Zeroes output, then reduces the contribution of each kernel piece
+    // into it.
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // As matvec, with the row and column indices exchanged.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class COOMatrix
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_COO_MATRIX_HPP_INCLUDED
@@ -0,0 +1,184 @@
+#include "COOMatrixTasks.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineSumAccessor, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+#include "SparseKernels.hpp"   // for dense_coo_matvec
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+#include "VectorKernels.hpp"   // for is_dense_rect, for_each_thread_range
+
+using LegionSolvers::COOMatvecTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::dense_coo_matvec;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void COOMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    const auto &output = regions[0];
+    const auto &row = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    assert(task->regions.size() == 5);
+    const auto &output_req = task->regions[0];
+    const auto &row_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(row_req.privilege_fields.size() == 1);
+    const Legion::FieldID row_fid = *row_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using Index = Legion::Point<DIM, COORD_T>;
+
+    AffineSumAccessor<ENTRY_T, DIM, COORD_T> output_reducer{
+        output, output_fid, LEGION_REDOP_SUM<ENTRY_T>};
+    AffineReader<Index, 1, COORD_T> row_reader{row, row_fid};
+    AffineReader<Index, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, row_req.region.get_index_space());
+
+    const auto input_ptr = [&](const Index &j) { return input_reader.ptr(j); };
+    const auto reduce = [&](const Index &i, ENTRY_T value) {
+        output_reducer.reduce(i, value);
+    };
+
+    using KernelRectIterator = Legion::RectInDomainIterator<1, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (KernelRectIterator it(kernel_domain); it(); ++it) {
+        const Legion::Rect<1, COORD_T> rect = *it;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, row_reader, col_reader, entry_reader)) {
+            const Index *row_ptr = row_reader.ptr(rect.lo);
+            const Index *col_ptr = col_reader.ptr(rect.lo);
+            const ENTRY_T *entry_ptr = entry_reader.ptr(rect.lo);
+            // Threads may share a row at the ends of their ranges; the
+            // reduction accessor is non-exclusive, so reductions are atomic.
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_coo_matvec(
+                        end - begin,
+                        row_ptr + begin,
+                        col_ptr + begin,
+                        entry_ptr + begin,
+                        input_ptr,
+                        reduce
+                    );
+                }
+            );
+            continue;
+        }
+        for (KernelIterator k(rect); k(); ++k) {
+            output_reducer.reduce(
+                row_reader[*k], entry_reader[*k] * input_reader[col_reader[*k]]
+            );
+        }
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void COOMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void COOMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void COOMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
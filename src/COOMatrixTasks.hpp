@@ -0,0 +1,49 @@
+#ifndef LEGION_SOLVERS_COO_MATRIX_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_COO_MATRIX_TASKS_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for COO_MATVEC_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Adds A * input to output for the nonzeros of a COO matrix A in one piece
+// of its kernel space. Regions are output (reduction by
+// LEGION_REDOP_SUM<ENTRY_T>, range piece), row indices, column indices, and
+// entries (read-only, kernel piece, one requirement each), and input
+// (read-only, domain piece). Row and column indices hold Point<DIM, COORD_T>
+// indices into the range and domain spaces, respectively.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct COOMatvecTask
+    : public TaskTDI<
+          COO_MATVEC_TASK_BLOCK_ID,
+          COOMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "coo_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct COOMatvecTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_COO_MATRIX_TASKS_HPP_INCLUDED
@@ -0,0 +1,149 @@
+#ifndef LEGION_SOLVERS_CSR_MATRIX_HPP_INCLUDED
+#define LEGION_SOLVERS_CSR_MATRIX_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractMatrix.hpp" // for AbstractMatrix
+
+namespace LegionSolvers {
+
+
+// A sparse matrix in compressed sparse row format, stored in place in
+// application-owned regions. The kernel region is a 1D region with one point
+// per nonzero, holding its column index (a Point<DIM, COORD_T> of the domain
+// space) and its entry. The row pointer region is defined over the range
+// space and holds, for each row, the Rect<1, COORD_T> of kernel points in
+// that row; the kernel points of consecutive rows must be consecutive.
+//
+// Products are computed row-parallel over an application-supplied partition
+// of the range space. The matching partitions of the kernel and domain
+// spaces are derived from it once, by dependent partitioning, when the
+// matrix is constructed.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class CSRMatrix : public AbstractMatrix<ENTRY_T> {
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::LogicalRegion kernel_region;
+    const Legion::FieldID fid_col;
+    const Legion::FieldID fid_entry;
+    const Legion::LogicalRegion rowptr_region;
+    const Legion::FieldID fid_rowptr;
+    const Legion::IndexSpace domain_space;
+    const Legion::IndexPartition range_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::IndexPartition kernel_partition;
+    const Legion::IndexPartition domain_partition;
+
+  public:
+
+    explicit CSRMatrix(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::LogicalRegion kernel_region,
+        Legion::FieldID fid_col,
+        Legion::FieldID fid_entry,
+        Legion::LogicalRegion rowptr_region,
+        Legion::FieldID fid_rowptr,
+        Legion::IndexSpace domain_space,
+        Legion::IndexPartition range_partition
+    );
+
+    CSRMatrix(const CSRMatrix &) = delete;
+
+    CSRMatrix &operator=(const CSRMatrix &) = delete;
+
+    virtual ~CSRMatrix();
+
+    Legion::LogicalRegion get_rowptr_region() const { return rowptr_region; }
+
+    Legion::FieldID get_fid_rowptr() const { return fid_rowptr; }
+
+    Legion::FieldID get_fid_col() const { return fid_col; }
+
+    Legion::FieldID get_fid_entry() const { return fid_entry; }
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_range_space() const {
+        return rowptr_region.get_index_space();
+    }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::IndexPartition get_domain_partition() const {
+        return domain_partition;
+    }
+
+    virtual Legion::IndexSpace get_kernel_space() const override {
+        return kernel_region.get_index_space();
+    }
+
+    virtual Legion::LogicalRegion get_kernel_region() const override {
+        return kernel_region;
+    }
+
+    virtual std::vector<Legion::LogicalRegion>
+    get_auxiliary_regions() const override {
+        return {rowptr_region};
+    }
+
+    // Nonzeros whose column lies in each piece (preimage of the columns).
+    virtual Legion::IndexPartition kernel_partition_from_domain_partition(
+        Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Nonzeros of the rows in each piece (image of the row pointers).
+    virtual Legion::IndexPartition
+    kernel_partition_from_range_partition(Legion::IndexPartition range_partition
+    ) const override;
+
+    // Columns of the nonzeros in each piece (image of the columns).
+    virtual Legion::IndexPartition domain_partition_from_kernel_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Rows whose nonzeros lie in each piece (preimage of the row pointers).
+    virtual Legion::IndexPartition range_partition_from_kernel_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Launches one CSRMatmatTask per piece of the range partition, which
+    // reads the matrix once for all vectors.
+    virtual void matmat(
+        Legion::LogicalRegion output_region,
+        const std::vector<Legion::FieldID> &output_fids,
+        Legion::LogicalRegion input_region,
+        const std::vector<Legion::FieldID> &input_fids
+    ) const override;
+
+    // Zeroes output, then launches one CSRTransposeMatvecTask per piece of
+    // the range partition, which reduces into the domain piece it touches.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class CSRMatrix
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_CSR_MATRIX_HPP_INCLUDED
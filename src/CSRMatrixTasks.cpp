@@ -0,0 +1,606 @@
+#include "CSRMatrixTasks.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::fma
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include "KrylovBasis.hpp"     // for KrylovBasis
+#include "LegionUtilities.hpp" // for AffineReader, AffineSumAccessor, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*, ...
+#include "SparseKernels.hpp"   // for dense_csr_matmat, ...
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+#include "VectorKernels.hpp"   // for is_dense_rect, for_each_thread_range
+
+using LegionSolvers::CSRMatmatTask;
+using LegionSolvers::CSRMatrixPowersTask;
+using LegionSolvers::CSRMatvecTask;
+using LegionSolvers::CSRTransposeMatvecTask;
+using LegionSolvers::KrylovBasis;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::dense_csr_matmat;
+using LegionSolvers::dense_csr_matvec;
+using LegionSolvers::dense_csr_transpose_matvec;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void CSRMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    const auto &output = regions[0];
+    const auto &rowptr = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    assert(task->regions.size() == 5);
+    const auto &output_req = task->regions[0];
+    const auto &rowptr_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{output, output_fid};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Column, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain output_domain =
+        rt->get_index_space_domain(ctx, output_req.region.get_index_space());
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, col_req.region.get_index_space());
+
+    // The rows of one piece normally own one contiguous run of the kernel
+    // space, which the dense path below streams through by pointer.
+    const Legion::Rect<1, COORD_T> kernel_rect = kernel_domain;
+    const bool dense_kernel =
+        kernel_domain.dense() &&
+        (kernel_rect.empty() ||
+         is_dense_rect(kernel_rect, col_reader, entry_reader));
+    const std::size_t num_entries = kernel_rect.volume();
+    const Column *col_ptr =
+        (num_entries > 0) ? col_reader.ptr(kernel_rect.lo) : nullptr;
+    const ENTRY_T *entry_ptr =
+        (num_entries > 0) ? entry_reader.ptr(kernel_rect.lo) : nullptr;
+    const auto input_ptr = [&](const Column &j) { return input_reader.ptr(j); };
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (RectIterator rect_iter(output_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (dense_kernel && is_dense_rect(rect, output_writer, rowptr_reader)) {
+            ENTRY_T *output_ptr = output_writer.ptr(rect.lo);
+            const RowExtent *rowptr_ptr = rowptr_reader.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_csr_matvec(
+                        end - begin,
+                        output_ptr + begin,
+                        rowptr_ptr + begin,
+                        kernel_rect.lo[0],
+                        num_entries,
+                        entry_ptr,
+                        col_ptr,
+                        input_ptr
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            ENTRY_T sum = static_cast<ENTRY_T>(0);
+            for (KernelIterator k(rowptr_reader[point]); k(); ++k) {
+                sum += entry_reader[*k] * input_reader[col_reader[*k]];
+            }
+            output_writer[point] = sum;
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void CSRTransposeMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    const auto &output = regions[0];
+    const auto &rowptr = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    assert(task->regions.size() == 5);
+    const auto &output_req = task->regions[0];
+    const auto &rowptr_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+
+    AffineSumAccessor<ENTRY_T, DIM, COORD_T> output_reducer{
+        output, output_fid, LEGION_REDOP_SUM<ENTRY_T>};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Column, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain row_domain =
+        rt->get_index_space_domain(ctx, rowptr_req.region.get_index_space());
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, col_req.region.get_index_space());
+
+    // As in CSRMatvecTask, the rows of one piece normally own one contiguous
+    // run of the kernel space, which the dense path streams through.
+    const Legion::Rect<1, COORD_T> kernel_rect = kernel_domain;
+    const bool dense_kernel =
+        kernel_domain.dense() &&
+        (kernel_rect.empty() ||
+         is_dense_rect(kernel_rect, col_reader, entry_reader));
+    const std::size_t num_entries = kernel_rect.volume();
+    const Column *col_ptr =
+        (num_entries > 0) ? col_reader.ptr(kernel_rect.lo) : nullptr;
+    const ENTRY_T *entry_ptr =
+        (num_entries > 0) ? entry_reader.ptr(kernel_rect.lo) : nullptr;
+    const auto reduce = [&](const Column &j, ENTRY_T value) {
+        output_reducer.reduce(j, value);
+    };
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (RectIterator rect_iter(row_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (dense_kernel && is_dense_rect(rect, input_reader, rowptr_reader)) {
+            const ENTRY_T *x_ptr = input_reader.ptr(rect.lo);
+            const RowExtent *rowptr_ptr = rowptr_reader.ptr(rect.lo);
+            // Rows of different threads may share columns; the reduction
+            // accessor is non-exclusive, so reductions are atomic.
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_csr_transpose_matvec(
+                        end - begin,
+                        x_ptr + begin,
+                        rowptr_ptr + begin,
+                        kernel_rect.lo[0],
+                        entry_ptr,
+                        col_ptr,
+                        reduce
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> row = *point_iter;
+            const ENTRY_T x = input_reader[row];
+            for (KernelIterator k(rowptr_reader[row]); k(); ++k) {
+                output_reducer.reduce(col_reader[*k], entry_reader[*k] * x);
+            }
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void CSRMatmatTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 5);
+    const auto &output = regions[0];
+    const auto &rowptr = regions[1];
+    const auto &col = regions[2];
+    const auto &entry = regions[3];
+    const auto &input = regions[4];
+
+    assert(task->regions.size() == 5);
+    const auto &output_req = task->regions[0];
+    const auto &rowptr_req = task->regions[1];
+    const auto &col_req = task->regions[2];
+    const auto &entry_req = task->regions[3];
+    const auto &input_req = task->regions[4];
+
+    const std::size_t m = output_req.instance_fields.size();
+    assert((m > 0) && (m <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    assert(input_req.instance_fields.size() == m);
+
+    assert(rowptr_req.privilege_fields.size() == 1);
+    const Legion::FieldID rowptr_fid = *rowptr_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+
+    std::vector<AffineWriter<ENTRY_T, DIM, COORD_T>> output_writers;
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> input_readers;
+    for (std::size_t j = 0; j < m; ++j) {
+        output_writers.emplace_back(output, output_req.instance_fields[j]);
+        input_readers.emplace_back(input, input_req.instance_fields[j]);
+    }
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{rowptr, rowptr_fid};
+    AffineReader<Column, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+
+    const Legion::Domain output_domain =
+        rt->get_index_space_domain(ctx, output_req.region.get_index_space());
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, col_req.region.get_index_space());
+
+    // As in CSRMatvecTask, the dense path streams through the contiguous run
+    // of the kernel space owned by the rows of this piece.
+    const Legion::Rect<1, COORD_T> kernel_rect = kernel_domain;
+    const bool dense_kernel =
+        kernel_domain.dense() &&
+        (kernel_rect.empty() ||
+         is_dense_rect(kernel_rect, col_reader, entry_reader));
+    const std::size_t num_entries = kernel_rect.volume();
+    const Column *col_ptr =
+        (num_entries > 0) ? col_reader.ptr(kernel_rect.lo) : nullptr;
+    const ENTRY_T *entry_ptr =
+        (num_entries > 0) ? entry_reader.ptr(kernel_rect.lo) : nullptr;
+    const auto input_ptr = [&](std::size_t j, const Column &c) {
+        return input_readers[j].ptr(c);
+    };
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    ENTRY_T *output_ptrs[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    ENTRY_T sums[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (RectIterator rect_iter(output_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        bool dense_rect = dense_kernel;
+        for (std::size_t j = 0; dense_rect && (j < m); ++j) {
+            dense_rect = is_dense_rect(rect, output_writers[j], rowptr_reader);
+        }
+        if (dense_rect) {
+            for (std::size_t j = 0; j < m; ++j) {
+                output_ptrs[j] = output_writers[j].ptr(rect.lo);
+            }
+            const RowExtent *rowptr_ptr = rowptr_reader.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    ENTRY_T *y[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+                    for (std::size_t j = 0; j < m; ++j) {
+                        y[j] = output_ptrs[j] + begin;
+                    }
+                    dense_csr_matmat(
+                        end - begin,
+                        m,
+                        y,
+                        rowptr_ptr + begin,
+                        kernel_rect.lo[0],
+                        num_entries,
+                        entry_ptr,
+                        col_ptr,
+                        input_ptr
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            for (std::size_t j = 0; j < m; ++j) {
+                sums[j] = static_cast<ENTRY_T>(0);
+            }
+            for (KernelIterator k(rowptr_reader[point]); k(); ++k) {
+                const ENTRY_T a = entry_reader[*k];
+                const Column c = col_reader[*k];
+                for (std::size_t j = 0; j < m; ++j) {
+                    sums[j] += a * input_readers[j][c];
+                }
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                output_writers[j][point] = sums[j];
+            }
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void CSRMatrixPowersTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->regions.size() == regions.size());
+    assert((regions.size() >= 5) && (regions.size() % 2 == 1));
+    const std::size_t L = (regions.size() - 3) / 2;
+
+    assert(task->arglen == sizeof(KrylovBasis<ENTRY_T>));
+    const KrylovBasis<ENTRY_T> &basis =
+        *static_cast<const KrylovBasis<ENTRY_T> *>(task->args);
+    assert(L <= basis.length);
+
+    for (const auto &req : task->regions) {
+        assert(req.privilege_fields.size() == 1);
+    }
+    const auto fid = [&](std::size_t i) {
+        return *task->regions[i].privilege_fields.begin();
+    };
+    const auto domain = [&](std::size_t i) {
+        return rt->get_index_space_domain(
+            ctx, task->regions[i].region.get_index_space()
+        );
+    };
+
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using Column = Legion::Point<DIM, COORD_T>;
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{regions[0], fid(0)};
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{regions[1], fid(1)};
+    AffineReader<Column, 1, COORD_T> col_reader{
+        regions[L + 1], fid(L + 1)};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{
+        regions[L + 2], fid(L + 2)};
+
+    // Basis vectors are kept in dense local arrays over the bounding box of
+    // the ghost piece of depth L.
+    const Legion::Domain ghost_domain = domain(0);
+    const Legion::Rect<DIM, COORD_T> bounds =
+        ghost_domain.bounds<DIM, COORD_T>();
+    const auto offset = [&](const Legion::Point<DIM, COORD_T> &point) {
+        std::size_t result = 0;
+        for (int d = 0; d < DIM; ++d) {
+            const std::size_t extent = bounds.hi[d] - bounds.lo[d] + 1;
+            result = result * extent + (point[d] - bounds.lo[d]);
+        }
+        return result;
+    };
+    std::vector<std::vector<ENTRY_T>> levels(
+        L + 1, std::vector<ENTRY_T>(bounds.empty() ? 0 : bounds.volume())
+    );
+
+    for (RectIterator rect_iter(ghost_domain); rect_iter(); ++rect_iter) {
+        for (PointIterator point_iter(*rect_iter); point_iter();
+             ++point_iter) {
+            levels[0][offset(*point_iter)] = input_reader[*point_iter];
+        }
+    }
+
+    for (std::size_t k = 1; k <= L; ++k) {
+        const ENTRY_T *v = levels[k - 1].data();
+        const ENTRY_T *u = (k >= 2) ? levels[k - 2].data() : nullptr;
+        ENTRY_T *w = levels[k].data();
+        const ENTRY_T shift = basis.shift[k - 1];
+        const ENTRY_T previous = basis.previous[k - 1];
+        const ENTRY_T scale = basis.scale[k - 1];
+        const Legion::Domain rows = domain(k);
+        for (RectIterator rect_iter(rows); rect_iter(); ++rect_iter) {
+            for (PointIterator point_iter(*rect_iter); point_iter();
+                 ++point_iter) {
+                const Legion::Point<DIM, COORD_T> point = *point_iter;
+                ENTRY_T sum = static_cast<ENTRY_T>(0);
+                for (KernelIterator j(rowptr_reader[point]); j(); ++j) {
+                    sum = std::fma(
+                        entry_reader[*j], v[offset(col_reader[*j])], sum
+                    );
+                }
+                const std::size_t i = offset(point);
+                sum = std::fma(-shift, v[i], sum);
+                if (u) { sum = std::fma(-previous, u[i], sum); }
+                w[i] = sum / scale;
+            }
+        }
+    }
+
+    const Legion::Domain output_domain = domain(L + 3);
+    for (std::size_t k = 1; k <= L; ++k) {
+        AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{
+            regions[L + 2 + k], fid(L + 2 + k)};
+        assert(domain(L + 2 + k) == output_domain);
+        for (RectIterator rect_iter(output_domain); rect_iter(); ++rect_iter) {
+            for (PointIterator point_iter(*rect_iter); point_iter();
+                 ++point_iter) {
+                output_writer[*point_iter] = levels[k][offset(*point_iter)];
+            }
+        }
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void CSRMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void CSRMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void CSRMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRTransposeMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatrixPowersTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void CSRMatmatTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
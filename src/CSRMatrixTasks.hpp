@@ -0,0 +1,151 @@
+#ifndef LEGION_SOLVERS_CSR_MATRIX_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_CSR_MATRIX_TASKS_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for CSR_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Computes output = A * input for the rows of a CSR matrix A in one piece of
+// its range space. Regions are output (write-discard, range piece), row
+// pointers (read-only, range piece), column indices and entries (read-only,
+// kernel piece, one requirement each), and input (read-only, domain piece).
+// Row pointers hold Rect<1, COORD_T> extents into the kernel space, and
+// column indices hold Point<DIM, COORD_T> indices into the domain space.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct CSRMatvecTask
+    : public TaskTDI<
+          CSR_MATVEC_TASK_BLOCK_ID,
+          CSRMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "csr_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct CSRMatvecTask
+
+
+// Adds A^T * input to output for the rows of a CSR matrix A in one piece of
+// its range space. Regions are output (reduction by
+// LEGION_REDOP_SUM<ENTRY_T>, domain piece), row pointers (read-only, range
+// piece), column indices and entries (read-only, kernel piece, one
+// requirement each), and input (read-only, range piece). Pieces of the
+// domain partition may overlap, so each entry is reduced into output rather
+// than written.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct CSRTransposeMatvecTask
+    : public TaskTDI<
+          CSR_TRANSPOSE_MATVEC_TASK_BLOCK_ID,
+          CSRTransposeMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "csr_transpose_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct CSRTransposeMatvecTask
+
+
+// Computes output_j = A * input_j for m vectors at once (sparse matrix times
+// multi-vector), for the rows of a CSR matrix A in one piece of its range
+// space. Regions are as for CSRMatvecTask, except that output and input
+// carry m fields each (the vectors of a MultiVector, in the order of
+// RegionRequirement::instance_fields). Each entry and column index is read
+// once for all m vectors, so the matrix traffic of m products is that of
+// one. At most LEGION_SOLVERS_MAX_BLOCK_SIZE vectors are supported.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct CSRMatmatTask
+    : public TaskTDI<
+          CSR_MATMAT_TASK_BLOCK_ID,
+          CSRMatmatTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "csr_matmat";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct CSRMatmatTask
+
+
+// Matrix-powers kernel: computes the vectors v_1, ..., v_L of a Krylov basis
+// (see KrylovBasis) of a square CSR matrix A from v_0, for the rows of one
+// piece of its range space, with a single read of v_0 over a ghost piece of
+// depth L. Vector v_k is computed locally, redundantly with neighbouring
+// pieces, on the rows of the ghost piece of depth L - k, which contains the
+// columns of the rows of depth L - k - 1. Regions are v_0 (read-only, depth
+// L), the row pointers over the ghost pieces of depth L - 1, ..., 0 (one
+// read-only requirement each), the column indices and entries of the rows
+// of depth L - 1 (read-only, one requirement each), and v_1, ..., v_L
+// (write-discard, depth 0). The task argument is a KrylovBasis<ENTRY_T>.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct CSRMatrixPowersTask
+    : public TaskTDI<
+          CSR_MATRIX_POWERS_TASK_BLOCK_ID,
+          CSRMatrixPowersTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "csr_matrix_powers";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct CSRMatrixPowersTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_CSR_MATRIX_TASKS_HPP_INCLUDED
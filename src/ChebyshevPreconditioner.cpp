@@ -0,0 +1,380 @@
+#include "ChebyshevPreconditioner.hpp"
+
+#include <algorithm> // for std::max, std::min
+#include <cassert>   // for assert
+#include <cmath>     // for std::abs, std::isfinite, std::sqrt
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint32_t
+#include <limits>    // for std::numeric_limits
+#include <memory>    // for std::make_unique
+#include <utility>   // for std::swap
+#include <vector>    // for std::vector
+
+#include "FusedVectorOperations.hpp" // for FusedVectorOperations
+#include "LibraryOptions.hpp"        // for LEGION_SOLVERS_USE_*
+#include "Scalar.hpp"                // for Scalar
+
+using LegionSolvers::ChebyshevPreconditioner;
+using LegionSolvers::EigenvalueBounds;
+using LegionSolvers::FusedVectorOperations;
+using LegionSolvers::Scalar;
+
+
+// Number of eigenvalues less than x of the symmetric tridiagonal matrix with
+// diagonal alpha and off-diagonal beta, by the signs of the pivots of the
+// LDL^T factorization of T - x * I (Sturm count).
+template <typename T>
+static std::size_t count_eigenvalues_below(
+    const std::vector<T> &alpha, const std::vector<T> &beta, T x
+) {
+    std::size_t count = 0;
+    T pivot = static_cast<T>(1);
+    for (std::size_t i = 0; i < alpha.size(); ++i) {
+        const T coupling = (i > 0) ? beta[i - 1] * beta[i - 1] / pivot
+                                   : static_cast<T>(0);
+        pivot = alpha[i] - x - coupling;
+        if (pivot == static_cast<T>(0)) {
+            pivot = -std::numeric_limits<T>::epsilon();
+        }
+        if (pivot < static_cast<T>(0)) { ++count; }
+    }
+    return count;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::ChebyshevPreconditioner(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::IndexPartition partition,
+    std::size_t degree,
+    const EigenvalueBounds<ENTRY_T> &bounds
+)
+    : ctx(ctx), rt(rt), matrix(matrix), partition(partition), degree(degree),
+      bounds(bounds), r(ctx, rt, partition), d(ctx, rt, partition),
+      w(ctx, rt, partition) {
+    assert(degree > 0);
+    assert(static_cast<ENTRY_T>(0) < bounds.lower);
+    assert(bounds.lower < bounds.upper);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+EigenvalueBounds<ENTRY_T>
+ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::estimate_eigenvalue_bounds(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion start_region,
+    Legion::FieldID start_fid,
+    Legion::IndexPartition partition,
+    std::size_t num_steps
+) {
+    using Operations = FusedVectorOperations<ENTRY_T, DIM, COORD_T>;
+
+    assert(num_steps > 0);
+    const Scalar<ENTRY_T> one{ctx, rt, static_cast<ENTRY_T>(1)};
+    const Vector start{ctx, rt, start_region, start_fid, partition};
+    auto previous = std::make_unique<Vector>(ctx, rt, partition);
+    auto current = std::make_unique<Vector>(ctx, rt, partition);
+    auto next = std::make_unique<Vector>(ctx, rt, partition);
+    previous->constant_fill(static_cast<ENTRY_T>(0));
+    current->copy(start);
+    current->scal(one / start.dot(start).sqrt());
+
+    // q_{j + 1} * beta_j = A * q_j - alpha_j * q_j - beta_{j - 1} * q_{j - 1}
+    std::vector<Scalar<ENTRY_T>> alphas;
+    std::vector<Scalar<ENTRY_T>> betas;
+    Scalar<ENTRY_T> beta{ctx, rt, static_cast<ENTRY_T>(0)};
+    for (std::size_t j = 0; j < num_steps; ++j) {
+        matrix.matvec(
+            next->get_logical_region(),
+            next->get_fid(),
+            current->get_logical_region(),
+            current->get_fid()
+        );
+        const Scalar<ENTRY_T> alpha = current->dot(*next);
+        Operations operations{ctx, rt};
+        operations.axpy(*next, -alpha, *current);
+        operations.axpy(*next, -beta, *previous);
+        const std::uint32_t norm_index = operations.dot(*next, *next);
+        const Legion::Future packed = operations.execute();
+        beta = Scalar<ENTRY_T>::packed(ctx, rt, packed, norm_index).sqrt();
+        next->scal(one / beta);
+        alphas.push_back(alpha);
+        betas.push_back(beta);
+        std::swap(previous, current);
+        std::swap(current, next);
+    }
+
+    // The tridiagonal matrix, truncated where the Krylov space becomes
+    // invariant (after which the basis vectors carry no information).
+    std::vector<ENTRY_T> alpha_values;
+    std::vector<ENTRY_T> beta_values;
+    ENTRY_T scale = static_cast<ENTRY_T>(0);
+    for (std::size_t j = 0; j < num_steps; ++j) {
+        const ENTRY_T alpha = alphas[j].get_value();
+        const ENTRY_T beta_value = betas[j].get_value();
+        assert(std::isfinite(alpha));
+        alpha_values.push_back(alpha);
+        scale = std::max(scale, std::abs(alpha));
+        const ENTRY_T threshold =
+            std::sqrt(std::numeric_limits<ENTRY_T>::epsilon()) * scale;
+        if (!std::isfinite(beta_value) || !(beta_value > threshold)) { break; }
+        beta_values.push_back(beta_value);
+    }
+    const std::size_t m = alpha_values.size();
+    beta_values.resize(m - 1);
+
+    // Bisection for the extreme eigenvalues within the Gershgorin interval.
+    ENTRY_T lo = alpha_values[0];
+    ENTRY_T hi = alpha_values[0];
+    for (std::size_t i = 0; i < m; ++i) {
+        ENTRY_T radius = static_cast<ENTRY_T>(0);
+        if (i > 0) { radius += std::abs(beta_values[i - 1]); }
+        if (i + 1 < m) { radius += std::abs(beta_values[i]); }
+        lo = std::min(lo, alpha_values[i] - radius);
+        hi = std::max(hi, alpha_values[i] + radius);
+    }
+    const auto bisect = [&](std::size_t rank) {
+        // Smallest x with at least rank eigenvalues at or below it.
+        ENTRY_T a = lo - std::abs(lo) - static_cast<ENTRY_T>(1);
+        ENTRY_T b = hi + std::abs(hi) + static_cast<ENTRY_T>(1);
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            const ENTRY_T mid = (a + b) / static_cast<ENTRY_T>(2);
+            if ((mid <= a) || (mid >= b)) { break; }
+            if (count_eigenvalues_below(alpha_values, beta_values, mid) >=
+                rank) {
+                b = mid;
+            } else {
+                a = mid;
+            }
+        }
+        return b;
+    };
+
+    EigenvalueBounds<ENTRY_T> result;
+    result.lower = bisect(1);
+    result.upper = bisect(m) * static_cast<ENTRY_T>(1.1);
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::power_partition(
+    Legion::IndexSpace space,
+    Legion::IndexPartition source_partition,
+    bool domain_from_range
+) const {
+    const auto step = [&](Legion::IndexPartition source) {
+        if (domain_from_range) {
+            return matrix.domain_partition_from_range_partition(space, source);
+        } else {
+            return matrix.range_partition_from_domain_partition(space, source);
+        }
+    };
+    Legion::IndexPartition result = step(source_partition);
+    for (std::size_t k = 1; k < degree; ++k) {
+        const Legion::IndexPartition wider = step(result);
+        rt->destroy_index_partition(ctx, result);
+        result = wider;
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    return power_partition(domain_space, range_partition, true);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    return power_partition(range_space, domain_partition, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::apply_matrix(
+    Vector &output, const Vector &input, bool transpose
+) const {
+    if (transpose) {
+        matrix.transpose_matvec(
+            output.get_logical_region(),
+            output.get_fid(),
+            input.get_logical_region(),
+            input.get_fid()
+        );
+    } else {
+        matrix.matvec(
+            output.get_logical_region(),
+            output.get_fid(),
+            input.get_logical_region(),
+            input.get_fid()
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::iterate(
+    Vector &x, const Vector &b, bool zero_initial_guess, bool transpose
+) const {
+    using Operations = FusedVectorOperations<ENTRY_T, DIM, COORD_T>;
+
+    const ENTRY_T one = static_cast<ENTRY_T>(1);
+    const ENTRY_T two = static_cast<ENTRY_T>(2);
+    const ENTRY_T theta = (bounds.upper + bounds.lower) / two; // center
+    const ENTRY_T delta = (bounds.upper - bounds.lower) / two; // half width
+    const ENTRY_T sigma = theta / delta;
+    ENTRY_T rho = one / sigma;
+
+    // r = b - A * x, d = r / theta, x = x + d
+    if (zero_initial_guess) {
+        r.copy(b);
+    } else {
+        apply_matrix(r, x, transpose);
+        r.xpay(Scalar<ENTRY_T>{ctx, rt, -one}, b);
+    }
+    d.copy(r);
+    d.scal(Scalar<ENTRY_T>{ctx, rt, one / theta});
+    if (zero_initial_guess) {
+        x.copy(d);
+    } else {
+        x.axpy(Scalar<ENTRY_T>{ctx, rt, one}, d);
+    }
+
+    for (std::size_t k = 1; k < degree; ++k) {
+        apply_matrix(w, d, transpose);
+        const ENTRY_T rho_next = one / (two * sigma - rho);
+        Operations operations{ctx, rt};
+        operations.axpy(r, Scalar<ENTRY_T>{ctx, rt, -one}, w);
+        operations.scal(d, Scalar<ENTRY_T>{ctx, rt, rho_next * rho});
+        operations.axpy(d, Scalar<ENTRY_T>{ctx, rt, two * rho_next / delta}, r);
+        operations.axpy(x, Scalar<ENTRY_T>{ctx, rt, one}, d);
+        operations.execute();
+        rho = rho_next;
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    Vector output{ctx, rt, output_region, output_fid, partition};
+    const Vector input{ctx, rt, input_region, input_fid, partition};
+    iterate(output, input, true, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    Vector output{ctx, rt, output_region, output_fid, partition};
+    const Vector input{ctx, rt, input_region, input_fid, partition};
+    iterate(output, input, true, true);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>::smooth(
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid
+) const {
+    Vector solution{ctx, rt, solution_region, solution_fid, partition};
+    const Vector rhs{ctx, rt, rhs_region, rhs_fid, partition};
+    iterate(solution, rhs, false, false);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::ChebyshevPreconditioner<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::ChebyshevPreconditioner<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::ChebyshevPreconditioner<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,153 @@
+#ifndef LEGION_SOLVERS_CHEBYSHEV_PRECONDITIONER_HPP_INCLUDED
+#define LEGION_SOLVERS_CHEBYSHEV_PRECONDITIONER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+
+namespace LegionSolvers {
+
+
+// An interval [lower, upper] containing the spectrum of an operator.
+template <typename T>
+struct EigenvalueBounds {
+    T lower;
+    T upper;
+}; // struct EigenvalueBounds
+
+
+// A Chebyshev polynomial preconditioner and smoother for a linear operator A
+// whose spectrum is real and lies in the interval [lower, upper], with
+// 0 < lower < upper. Applying it runs degree steps of the Chebyshev
+// iteration for A * x = b on that interval (Saad, Algorithm 12.1), which
+// computes x = p(A) * b for the polynomial p of degree - 1 minimizing the
+// largest value of |1 - lambda * p(lambda)| on the interval. Each step is one
+// application of A followed by one fused launch of vector updates (see
+// FusedVectorOperations); the coefficients depend only on the bounds, so
+// applying the preconditioner needs no inner products and no reductions.
+// A is used only through its AbstractLinearOperator interface and may be
+// matrix-free.
+//
+// The bounds are supplied by the caller, typically from
+// estimate_eigenvalue_bounds, once, and then reused for any number of
+// preconditioners and solves. For symmetric positive definite A, p(A) is
+// symmetric positive definite (and usable with the CG solvers) if upper is
+// at least the largest eigenvalue of A; lower may overestimate the smallest
+// one. As a smoother, bounds such as [upper / 30, upper] damp the part of
+// the error in the upper part of the spectrum.
+//
+// Vectors are defined over the parent index space of partition, which is
+// both the domain and the range space of A; three scratch vectors are
+// allocated over it.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class ChebyshevPreconditioner : public AbstractLinearOperator<ENTRY_T> {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const Legion::IndexPartition partition;
+    const std::size_t degree;
+    const EigenvalueBounds<ENTRY_T> bounds;
+    mutable Vector r, d, w; // residual, update, and w = A * d
+
+    // Applies A (or A^T) to input.
+    void apply_matrix(Vector &output, const Vector &input, bool transpose)
+        const;
+
+    // Runs the Chebyshev iteration for A * x = b (or A^T * x = b) from x, or
+    // from zero if zero_initial_guess is set.
+    void iterate(
+        Vector &x, const Vector &b, bool zero_initial_guess, bool transpose
+    ) const;
+
+    // The partition of the dependencies of p(A), found by applying
+    // (domain_from_range ? domain_partition_from_range_partition
+    //                    : range_partition_from_domain_partition)
+    // of A degree - 1 times.
+    Legion::IndexPartition power_partition(
+        Legion::IndexSpace space,
+        Legion::IndexPartition source_partition,
+        bool domain_from_range
+    ) const;
+
+  public:
+
+    explicit ChebyshevPreconditioner(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::IndexPartition partition,
+        std::size_t degree,
+        const EigenvalueBounds<ENTRY_T> &bounds
+    );
+
+    ChebyshevPreconditioner(const ChebyshevPreconditioner &) = delete;
+
+    ChebyshevPreconditioner &
+    operator=(const ChebyshevPreconditioner &) = delete;
+
+    // Estimates the spectrum of a symmetric operator A from num_steps steps
+    // of the Lanczos process started at the vector in field start_fid of
+    // start_region, which should not be orthogonal to the extreme
+    // eigenvectors of A (a right-hand side usually serves). Returns the
+    // extreme eigenvalues of the Lanczos tridiagonal matrix, with the upper
+    // one enlarged by 10%, since these Ritz values lie inside the spectrum
+    // and approach its ends from within. Inner products are only read back
+    // after the last step, so the runtime blocks once.
+    static EigenvalueBounds<ENTRY_T> estimate_eigenvalue_bounds(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion start_region,
+        Legion::FieldID start_fid,
+        Legion::IndexPartition partition,
+        std::size_t num_steps
+    );
+
+    std::size_t get_degree() const { return degree; }
+
+    const EigenvalueBounds<ENTRY_T> &get_bounds() const { return bounds; }
+
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Computes output = p(A) * input.
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Computes output = p(A)^T * input = p(A^T) * input.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Smooths the solution of A * x = b in place: x = x + p(A) * (b - A * x).
+    void smooth(
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid
+    ) const;
+
+}; // class ChebyshevPreconditioner
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_CHEBYSHEV_PRECONDITIONER_HPP_INCLUDED
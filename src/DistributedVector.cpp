@@ -0,0 +1,415 @@
+#include "DistributedVector.hpp"
+
+#include <cassert> // for assert
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp"    // for create_field_space
+#include "LibraryOptions.hpp"     // for LEGION_SOLVERS_USE_*, ...
+#include "LinearAlgebraTasks.hpp" // for ScalTask, AxpyTask, XpayTask, ...
+#include "ScalarProgram.hpp"      // for ScalarProgram
+#include "TaskIDs.hpp"            // for LEGION_REDOP_SUM
+
+using LegionSolvers::AxpyConvertTask;
+using LegionSolvers::AxpyTask;
+using LegionSolvers::ConvertTask;
+using LegionSolvers::DistributedVector;
+using LegionSolvers::DotProductMode;
+using LegionSolvers::DotTask;
+using LegionSolvers::Scalar;
+using LegionSolvers::ScalTask;
+using LegionSolvers::ScalarProgram;
+using LegionSolvers::XpayTask;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+DistributedVector<ENTRY_T, DIM, COORD_T>::DistributedVector(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexPartition index_partition,
+    Legion::FieldID fid
+)
+    : ctx(ctx), rt(rt),
+      index_space(rt->get_parent_index_space(ctx, index_partition)), fid(fid),
+      field_space(LegionSolvers::create_field_space(
+          ctx, rt, {sizeof(ENTRY_T)}, {fid}
+      )),
+      logical_region(rt->create_logical_region(ctx, index_space, field_space)),
+      index_partition(index_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, index_partition)
+      ),
+      logical_partition(
+          rt->get_logical_partition(ctx, logical_region, index_partition)
+      ),
+      owns_region(true) {}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+DistributedVector<ENTRY_T, DIM, COORD_T>::DistributedVector(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::LogicalRegion logical_region,
+    Legion::FieldID fid,
+    Legion::IndexPartition index_partition
+)
+    : ctx(ctx), rt(rt), index_space(logical_region.get_index_space()),
+      fid(fid), field_space(logical_region.get_field_space()),
+      logical_region(logical_region), index_partition(index_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, index_partition)
+      ),
+      logical_partition(
+          rt->get_logical_partition(ctx, logical_region, index_partition)
+      ),
+      owns_region(false) {
+    assert(rt->get_parent_index_space(ctx, index_partition) == index_space);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+DistributedVector<ENTRY_T, DIM, COORD_T>::~DistributedVector() {
+    if (owns_region) {
+        rt->destroy_logical_region(ctx, logical_region);
+        rt->destroy_field_space(ctx, field_space);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::LogicalPartition
+DistributedVector<ENTRY_T, DIM, COORD_T>::get_aligned_partition(
+    const DistributedVector &x
+) const {
+    assert(x.index_space == index_space);
+    if (x.index_partition == index_partition) {
+        return x.logical_partition;
+    } else {
+        return rt->get_logical_partition(
+            ctx, x.logical_region, index_partition
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::constant_fill(ENTRY_T value) {
+    rt->fill_field<ENTRY_T>(ctx, logical_region, logical_region, fid, value);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::constant_fill(
+    const Scalar<ENTRY_T> &value
+) {
+    rt->fill_field(
+        ctx, logical_region, logical_region, fid, value.get_future()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::copy(
+    const DistributedVector &x
+) {
+    if (aliases(x)) { return; }
+    Legion::IndexCopyLauncher launcher{color_space};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_copy_requirements(
+        Legion::RegionRequirement{
+            get_aligned_partition(x),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.logical_region},
+        Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            logical_region}
+    );
+    launcher.add_src_field(0, x.fid);
+    launcher.add_dst_field(0, fid);
+    rt->issue_copy_operation(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::scal(
+    const Scalar<ENTRY_T> &alpha
+) {
+    std::vector<Legion::Future> futures;
+    const ScalarProgram<ENTRY_T> program = alpha.compile(futures);
+    Legion::IndexLauncher launcher{
+        ScalTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&program, sizeof(ScalarProgram<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_READ_WRITE,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::axpy(
+    const Scalar<ENTRY_T> &alpha, const DistributedVector &x
+) {
+    if (aliases(x)) {
+        scal(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(1)} + alpha);
+        return;
+    }
+    std::vector<Legion::Future> futures;
+    const ScalarProgram<ENTRY_T> program = alpha.compile(futures);
+    Legion::IndexLauncher launcher{
+        AxpyTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&program, sizeof(ScalarProgram<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_READ_WRITE,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            get_aligned_partition(x),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.logical_region})
+        .add_field(x.fid);
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::xpay(
+    const Scalar<ENTRY_T> &alpha, const DistributedVector &x
+) {
+    if (aliases(x)) {
+        scal(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(1)} + alpha);
+        return;
+    }
+    std::vector<Legion::Future> futures;
+    const ScalarProgram<ENTRY_T> program = alpha.compile(futures);
+    Legion::IndexLauncher launcher{
+        XpayTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&program, sizeof(ScalarProgram<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_READ_WRITE,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            get_aligned_partition(x),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.logical_region})
+        .add_field(x.fid);
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::convert(const OtherVector &x) {
+    assert(x.get_index_space() == index_space);
+    Legion::IndexLauncher launcher{
+        ConvertTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, x.get_logical_region(), index_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.get_logical_region()})
+        .add_field(x.get_fid());
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void DistributedVector<ENTRY_T, DIM, COORD_T>::axpy_convert(
+    const Scalar<ENTRY_T> &alpha, const OtherVector &x
+) {
+    assert(x.get_index_space() == index_space);
+    std::vector<Legion::Future> futures;
+    const ScalarProgram<ENTRY_T> program = alpha.compile(futures);
+    Legion::IndexLauncher launcher{
+        AxpyConvertTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&program, sizeof(ScalarProgram<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_READ_WRITE,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, x.get_logical_region(), index_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.get_logical_region()})
+        .add_field(x.get_fid());
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Scalar<ENTRY_T> DistributedVector<ENTRY_T, DIM, COORD_T>::dot(
+    const DistributedVector &x, DotProductMode mode
+) const {
+    Legion::IndexLauncher launcher{
+        DotTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&mode, sizeof(DotProductMode)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            logical_region})
+        .add_field(fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            get_aligned_partition(x),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.logical_region})
+        .add_field(x.fid);
+    return Scalar<ENTRY_T>{
+        ctx,
+        rt,
+        rt->execute_index_space(ctx, launcher, LEGION_REDOP_SUM<ENTRY_T>)};
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::DistributedVector<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::DistributedVector<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::DistributedVector<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
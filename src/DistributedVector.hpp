@@ -0,0 +1,128 @@
+#ifndef LEGION_SOLVERS_DISTRIBUTED_VECTOR_HPP_INCLUDED
+#define LEGION_SOLVERS_DISTRIBUTED_VECTOR_HPP_INCLUDED
+
+#include <legion.h> // for Legion::*
+
+#include "MetaprogrammingUtilities.hpp" // for OtherPrecision
+#include "Scalar.hpp"                   // for Scalar
+#include "VectorKernels.hpp"            // for DotProductMode
+
+namespace LegionSolvers {
+
+
+// A vector stored in a single field of a logical region, over an index space
+// that is divided into pieces by an application-supplied index partition.
+// The region is either created and owned by the vector, or supplied by the
+// application, in which case the vector operates on it in place. Each
+// vector operation is issued as one index launch over the color space of
+// that partition, so the top-level task never launches per-piece tasks.
+// Operations on two vectors require both to be defined over the same index
+// space; the partition of *this is used for both operands.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class DistributedVector {
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::IndexSpace index_space;
+    const Legion::FieldID fid;
+    const Legion::FieldSpace field_space;
+    const Legion::LogicalRegion logical_region;
+    const Legion::IndexPartition index_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::LogicalPartition logical_partition;
+    const bool owns_region;
+
+  public:
+
+    // A vector of the other entry type (see OtherPrecision), such as the
+    // single-precision copy of a double-precision vector.
+    using OtherVector = DistributedVector<
+        typename OtherPrecision<ENTRY_T>::type,
+        DIM,
+        COORD_T>;
+
+    static constexpr Legion::FieldID DEFAULT_FID = 0;
+
+    explicit DistributedVector(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::IndexPartition index_partition,
+        Legion::FieldID fid = DEFAULT_FID
+    );
+
+    // Wraps field fid of an existing region over the parent index space of
+    // index_partition, which remains owned by the caller.
+    explicit DistributedVector(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::LogicalRegion logical_region,
+        Legion::FieldID fid,
+        Legion::IndexPartition index_partition
+    );
+
+    DistributedVector(const DistributedVector &) = delete;
+
+    DistributedVector &operator=(const DistributedVector &) = delete;
+
+    ~DistributedVector();
+
+    Legion::IndexSpace get_index_space() const { return index_space; }
+
+    Legion::FieldID get_fid() const { return fid; }
+
+    Legion::LogicalRegion get_logical_region() const { return logical_region; }
+
+    Legion::IndexPartition get_index_partition() const {
+        return index_partition;
+    }
+
+    Legion::IndexSpace get_color_space() const { return color_space; }
+
+    Legion::LogicalPartition get_logical_partition() const {
+        return logical_partition;
+    }
+
+    // Logical partition of x's region by the index partition of *this.
+    Legion::LogicalPartition
+    get_aligned_partition(const DistributedVector &x) const;
+
+    // Whether x is the same field of the same region as *this. Operations
+    // with such an x are rewritten so that no launch names the field twice
+    // with interfering privileges.
+    bool aliases(const DistributedVector &x) const {
+        return (x.logical_region == logical_region) && (x.fid == fid);
+    }
+
+    void constant_fill(ENTRY_T value);
+
+    void constant_fill(const Scalar<ENTRY_T> &value);
+
+    // *this = x; a no-op if x aliases *this
+    void copy(const DistributedVector &x);
+
+    // *this = alpha * *this
+    void scal(const Scalar<ENTRY_T> &alpha);
+
+    // *this = alpha * x + *this; scal(1 + alpha) if x aliases *this
+    void axpy(const Scalar<ENTRY_T> &alpha, const DistributedVector &x);
+
+    // *this = x + alpha * *this; scal(1 + alpha) if x aliases *this
+    void xpay(const Scalar<ENTRY_T> &alpha, const DistributedVector &x);
+
+    // *this = x, converted to ENTRY_T
+    void convert(const OtherVector &x);
+
+    // *this = alpha * x + *this, with x converted to ENTRY_T
+    void axpy_convert(const Scalar<ENTRY_T> &alpha, const OtherVector &x);
+
+    Scalar<ENTRY_T> dot(
+        const DistributedVector &x,
+        DotProductMode mode = DotProductMode::BLOCKED
+    ) const;
+
+}; // class DistributedVector
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_DISTRIBUTED_VECTOR_HPP_INCLUDED
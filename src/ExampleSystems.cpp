@@ -0,0 +1,253 @@
+#include "ExampleSystems.hpp"
+
+#include <cassert> // for assert
+#include <string>  // for std::string
+
+#include "LegionUtilities.hpp"          // for AffineWriter, preregister_task
+#include "MetaprogrammingUtilities.hpp" // for ToString
+
+using LegionSolvers::AffineWriter;
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_CONVECTION_ENTRY;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROW;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_GRID_MATRICES_TASK_ID;
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+using LegionSolvers::FILL_LAPLACIAN_1D_TASK_ID;
+using LegionSolvers::FILL_PERIODIC_VECTOR_TASK_ID;
+using LegionSolvers::TaskFlags;
+using LegionSolvers::ToString;
+
+
+template <typename ENTRY_T, typename COORD_T>
+void LegionSolvers::fill_laplacian_1d_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Point = Legion::Point<1, COORD_T>;
+    using Rect = Legion::Rect<1, COORD_T>;
+
+    assert(!regions.empty());
+    assert(task->regions.size() == regions.size());
+    const std::size_t last = regions.size() - 1;
+    const Legion::FieldID x_fid =
+        *task->regions[last].privilege_fields.begin();
+    AffineWriter<ENTRY_T, 1, COORD_T> x_writer{regions[last], x_fid};
+    const Rect rows = rt->get_index_space_domain(
+        ctx, task->regions[last].region.get_index_space()
+    );
+    const COORD_T n = rows.hi[0] + 1;
+    for (COORD_T i = 0; i < n; ++i) {
+        x_writer[Point{i}] = static_cast<ENTRY_T>(i);
+    }
+
+    // Row i holds columns max(i - 1, 0) through min(i + 1, n - 1).
+    const auto for_each_nonzero = [n](const auto &f) {
+        COORD_T k = 0;
+        for (COORD_T i = 0; i < n; ++i) {
+            const COORD_T first = k;
+            for (COORD_T j = (i > 0) ? i - 1 : 0; (j <= i + 1) && (j < n);
+                 ++j) {
+                f(i, j, k, first);
+                ++k;
+            }
+        }
+        assert(k == 3 * n - 2);
+    };
+
+    for (std::size_t r = 0; r < last; ++r) {
+        const Legion::FieldID fid = *task->regions[r].privilege_fields.begin();
+        if (fid == FID_ROWPTR) {
+            AffineWriter<Rect, 1, COORD_T> rowptr_writer{regions[r], fid};
+            for_each_nonzero(
+                [&](COORD_T i, COORD_T, COORD_T k, COORD_T first) {
+                    rowptr_writer[Point{i}] = Rect{first, k};
+                }
+            );
+        } else if (fid == FID_ROW) {
+            AffineWriter<Point, 1, COORD_T> row_writer{regions[r], fid};
+            for_each_nonzero([&](COORD_T i, COORD_T, COORD_T k, COORD_T) {
+                row_writer[Point{k}] = Point{i};
+            });
+        } else if (fid == FID_COL) {
+            AffineWriter<Point, 1, COORD_T> col_writer{regions[r], fid};
+            for_each_nonzero([&](COORD_T, COORD_T j, COORD_T k, COORD_T) {
+                col_writer[Point{k}] = Point{j};
+            });
+        } else {
+            assert(fid == FID_ENTRY);
+            AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[r], fid};
+            for_each_nonzero([&](COORD_T i, COORD_T j, COORD_T k, COORD_T) {
+                entry_writer[Point{k}] =
+                    static_cast<ENTRY_T>((i == j) ? 2 : -1);
+            });
+        }
+    }
+}
+
+
+void LegionSolvers::fill_grid_matrices_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context,
+    Legion::Runtime *
+) {
+    using Point = Legion::Point<2, int>;
+    using KernelPoint = Legion::Point<1, int>;
+
+    assert(task->regions.size() == regions.size());
+    assert(task->arglen == sizeof(int));
+    const int n = *static_cast<const int *>(task->args);
+
+    // Row (i, j) holds its diagonal entry, then its -e_0, +e_0, -e_1, and
+    // +e_1 neighbours inside the grid; f(row, column, k, first, laplacian,
+    // convection) is called on nonzero k, with first the first of its row.
+    const auto for_each_nonzero = [n](const auto &f) {
+        int k = 0;
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                const Point row{i, j};
+                const int first = k;
+                f(row, row, k++, first, 4.0, 4.75);
+                if (i > 0) { f(row, Point{i - 1, j}, k++, first, -1.0, -1.5); }
+                if (i + 1 < n) {
+                    f(row, Point{i + 1, j}, k++, first, -1.0, -1.0);
+                }
+                if (j > 0) { f(row, Point{i, j - 1}, k++, first, -1.0, -1.25); }
+                if (j + 1 < n) {
+                    f(row, Point{i, j + 1}, k++, first, -1.0, -1.0);
+                }
+            }
+        }
+        assert(k == 5 * n * n - 4 * n);
+    };
+
+    for (std::size_t r = 0; r < regions.size(); ++r) {
+        const Legion::FieldID fid = *task->regions[r].privilege_fields.begin();
+        if (fid == FID_ROWPTR) {
+            AffineWriter<Legion::Rect<1, int>, 2, int> rowptr_writer{
+                regions[r], fid};
+            // The last nonzero of a row closes its range.
+            for_each_nonzero(
+                [&](Point row, Point, int k, int first, double, double) {
+                    rowptr_writer[row] = Legion::Rect<1, int>{first, k};
+                }
+            );
+        } else if (fid == FID_COL) {
+            AffineWriter<Point, 1, int> col_writer{regions[r], fid};
+            for_each_nonzero(
+                [&](Point, Point column, int k, int, double, double) {
+                    col_writer[KernelPoint{k}] = column;
+                }
+            );
+        } else if (fid == FID_ENTRY) {
+            AffineWriter<double, 1, int> entry_writer{regions[r], fid};
+            for_each_nonzero(
+                [&](Point, Point, int k, int, double laplacian, double) {
+                    entry_writer[KernelPoint{k}] = laplacian;
+                }
+            );
+        } else {
+            assert(fid == FID_CONVECTION_ENTRY);
+            AffineWriter<double, 1, int> entry_writer{regions[r], fid};
+            for_each_nonzero(
+                [&](Point, Point, int k, int, double, double convection) {
+                    entry_writer[KernelPoint{k}] = convection;
+                }
+            );
+        }
+    }
+}
+
+
+void LegionSolvers::fill_grid_vector_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 1);
+    assert(task->regions.size() == 1);
+    const Legion::FieldID x_fid = *task->regions[0].privilege_fields.begin();
+    AffineWriter<double, 2, int> x_writer{regions[0], x_fid};
+
+    const Legion::Rect<2, int> grid = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    const int n = grid.hi[0] + 1;
+    for (Legion::PointInRectIterator<2, int> iter{grid}; iter(); ++iter) {
+        const Legion::Point<2, int> point = *iter;
+        x_writer[point] = static_cast<double>(point[0] + n * point[1]);
+    }
+}
+
+
+void LegionSolvers::fill_periodic_vector_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 1);
+    assert(task->regions.size() == 1);
+    const Legion::FieldID fid = *task->regions[0].privilege_fields.begin();
+    AffineWriter<double, 1, int> x_writer{regions[0], fid};
+    const Legion::Domain domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    for (Legion::PointInDomainIterator<1, int> i(domain); i(); ++i) {
+        x_writer[*i] = periodic_entry((*i)[0]);
+    }
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+void preregister_fill_laplacian_1d_task(bool verbose) {
+    LegionSolvers::preregister_task<
+        LegionSolvers::fill_laplacian_1d_task<ENTRY_T, COORD_T>>(
+        FILL_LAPLACIAN_1D_TASK_ID<ENTRY_T, COORD_T>,
+        "fill_laplacian_1d_" + ToString<ENTRY_T>::value() + "_" +
+            ToString<COORD_T>::value(),
+        TaskFlags::LEAF,
+        verbose
+    );
+}
+
+
+void LegionSolvers::preregister_example_system_tasks(bool verbose) {
+    preregister_fill_laplacian_1d_task<float, int>(verbose);
+    preregister_fill_laplacian_1d_task<float, unsigned>(verbose);
+    preregister_fill_laplacian_1d_task<double, long long>(verbose);
+    LegionSolvers::preregister_task<LegionSolvers::fill_grid_matrices_task>(
+        FILL_GRID_MATRICES_TASK_ID,
+        "fill_grid_matrices",
+        TaskFlags::LEAF,
+        verbose
+    );
+    LegionSolvers::preregister_task<LegionSolvers::fill_grid_vector_task>(
+        FILL_GRID_VECTOR_TASK_ID, "fill_grid_vector", TaskFlags::LEAF, verbose
+    );
+    LegionSolvers::preregister_task<LegionSolvers::fill_periodic_vector_task>(
+        FILL_PERIODIC_VECTOR_TASK_ID,
+        "fill_periodic_vector",
+        TaskFlags::LEAF,
+        verbose
+    );
+}
+
+
+std::size_t LegionSolvers::subspace_volume(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexPartition partition,
+    const Legion::DomainPoint &color
+) {
+    return rt
+        ->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, partition, color)
+        )
+        .get_volume();
+}
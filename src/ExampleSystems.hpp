@@ -0,0 +1,136 @@
+#ifndef LEGION_SOLVERS_EXAMPLE_SYSTEMS_HPP_INCLUDED
+#define LEGION_SOLVERS_EXAMPLE_SYSTEMS_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+namespace LegionSolvers {
+
+
+// Fixtures shared by the test programs.
+
+
+// Field IDs of the arrays written by fill_laplacian_1d_task and
+// fill_grid_matrices_task.
+enum ExampleSystemFieldID : Legion::FieldID {
+    FID_ROW,
+    FID_COL,
+    FID_ENTRY,
+    FID_ROWPTR,
+    FID_CONVECTION_ENTRY,
+}; // enum ExampleSystemFieldID
+
+
+// Task IDs of the fixtures, above those of the tasks of the test programs.
+constexpr Legion::TaskID EXAMPLE_SYSTEM_TASK_ID_ORIGIN = 1'000;
+
+template <typename ENTRY_T, typename COORD_T>
+constexpr Legion::TaskID FILL_LAPLACIAN_1D_TASK_ID =
+    static_cast<Legion::TaskID>(-1);
+template <>
+constexpr Legion::TaskID FILL_LAPLACIAN_1D_TASK_ID<float, int> =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN;
+template <>
+constexpr Legion::TaskID FILL_LAPLACIAN_1D_TASK_ID<float, unsigned> =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN + 1;
+template <>
+constexpr Legion::TaskID FILL_LAPLACIAN_1D_TASK_ID<double, long long> =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN + 2;
+
+constexpr Legion::TaskID FILL_GRID_MATRICES_TASK_ID =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN + 3;
+constexpr Legion::TaskID FILL_GRID_VECTOR_TASK_ID =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN + 4;
+constexpr Legion::TaskID FILL_PERIODIC_VECTOR_TASK_ID =
+    EXAMPLE_SYSTEM_TASK_ID_ORIGIN + 5;
+
+
+// Writes the n-by-n matrix tridiag(-1, 2, -1), with 3n - 2 nonzeros in
+// row-major order, and the vector x[i] = i. Regions are any of the arrays
+// of the matrix in CSR and row-sorted COO form (row pointers, row indices,
+// column indices, and entries, each identified by its ExampleSystemFieldID)
+// followed by x, all write-discard; n is the size of x.
+template <typename ENTRY_T, typename COORD_T>
+void fill_laplacian_1d_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+
+
+// Writes, in CSR form over an n-by-n grid with double entries and int
+// coordinates, the 5-point Laplacian (entries 4 and -1) and the
+// convection-diffusion operator of Test11StencilSolveBiCGStab (entries 4.75
+// at the center and -1.5, -1.0, -1.25, and -1.0 at the -e_0, +e_0, -e_1,
+// and +e_1 neighbours), which share their row pointers and column indices,
+// with 5n^2 - 4n nonzeros in row-major order. Regions are any of the row
+// pointers, column indices, Laplacian entries (FID_ENTRY), and
+// convection-diffusion entries, each identified by its ExampleSystemFieldID,
+// all write-discard; the task argument is n, as an int.
+void fill_grid_matrices_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+
+
+// Writes x[i, j] = i + n * j, as a double, on an n-by-n grid with int
+// coordinates. The only region is x, write-discard.
+void fill_grid_vector_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+
+
+// Entry i of the vector written by fill_periodic_vector_task: an integer
+// from -3 to 3, of period 7 in i, so that its products with matrices of
+// small dyadic entries are exact.
+inline double periodic_entry(int i) {
+    return static_cast<double>(i % 7 - 3);
+}
+
+
+// Writes x[i] = periodic_entry(i), as a double, with int coordinates.
+// The only region is x, write-discard.
+void fill_periodic_vector_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+
+
+// Registers the tasks above under their task IDs, fill_laplacian_1d_task for
+// every pair of types it is defined for. Must be called before the runtime
+// starts.
+void preregister_example_system_tasks(bool verbose = true);
+
+
+// Volume of the subspace of the given color of partition.
+std::size_t subspace_volume(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexPartition partition,
+    const Legion::DomainPoint &color
+);
+
+
+inline std::size_t subspace_volume(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexPartition partition,
+    long long color
+) {
+    return subspace_volume(ctx, rt, partition, Legion::DomainPoint{color});
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_EXAMPLE_SYSTEMS_HPP_INCLUDED
@@ -0,0 +1,257 @@
+#include "FusedVectorOperations.hpp"
+
+#include <algorithm> // for std::find_if
+#include <cassert>   // for assert
+#include <cstring>   // for std::memcpy
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+#include "TaskIDs.hpp"        // for PACKED_SUM_REDOP_ID
+
+using LegionSolvers::FusedVectorOperations;
+using LegionSolvers::MultiUpdateDotTask;
+using LegionSolvers::Scalar;
+using LegionSolvers::ScalarInstruction;
+using LegionSolvers::ScalarProgram;
+using LegionSolvers::VectorUpdateKind;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+FusedVectorOperations<ENTRY_T, DIM, COORD_T>::FusedVectorOperations(
+    Legion::Context ctx, Legion::Runtime *rt, DotProductMode mode
+)
+    : ctx(ctx), rt(rt), args{} {
+    args.mode = mode;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint32_t FusedVectorOperations<ENTRY_T, DIM, COORD_T>::vector_index(
+    const Vector &x, bool write
+) {
+    // Distinct Vector objects may view the same field of the same region;
+    // they must share one region requirement, with merged privileges.
+    const auto iter = std::find_if(
+        vectors.begin(),
+        vectors.end(),
+        [&x](const Vector *v) {
+            return (v->get_logical_region() == x.get_logical_region()) &&
+                   (v->get_fid() == x.get_fid());
+        }
+    );
+    const std::uint32_t index =
+        static_cast<std::uint32_t>(iter - vectors.begin());
+    if (iter == vectors.end()) {
+        assert(
+            vectors.empty() ||
+            (x.get_index_space() == vectors[0]->get_index_space())
+        );
+        vectors.push_back(&x);
+        written.push_back(write);
+    } else if (write) {
+        written[index] = true;
+    }
+    return index;
+}
+
+
+template <typename T>
+bool same_program(const ScalarProgram<T> &lhs, const ScalarProgram<T> &rhs) {
+    if (lhs.num_instructions != rhs.num_instructions) { return false; }
+    for (std::uint32_t i = 0; i < lhs.num_instructions; ++i) {
+        const ScalarInstruction &a = lhs.instructions[i];
+        const ScalarInstruction &b = rhs.instructions[i];
+        if ((a.opcode != b.opcode) || (a.component != b.component) ||
+            (a.operand != b.operand) ||
+            !(lhs.constants[i] == rhs.constants[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint32_t FusedVectorOperations<ENTRY_T, DIM, COORD_T>::coefficient(
+    const Scalar<ENTRY_T> &alpha
+) {
+    // Programs index the futures shared by the whole launch, so equal
+    // expressions compile to equal programs.
+    const ScalarProgram<ENTRY_T> program = alpha.compile(futures);
+    std::uint32_t index = 0;
+    while ((index < coefficients.size()) &&
+           !same_program(coefficients[index], program)) {
+        ++index;
+    }
+    if (index == coefficients.size()) {
+        coefficients.push_back(program);
+        args.num_coefficients = index + 1;
+    }
+    return index;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void FusedVectorOperations<ENTRY_T, DIM, COORD_T>::update(
+    VectorUpdateKind kind,
+    Vector &target,
+    const Vector &source,
+    const Scalar<ENTRY_T> &alpha
+) {
+    assert(args.num_dot_products == 0); // updates precede dot products
+    assert(args.num_updates < LEGION_SOLVERS_MAX_FUSED_UPDATES);
+    VectorUpdate &result = args.updates[args.num_updates++];
+    result.kind = kind;
+    result.target = vector_index(target, true);
+    result.source = vector_index(source, false);
+    result.alpha = coefficient(alpha);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void FusedVectorOperations<ENTRY_T, DIM, COORD_T>::scal(
+    Vector &x, const Scalar<ENTRY_T> &alpha
+) {
+    update(VectorUpdateKind::SCAL, x, x, alpha);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void FusedVectorOperations<ENTRY_T, DIM, COORD_T>::axpy(
+    Vector &y, const Scalar<ENTRY_T> &alpha, const Vector &x
+) {
+    update(VectorUpdateKind::AXPY, y, x, alpha);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void FusedVectorOperations<ENTRY_T, DIM, COORD_T>::xpay(
+    Vector &y, const Scalar<ENTRY_T> &alpha, const Vector &x
+) {
+    update(VectorUpdateKind::XPAY, y, x, alpha);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint32_t FusedVectorOperations<ENTRY_T, DIM, COORD_T>::dot(
+    const Vector &x, const Vector &y
+) {
+    assert(args.num_dot_products < LEGION_SOLVERS_MAX_PACKED_SCALARS);
+    VectorDotProduct &result = args.dot_products[args.num_dot_products];
+    result.lhs = vector_index(x, false);
+    result.rhs = vector_index(y, false);
+    return args.num_dot_products++;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future FusedVectorOperations<ENTRY_T, DIM, COORD_T>::execute() const {
+    assert(!vectors.empty());
+    const Vector &first = *vectors[0];
+    std::vector<char> buffer(
+        sizeof(MultiUpdateDotArgs) +
+        coefficients.size() * sizeof(ScalarProgram<ENTRY_T>)
+    );
+    std::memcpy(buffer.data(), &args, sizeof(MultiUpdateDotArgs));
+    std::memcpy(
+        buffer.data() + sizeof(MultiUpdateDotArgs),
+        coefficients.data(),
+        coefficients.size() * sizeof(ScalarProgram<ENTRY_T>)
+    );
+
+    Legion::IndexLauncher launcher{
+        MultiUpdateDotTask<ENTRY_T, DIM, COORD_T>::task_id,
+        first.get_color_space(),
+        Legion::TaskArgument{buffer.data(), buffer.size()},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                first.get_aligned_partition(*vectors[i]),
+                0,
+                written[i] ? LEGION_READ_WRITE : LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                vectors[i]->get_logical_region()})
+            .add_field(vectors[i]->get_fid());
+    }
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    return rt->execute_index_space(
+        ctx, launcher, PACKED_SUM_REDOP_ID<ENTRY_T>
+    );
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::FusedVectorOperations<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::FusedVectorOperations<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::FusedVectorOperations<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,85 @@
+#ifndef LEGION_SOLVERS_FUSED_VECTOR_OPERATIONS_HPP_INCLUDED
+#define LEGION_SOLVERS_FUSED_VECTOR_OPERATIONS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"  // for DistributedVector
+#include "LinearAlgebraTasks.hpp" // for MultiUpdateDotArgs
+#include "Scalar.hpp"             // for Scalar
+#include "ScalarProgram.hpp"      // for ScalarProgram
+#include "VectorKernels.hpp"      // for DotProductMode
+
+namespace LegionSolvers {
+
+
+// Records a sequence of vector updates followed by dot products of the
+// updated vectors, and issues all of them as a single MultiUpdateDotTask
+// index launch, so that every vector involved is streamed through memory
+// once and all dot products share one reduction. Updates are applied in the
+// order in which they are recorded. All vectors must be defined over the
+// same index space; the launch uses the partition of the first vector
+// recorded. Coefficients are compiled into ScalarPrograms when they are
+// recorded and evaluated by the task itself, without launching tasks of
+// their own (see Scalar::compile).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class FusedVectorOperations {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    MultiUpdateDotArgs args;
+    std::vector<const Vector *> vectors;
+    std::vector<bool> written;
+    std::vector<ScalarProgram<ENTRY_T>> coefficients;
+    std::vector<Legion::Future> futures;
+
+    // Region requirement index of the field of x, which is added if
+    // necessary, and made read-write if write is set.
+    std::uint32_t vector_index(const Vector &x, bool write);
+
+    // Index of the program of alpha, which is compiled and added if
+    // necessary.
+    std::uint32_t coefficient(const Scalar<ENTRY_T> &alpha);
+
+    void update(
+        VectorUpdateKind kind,
+        Vector &target,
+        const Vector &source,
+        const Scalar<ENTRY_T> &alpha
+    );
+
+  public:
+
+    explicit FusedVectorOperations(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        DotProductMode mode = DotProductMode::BLOCKED
+    );
+
+    // x = alpha * x
+    void scal(Vector &x, const Scalar<ENTRY_T> &alpha);
+
+    // y = alpha * x + y
+    void axpy(Vector &y, const Scalar<ENTRY_T> &alpha, const Vector &x);
+
+    // y = x + alpha * y
+    void xpay(Vector &y, const Scalar<ENTRY_T> &alpha, const Vector &x);
+
+    // Records dot(x, y) of the updated vectors and returns its component
+    // index in the future returned by execute().
+    std::uint32_t dot(const Vector &x, const Vector &y);
+
+    // Issues the recorded operations and returns their dot products as a
+    // PackedScalars<ENTRY_T> future (see Scalar::packed).
+    Legion::Future execute() const;
+
+}; // class FusedVectorOperations
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_FUSED_VECTOR_OPERATIONS_HPP_INCLUDED
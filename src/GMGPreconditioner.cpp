@@ -0,0 +1,720 @@
+#include "GMGPreconditioner.hpp"
+
+#include <algorithm> // for std::clamp, std::max, std::min
+#include <cassert>   // for assert
+#include <cmath>     // for std::abs
+#include <cstddef>   // for std::size_t
+#include <iostream>  // for std::cout, std::endl
+#include <map>       // for std::map
+#include <utility>   // for std::move
+#include <vector>    // for std::vector
+
+#include "GMGPreconditionerTasks.hpp" // for GMGRestrictTask, GMGProlongTask
+#include "LibraryOptions.hpp"         // for LEGION_SOLVERS_USE_*, ...
+#include "Scalar.hpp"                 // for Scalar
+#include "StencilOperatorTasks.hpp"   // for StencilArgs, stencil_offset
+
+using LegionSolvers::EigenvalueBounds;
+using LegionSolvers::GMGPreconditioner;
+using LegionSolvers::GMGProlongTask;
+using LegionSolvers::GMGRestrictTask;
+using LegionSolvers::Scalar;
+using LegionSolvers::StencilArgs;
+using LegionSolvers::StencilShape;
+using LegionSolvers::stencil_offset;
+using LegionSolvers::stencil_size;
+
+
+// Weight of fine offset v (relative to a coarse point) in the prolongation.
+template <typename ENTRY_T, int DIM>
+inline ENTRY_T gmg_weight(const int (&v)[DIM]) {
+    ENTRY_T result = static_cast<ENTRY_T>(1);
+    for (int d = 0; d < DIM; ++d) {
+        if ((v[d] < -1) || (v[d] > 1)) { return static_cast<ENTRY_T>(0); }
+        if (v[d] != 0) { result /= static_cast<ENTRY_T>(2); }
+    }
+    return result;
+}
+
+
+// The BOX stencil of P^T * A * P for the constant stencil A of args (see
+// GMGRestrictTask for P). Coarse point offset O collects, over the fine
+// points u of the support of a coarse point and the points s of A, the
+// weight of u times a_s times the weight of u + offset_s - 2 * O.
+template <typename ENTRY_T, int DIM>
+inline std::vector<ENTRY_T>
+gmg_galerkin_coefficients(const StencilArgs<ENTRY_T> &args) {
+    const int num_points = stencil_size(args.shape, DIM);
+    const int num_box_points = stencil_size(StencilShape::BOX, DIM);
+    std::vector<ENTRY_T> result(
+        static_cast<std::size_t>(num_box_points), static_cast<ENTRY_T>(0)
+    );
+    for (int o = 0; o < num_box_points; ++o) {
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        for (int t = 0; t < num_box_points; ++t) {
+            int u[DIM];
+            for (int d = 0; d < DIM; ++d) {
+                u[d] = stencil_offset(StencilShape::BOX, t, d);
+            }
+            const ENTRY_T u_weight = gmg_weight<ENTRY_T, DIM>(u);
+            for (int s = 0; s < num_points; ++s) {
+                int v[DIM];
+                for (int d = 0; d < DIM; ++d) {
+                    v[d] = u[d] + stencil_offset(args.shape, s, d) -
+                           2 * stencil_offset(StencilShape::BOX, o, d);
+                }
+                sum += u_weight * args.coefficients[s] *
+                       gmg_weight<ENTRY_T, DIM>(v);
+            }
+        }
+        result[static_cast<std::size_t>(o)] = sum;
+    }
+    return result;
+}
+
+
+// The sum of the magnitudes of the coefficients of a constant stencil,
+// which bounds the spectrum of the operator (Gershgorin).
+template <typename ENTRY_T, int DIM>
+inline ENTRY_T gmg_spectral_bound(const StencilArgs<ENTRY_T> &args) {
+    ENTRY_T result = static_cast<ENTRY_T>(0);
+    for (int s = 0; s < stencil_size(args.shape, DIM); ++s) {
+        result += std::abs(args.coefficients[s]);
+    }
+    return result;
+}
+
+
+// A rect with no points.
+template <int DIM, typename COORD_T>
+inline Legion::Rect<DIM, COORD_T> gmg_empty_rect() {
+    Legion::Rect<DIM, COORD_T> result;
+    for (int d = 0; d < DIM; ++d) {
+        result.lo[d] = static_cast<COORD_T>(1);
+        result.hi[d] = static_cast<COORD_T>(0);
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+GMGPreconditioner<ENTRY_T, DIM, COORD_T>::GMGPreconditioner(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const StencilOperator<ENTRY_T, DIM, COORD_T> &matrix,
+    const GMGOptions &options,
+    bool verbose
+)
+    : ctx(ctx), rt(rt), options(options) {
+    assert(!matrix.get_stencil_args().variable);
+    assert(options.max_levels > 0);
+    assert(options.min_points_per_piece > 0);
+    assert(options.smoother_degree > 0);
+    assert(options.coarse_degree > 0);
+
+    auto finest = std::make_unique<Level>();
+    finest->space = matrix.get_grid_space();
+    finest->partition = matrix.get_range_partition();
+    finest->color_space =
+        rt->get_index_partition_color_space_name(ctx, finest->partition);
+    finest->owns_space = false;
+    finest->owns_color_space = false;
+    finest->op = &matrix;
+    finest->restrict_partition = Legion::IndexPartition::NO_PART;
+    finest->prolong_partition = Legion::IndexPartition::NO_PART;
+    assert(rt->is_index_partition_disjoint(ctx, finest->partition));
+    levels.push_back(std::move(finest));
+
+    while (levels.size() < options.max_levels) {
+        const Legion::Domain grid =
+            rt->get_index_space_domain(ctx, levels.back()->space);
+        if (grid.get_volume() <= options.max_coarse_size) { break; }
+        const Legion::Rect<DIM, COORD_T> rect = grid.bounds<DIM, COORD_T>();
+        bool coarsenable = true;
+        for (int d = 0; d < DIM; ++d) {
+            if (static_cast<long long>(rect.hi[d]) -
+                    static_cast<long long>(rect.lo[d]) <
+                2) {
+                coarsenable = false;
+            }
+        }
+        if (!coarsenable) { break; }
+        coarsen();
+    }
+
+    for (std::size_t k = 0; k < levels.size(); ++k) {
+        Level &level = *levels[k];
+        if (k > 0) {
+            level.rhs = std::make_unique<Vector>(ctx, rt, level.partition);
+            level.solution =
+                std::make_unique<Vector>(ctx, rt, level.partition);
+        }
+        if (k + 1 < levels.size()) {
+            const ENTRY_T rho = gmg_spectral_bound<ENTRY_T, DIM>(
+                level.op->get_stencil_args()
+            );
+            level.smoother = std::make_unique<Smoother>(
+                ctx,
+                rt,
+                *level.op,
+                level.partition,
+                options.smoother_degree,
+                EigenvalueBounds<ENTRY_T>{rho / static_cast<ENTRY_T>(30), rho}
+            );
+            level.residual =
+                std::make_unique<Vector>(ctx, rt, level.partition);
+            level.correction =
+                std::make_unique<Vector>(ctx, rt, level.partition);
+        } else {
+            Vector start{ctx, rt, level.partition};
+            start.constant_fill(static_cast<ENTRY_T>(1));
+            level.smoother = std::make_unique<Smoother>(
+                ctx,
+                rt,
+                *level.op,
+                level.partition,
+                options.coarse_degree,
+                Smoother::estimate_eigenvalue_bounds(
+                    ctx,
+                    rt,
+                    *level.op,
+                    start.get_logical_region(),
+                    start.get_fid(),
+                    level.partition,
+                    20
+                )
+            );
+        }
+    }
+
+    if (verbose) {
+        std::cout << "[LegionSolvers] GMG setup: " << levels.size()
+                  << " levels." << std::endl;
+        for (std::size_t k = 0; k < levels.size(); ++k) {
+            const Level &level = *levels[k];
+            std::cout
+                << "[LegionSolvers]   level " << k << ": "
+                << rt->get_index_space_domain(ctx, level.space).get_volume()
+                << " points, "
+                << rt->get_index_space_domain(ctx, level.color_space)
+                       .get_volume()
+                << " pieces, " << level.op->get_num_points()
+                << "-point stencil." << std::endl;
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+GMGPreconditioner<ENTRY_T, DIM, COORD_T>::~GMGPreconditioner() {
+    // Operators and vectors first, since they hold partitions of the grids.
+    for (const auto &level : levels) {
+        level->smoother.reset();
+        level->owned_op.reset();
+        level->rhs.reset();
+        level->solution.reset();
+        level->residual.reset();
+        level->correction.reset();
+    }
+    for (const auto &level : levels) {
+        if (level->restrict_partition != Legion::IndexPartition::NO_PART) {
+            rt->destroy_index_partition(ctx, level->restrict_partition);
+        }
+        if (level->prolong_partition != Legion::IndexPartition::NO_PART) {
+            rt->destroy_index_partition(ctx, level->prolong_partition);
+        }
+    }
+    for (const auto &level : levels) {
+        if (level->owns_space) {
+            rt->destroy_index_partition(ctx, level->partition);
+            rt->destroy_index_space(ctx, level->space);
+        }
+        if (level->owns_color_space) {
+            rt->destroy_index_space(ctx, level->color_space);
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::coarsen() {
+    using Rect = Legion::Rect<DIM, COORD_T>;
+
+    Level &fine = *levels.back();
+    const Rect fine_grid = rt->get_index_space_domain(ctx, fine.space)
+                               .template bounds<DIM, COORD_T>();
+    long long extents[DIM];
+    Rect coarse_grid;
+    for (int d = 0; d < DIM; ++d) {
+        const long long n = static_cast<long long>(fine_grid.hi[d]) -
+                            static_cast<long long>(fine_grid.lo[d]) + 1;
+        extents[d] = (n - 1) / 2;
+        coarse_grid.lo[d] = static_cast<COORD_T>(0);
+        coarse_grid.hi[d] = static_cast<COORD_T>(extents[d] - 1);
+    }
+
+    auto level = std::make_unique<Level>();
+    level->space = rt->create_index_space(ctx, coarse_grid);
+    level->owns_space = true;
+    level->restrict_partition = Legion::IndexPartition::NO_PART;
+    level->prolong_partition = Legion::IndexPartition::NO_PART;
+
+    // The bounds of piece c of partition, relative to the grid origin.
+    const auto piece_bounds = [&](Legion::IndexPartition partition,
+                                  const Legion::DomainPoint &c,
+                                  const Rect &grid,
+                                  long long (&lo)[DIM],
+                                  long long (&hi)[DIM]) {
+        const Legion::Domain piece = rt->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, partition, c)
+        );
+        if (piece.empty()) { return false; }
+        const Rect rect = piece.bounds<DIM, COORD_T>();
+        for (int d = 0; d < DIM; ++d) {
+            lo[d] = static_cast<long long>(rect.lo[d]) -
+                    static_cast<long long>(grid.lo[d]);
+            hi[d] = static_cast<long long>(rect.hi[d]) -
+                    static_cast<long long>(grid.lo[d]);
+        }
+        return true;
+    };
+
+    // A rect of relative bounds [lo, hi], clipped to [0, extents - 1] and
+    // shifted to origin.
+    const auto clipped_rect = [](const long long (&lo)[DIM],
+                                 const long long (&hi)[DIM],
+                                 const long long (&limits)[DIM],
+                                 const Rect &origin) {
+        Rect result;
+        for (int d = 0; d < DIM; ++d) {
+            const long long a = std::max(lo[d], 0LL);
+            const long long b = std::min(hi[d], limits[d] - 1);
+            if (a > b) { return gmg_empty_rect<DIM, COORD_T>(); }
+            result.lo[d] = static_cast<COORD_T>(
+                static_cast<long long>(origin.lo[d]) + a
+            );
+            result.hi[d] = static_cast<COORD_T>(
+                static_cast<long long>(origin.lo[d]) + b
+            );
+        }
+        return result;
+    };
+
+    const Legion::Domain fine_colors =
+        rt->get_index_space_domain(ctx, fine.color_space);
+    const std::size_t num_fine_pieces = fine_colors.get_volume();
+    const std::size_t volume = coarse_grid.volume();
+    const std::size_t num_pieces = std::clamp(
+        volume / options.min_points_per_piece,
+        std::size_t{1},
+        std::min(num_fine_pieces, static_cast<std::size_t>(extents[DIM - 1]))
+    );
+
+    // Coarse pieces under the fine pieces, where that partition is still
+    // fine enough (and disjoint and complete).
+    level->partition = Legion::IndexPartition::NO_PART;
+    if (num_pieces == num_fine_pieces) {
+        std::map<Legion::DomainPoint, Legion::Domain> pieces;
+        std::size_t covered = 0;
+        for (Legion::Domain::DomainPointIterator it(fine_colors); it; ++it) {
+            long long lo[DIM], hi[DIM];
+            if (!piece_bounds(fine.partition, *it, fine_grid, lo, hi)) {
+                pieces[*it] = gmg_empty_rect<DIM, COORD_T>();
+                continue;
+            }
+            for (int d = 0; d < DIM; ++d) {
+                lo[d] = lo[d] / 2;
+                hi[d] = (hi[d] + 1) / 2 - 1;
+            }
+            const Rect piece = clipped_rect(lo, hi, extents, coarse_grid);
+            covered += piece.volume();
+            pieces[*it] = piece;
+        }
+        level->partition = rt->create_partition_by_domain(
+            ctx,
+            level->space,
+            pieces,
+            fine.color_space,
+            true,
+            LEGION_COMPUTE_KIND
+        );
+        // Disjoint pieces that add up to the grid also cover it.
+        if (rt->is_index_partition_disjoint(ctx, level->partition) &&
+            (covered == volume)) {
+            level->color_space = fine.color_space;
+            level->owns_color_space = false;
+        } else {
+            rt->destroy_index_partition(ctx, level->partition);
+            level->partition = Legion::IndexPartition::NO_PART;
+        }
+    }
+
+    // Otherwise, slabs along the last dimension (agglomeration).
+    if (level->partition == Legion::IndexPartition::NO_PART) {
+        level->color_space = rt->create_index_space(
+            ctx,
+            Legion::Rect<1>{0, static_cast<Legion::coord_t>(num_pieces - 1)}
+        );
+        level->owns_color_space = true;
+        const long long n = extents[DIM - 1];
+        const long long p = static_cast<long long>(num_pieces);
+        std::map<Legion::DomainPoint, Legion::Domain> pieces;
+        for (long long g = 0; g < p; ++g) {
+            Rect slab = coarse_grid;
+            slab.lo[DIM - 1] = static_cast<COORD_T>(g * n / p);
+            slab.hi[DIM - 1] = static_cast<COORD_T>((g + 1) * n / p - 1);
+            pieces[Legion::DomainPoint{
+                Legion::Point<1>{static_cast<Legion::coord_t>(g)}}] = slab;
+        }
+        level->partition = rt->create_partition_by_domain(
+            ctx,
+            level->space,
+            pieces,
+            level->color_space,
+            true,
+            LEGION_DISJOINT_COMPLETE_KIND
+        );
+    }
+
+    // Fine points F.lo + 2 * I + 1 + u of the coarse pieces.
+    long long fine_extents[DIM];
+    for (int d = 0; d < DIM; ++d) {
+        fine_extents[d] = static_cast<long long>(fine_grid.hi[d]) -
+                          static_cast<long long>(fine_grid.lo[d]) + 1;
+    }
+    std::map<Legion::DomainPoint, Legion::Domain> restrict_pieces;
+    for (Legion::Domain::DomainPointIterator it(
+             rt->get_index_space_domain(ctx, level->color_space)
+         );
+         it;
+         ++it) {
+        long long lo[DIM], hi[DIM];
+        if (!piece_bounds(level->partition, *it, coarse_grid, lo, hi)) {
+            restrict_pieces[*it] = gmg_empty_rect<DIM, COORD_T>();
+            continue;
+        }
+        for (int d = 0; d < DIM; ++d) {
+            lo[d] = 2 * lo[d];
+            hi[d] = 2 * hi[d] + 2;
+        }
+        restrict_pieces[*it] = clipped_rect(lo, hi, fine_extents, fine_grid);
+    }
+    fine.restrict_partition = rt->create_partition_by_domain(
+        ctx,
+        fine.space,
+        restrict_pieces,
+        level->color_space,
+        true,
+        LEGION_COMPUTE_KIND
+    );
+
+    // Coarse points J with F.lo + 2 * J + 1 within one point of the fine
+    // pieces.
+    std::map<Legion::DomainPoint, Legion::Domain> prolong_pieces;
+    for (Legion::Domain::DomainPointIterator it(fine_colors); it; ++it) {
+        long long lo[DIM], hi[DIM];
+        if (!piece_bounds(fine.partition, *it, fine_grid, lo, hi)) {
+            prolong_pieces[*it] = gmg_empty_rect<DIM, COORD_T>();
+            continue;
+        }
+        for (int d = 0; d < DIM; ++d) {
+            lo[d] = (lo[d] + 1) / 2 - 1;
+            hi[d] = hi[d] / 2;
+        }
+        prolong_pieces[*it] = clipped_rect(lo, hi, extents, coarse_grid);
+    }
+    fine.prolong_partition = rt->create_partition_by_domain(
+        ctx,
+        level->space,
+        prolong_pieces,
+        fine.color_space,
+        true,
+        LEGION_COMPUTE_KIND
+    );
+
+    level->owned_op = std::make_unique<Operator>(
+        ctx,
+        rt,
+        level->space,
+        level->partition,
+        StencilShape::BOX,
+        gmg_galerkin_coefficients<ENTRY_T, DIM>(fine.op->get_stencil_args())
+    );
+    level->op = level->owned_op.get();
+    levels.push_back(std::move(level));
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::restrict_to(
+    std::size_t k, Vector &coarse, const Vector &fine
+) const {
+    const Level &fine_level = *levels[k];
+    const Level &coarse_level = *levels[k + 1];
+    Legion::IndexLauncher launcher{
+        GMGRestrictTask<ENTRY_T, DIM, COORD_T>::task_id,
+        coarse_level.color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, coarse.get_logical_region(), coarse_level.partition
+            ),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            coarse.get_logical_region()})
+        .add_field(coarse.get_fid());
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, fine.get_logical_region(), fine_level.restrict_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            fine.get_logical_region()})
+        .add_field(fine.get_fid());
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::prolong_to(
+    std::size_t k, Vector &fine, const Vector &coarse
+) const {
+    const Level &fine_level = *levels[k];
+    Legion::IndexLauncher launcher{
+        GMGProlongTask<ENTRY_T, DIM, COORD_T>::task_id,
+        fine_level.color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, fine.get_logical_region(), fine_level.partition
+            ),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            fine.get_logical_region()})
+        .add_field(fine.get_fid());
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, coarse.get_logical_region(), fine_level.prolong_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            coarse.get_logical_region()})
+        .add_field(coarse.get_fid());
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::cycle(
+    std::size_t k, Vector &x, const Vector &b, bool transpose
+) const {
+    const Scalar<ENTRY_T> one{ctx, rt, static_cast<ENTRY_T>(1)};
+    const Scalar<ENTRY_T> minus_one{ctx, rt, static_cast<ENTRY_T>(-1)};
+
+    const auto apply_operator = [&](const AbstractLinearOperator<ENTRY_T> &op,
+                                    Vector &output,
+                                    const Vector &input) {
+        if (transpose) {
+            op.transpose_matvec(
+                output.get_logical_region(),
+                output.get_fid(),
+                input.get_logical_region(),
+                input.get_fid()
+            );
+        } else {
+            op.matvec(
+                output.get_logical_region(),
+                output.get_fid(),
+                input.get_logical_region(),
+                input.get_fid()
+            );
+        }
+    };
+
+    const Level &level = *levels[k];
+    if (k + 1 == levels.size()) {
+        apply_operator(*level.smoother, x, b);
+        return;
+    }
+
+    // Presmoothing from x = 0, then r = b - A * x.
+    apply_operator(*level.smoother, x, b);
+    apply_operator(*level.op, *level.residual, x);
+    level.residual->xpay(minus_one, b);
+
+    // Coarse-grid correction.
+    const Level &next = *levels[k + 1];
+    restrict_to(k, *next.rhs, *level.residual);
+    cycle(k + 1, *next.solution, *next.rhs, transpose);
+    prolong_to(k, *level.correction, *next.solution);
+    x.axpy(one, *level.correction);
+
+    // Postsmoothing.
+    apply_operator(*level.op, *level.residual, x);
+    level.residual->xpay(minus_one, b);
+    apply_operator(*level.smoother, *level.correction, *level.residual);
+    x.axpy(one, *level.correction);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::apply(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid,
+    bool transpose
+) const {
+    const Legion::IndexPartition partition = levels[0]->partition;
+    Vector x{ctx, rt, output_region, output_fid, partition};
+    const Vector b{ctx, rt, input_region, input_fid, partition};
+    cycle(0, x, b, transpose);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+GMGPreconditioner<ENTRY_T, DIM, COORD_T>::whole_partition(
+    Legion::IndexSpace space, Legion::IndexPartition partition
+) const {
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, partition);
+    const Legion::Domain whole = rt->get_index_space_domain(ctx, space);
+    std::map<Legion::DomainPoint, Legion::Domain> pieces;
+    for (Legion::Domain::DomainPointIterator it(
+             rt->get_index_space_domain(ctx, colors)
+         );
+         it;
+         ++it) {
+        pieces[*it] = whole;
+    }
+    return rt->create_partition_by_domain(
+        ctx, space, pieces, colors, true, LEGION_ALIASED_COMPLETE_KIND
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition GMGPreconditioner<ENTRY_T, DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    return whole_partition(domain_space, range_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition GMGPreconditioner<ENTRY_T, DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    return whole_partition(range_space, domain_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGPreconditioner<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(output_region, output_fid, input_region, input_fid, true);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMGPreconditioner<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMGPreconditioner<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMGPreconditioner<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,189 @@
+#ifndef LEGION_SOLVERS_GMG_PRECONDITIONER_HPP_INCLUDED
+#define LEGION_SOLVERS_GMG_PRECONDITIONER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp"  // for AbstractLinearOperator
+#include "ChebyshevPreconditioner.hpp" // for ChebyshevPreconditioner
+#include "DistributedVector.hpp"       // for DistributedVector
+#include "StencilOperator.hpp"         // for StencilOperator
+
+namespace LegionSolvers {
+
+
+// Parameters of the hierarchy built by GMGPreconditioner.
+struct GMGOptions {
+    // Largest number of levels, including the finest and the coarsest.
+    std::size_t max_levels = 10;
+    // Levels with at most this many points are not coarsened further.
+    std::size_t max_coarse_size = 64;
+    // Coarse levels get at most one piece per this many points (and at least
+    // one piece, and at most as many pieces as the level above).
+    std::size_t min_points_per_piece = 1024;
+    // Degree of the Chebyshev smoother (see ChebyshevPreconditioner).
+    std::size_t smoother_degree = 2;
+    // Degree of the Chebyshev iteration that solves the coarsest level.
+    std::size_t coarse_degree = 16;
+}; // struct GMGOptions
+
+
+// A geometric multigrid preconditioner M for a StencilOperator A with
+// constant coefficients on a structured grid, typically symmetric positive
+// definite and arising from an elliptic problem, for which the number of
+// iterations of the preconditioned solver stays roughly constant as the
+// grid is refined. Unlike AMGPreconditioner, nothing is assembled: the
+// hierarchy is a sequence of grids with a stencil each.
+//
+// Level 0 is A on its grid and range partition. Each coarser grid has
+// (n_d - 1) / 2 points in dimension d, where the finer grid has n_d (see
+// GMGRestrictTask for the transfers); its operator is the Galerkin product
+// P^T * A * P, which is a constant BOX stencil computed on the host. Each
+// coarse grid is partitioned like the grid above it while its pieces keep at
+// least GMGOptions::min_points_per_piece points; below that, the coarse grid
+// is agglomerated onto fewer slabs along the last dimension. Coarsening
+// stops at the maximum number of levels, when a grid is small enough, or
+// when a dimension has fewer than three points. For odd n_d (such as
+// 2^k - 1) every level is coarsened exactly.
+//
+// Applying M^{-1} is one V-cycle from zero: on each level, Chebyshev
+// smoothing (ChebyshevPreconditioner on [rho / 30, rho], where rho is the
+// sum of the magnitudes of the stencil coefficients), the residual, its
+// restriction (GMGRestrictTask), the cycle of the next level, the
+// prolongation of its solution (GMGProlongTask), and the same smoothing
+// again. The coarsest level is solved approximately, by a Chebyshev
+// iteration of degree GMGOptions::coarse_degree on bounds estimated by
+// Lanczos at setup, so the cycle needs no task outside the index launches
+// of its levels. The cycle is symmetric, so M^{-1} is symmetric positive
+// definite for symmetric positive definite A and may precondition the CG
+// solvers; its transpose is the cycle of A^T.
+//
+// A and its range partition are used by every apply, so they must outlive
+// this object. The range partition must be disjoint and complete, with
+// rectangular pieces.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class GMGPreconditioner : public AbstractLinearOperator<ENTRY_T> {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using Operator = StencilOperator<ENTRY_T, DIM, COORD_T>;
+    using Smoother = ChebyshevPreconditioner<ENTRY_T, DIM, COORD_T>;
+
+    // One level of the hierarchy. Level 0 borrows the grid, partition, and
+    // operator of A, and its right-hand side and solution are the input and
+    // output of each apply. The smoother of the coarsest level is its
+    // solver, and the transfer partitions and the residual and correction
+    // vectors are absent there.
+    struct Level {
+        Legion::IndexSpace space;
+        Legion::IndexSpace color_space;
+        Legion::IndexPartition partition;
+        bool owns_space;
+        bool owns_color_space;
+        std::unique_ptr<Operator> owned_op;
+        const Operator *op;
+        std::unique_ptr<Smoother> smoother;
+        std::unique_ptr<Vector> rhs, solution, residual, correction;
+        // Partition of this grid by the colors of the next coarser level,
+        // holding the support of the restriction of each coarse piece.
+        Legion::IndexPartition restrict_partition;
+        // Partition of the next coarser grid by the colors of this level,
+        // holding the coarse points interpolated into each piece.
+        Legion::IndexPartition prolong_partition;
+    }; // struct Level
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const GMGOptions options;
+    std::vector<std::unique_ptr<Level>> levels;
+
+    // Builds the grid, partition, and operator of the level below the last
+    // one, and the transfer partitions between them.
+    void coarsen();
+
+    // Runs the cycle of level k for x from zero.
+    void cycle(std::size_t k, Vector &x, const Vector &b, bool transpose)
+        const;
+
+    // Computes the restriction of fine (on level k) into coarse (on level
+    // k + 1).
+    void restrict_to(std::size_t k, Vector &coarse, const Vector &fine) const;
+
+    // Computes the prolongation of coarse (on level k + 1) into fine (on
+    // level k).
+    void prolong_to(std::size_t k, Vector &fine, const Vector &coarse) const;
+
+    void apply(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid,
+        bool transpose
+    ) const;
+
+    // The partition of space in which every piece is all of space.
+    Legion::IndexPartition whole_partition(
+        Legion::IndexSpace space, Legion::IndexPartition partition
+    ) const;
+
+  public:
+
+    // Builds the hierarchy of a stencil operator with constant coefficients,
+    // using its grid and range partition.
+    explicit GMGPreconditioner(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const StencilOperator<ENTRY_T, DIM, COORD_T> &matrix,
+        const GMGOptions &options = GMGOptions{},
+        bool verbose = false
+    );
+
+    GMGPreconditioner(const GMGPreconditioner &) = delete;
+
+    GMGPreconditioner &operator=(const GMGPreconditioner &) = delete;
+
+    virtual ~GMGPreconditioner();
+
+    std::size_t get_num_levels() const { return levels.size(); }
+
+    Legion::IndexSpace get_level_space(std::size_t k) const {
+        return levels[k]->space;
+    }
+
+    Legion::IndexPartition get_level_partition(std::size_t k) const {
+        return levels[k]->partition;
+    }
+
+    // Every output entry depends on every input entry.
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Computes output = M^{-1} * input (one V-cycle).
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Computes output = M^{-T} * input (one V-cycle of A^T).
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class GMGPreconditioner
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_GMG_PRECONDITIONER_HPP_INCLUDED
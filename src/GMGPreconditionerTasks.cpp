@@ -0,0 +1,254 @@
+#include "GMGPreconditionerTasks.hpp"
+
+#include <cassert> // for assert
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineWriter
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::GMGProlongTask;
+using LegionSolvers::GMGRestrictTask;
+
+
+// The bounds of the grid of region requirement r of a task.
+template <int DIM, typename COORD_T>
+inline Legion::Rect<DIM, COORD_T> gmg_grid(
+    const Legion::Task *task, std::size_t r, Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    return rt
+        ->get_index_space_domain(
+            ctx, task->regions[r].parent.get_index_space()
+        )
+        .template bounds<DIM, COORD_T>();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGRestrictTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Point = Legion::Point<DIM, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+
+    assert(regions.size() == 2);
+    assert(task->regions.size() == 2);
+    assert(task->regions[0].privilege_fields.size() == 1);
+    assert(task->regions[1].privilege_fields.size() == 1);
+    AffineWriter<ENTRY_T, DIM, COORD_T> output{
+        regions[0], *task->regions[0].privilege_fields.begin()};
+    AffineReader<ENTRY_T, DIM, COORD_T> input{
+        regions[1], *task->regions[1].privilege_fields.begin()};
+
+    const Legion::Rect<DIM, COORD_T> fine =
+        gmg_grid<DIM, COORD_T>(task, 1, ctx, rt);
+    const Legion::Domain output_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+
+    int num_neighbours = 1;
+    for (int d = 0; d < DIM; ++d) { num_neighbours *= 3; }
+    for (PointIterator it(output_domain); it(); ++it) {
+        const Point coarse_point = *it;
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        for (int s = 0; s < num_neighbours; ++s) {
+            // Component d of the offset u is the d-th base-3 digit of s
+            // minus one.
+            Point q;
+            ENTRY_T weight = static_cast<ENTRY_T>(1);
+            bool inside = true;
+            int digits = s;
+            for (int d = 0; d < DIM; ++d, digits /= 3) {
+                const int u = digits % 3 - 1;
+                const long long c =
+                    static_cast<long long>(fine.lo[d]) +
+                    2 * static_cast<long long>(coarse_point[d]) + 1 + u;
+                if (c > static_cast<long long>(fine.hi[d])) {
+                    inside = false;
+                    break;
+                }
+                q[d] = static_cast<COORD_T>(c);
+                if (u != 0) { weight /= static_cast<ENTRY_T>(2); }
+            }
+            if (inside) { sum += weight * input[q]; }
+        }
+        output[coarse_point] = sum;
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMGProlongTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Point = Legion::Point<DIM, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+
+    assert(regions.size() == 2);
+    assert(task->regions.size() == 2);
+    assert(task->regions[0].privilege_fields.size() == 1);
+    assert(task->regions[1].privilege_fields.size() == 1);
+    AffineWriter<ENTRY_T, DIM, COORD_T> output{
+        regions[0], *task->regions[0].privilege_fields.begin()};
+    AffineReader<ENTRY_T, DIM, COORD_T> input{
+        regions[1], *task->regions[1].privilege_fields.begin()};
+
+    const Legion::Rect<DIM, COORD_T> fine =
+        gmg_grid<DIM, COORD_T>(task, 0, ctx, rt);
+    const Legion::Rect<DIM, COORD_T> coarse =
+        gmg_grid<DIM, COORD_T>(task, 1, ctx, rt);
+    const Legion::Domain output_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+
+    for (PointIterator it(output_domain); it(); ++it) {
+        const Point fine_point = *it;
+
+        // Fine offset r_d = x_d - F.lo_d is interpolated from the coarse
+        // coordinate (r_d - 1) / 2 with weight 1 if r_d is odd, and from
+        // the coarse coordinates r_d / 2 - 1 and r_d / 2 (where they exist)
+        // with weight 1/2 each if r_d is even.
+        long long candidates[DIM][2];
+        int num_candidates[DIM];
+        bool empty = false;
+        for (int d = 0; d < DIM; ++d) {
+            const long long r = static_cast<long long>(fine_point[d]) -
+                                static_cast<long long>(fine.lo[d]);
+            num_candidates[d] = 0;
+            const long long first = (r % 2 == 1) ? (r - 1) / 2 : r / 2 - 1;
+            for (long long c = first; c <= r / 2; ++c) {
+                if ((2 * c + 1 - r >= -1) && (2 * c + 1 - r <= 1) &&
+                    (c >= static_cast<long long>(coarse.lo[d])) &&
+                    (c <= static_cast<long long>(coarse.hi[d]))) {
+                    candidates[d][num_candidates[d]++] = c;
+                }
+            }
+            if (num_candidates[d] == 0) { empty = true; }
+        }
+
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        if (!empty) {
+            const int num_combinations = 1 << DIM;
+            for (int k = 0; k < num_combinations; ++k) {
+                Point q;
+                ENTRY_T weight = static_cast<ENTRY_T>(1);
+                bool valid = true;
+                for (int d = 0; d < DIM; ++d) {
+                    const int j = (k >> d) & 1;
+                    if (j >= num_candidates[d]) {
+                        valid = false;
+                        break;
+                    }
+                    q[d] = static_cast<COORD_T>(candidates[d][j]);
+                    if (num_candidates[d] == 2 ||
+                        2 * candidates[d][j] + 1 !=
+                            static_cast<long long>(fine_point[d]) -
+                                static_cast<long long>(fine.lo[d])) {
+                        weight /= static_cast<ENTRY_T>(2);
+                    }
+                }
+                if (valid) { sum += weight * input[q]; }
+            }
+        }
+        output[fine_point] = sum;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void LegionSolvers::GMGRestrictTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void LegionSolvers::GMGRestrictTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void LegionSolvers::GMGRestrictTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LegionSolvers::GMGProlongTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
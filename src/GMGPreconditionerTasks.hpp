@@ -0,0 +1,89 @@
+#ifndef LEGION_SOLVERS_GMG_PRECONDITIONER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_GMG_PRECONDITIONER_TASKS_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for GMG_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Grid transfers of geometric multigrid by vertex-centered coarsening. The
+// fine grid is a rect F of n_d points in each dimension d, and the coarse
+// grid the rect [0, m_d - 1] of m_d = (n_d - 1) / 2 points; coarse point I
+// lies at fine point F.lo + 2 * I + 1. Prolongation P is d-linear
+// interpolation: coarse point I contributes with weight 2^{-k} to the fine
+// points F.lo + 2 * I + 1 + u, for u in {-1, 0, +1}^DIM with k nonzero
+// components. Restriction is P^T (full weighting, unscaled), so that the
+// Galerkin coarse operator P^T * A * P of a constant stencil is again a
+// constant stencil. For odd n_d, the support of every coarse point lies in
+// the fine grid.
+
+
+// Computes output = P^T * input for one piece of the coarse grid. Regions
+// are output (write-discard, coarse piece) and input (read-only, a piece of
+// the fine grid containing the support of the coarse piece). The grids are
+// the index spaces of the parent regions.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct GMGRestrictTask
+    : public TaskTDI<
+          GMG_RESTRICT_TASK_BLOCK_ID,
+          GMGRestrictTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "gmg_restrict";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct GMGRestrictTask
+
+
+// Computes output = P * input for one piece of the fine grid. Regions are
+// output (write-discard, fine piece) and input (read-only, a piece of the
+// coarse grid containing every coarse point whose support meets the fine
+// piece). The grids are the index spaces of the parent regions.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct GMGProlongTask
+    : public TaskTDI<
+          GMG_PROLONG_TASK_BLOCK_ID,
+          GMGProlongTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "gmg_prolong";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct GMGProlongTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_GMG_PRECONDITIONER_TASKS_HPP_INCLUDED
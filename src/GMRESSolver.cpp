@@ -0,0 +1,252 @@
+#include "GMRESSolver.hpp"
+
+#include <algorithm> // for std::max
+#include <cassert>   // for assert
+#include <cmath>     // for std::sqrt
+#include <cstdint>   // for std::uint32_t
+
+#include "FusedVectorOperations.hpp" // for FusedVectorOperations
+#include "GMRESSolverTasks.hpp"      // for GMRESLeastSquaresTask, ...
+#include "LibraryOptions.hpp"        // for LEGION_SOLVERS_USE_*, ...
+#include "LinearCombinations.hpp"    // for LinearCombinations
+#include "Scalar.hpp"                // for Scalar
+
+using LegionSolvers::GMRESSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+GMRESSolver<ENTRY_T, DIM, COORD_T>::GMRESSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<ENTRY_T> *preconditioner,
+    std::size_t restart,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), preconditioner(preconditioner),
+      restart(restart), check_interval(check_interval),
+      rhs(ctx, rt, rhs_region, rhs_fid, partition),
+      solution(ctx, rt, solution_region, solution_fid, partition),
+      w(ctx, rt, partition),
+      z(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                       : nullptr),
+      residual_norm(static_cast<ENTRY_T>(0)) {
+    assert((restart >= 1) && (restart <= MAX_RESTART));
+    assert(check_interval > 0);
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+    for (std::size_t i = 0; i < restart; ++i) {
+        basis.push_back(std::make_unique<Vector>(ctx, rt, partition));
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void GMRESSolver<ENTRY_T, DIM, COORD_T>::apply(
+    const AbstractLinearOperator<ENTRY_T> &op,
+    Vector &output,
+    const Vector &input
+) {
+    op.matvec(
+        output.get_logical_region(),
+        output.get_fid(),
+        input.get_logical_region(),
+        input.get_fid()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future GMRESSolver<ENTRY_T, DIM, COORD_T>::block_dot(
+    std::size_t j, bool with_norm
+) {
+    FusedVectorOperations<ENTRY_T, DIM, COORD_T> operations{ctx, rt};
+    for (std::size_t i = 0; i <= j; ++i) { operations.dot(*basis[i], w); }
+    if (with_norm) { operations.dot(w, w); }
+    return operations.execute();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future GMRESSolver<ENTRY_T, DIM, COORD_T>::least_squares(
+    const std::vector<Legion::Future> &futures
+) const {
+    const GMRESLeastSquaresArgs args{
+        static_cast<std::uint32_t>(futures.size() / 2)};
+    Legion::TaskLauncher launcher{
+        GMRESLeastSquaresTask<ENTRY_T>::task_id,
+        Legion::TaskArgument{&args, sizeof(GMRESLeastSquaresArgs)}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    return rt->execute_task(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t GMRESSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    const ENTRY_T threshold =
+        tolerance * tolerance * rhs.dot(rhs).get_value();
+
+    const Scalar<ENTRY_T> one{ctx, rt, static_cast<ENTRY_T>(1)};
+    std::size_t iteration = 0;
+    while (true) {
+        // w = b - A * x
+        apply(matrix, w, solution);
+        w.xpay(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-1)}, rhs);
+        FusedVectorOperations<ENTRY_T, DIM, COORD_T> norm{ctx, rt};
+        norm.dot(w, w);
+        const Legion::Future beta_squared = norm.execute();
+        const Scalar<ENTRY_T> rr =
+            Scalar<ENTRY_T>::packed(ctx, rt, beta_squared, 0);
+        const ENTRY_T rr_value = rr.get_value();
+        residual_norm = std::sqrt(std::max(rr_value, static_cast<ENTRY_T>(0)));
+        if ((iteration >= max_iterations) || (rr_value <= threshold)) {
+            return iteration;
+        }
+
+        // v_0 = w / beta
+        basis[0]->copy(w);
+        basis[0]->scal(one / rr.sqrt());
+
+        std::vector<Legion::Future> futures{beta_squared};
+        Legion::Future coefficients;
+        std::vector<const Vector *> inputs;
+        std::size_t k = 0;
+        while ((k < restart) && (iteration < max_iterations)) {
+            const Vector &v = *basis[k];
+            inputs.push_back(&v);
+            if (preconditioner) {
+                apply(*preconditioner, *z, v);
+                apply(matrix, w, *z);
+            } else {
+                apply(matrix, w, v);
+            }
+
+            // CGS2: w -= V * (V^T w), twice.
+            const Legion::Future first = block_dot(k, false);
+            LinearCombinations<ENTRY_T, DIM, COORD_T> projection{
+                ctx, rt, inputs, first};
+            projection.subtract(w, 0);
+            projection.execute();
+            futures.push_back(first);
+            futures.push_back(block_dot(k, true));
+            coefficients = least_squares(futures);
+            ++k;
+            ++iteration;
+
+            // v_k = (w - V * (V^T w)) / |w - V * (V^T w)|
+            if (k < restart) {
+                std::vector<const Vector *> terms = inputs;
+                terms.push_back(&w);
+                LinearCombinations<ENTRY_T, DIM, COORD_T> next{
+                    ctx, rt, terms, coefficients};
+                next.assign(*basis[k], static_cast<std::uint32_t>(k + 1));
+                next.execute();
+            }
+
+            if (iteration % check_interval == 0) {
+                const Scalar<ENTRY_T> estimate = Scalar<ENTRY_T>::packed(
+                    ctx, rt, coefficients, static_cast<std::uint32_t>(k)
+                );
+                const ENTRY_T estimate_value = estimate.get_value();
+                if (estimate_value * estimate_value <= threshold) { break; }
+            }
+        }
+
+        // x += M * V * y
+        LinearCombinations<ENTRY_T, DIM, COORD_T> update{
+            ctx, rt, inputs, coefficients};
+        if (preconditioner) {
+            update.assign(w, 0);
+            update.execute();
+            apply(*preconditioner, *z, w);
+            solution.axpy(one, *z);
+        } else {
+            update.add(solution, 0);
+            update.execute();
+        }
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::GMRESSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::GMRESSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::GMRESSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,109 @@
+#ifndef LEGION_SOLVERS_GMRES_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_GMRES_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+#include "LibraryOptions.hpp"         // for LEGION_SOLVERS_MAX_PACKED_SCALARS
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a nonsingular linear operator A by the restarted
+// generalized minimal residual method GMRES(m), with m = restart, optionally
+// right-preconditioned as in BiCGStabSolver. Other arguments are as in
+// CGSolver.
+//
+// Each step orthogonalizes w = A * M * v_j against the basis v_0, ..., v_j by
+// classical Gram-Schmidt with one reorthogonalization (CGS2), which needs two
+// reductions per step however large j is, instead of the j + 1 of modified
+// Gram-Schmidt. Each projection is a block dot product V^T w, issued as one
+// fused launch (see FusedVectorOperations), followed by a multi-axpy w -= V h
+// (see LinearCombinations). The small least-squares problem of the cycle is
+// solved by one GMRESLeastSquaresTask per step from the futures of the
+// projections, and the same task supplies the coefficients that normalize
+// the next basis vector, so nothing waits for the top-level task between
+// convergence checks. The residual estimate is checked every check_interval
+// steps; at the end of a cycle, or when the estimate has converged, x is
+// updated and the true residual is computed and checked.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class GMRESSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const AbstractLinearOperator<ENTRY_T> *const preconditioner;
+    const std::size_t restart;
+    const std::size_t check_interval;
+    const Vector rhs;
+    Vector solution;
+    Vector w;
+    std::vector<std::unique_ptr<Vector>> basis; // v_0, ..., v_{m-1}
+    const std::unique_ptr<Vector> z;            // only with preconditioner
+    ENTRY_T residual_norm;
+
+    void apply(
+        const AbstractLinearOperator<ENTRY_T> &op,
+        Vector &output,
+        const Vector &input
+    );
+
+    // Returns the dot products of v_0, ..., v_j with w, followed by (w, w)
+    // if with_norm is true, as a PackedScalars<ENTRY_T> future.
+    Legion::Future block_dot(std::size_t j, bool with_norm);
+
+    // Launches the GMRESLeastSquaresTask of the steps so far, given the
+    // futures it takes (see GMRESLeastSquaresTask).
+    Legion::Future
+    least_squares(const std::vector<Legion::Future> &futures) const;
+
+  public:
+
+    static constexpr std::size_t DEFAULT_RESTART = 30;
+
+    // Bounded by the capacity of the PackedScalars returned by
+    // GMRESLeastSquaresTask.
+    static constexpr std::size_t MAX_RESTART =
+        (LEGION_SOLVERS_MAX_PACKED_SCALARS - 2) / 2;
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 5;
+
+    explicit GMRESSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<ENTRY_T> *preconditioner = nullptr,
+        std::size_t restart = DEFAULT_RESTART,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    GMRESSolver(const GMRESSolver &) = delete;
+
+    GMRESSolver &operator=(const GMRESSolver &) = delete;
+
+    // Iterates until the true residual norm is at most tolerance times the
+    // norm of b, or until max_iterations steps have been performed. Returns
+    // the number of steps.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norm of the true residual b - A * x when solve returned.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class GMRESSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_GMRES_SOLVER_HPP_INCLUDED
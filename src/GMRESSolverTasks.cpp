@@ -0,0 +1,111 @@
+#include "GMRESSolverTasks.hpp"
+
+#include <algorithm> // for std::max
+#include <cassert>   // for assert
+#include <cmath>     // for std::abs, std::hypot, std::sqrt
+#include <cstddef>   // for std::size_t
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::GMRESLeastSquaresArgs;
+using LegionSolvers::GMRESLeastSquaresTask;
+using LegionSolvers::PackedScalars;
+
+
+template <typename T>
+PackedScalars<T> GMRESLeastSquaresTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    constexpr std::size_t MAX_COLUMNS =
+        (LEGION_SOLVERS_MAX_PACKED_SCALARS - 2) / 2;
+
+    assert(task->arglen == sizeof(GMRESLeastSquaresArgs));
+    const GMRESLeastSquaresArgs &args =
+        *static_cast<const GMRESLeastSquaresArgs *>(task->args);
+    const std::size_t k = args.num_columns;
+    assert((k >= 1) && (k <= MAX_COLUMNS));
+    assert(task->futures.size() == 2 * k + 1);
+
+    const T zero = static_cast<T>(0);
+    const T beta = std::sqrt(std::max(
+        task->futures[0].get_result<PackedScalars<T>>().values[0], zero
+    ));
+
+    // h[i][c] for i <= c + 1.
+    T h[MAX_COLUMNS + 1][MAX_COLUMNS] = {};
+    PackedScalars<T> second{};
+    for (std::size_t c = 0; c < k; ++c) {
+        const PackedScalars<T> first =
+            task->futures[1 + 2 * c].get_result<PackedScalars<T>>();
+        second = task->futures[2 + 2 * c].get_result<PackedScalars<T>>();
+        T norm_squared = second.values[c + 1];
+        for (std::size_t i = 0; i <= c; ++i) {
+            h[i][c] = first.values[i] + second.values[i];
+            norm_squared -= second.values[i] * second.values[i];
+        }
+        h[c + 1][c] = std::sqrt(std::max(norm_squared, zero));
+    }
+    const T next_norm = h[k][k - 1];
+
+    // Reduce H to upper triangular form by Givens rotations, applying them
+    // to g = beta * e_0 as well.
+    T g[MAX_COLUMNS + 1] = {};
+    g[0] = beta;
+    for (std::size_t c = 0; c < k; ++c) {
+        const T a = h[c][c];
+        const T b = h[c + 1][c];
+        const T radius = std::hypot(a, b);
+        if (radius == zero) { continue; }
+        const T cosine = a / radius;
+        const T sine = b / radius;
+        for (std::size_t j = c; j < k; ++j) {
+            const T upper = h[c][j];
+            const T lower = h[c + 1][j];
+            h[c][j] = cosine * upper + sine * lower;
+            h[c + 1][j] = cosine * lower - sine * upper;
+        }
+        const T upper = g[c];
+        g[c] = cosine * upper;
+        g[c + 1] = -sine * upper;
+    }
+
+    PackedScalars<T> result{};
+    for (std::size_t i = k; i-- > 0;) {
+        T value = g[i];
+        for (std::size_t j = i + 1; j < k; ++j) {
+            value -= h[i][j] * result.values[j];
+        }
+        result.values[i] = (h[i][i] == zero) ? zero : value / h[i][i];
+    }
+    result.values[k] = std::abs(g[k]);
+
+    const T inverse = (next_norm > zero) ? static_cast<T>(1) / next_norm : zero;
+    for (std::size_t i = 0; i < k; ++i) {
+        result.values[k + 1 + i] = -second.values[i] * inverse;
+    }
+    result.values[2 * k + 1] = inverse;
+    return result;
+}
+
+
+#ifdef LEGION_SOLVERS_USE_FLOAT
+template PackedScalars<float> GMRESLeastSquaresTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_FLOAT
+
+
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+template PackedScalars<double> GMRESLeastSquaresTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_DOUBLE
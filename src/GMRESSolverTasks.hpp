@@ -0,0 +1,62 @@
+#ifndef LEGION_SOLVERS_GMRES_SOLVER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_GMRES_SOLVER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PackedScalars.hpp"   // for PackedScalars
+#include "TaskBaseClasses.hpp" // for TaskT
+#include "TaskIDs.hpp"         // for GMRES_LEAST_SQUARES_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+struct GMRESLeastSquaresArgs {
+    std::uint32_t num_columns;
+}; // struct GMRESLeastSquaresArgs
+
+
+// Solves the least-squares problem min |beta e_0 - H y| of the first k =
+// num_columns steps of a GMRES cycle, where H is the (k + 1)-by-k upper
+// Hessenberg matrix produced by classical Gram-Schmidt with one
+// reorthogonalization (CGS2). The futures are PackedScalars<T>: the first
+// holds beta^2 = (r, r) in component 0, and each column c < k contributes
+// two more, the dot products (v_i, w) of the first projection (components
+// 0 to c) and of the second (components 0 to c, followed by (w, w) after the
+// first projection in component c + 1). H[i][c] is the sum of the two
+// projections and H[c + 1][c] = sqrt((w, w) - sum of squares of the second).
+//
+// Returns, packed, y (components [0, k)), the residual norm |beta e_0 - H y|
+// of the cycle (component k), and the coefficients that make v_k =
+// (w - sum_i h_i v_i) / H[k][k - 1] from v_0, ..., v_{k - 1}, w, with h the
+// second projection of the last column (components [k + 1, 2k + 2)). A zero
+// H[k][k - 1] (lucky breakdown) gives v_k = 0.
+template <typename T>
+struct GMRESLeastSquaresTask : public TaskT<
+                                   GMRES_LEAST_SQUARES_TASK_BLOCK_ID,
+                                   GMRESLeastSquaresTask,
+                                   T> {
+
+    static constexpr const char *task_base_name = "gmres_least_squares";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = PackedScalars<T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct GMRESLeastSquaresTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_GMRES_SOLVER_TASKS_HPP_INCLUDED
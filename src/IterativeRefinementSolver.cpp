@@ -0,0 +1,135 @@
+#include "IterativeRefinementSolver.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*
+#include "Scalar.hpp"         // for Scalar
+
+using LegionSolvers::IterativeRefinementSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+IterativeRefinementSolver<ENTRY_T, DIM, COORD_T>::IterativeRefinementSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    const AbstractLinearOperator<LOW_T> &low_matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<LOW_T> *low_preconditioner,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix),
+      rhs(ctx, rt, rhs_region, rhs_fid, partition),
+      solution(ctx, rt, solution_region, solution_fid, partition),
+      residual(ctx, rt, partition), product(ctx, rt, partition),
+      low_residual(ctx, rt, partition), low_correction(ctx, rt, partition),
+      inner_solver(
+          ctx,
+          rt,
+          low_matrix,
+          low_residual.get_logical_region(),
+          low_residual.get_fid(),
+          low_correction.get_logical_region(),
+          low_correction.get_fid(),
+          partition,
+          low_preconditioner,
+          check_interval
+      ),
+      inner_iterations(0), residual_norm(static_cast<ENTRY_T>(0)) {
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t IterativeRefinementSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_refinements,
+    ENTRY_T tolerance,
+    std::size_t max_inner_iterations,
+    LOW_T inner_tolerance
+) {
+    const Scalar<ENTRY_T> minus_one{ctx, rt, static_cast<ENTRY_T>(-1)};
+    const ENTRY_T rhs_norm = std::sqrt(rhs.dot(rhs).get_value());
+    inner_iterations = 0;
+
+    std::size_t step = 0;
+    while (true) {
+        // r = b - A * x, in ENTRY_T
+        matrix.matvec(
+            product.get_logical_region(),
+            product.get_fid(),
+            solution.get_logical_region(),
+            solution.get_fid()
+        );
+        residual.copy(rhs);
+        residual.axpy(minus_one, product);
+        residual_norm = std::sqrt(residual.dot(residual).get_value());
+        // An exact solution (r = 0) cannot be scaled below, and needs no
+        // refinement even when the tolerance is zero.
+        if ((step == max_refinements) || (residual_norm == 0) ||
+            (residual_norm <= tolerance * rhs_norm)) {
+            return step;
+        }
+
+        // A * d = r / |r| from d = 0, in LOW_T
+        low_residual.convert(residual);
+        low_residual.scal(Scalar<LOW_T>{
+            ctx, rt, static_cast<LOW_T>(static_cast<ENTRY_T>(1) / residual_norm)
+        });
+        low_correction.constant_fill(static_cast<LOW_T>(0));
+        inner_iterations +=
+            inner_solver.solve(max_inner_iterations, inner_tolerance);
+
+        // x = x + |r| * d, in ENTRY_T
+        solution.axpy_convert(
+            Scalar<ENTRY_T>{ctx, rt, residual_norm}, low_correction
+        );
+        ++step;
+    }
+}
+
+
+// Refinement runs in double with single-precision inner solves, so both
+// entry types must be enabled.
+// clang-format off
+#if defined(LEGION_SOLVERS_USE_FLOAT) && defined(LEGION_SOLVERS_USE_DOUBLE)
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::IterativeRefinementSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::IterativeRefinementSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::IterativeRefinementSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::IterativeRefinementSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::IterativeRefinementSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::IterativeRefinementSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::IterativeRefinementSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::IterativeRefinementSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::IterativeRefinementSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT && LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
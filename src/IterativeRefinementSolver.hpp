@@ -0,0 +1,104 @@
+#ifndef LEGION_SOLVERS_ITERATIVE_REFINEMENT_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_ITERATIVE_REFINEMENT_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp"   // for AbstractLinearOperator
+#include "CGSolver.hpp"                 // for CGSolver
+#include "DistributedVector.hpp"        // for DistributedVector
+#include "MetaprogrammingUtilities.hpp" // for OtherPrecision
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a symmetric positive definite linear operator A by
+// mixed-precision iterative refinement. Each refinement step computes the
+// residual r = b - A * x in ENTRY_T (double), converts it to the other
+// precision (float) by ConvertTask, solves A * d = r approximately in float
+// by preconditioned CG, and adds the correction to x in double by
+// AxpyConvertTask. The inner solve, which does nearly all of the work, thus
+// reads half as many bytes per vector and matrix entry, while the residual,
+// and with it the attainable accuracy of x, is that of double precision, as
+// long as the float solves reduce the residual at all (i.e., A is not too
+// ill-conditioned for float).
+//
+// The application supplies A twice: as matrix in double, used only for the
+// residual, and as low_matrix in float, with the same entries rounded (for
+// instance, a second operator over float copies of the entries, which
+// DistributedVector::convert produces). The optional preconditioner, also in
+// float, is applied by the inner CG solver. Each right-hand side of the
+// inner solve is scaled to unit norm, so that small residuals do not
+// underflow in float.
+//
+// b and x are fields of application regions over the parent index space of
+// partition, as for CGSolver; x is updated in place. The solver blocks once
+// per refinement step, on the norm of the residual.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class IterativeRefinementSolver {
+
+    using LOW_T = typename OtherPrecision<ENTRY_T>::type;
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using LowVector = DistributedVector<LOW_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const Vector rhs;
+    Vector solution;
+    Vector residual;
+    Vector product;
+    LowVector low_residual;
+    LowVector low_correction;
+    CGSolver<LOW_T, DIM, COORD_T> inner_solver;
+    std::size_t inner_iterations;
+    ENTRY_T residual_norm;
+
+  public:
+
+    explicit IterativeRefinementSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        const AbstractLinearOperator<LOW_T> &low_matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<LOW_T> *low_preconditioner = nullptr,
+        std::size_t check_interval =
+            CGSolver<LOW_T, DIM, COORD_T>::DEFAULT_CHECK_INTERVAL
+    );
+
+    IterativeRefinementSolver(const IterativeRefinementSolver &) = delete;
+
+    IterativeRefinementSolver &
+    operator=(const IterativeRefinementSolver &) = delete;
+
+    // Refines x until the residual norm is at most tolerance times the norm
+    // of b, or until max_refinements steps have been performed. Each inner
+    // solve runs until its residual is reduced by inner_tolerance, or for
+    // max_inner_iterations iterations. Returns the number of refinement
+    // steps.
+    std::size_t solve(
+        std::size_t max_refinements,
+        ENTRY_T tolerance,
+        std::size_t max_inner_iterations,
+        LOW_T inner_tolerance = static_cast<LOW_T>(1.0e-4)
+    );
+
+    // Total number of inner CG iterations of the last solve.
+    std::size_t get_inner_iterations() const { return inner_iterations; }
+
+    // Norm of the residual b - A * x, computed in ENTRY_T, at the end of the
+    // last solve.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class IterativeRefinementSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_ITERATIVE_REFINEMENT_SOLVER_HPP_INCLUDED
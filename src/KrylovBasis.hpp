@@ -0,0 +1,135 @@
+#ifndef LEGION_SOLVERS_KRYLOV_BASIS_HPP_INCLUDED
+#define LEGION_SOLVERS_KRYLOV_BASIS_HPP_INCLUDED
+
+#include <cassert> // for assert
+#include <cmath>   // for std::abs, std::acos, std::cos
+#include <cstdint> // for std::uint8_t, std::uint32_t
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH
+
+namespace LegionSolvers {
+
+
+// Polynomial bases of the Krylov subspaces computed by matrix-powers
+// kernels. The monomial basis v_k = A^k v_0 becomes numerically linearly
+// dependent after a few steps; the Newton and Chebyshev bases keep it well
+// conditioned given bounds on the spectrum of A.
+enum class KrylovBasisKind : std::uint8_t {
+    MONOMIAL,
+    NEWTON,
+    CHEBYSHEV,
+}; // enum class KrylovBasisKind
+
+
+// Three-term recurrence of a Krylov basis of up to
+// LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH vectors beyond v_0:
+//     v_{k+1} = (A v_k - shift[k] v_k - previous[k] v_{k-1}) / scale[k],
+// or equivalently, A v_k = scale[k] v_{k+1} + shift[k] v_k +
+// previous[k] v_{k-1}, with previous[0] = 0. The second form gives the
+// change-of-basis matrix used by s-step methods (see multiply_in_basis).
+template <typename ENTRY_T>
+struct KrylovBasis {
+    std::uint32_t length;
+    ENTRY_T shift[LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH];
+    ENTRY_T previous[LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH];
+    ENTRY_T scale[LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH];
+}; // struct KrylovBasis
+
+
+// Basis of the given length for an operator whose spectrum lies in
+// [lambda_min, lambda_max] (ignored by the monomial basis). Newton shifts
+// are the Chebyshev points of the interval in Leja order, which keeps
+// consecutive basis vectors far apart; Chebyshev vectors are the Chebyshev
+// polynomials of A mapped onto [-1, 1], applied to v_0.
+template <typename ENTRY_T>
+KrylovBasis<ENTRY_T> make_krylov_basis(
+    KrylovBasisKind kind,
+    std::uint32_t length,
+    ENTRY_T lambda_min,
+    ENTRY_T lambda_max
+) {
+    assert(length <= LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH);
+    const ENTRY_T zero = static_cast<ENTRY_T>(0);
+    const ENTRY_T one = static_cast<ENTRY_T>(1);
+    const ENTRY_T center = (lambda_max + lambda_min) / 2;
+    const ENTRY_T radius = (lambda_max - lambda_min) / 2;
+    KrylovBasis<ENTRY_T> basis{};
+    basis.length = length;
+    for (std::uint32_t k = 0; k < length; ++k) {
+        basis.shift[k] = zero;
+        basis.previous[k] = zero;
+        basis.scale[k] = one;
+    }
+    if (kind == KrylovBasisKind::MONOMIAL) { return basis; }
+    assert(radius > zero);
+
+    if (kind == KrylovBasisKind::CHEBYSHEV) {
+        for (std::uint32_t k = 0; k < length; ++k) {
+            basis.shift[k] = center;
+            basis.previous[k] = (k == 0) ? zero : radius / 2;
+            basis.scale[k] = (k == 0) ? radius : radius / 2;
+        }
+        return basis;
+    }
+
+    assert(kind == KrylovBasisKind::NEWTON);
+    const double pi = std::acos(-1.0);
+    ENTRY_T nodes[LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH];
+    bool used[LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH] = {};
+    for (std::uint32_t i = 0; i < length; ++i) {
+        const double angle = (2 * i + 1) * pi / (2 * length);
+        nodes[i] = center + radius * static_cast<ENTRY_T>(std::cos(angle));
+    }
+    // Leja order: start with the node of largest magnitude, then repeatedly
+    // take the node maximizing the product of distances to those taken.
+    for (std::uint32_t k = 0; k < length; ++k) {
+        std::uint32_t best = length;
+        ENTRY_T best_value = -one;
+        for (std::uint32_t i = 0; i < length; ++i) {
+            if (used[i]) { continue; }
+            ENTRY_T value = std::abs(nodes[i]);
+            if (k > 0) {
+                value = one;
+                for (std::uint32_t j = 0; j < k; ++j) {
+                    value *= std::abs(nodes[i] - basis.shift[j]);
+                }
+            }
+            if (value > best_value) {
+                best = i;
+                best_value = value;
+            }
+        }
+        used[best] = true;
+        basis.shift[k] = nodes[best];
+        basis.scale[k] = radius;
+    }
+    return basis;
+}
+
+
+// Coordinates of A * y, given the coordinates c[0 : length + 1] of y in a
+// basis v_0, ..., v_length of the kind above, where c[length] must be zero.
+// Writes the result to result[0 : length + 1].
+template <typename ENTRY_T>
+void multiply_in_basis(
+    const KrylovBasis<ENTRY_T> &basis,
+    std::uint32_t length,
+    const ENTRY_T *c,
+    ENTRY_T *result
+) {
+    assert(length <= basis.length);
+    for (std::uint32_t k = 0; k <= length; ++k) {
+        result[k] = static_cast<ENTRY_T>(0);
+    }
+    for (std::uint32_t k = 0; k < length; ++k) {
+        result[k + 1] += basis.scale[k] * c[k];
+        result[k] += basis.shift[k] * c[k];
+        if (k > 0) { result[k - 1] += basis.previous[k] * c[k]; }
+    }
+    assert(c[length] == static_cast<ENTRY_T>(0));
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_KRYLOV_BASIS_HPP_INCLUDED
@@ -0,0 +1,241 @@
+#include "LSQRSolver.hpp"
+
+#include <cassert> // for assert
+
+#include "FusedVectorOperations.hpp" // for FusedVectorOperations
+#include "LSQRSolverTasks.hpp"       // for LSQRStepTask, LSQRComponent
+#include "LibraryOptions.hpp"        // for LEGION_SOLVERS_USE_*, ...
+#include "PackedScalars.hpp"         // for PackedScalars
+#include "Scalar.hpp"                // for Scalar
+
+using LegionSolvers::LSQRSolver;
+using LegionSolvers::LSQRStepTask;
+using LegionSolvers::LSQRStopReason;
+using LegionSolvers::PackedScalars;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+LSQRSolver<ENTRY_T, DIM, COORD_T>::LSQRSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition range_partition,
+    Legion::IndexPartition domain_partition,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), check_interval(check_interval),
+      rhs(ctx, rt, rhs_region, rhs_fid, range_partition),
+      solution(ctx, rt, solution_region, solution_fid, domain_partition),
+      u(ctx, rt, range_partition), range_scratch(ctx, rt, range_partition),
+      v(ctx, rt, domain_partition), w(ctx, rt, domain_partition),
+      domain_scratch(ctx, rt, domain_partition),
+      stop_reason(LSQRStopReason::MAX_ITERATIONS),
+      residual_norm(static_cast<ENTRY_T>(0)),
+      normal_residual_norm(static_cast<ENTRY_T>(0)),
+      matrix_norm(static_cast<ENTRY_T>(0)),
+      condition(static_cast<ENTRY_T>(0)) {
+    assert(check_interval > 0);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future LSQRSolver<ENTRY_T, DIM, COORD_T>::step(
+    const std::vector<Legion::Future> &futures
+) const {
+    Legion::TaskLauncher launcher{
+        LSQRStepTask<ENTRY_T>::task_id, Legion::TaskArgument{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const Legion::Future &future : futures) {
+        launcher.add_future(future);
+    }
+    return rt->execute_task(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t LSQRSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T atol, ENTRY_T btol, ENTRY_T conlim
+) {
+    using Operations = FusedVectorOperations<ENTRY_T, DIM, COORD_T>;
+    const auto component = [&](const Legion::Future &state,
+                               LSQRComponent index) {
+        return Scalar<ENTRY_T>::packed(ctx, rt, state, index);
+    };
+    const ENTRY_T zero = static_cast<ENTRY_T>(0);
+
+    // u = b - A * x; v = A^T u, from v = 0, as in the steps below.
+    matrix.matvec(
+        range_scratch.get_logical_region(),
+        range_scratch.get_fid(),
+        solution.get_logical_region(),
+        solution.get_fid()
+    );
+    u.copy(rhs);
+    Operations initial_range{ctx, rt};
+    initial_range.axpy(
+        u, Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-1)}, range_scratch
+    );
+    initial_range.dot(u, u);
+    initial_range.dot(rhs, rhs);
+    Legion::Future range_dots = initial_range.execute();
+    v.constant_fill(zero);
+    w.constant_fill(zero);
+
+    Legion::Future state;
+    std::size_t iteration = 0;
+    while (true) {
+        // v = A^T u - (u, u) * v
+        matrix.transpose_matvec(
+            domain_scratch.get_logical_region(),
+            domain_scratch.get_fid(),
+            u.get_logical_region(),
+            u.get_fid()
+        );
+        const Scalar<ENTRY_T> u_u =
+            Scalar<ENTRY_T>::packed(ctx, rt, range_dots, 0);
+        Operations domain{ctx, rt};
+        if (iteration == 0) {
+            domain.xpay(v, -u_u, domain_scratch);
+            domain.dot(v, v);
+            domain.dot(solution, solution);
+            state = step({range_dots, domain.execute()});
+        } else {
+            // x_{i-1} = x_{i-2} + x_step * w_{i-1};
+            // w_i = v_i + w_step * w_{i-1}, with v_i = v / |v|.
+            domain.axpy(solution, component(state, LSQR_X_STEP), w);
+            domain.scal(v, component(state, LSQR_ALPHA_INVERSE));
+            domain.xpay(w, component(state, LSQR_W_STEP), v);
+            domain.xpay(v, -u_u, domain_scratch);
+            domain.dot(v, v);
+            domain.dot(w, w);
+            domain.dot(solution, solution);
+            domain.dot(solution, w);
+            state = step({state, range_dots, domain.execute()});
+        }
+
+        const bool last = (iteration == max_iterations);
+        if (last || (iteration % check_interval == 0)) {
+            const PackedScalars<ENTRY_T> values =
+                state.get_result<PackedScalars<ENTRY_T>>();
+            residual_norm = values.values[LSQR_RESIDUAL_NORM];
+            normal_residual_norm = values.values[LSQR_NORMAL_RESIDUAL_NORM];
+            matrix_norm = values.values[LSQR_MATRIX_NORM];
+            condition = values.values[LSQR_CONDITION];
+            const ENTRY_T rhs_norm = values.values[LSQR_RHS_NORM];
+            const ENTRY_T solution_norm = values.values[LSQR_SOLUTION_NORM];
+            bool done = true;
+            if (residual_norm <=
+                btol * rhs_norm + atol * matrix_norm * solution_norm) {
+                stop_reason = LSQRStopReason::RESIDUAL;
+            } else if (normal_residual_norm <=
+                       atol * matrix_norm * residual_norm) {
+                stop_reason = LSQRStopReason::LEAST_SQUARES;
+            } else if ((conlim > zero) && (condition >= conlim)) {
+                stop_reason = LSQRStopReason::CONDITION;
+            } else {
+                stop_reason = LSQRStopReason::MAX_ITERATIONS;
+                done = last;
+            }
+            if (done) {
+                // x_i = x_{i-1} + x_step * w_i
+                if (iteration > 0) {
+                    solution.axpy(component(state, LSQR_X_STEP), w);
+                }
+                return iteration;
+            }
+        }
+
+        // u = A * v_i - alpha_i * u_i, with v_i = v / |v| and
+        // u_i = u / |u|.
+        matrix.matvec(
+            range_scratch.get_logical_region(),
+            range_scratch.get_fid(),
+            v.get_logical_region(),
+            v.get_fid()
+        );
+        Operations range{ctx, rt};
+        range.scal(range_scratch, component(state, LSQR_ALPHA_INVERSE));
+        range.scal(u, component(state, LSQR_BETA_INVERSE));
+        range.xpay(u, -component(state, LSQR_ALPHA), range_scratch);
+        range.dot(u, u);
+        range_dots = range.execute();
+        ++iteration;
+    }
+}
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LSQRSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LSQRSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LSQRSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
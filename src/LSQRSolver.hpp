@@ -0,0 +1,114 @@
+#ifndef LEGION_SOLVERS_LSQR_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_LSQR_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+
+namespace LegionSolvers {
+
+
+// Which stopping rule of LSQRSolver::solve was satisfied.
+enum class LSQRStopReason : std::uint8_t {
+    MAX_ITERATIONS,
+    RESIDUAL,       // |r| <= btol * |b| + atol * |A| * |x|
+    LEAST_SQUARES,  // |A^T r| <= atol * |A| * |r|
+    CONDITION,      // cond(A) >= conlim
+}; // enum class LSQRStopReason
+
+
+// Solves the least-squares problem min |b - A * x| for a linear operator A of
+// any shape by LSQR (Paige and Saunders), which applies CG to the normal
+// equations A^T A x = A^T b implicitly, through Golub-Kahan
+// bidiagonalization, without forming A^T A or squaring its condition
+// number. The right-hand side b lives in the range of A and is divided into
+// pieces by range_partition; the solution x, which supplies the initial
+// guess, lives in the domain of A and is divided by domain_partition.
+//
+// Each step applies A and A^T once (see
+// AbstractLinearOperator::transpose_matvec) and issues one fused launch on
+// each side (see FusedVectorOperations): the update of u with its norm on
+// the range side, and the updates of x, w, and v with the norms and inner
+// products that the estimates need on the domain side. The scalar
+// recurrences, including the plane rotations and the estimates of |r|,
+// |A^T r|, |A|, cond(A), and |x|, are advanced by one LSQRStepTask per step
+// from the futures of the two reductions, so the bidiagonalization scalars
+// stay in futures and the solver blocks only to test the stopping rules,
+// every check_interval steps.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class LSQRSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const std::size_t check_interval;
+    const Vector rhs;
+    Vector solution;
+    Vector u, range_scratch;       // range space
+    Vector v, w, domain_scratch;   // domain space
+    LSQRStopReason stop_reason;
+    ENTRY_T residual_norm;
+    ENTRY_T normal_residual_norm;
+    ENTRY_T matrix_norm;
+    ENTRY_T condition;
+
+    // Launches an LSQRStepTask on the given futures.
+    Legion::Future step(const std::vector<Legion::Future> &futures) const;
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 10;
+
+    explicit LSQRSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition range_partition,
+        Legion::IndexPartition domain_partition,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    LSQRSolver(const LSQRSolver &) = delete;
+
+    LSQRSolver &operator=(const LSQRSolver &) = delete;
+
+    // Iterates until one of the stopping rules of LSQRStopReason holds, as
+    // observed at a check, or until max_iterations steps have been
+    // performed. A conlim of zero disables the condition number test.
+    // Returns the number of steps.
+    std::size_t solve(
+        std::size_t max_iterations,
+        ENTRY_T atol,
+        ENTRY_T btol,
+        ENTRY_T conlim = static_cast<ENTRY_T>(0)
+    );
+
+    LSQRStopReason get_stop_reason() const { return stop_reason; }
+
+    // Estimates of |b - A * x| and |A^T (b - A * x)| when solve returned.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+    ENTRY_T get_normal_residual_norm() const { return normal_residual_norm; }
+
+    // Estimates of the Frobenius norm and condition number of A.
+    ENTRY_T get_matrix_norm() const { return matrix_norm; }
+
+    ENTRY_T get_condition() const { return condition; }
+
+}; // class LSQRSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_LSQR_SOLVER_HPP_INCLUDED
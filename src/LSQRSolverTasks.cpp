@@ -0,0 +1,121 @@
+#include "LSQRSolverTasks.hpp"
+
+#include <algorithm> // for std::max
+#include <cassert>   // for assert
+#include <cmath>     // for std::abs, std::hypot, std::sqrt
+#include <cstddef>   // for std::size_t
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::LSQRStepTask;
+using LegionSolvers::PackedScalars;
+
+
+template <typename T>
+PackedScalars<T> LSQRStepTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    static_assert(LSQR_NUM_COMPONENTS <= LEGION_SOLVERS_MAX_PACKED_SCALARS);
+
+    const T zero = static_cast<T>(0);
+    const T one = static_cast<T>(1);
+    const auto norm = [&](T squared) {
+        return std::sqrt(std::max(squared, zero));
+    };
+    const auto inverse = [&](T value) {
+        return (value > zero) ? one / value : zero;
+    };
+
+    assert((task->futures.size() == 2) || (task->futures.size() == 3));
+    const bool initial = (task->futures.size() == 2);
+    const std::size_t first = initial ? 0 : 1;
+    const PackedScalars<T> range =
+        task->futures[first].get_result<PackedScalars<T>>();
+    const PackedScalars<T> domain =
+        task->futures[first + 1].get_result<PackedScalars<T>>();
+
+    // u = beta * u_{i+1} and v = beta * alpha * v_{i+1}.
+    const T beta = norm(range.values[0]);
+    const T v_norm = norm(domain.values[0]);
+    const T alpha = (beta > zero) ? v_norm / beta : zero;
+
+    PackedScalars<T> state{};
+    if (initial) {
+        state.values[LSQR_ALPHA] = alpha;
+        state.values[LSQR_ALPHA_INVERSE] = inverse(v_norm);
+        state.values[LSQR_BETA_INVERSE] = inverse(beta);
+        state.values[LSQR_RHO_BAR] = alpha;
+        state.values[LSQR_PHI_BAR] = beta;
+        state.values[LSQR_RHS_NORM] = norm(range.values[1]);
+        state.values[LSQR_RESIDUAL_NORM] = beta;
+        state.values[LSQR_NORMAL_RESIDUAL_NORM] = alpha * beta;
+        state.values[LSQR_SOLUTION_NORM] = norm(domain.values[1]);
+        return state;
+    }
+
+    state = task->futures[0].get_result<PackedScalars<T>>();
+    const T w_w = domain.values[1];
+    const T x_x = domain.values[2];
+    const T x_w = domain.values[3];
+    const T previous_alpha = state.values[LSQR_ALPHA];
+    const T rho_bar = state.values[LSQR_RHO_BAR];
+    const T phi_bar = state.values[LSQR_PHI_BAR];
+
+    // Plane rotation eliminating beta_{i+1} from the lower bidiagonal.
+    const T rho = std::hypot(rho_bar, beta);
+    const T c = (rho > zero) ? rho_bar / rho : one;
+    const T s = (rho > zero) ? beta / rho : zero;
+    const T theta = s * alpha;
+    const T phi = c * phi_bar;
+    const T x_step = phi * inverse(rho);
+
+    const T matrix_norm_squared = state.values[LSQR_MATRIX_NORM_SQUARED] +
+                                  previous_alpha * previous_alpha +
+                                  beta * beta;
+    const T direction_norm_squared =
+        state.values[LSQR_DIRECTION_NORM_SQUARED] +
+        w_w * inverse(rho) * inverse(rho);
+
+    state.values[LSQR_ALPHA] = alpha;
+    state.values[LSQR_ALPHA_INVERSE] = inverse(v_norm);
+    state.values[LSQR_BETA_INVERSE] = inverse(beta);
+    state.values[LSQR_X_STEP] = x_step;
+    state.values[LSQR_W_STEP] = -theta * inverse(rho);
+    state.values[LSQR_RHO_BAR] = -c * alpha;
+    state.values[LSQR_PHI_BAR] = s * phi_bar;
+    state.values[LSQR_MATRIX_NORM_SQUARED] = matrix_norm_squared;
+    state.values[LSQR_DIRECTION_NORM_SQUARED] = direction_norm_squared;
+    state.values[LSQR_RESIDUAL_NORM] = s * phi_bar;
+    state.values[LSQR_NORMAL_RESIDUAL_NORM] =
+        s * phi_bar * alpha * std::abs(c);
+    state.values[LSQR_MATRIX_NORM] = norm(matrix_norm_squared);
+    state.values[LSQR_CONDITION] =
+        norm(matrix_norm_squared) * norm(direction_norm_squared);
+    // x_i = x_{i-1} + x_step * w_i
+    state.values[LSQR_SOLUTION_NORM] =
+        norm(x_x + 2 * x_step * x_w + x_step * x_step * w_w);
+    return state;
+}
+
+
+#ifdef LEGION_SOLVERS_USE_FLOAT
+template PackedScalars<float> LSQRStepTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_FLOAT
+
+
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+template PackedScalars<double> LSQRStepTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_DOUBLE
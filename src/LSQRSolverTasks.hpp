@@ -0,0 +1,77 @@
+#ifndef LEGION_SOLVERS_LSQR_SOLVER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_LSQR_SOLVER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PackedScalars.hpp"   // for PackedScalars
+#include "TaskBaseClasses.hpp" // for TaskT
+#include "TaskIDs.hpp"         // for LSQR_STEP_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Components of the LSQR state returned by LSQRStepTask after step i, in
+// the notation of Paige and Saunders. The first five are the coefficients of
+// the vector updates of the next step; the last five are the estimates
+// tested by the stopping rules.
+enum LSQRComponent : std::uint32_t {
+    LSQR_ALPHA,         // alpha_{i+1}
+    LSQR_ALPHA_INVERSE, // inverse of the norm of the unnormalized v_{i+1}
+    LSQR_BETA_INVERSE,  // inverse of the norm of the unnormalized u_{i+1}
+    LSQR_X_STEP,        // phi_i / rho_i
+    LSQR_W_STEP,        // -theta_{i+1} / rho_i
+    LSQR_RHO_BAR,
+    LSQR_PHI_BAR,
+    LSQR_MATRIX_NORM_SQUARED,
+    LSQR_DIRECTION_NORM_SQUARED, // sum of |w_k / rho_k|^2 for k <= i
+    LSQR_RHS_NORM,               // |b|
+    LSQR_RESIDUAL_NORM,          // |b - A x_i|
+    LSQR_NORMAL_RESIDUAL_NORM,   // |A^T (b - A x_i)|
+    LSQR_MATRIX_NORM,            // Frobenius norm estimate of A
+    LSQR_CONDITION,              // condition number estimate of A
+    LSQR_SOLUTION_NORM,          // |x_i|
+    LSQR_NUM_COMPONENTS,
+}; // enum LSQRComponent
+
+
+// Advances the scalar recurrences of LSQR by one step of Golub-Kahan
+// bidiagonalization, given the reductions of the step as futures, and
+// returns the new state, packed as in LSQRComponent. The vectors u and v of
+// the bidiagonalization are kept unnormalized, as u = beta * u_{i+1} and
+// v = beta * alpha * v_{i+1}, so that the launches that produce them need no
+// coefficient that is not yet known; their norms are normalized away here.
+//
+// With three futures, they are the state after step i - 1 and the
+// PackedScalars<T> holding (u, u) in component 0 and (v, v), (w_i, w_i),
+// (x_{i-1}, x_{i-1}), and (x_{i-1}, w_i) in components 0 to 3. With two,
+// they are the reductions of the initialization, (u, u) and (b, b), and
+// (v, v) and (x_0, x_0), and the task returns the state after step 0.
+// Vanishing norms (breakdown at an exact solution) give zero inverses.
+template <typename T>
+struct LSQRStepTask
+    : public TaskT<LSQR_STEP_TASK_BLOCK_ID, LSQRStepTask, T> {
+
+    static constexpr const char *task_base_name = "lsqr_step";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = PackedScalars<T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct LSQRStepTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_LSQR_SOLVER_TASKS_HPP_INCLUDED
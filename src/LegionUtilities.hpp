@@ -93,15 +93,15 @@ template <void (*TASK_PTR)(const Legion::Task *,
 void preregister_task(Legion::TaskID task_id,
                       const std::string &task_name,
                       TaskFlags task_flags,
-                      bool verbose = true) {
+                      bool verbose = true,
+                      Legion::Processor::Kind proc_kind =
+                          Legion::Processor::LOC_PROC) {
     if (verbose) {
         std::cout << "[LegionSolvers] Registering task " << task_name
                   << " with ID " << task_id << "." << std::endl;
     }
     Legion::TaskVariantRegistrar registrar{task_id, task_name.c_str()};
-    registrar.add_constraint(
-        Legion::ProcessorConstraint{Legion::Processor::LOC_PROC}
-    );
+    registrar.add_constraint(Legion::ProcessorConstraint{proc_kind});
     registrar.set_leaf(task_flags & TaskFlags::LEAF);
     registrar.set_inner(task_flags & TaskFlags::INNER);
     registrar.set_idempotent(task_flags & TaskFlags::IDEMPOTENT);
@@ -144,15 +144,15 @@ template <typename RETURN_T,
 void preregister_task(Legion::TaskID task_id,
                       const std::string &task_name,
                       TaskFlags task_flags,
-                      bool verbose = true) {
+                      bool verbose = true,
+                      Legion::Processor::Kind proc_kind =
+                          Legion::Processor::LOC_PROC) {
     if (verbose) {
         std::cout << "[LegionSolvers] Registering task " << task_name
                   << " with ID " << task_id << "." << std::endl;
     }
     Legion::TaskVariantRegistrar registrar{task_id, task_name.c_str()};
-    registrar.add_constraint(
-        Legion::ProcessorConstraint{Legion::Processor::LOC_PROC}
-    );
+    registrar.add_constraint(Legion::ProcessorConstraint{proc_kind});
     registrar.set_leaf(task_flags & TaskFlags::LEAF);
     registrar.set_inner(task_flags & TaskFlags::INNER);
     registrar.set_idempotent(task_flags & TaskFlags::IDEMPOTENT);
@@ -179,6 +179,14 @@ Legion::FieldSpace create_field_space(
 );
 
 
+// OMP_PROC task variants split their dense loops across the processor's
+// threads.
+inline bool is_omp_processor(Legion::Context ctx, Legion::Runtime *rt) {
+    return rt->get_executing_processor(ctx).kind() ==
+           Legion::Processor::OMP_PROC;
+}
+
+
 // void print_index_partition(
 //     Legion::Context ctx, Legion::Runtime *rt,
 //     const std::string &name,
@@ -15,6 +15,13 @@ namespace LegionSolvers {
 #define LEGION_SOLVERS_USE_S64_INDICES true
 
 
+// OMP_PROC task variants are registered when Realm provides OpenMP processors
+// and the library is compiled with OpenMP enabled.
+#if defined(REALM_USE_OPENMP) && defined(_OPENMP)
+    #define LEGION_SOLVERS_USE_OPENMP true
+#endif
+
+
 #ifdef NDEBUG
 constexpr bool LEGION_SOLVERS_CHECK_BOUNDS = false;
 #else
@@ -37,6 +44,98 @@ constexpr Legion::ProjectionID LEGION_SOLVERS_PROJECTION_ID_ORIGIN = 10'000;
 #endif // LEGION_SOLVERS_PROJECTION_ID_ORIGIN
 
 
+#ifndef LEGION_SOLVERS_REDOP_ID_ORIGIN
+constexpr Legion::ReductionOpID LEGION_SOLVERS_REDOP_ID_ORIGIN = 1'000;
+#endif // LEGION_SOLVERS_REDOP_ID_ORIGIN
+
+
+#ifndef LEGION_SOLVERS_MAX_PACKED_SCALARS
+// Capacity of PackedScalars, i.e., the largest number of reductions that a
+// fused task can return in a single future.
+constexpr int LEGION_SOLVERS_MAX_PACKED_SCALARS = 64;
+#endif // LEGION_SOLVERS_MAX_PACKED_SCALARS
+
+
+#ifndef LEGION_SOLVERS_MAX_FUSED_UPDATES
+// Largest number of vector updates performed by one MultiUpdateDotTask, and
+// of vectors written by one LinearCombinationTask.
+constexpr int LEGION_SOLVERS_MAX_FUSED_UPDATES = 16;
+#endif // LEGION_SOLVERS_MAX_FUSED_UPDATES
+
+
+#ifndef LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH
+// Largest number of matrix-vector products computed by one matrix-powers
+// kernel launch, i.e., the largest step count s of s-step Krylov methods.
+// The Gram matrix of an s-step CG basis, with (2s + 1)(2s + 2) / 2 distinct
+// entries, must fit in one PackedScalars.
+constexpr int LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH = 4;
+#endif // LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH
+
+
+#ifndef LEGION_SOLVERS_MAX_BLOCK_SIZE
+// Largest number of vectors in a MultiVector, i.e., the largest number of
+// right-hand sides solved together by the block Krylov solvers. A k-by-k
+// block of scalars (see BlockScalars) has LEGION_SOLVERS_MAX_BLOCK_SIZE^2
+// entries, so larger values make every block reduction more expensive.
+constexpr std::size_t LEGION_SOLVERS_MAX_BLOCK_SIZE = 16;
+#endif // LEGION_SOLVERS_MAX_BLOCK_SIZE
+
+
+#ifndef LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH
+// Largest number of instructions in a ScalarProgram. Longer Scalar
+// expressions are evaluated in several steps.
+constexpr std::size_t LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH = 32;
+#endif // LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH
+
+
+#ifndef LEGION_SOLVERS_DOT_BLOCK_SIZE
+// Number of entries summed by each block of the blocked dot product kernel.
+// Two blocks of double-precision operands should fit in L1 cache.
+constexpr std::size_t LEGION_SOLVERS_DOT_BLOCK_SIZE = 1'024;
+#endif // LEGION_SOLVERS_DOT_BLOCK_SIZE
+
+
+#ifndef LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE
+// Number of nonzero entries ahead of the current one whose input vector
+// entries are prefetched by the sparse matrix-vector product kernels.
+constexpr std::size_t LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE = 32;
+#endif // LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE
+
+
+#ifndef LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT
+// Largest chunk height C of a SELL-C-sigma matrix.
+constexpr std::size_t LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT = 64;
+#endif // LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT
+
+
+#ifndef LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE
+// Number of bytes of a Matrix Market file read at a time by each reader
+// task, which bounds its memory use regardless of the size of the file.
+constexpr std::size_t LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE = 1 << 22;
+#endif // LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE
+
+
+#ifndef LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE
+// Number of bytes of a binary sparse matrix file written at a time by each
+// writer task, which bounds the staging buffer it needs.
+constexpr std::size_t LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE = 1 << 22;
+#endif // LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE
+
+
+#ifndef LEGION_SOLVERS_STENCIL_LINE_BLOCK
+// Number of points along the first dimension of the tiles that stencil
+// operators sweep through the remaining dimensions. The input planes of a
+// tile should fit in L2 cache.
+constexpr std::size_t LEGION_SOLVERS_STENCIL_LINE_BLOCK = 256;
+#endif // LEGION_SOLVERS_STENCIL_LINE_BLOCK
+
+
+#ifndef LEGION_SOLVERS_STENCIL_TILE_HEIGHT
+// Number of lines along the second dimension of the same tiles.
+constexpr std::size_t LEGION_SOLVERS_STENCIL_TILE_HEIGHT = 16;
+#endif // LEGION_SOLVERS_STENCIL_TILE_HEIGHT
+
+
 #ifndef LEGION_SOLVERS_MAX_DIM
     #define LEGION_SOLVERS_MAX_DIM 3
 #endif // LEGION_SOLVERS_MAX_DIM
@@ -49,6 +148,15 @@ static_assert(
 );
 
 
+static_assert(
+    (2 * LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH + 1) *
+            (2 * LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH + 2) / 2 <=
+        LEGION_SOLVERS_MAX_PACKED_SCALARS,
+    "The Gram matrix of an s-step CG basis of the largest supported length "
+    "does not fit in LEGION_SOLVERS_MAX_PACKED_SCALARS scalars."
+);
+
+
 static_assert(
     LEGION_SOLVERS_MAX_DIM <= LEGION_MAX_DIM,
     "Legion was not compiled with LEGION_MAX_DIM large enough to "
@@ -1,38 +1,80 @@
 #include "LinearAlgebraTasks.hpp"
 
-#include <cassert> // for assert
-#include <cmath>   // for std::fma
-#include <vector>  // for std::vector
+#include <algorithm> // for std::min
+#include <cassert>   // for assert
+#include <cmath>     // for std::fma
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint32_t
+#include <vector>    // for std::vector
 
-#include "LegionUtilities.hpp" // for AffineReader, AffineWriter, ...
+#include "LegionUtilities.hpp" // for AffineReader, is_omp_processor, ...
 #include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*
+#include "ScalarProgram.hpp"   // for ScalarProgram, evaluate_scalar_program
+#include "VectorKernels.hpp"   // for is_dense_rect, dense_*
 
+using LegionSolvers::AxpyConvertTask;
+using LegionSolvers::AxpyDotTask;
 using LegionSolvers::AxpyTask;
+using LegionSolvers::CoefficientFutures;
+using LegionSolvers::ConvertTask;
+using LegionSolvers::DotProductAccumulator;
+using LegionSolvers::DotProductMode;
 using LegionSolvers::DotTask;
+using LegionSolvers::LinearCombinationArgs;
+using LegionSolvers::LinearCombinationMode;
+using LegionSolvers::LinearCombinationOutput;
+using LegionSolvers::LinearCombinationTask;
+using LegionSolvers::MultiUpdateDotArgs;
+using LegionSolvers::MultiUpdateDotTask;
+using LegionSolvers::OtherPrecision;
+using LegionSolvers::PackedScalars;
 using LegionSolvers::ScalTask;
+using LegionSolvers::ScalarProgram;
+using LegionSolvers::VectorDotProduct;
+using LegionSolvers::VectorUpdate;
+using LegionSolvers::VectorUpdateKind;
+using LegionSolvers::XpayAxpyArgs;
+using LegionSolvers::XpayAxpyTask;
 using LegionSolvers::XpayTask;
+using LegionSolvers::dense_axpy;
+using LegionSolvers::dense_axpy_convert;
+using LegionSolvers::dense_convert;
+using LegionSolvers::dense_scal;
+using LegionSolvers::dense_xpay;
+using LegionSolvers::dense_xpay_axpy;
+using LegionSolvers::evaluate_scalar_program;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+using LegionSolvers::max_thread_ranges;
 
 
+// Combines futures[first : first + count] into a single coefficient.
 template <typename ENTRY_T>
-inline ENTRY_T get_alpha(const std::vector<Legion::Future> &futures) {
-    if (futures.size() == 0) {
+inline ENTRY_T get_alpha(
+    const std::vector<Legion::Future> &futures,
+    std::size_t first,
+    std::size_t count
+) {
+    assert(first + count <= futures.size());
+    if (count == 0) {
         return static_cast<ENTRY_T>(1);
-    } else if (futures.size() == 1) {
-        return futures[0].get_result<ENTRY_T>();
-    } else if (futures.size() == 2) {
-        const ENTRY_T f0 = futures[0].get_result<ENTRY_T>();
-        const ENTRY_T f1 = futures[1].get_result<ENTRY_T>();
+    } else if (count == 1) {
+        return futures[first].get_result<ENTRY_T>();
+    } else if (count == 2) {
+        const ENTRY_T f0 = futures[first].get_result<ENTRY_T>();
+        const ENTRY_T f1 = futures[first + 1].get_result<ENTRY_T>();
         return f0 / f1;
-    } else if (futures.size() == 3) {
-        const ENTRY_T f0 = futures[0].get_result<ENTRY_T>();
-        const ENTRY_T f1 = futures[1].get_result<ENTRY_T>();
-        const ENTRY_T f2 = futures[2].get_result<ENTRY_T>();
+    } else if (count == 3) {
+        const ENTRY_T f0 = futures[first].get_result<ENTRY_T>();
+        const ENTRY_T f1 = futures[first + 1].get_result<ENTRY_T>();
+        const ENTRY_T f2 = futures[first + 2].get_result<ENTRY_T>();
         return f0 * f1 / f2;
-    } else if (futures.size() == 4) {
-        const ENTRY_T f0 = futures[0].get_result<ENTRY_T>();
-        const ENTRY_T f1 = futures[1].get_result<ENTRY_T>();
-        const ENTRY_T f2 = futures[2].get_result<ENTRY_T>();
-        const ENTRY_T f3 = futures[3].get_result<ENTRY_T>();
+    } else if (count == 4) {
+        const ENTRY_T f0 = futures[first].get_result<ENTRY_T>();
+        const ENTRY_T f1 = futures[first + 1].get_result<ENTRY_T>();
+        const ENTRY_T f2 = futures[first + 2].get_result<ENTRY_T>();
+        const ENTRY_T f3 = futures[first + 3].get_result<ENTRY_T>();
         return f0 * f1 / (f2 * f3);
     } else {
         assert(false);
@@ -41,6 +83,50 @@ inline ENTRY_T get_alpha(const std::vector<Legion::Future> &futures) {
 }
 
 
+template <typename ENTRY_T>
+inline ENTRY_T get_alpha(const std::vector<Legion::Future> &futures) {
+    return get_alpha<ENTRY_T>(futures, 0, futures.size());
+}
+
+
+template <typename ENTRY_T>
+inline ENTRY_T get_alpha(
+    const std::vector<Legion::Future> &futures,
+    const CoefficientFutures &coefficient
+) {
+    return get_alpha<ENTRY_T>(futures, coefficient.first, coefficient.count);
+}
+
+
+// ScalTask, AxpyTask, and XpayTask take their coefficient either from the task
+// futures, as in get_alpha, or by evaluating a ScalarProgram passed as the
+// task argument on the task futures.
+template <typename ENTRY_T>
+inline ENTRY_T get_coefficient(const Legion::Task *task) {
+    if (task->arglen == sizeof(ScalarProgram<ENTRY_T>)) {
+        return evaluate_scalar_program(
+            *static_cast<const ScalarProgram<ENTRY_T> *>(task->args),
+            task->futures
+        );
+    } else {
+        assert(task->arglen == 0);
+        return get_alpha<ENTRY_T>(task->futures);
+    }
+}
+
+
+// DotTask and AxpyDotTask accept an optional DotProductMode as their task
+// argument.
+inline DotProductMode get_dot_product_mode(const Legion::Task *task) {
+    if (task->arglen == sizeof(DotProductMode)) {
+        return *static_cast<const DotProductMode *>(task->args);
+    } else {
+        assert(task->arglen == 0);
+        return DotProductMode::BLOCKED;
+    }
+}
+
+
 template <typename ENTRY_T, int DIM, typename COORD_T>
 void ScalTask<ENTRY_T, DIM, COORD_T>::task_body(
     const Legion::Task *task,
@@ -57,7 +143,8 @@ void ScalTask<ENTRY_T, DIM, COORD_T>::task_body(
     assert(x_req.privilege_fields.size() == 1);
     const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
 
-    const ENTRY_T alpha = get_alpha<ENTRY_T>(task->futures);
+    const ENTRY_T alpha = get_coefficient<ENTRY_T>(task);
+    const bool parallel = is_omp_processor(ctx, rt);
 
     AffineReaderWriter<ENTRY_T, DIM, COORD_T> x_reader_writer(x, x_fid);
 
@@ -69,6 +156,18 @@ void ScalTask<ENTRY_T, DIM, COORD_T>::task_body(
 
     for (RectIterator rect_iter(x_domain); rect_iter(); ++rect_iter) {
         const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, x_reader_writer)) {
+            ENTRY_T *x_ptr = x_reader_writer.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_scal(end - begin, alpha, x_ptr + begin);
+                }
+            );
+            continue;
+        }
         for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
             const Legion::Point<DIM, COORD_T> point = *point_iter;
             x_reader_writer[point] = alpha * x_reader_writer[point];
@@ -98,7 +197,8 @@ void AxpyTask<ENTRY_T, DIM, COORD_T>::task_body(
     assert(x_req.privilege_fields.size() == 1);
     const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
 
-    const ENTRY_T alpha = get_alpha<ENTRY_T>(task->futures);
+    const ENTRY_T alpha = get_coefficient<ENTRY_T>(task);
+    const bool parallel = is_omp_processor(ctx, rt);
 
     AffineReaderWriter<ENTRY_T, DIM, COORD_T> y_reader_writer{y, y_fid};
     AffineReader<ENTRY_T, DIM, COORD_T> x_reader{x, x_fid};
@@ -116,6 +216,21 @@ void AxpyTask<ENTRY_T, DIM, COORD_T>::task_body(
 
     for (RectIterator rect_iter(x_domain); rect_iter(); ++rect_iter) {
         const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_reader_writer, x_reader)) {
+            const ENTRY_T *x_ptr = x_reader.ptr(rect.lo);
+            ENTRY_T *y_ptr = y_reader_writer.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_axpy(
+                        end - begin, alpha, x_ptr + begin, y_ptr + begin
+                    );
+                }
+            );
+            continue;
+        }
         for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
             const Legion::Point<DIM, COORD_T> point = *point_iter;
             y_reader_writer[point] =
@@ -146,7 +261,8 @@ void XpayTask<ENTRY_T, DIM, COORD_T>::task_body(
     assert(x_req.privilege_fields.size() == 1);
     const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
 
-    const ENTRY_T alpha = get_alpha<ENTRY_T>(task->futures);
+    const ENTRY_T alpha = get_coefficient<ENTRY_T>(task);
+    const bool parallel = is_omp_processor(ctx, rt);
 
     AffineReaderWriter<ENTRY_T, DIM, COORD_T> y_reader_writer{y, y_fid};
     AffineReader<ENTRY_T, DIM, COORD_T> x_reader{x, x_fid};
@@ -164,6 +280,21 @@ void XpayTask<ENTRY_T, DIM, COORD_T>::task_body(
 
     for (RectIterator rect_iter(x_domain); rect_iter(); ++rect_iter) {
         const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_reader_writer, x_reader)) {
+            const ENTRY_T *x_ptr = x_reader.ptr(rect.lo);
+            ENTRY_T *y_ptr = y_reader_writer.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_xpay(
+                        end - begin, alpha, x_ptr + begin, y_ptr + begin
+                    );
+                }
+            );
+            continue;
+        }
         for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
             const Legion::Point<DIM, COORD_T> point = *point_iter;
             y_reader_writer[point] =
@@ -173,6 +304,137 @@ void XpayTask<ENTRY_T, DIM, COORD_T>::task_body(
 }
 
 
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void ConvertTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using SOURCE_T = typename OtherPrecision<ENTRY_T>::type;
+
+    assert(regions.size() == 2);
+    const auto &y = regions[0];
+    const auto &x = regions[1];
+
+    assert(task->regions.size() == 2);
+    const auto &y_req = task->regions[0];
+    const auto &x_req = task->regions[1];
+
+    assert(y_req.privilege_fields.size() == 1);
+    const Legion::FieldID y_fid = *y_req.privilege_fields.begin();
+
+    assert(x_req.privilege_fields.size() == 1);
+    const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> y_writer{y, y_fid};
+    AffineReader<SOURCE_T, DIM, COORD_T> x_reader{x, x_fid};
+
+    const Legion::Domain y_domain =
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space());
+
+    const Legion::Domain x_domain =
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space());
+
+    assert(y_domain == x_domain);
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+
+    for (RectIterator rect_iter(x_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_writer, x_reader)) {
+            const SOURCE_T *x_ptr = x_reader.ptr(rect.lo);
+            ENTRY_T *y_ptr = y_writer.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_convert(end - begin, x_ptr + begin, y_ptr + begin);
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            y_writer[point] = static_cast<ENTRY_T>(x_reader[point]);
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void AxpyConvertTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using SOURCE_T = typename OtherPrecision<ENTRY_T>::type;
+
+    assert(regions.size() == 2);
+    const auto &y = regions[0];
+    const auto &x = regions[1];
+
+    assert(task->regions.size() == 2);
+    const auto &y_req = task->regions[0];
+    const auto &x_req = task->regions[1];
+
+    assert(y_req.privilege_fields.size() == 1);
+    const Legion::FieldID y_fid = *y_req.privilege_fields.begin();
+
+    assert(x_req.privilege_fields.size() == 1);
+    const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
+
+    const ENTRY_T alpha = get_coefficient<ENTRY_T>(task);
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    AffineReaderWriter<ENTRY_T, DIM, COORD_T> y_reader_writer{y, y_fid};
+    AffineReader<SOURCE_T, DIM, COORD_T> x_reader{x, x_fid};
+
+    const Legion::Domain y_domain =
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space());
+
+    const Legion::Domain x_domain =
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space());
+
+    assert(y_domain == x_domain);
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+
+    for (RectIterator rect_iter(x_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_reader_writer, x_reader)) {
+            const SOURCE_T *x_ptr = x_reader.ptr(rect.lo);
+            ENTRY_T *y_ptr = y_reader_writer.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int, std::size_t begin, std::size_t end) {
+                    dense_axpy_convert(
+                        end - begin, alpha, x_ptr + begin, y_ptr + begin
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            y_reader_writer[point] = std::fma(
+                alpha,
+                static_cast<ENTRY_T>(x_reader[point]),
+                y_reader_writer[point]
+            );
+        }
+    }
+}
+
+
 template <typename ENTRY_T, int DIM, typename COORD_T>
 ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
     const Legion::Task *task,
@@ -208,15 +470,585 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
     using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
     using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
 
-    ENTRY_T result = static_cast<ENTRY_T>(0);
+    const DotProductMode mode = get_dot_product_mode(task);
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    // Each thread accumulates its own range; the per-thread results are then
+    // merged in thread order, so the result does not vary from run to run.
+    DotProductAccumulator<ENTRY_T> result{mode};
+    std::vector<DotProductAccumulator<ENTRY_T>> thread_results(
+        max_thread_ranges(parallel), DotProductAccumulator<ENTRY_T>{mode}
+    );
     for (RectIterator rect_iter(v_domain); rect_iter(); ++rect_iter) {
         const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, v_reader, w_reader)) {
+            const ENTRY_T *v_ptr = v_reader.ptr(rect.lo);
+            const ENTRY_T *w_ptr = w_reader.ptr(rect.lo);
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int thread, std::size_t begin, std::size_t end) {
+                    thread_results[thread].add_dense(
+                        end - begin, v_ptr + begin, w_ptr + begin
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            result.add(v_reader[point], w_reader[point]);
+        }
+    }
+    for (const auto &thread_result : thread_results) {
+        result.merge(thread_result);
+    }
+    return result.result();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+ENTRY_T AxpyDotTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert((regions.size() == 2) || (regions.size() == 3));
+    const auto &y = regions[0];
+    const auto &x = regions[1];
+
+    assert(task->regions.size() == regions.size());
+    const auto &y_req = task->regions[0];
+    const auto &x_req = task->regions[1];
+
+    assert(y_req.privilege_fields.size() == 1);
+    const Legion::FieldID y_fid = *y_req.privilege_fields.begin();
+
+    assert(x_req.privilege_fields.size() == 1);
+    const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
+
+    const ENTRY_T alpha = get_alpha<ENTRY_T>(task->futures);
+
+    AffineReaderWriter<ENTRY_T, DIM, COORD_T> y_reader_writer{y, y_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> x_reader{x, x_fid};
+
+    const Legion::Domain y_domain =
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space());
+
+    const Legion::Domain x_domain =
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space());
+
+    assert(y_domain == x_domain);
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+
+    DotProductAccumulator<ENTRY_T> result{get_dot_product_mode(task)};
+
+    if (regions.size() == 2) {
+        for (RectIterator rect_iter(y_domain); rect_iter(); ++rect_iter) {
+            const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+            if (rect.empty()) { continue; }
+            if (is_dense_rect(rect, y_reader_writer, x_reader)) {
+                const std::size_t n = rect.volume();
+                const ENTRY_T *x_ptr = x_reader.ptr(rect.lo);
+                ENTRY_T *y_ptr = y_reader_writer.ptr(rect.lo);
+                // Each block of y is still in cache when it is reduced.
+                for (std::size_t i = 0; i < n; i += B) {
+                    const std::size_t len = std::min(B, n - i);
+                    dense_axpy(len, alpha, x_ptr + i, y_ptr + i);
+                    result.add_dense(len, y_ptr + i, y_ptr + i);
+                }
+                continue;
+            }
+            for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+                const Legion::Point<DIM, COORD_T> point = *point_iter;
+                const ENTRY_T y_new =
+                    std::fma(alpha, x_reader[point], y_reader_writer[point]);
+                y_reader_writer[point] = y_new;
+                result.add(y_new, y_new);
+            }
+        }
+        return result.result();
+    }
+
+    const auto &z = regions[2];
+    const auto &z_req = task->regions[2];
+
+    assert(z_req.privilege_fields.size() == 1);
+    const Legion::FieldID z_fid = *z_req.privilege_fields.begin();
+
+    AffineReader<ENTRY_T, DIM, COORD_T> z_reader{z, z_fid};
+
+    const Legion::Domain z_domain =
+        rt->get_index_space_domain(ctx, z_req.region.get_index_space());
+
+    assert(y_domain == z_domain);
+
+    for (RectIterator rect_iter(y_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_reader_writer, x_reader, z_reader)) {
+            const std::size_t n = rect.volume();
+            const ENTRY_T *x_ptr = x_reader.ptr(rect.lo);
+            const ENTRY_T *z_ptr = z_reader.ptr(rect.lo);
+            ENTRY_T *y_ptr = y_reader_writer.ptr(rect.lo);
+            for (std::size_t i = 0; i < n; i += B) {
+                const std::size_t len = std::min(B, n - i);
+                dense_axpy(len, alpha, x_ptr + i, y_ptr + i);
+                result.add_dense(len, y_ptr + i, z_ptr + i);
+            }
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            const ENTRY_T y_new =
+                std::fma(alpha, x_reader[point], y_reader_writer[point]);
+            y_reader_writer[point] = y_new;
+            result.add(y_new, z_reader[point]);
+        }
+    }
+    return result.result();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void XpayAxpyTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 3);
+    const auto &y = regions[0];
+    const auto &x = regions[1];
+    const auto &z = regions[2];
+
+    assert(task->regions.size() == 3);
+    const auto &y_req = task->regions[0];
+    const auto &x_req = task->regions[1];
+    const auto &z_req = task->regions[2];
+
+    assert(y_req.privilege_fields.size() == 1);
+    const Legion::FieldID y_fid = *y_req.privilege_fields.begin();
+
+    assert(x_req.privilege_fields.size() == 1);
+    const Legion::FieldID x_fid = *x_req.privilege_fields.begin();
+
+    assert(z_req.privilege_fields.size() == 1);
+    const Legion::FieldID z_fid = *z_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(XpayAxpyArgs));
+    const XpayAxpyArgs &args = *static_cast<const XpayAxpyArgs *>(task->args);
+    const ENTRY_T beta = get_alpha<ENTRY_T>(task->futures, args.beta);
+    const ENTRY_T alpha = get_alpha<ENTRY_T>(task->futures, args.alpha);
+
+    AffineReaderWriter<ENTRY_T, DIM, COORD_T> y_reader_writer{y, y_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> x_reader{x, x_fid};
+    AffineReaderWriter<ENTRY_T, DIM, COORD_T> z_reader_writer{z, z_fid};
+
+    const Legion::Domain y_domain =
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space());
+
+    const Legion::Domain x_domain =
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space());
+
+    const Legion::Domain z_domain =
+        rt->get_index_space_domain(ctx, z_req.region.get_index_space());
+
+    assert(y_domain == x_domain);
+    assert(y_domain == z_domain);
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+
+    for (RectIterator rect_iter(y_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        if (is_dense_rect(rect, y_reader_writer, x_reader, z_reader_writer)) {
+            dense_xpay_axpy(
+                rect.volume(),
+                beta,
+                alpha,
+                x_reader.ptr(rect.lo),
+                y_reader_writer.ptr(rect.lo),
+                z_reader_writer.ptr(rect.lo)
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            const ENTRY_T y_old = y_reader_writer[point];
+            z_reader_writer[point] =
+                std::fma(alpha, y_old, z_reader_writer[point]);
+            y_reader_writer[point] = std::fma(beta, y_old, x_reader[point]);
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+PackedScalars<ENTRY_T> MultiUpdateDotTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->regions.size() == regions.size());
+    const std::size_t num_vectors = regions.size();
+    assert(num_vectors > 0);
+
+    assert(task->arglen >= sizeof(MultiUpdateDotArgs));
+    const MultiUpdateDotArgs &args =
+        *static_cast<const MultiUpdateDotArgs *>(task->args);
+    assert(args.num_updates <= LEGION_SOLVERS_MAX_FUSED_UPDATES);
+    assert(args.num_dot_products <= LEGION_SOLVERS_MAX_PACKED_SCALARS);
+    assert(
+        task->arglen == sizeof(MultiUpdateDotArgs) +
+                            args.num_coefficients *
+                                sizeof(ScalarProgram<ENTRY_T>)
+    );
+    const ScalarProgram<ENTRY_T> *programs =
+        reinterpret_cast<const ScalarProgram<ENTRY_T> *>(
+            static_cast<const char *>(task->args) + sizeof(MultiUpdateDotArgs)
+        );
+
+    // Each coefficient is evaluated once, however many updates share it.
+    std::vector<ENTRY_T> coefficients;
+    for (std::uint32_t k = 0; k < args.num_coefficients; ++k) {
+        coefficients.push_back(
+            evaluate_scalar_program(programs[k], task->futures)
+        );
+    }
+
+    // Read-write vectors get a reader-writer; all others get a reader.
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> readers;
+    std::vector<AffineReaderWriter<ENTRY_T, DIM, COORD_T>> reader_writers;
+    std::vector<std::size_t> slots;
+    std::vector<bool> writable;
+    for (std::size_t i = 0; i < num_vectors; ++i) {
+        const auto &req = task->regions[i];
+        assert(req.privilege_fields.size() == 1);
+        const Legion::FieldID fid = *req.privilege_fields.begin();
+        if (req.privilege == LEGION_READ_WRITE) {
+            slots.push_back(reader_writers.size());
+            writable.push_back(true);
+            reader_writers.emplace_back(regions[i], fid);
+        } else {
+            assert(req.privilege == LEGION_READ_ONLY);
+            slots.push_back(readers.size());
+            writable.push_back(false);
+            readers.emplace_back(regions[i], fid);
+        }
+    }
+
+    std::vector<ENTRY_T> alphas;
+    for (std::uint32_t k = 0; k < args.num_updates; ++k) {
+        const VectorUpdate &update = args.updates[k];
+        assert(update.target < num_vectors);
+        assert(writable[update.target]);
+        assert(
+            (update.kind == VectorUpdateKind::SCAL) ||
+            (update.source < num_vectors)
+        );
+        assert(update.alpha < args.num_coefficients);
+        alphas.push_back(coefficients[update.alpha]);
+    }
+
+    std::vector<DotProductAccumulator<ENTRY_T>> results;
+    for (std::uint32_t k = 0; k < args.num_dot_products; ++k) {
+        assert(args.dot_products[k].lhs < num_vectors);
+        assert(args.dot_products[k].rhs < num_vectors);
+        results.emplace_back(args.mode);
+    }
+
+    const Legion::Domain domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    for (std::size_t i = 1; i < num_vectors; ++i) {
+        assert(
+            rt->get_index_space_domain(
+                ctx, task->regions[i].region.get_index_space()
+            ) == domain
+        );
+    }
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+
+    std::vector<const ENTRY_T *> in_ptrs(num_vectors);
+    std::vector<ENTRY_T *> out_ptrs(num_vectors);
+    std::vector<ENTRY_T> values(num_vectors);
+
+    for (RectIterator rect_iter(domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+
+        bool col_major = true;
+        bool row_major = true;
+        for (const auto &reader : readers) {
+            col_major = col_major && reader.accessor.is_dense_col_major(rect);
+            row_major = row_major && reader.accessor.is_dense_row_major(rect);
+        }
+        for (const auto &reader_writer : reader_writers) {
+            col_major =
+                col_major && reader_writer.accessor.is_dense_col_major(rect);
+            row_major =
+                row_major && reader_writer.accessor.is_dense_row_major(rect);
+        }
+
+        if (col_major || row_major) {
+            for (std::size_t i = 0; i < num_vectors; ++i) {
+                if (writable[i]) {
+                    out_ptrs[i] = reader_writers[slots[i]].ptr(rect.lo);
+                    in_ptrs[i] = out_ptrs[i];
+                } else {
+                    out_ptrs[i] = nullptr;
+                    in_ptrs[i] = readers[slots[i]].ptr(rect.lo);
+                }
+            }
+            // Updates and dot products are applied block by block, so that
+            // each vector is streamed from memory once per rect.
+            const std::size_t n = rect.volume();
+            for (std::size_t i = 0; i < n; i += B) {
+                const std::size_t len = std::min(B, n - i);
+                for (std::uint32_t k = 0; k < args.num_updates; ++k) {
+                    const VectorUpdate &update = args.updates[k];
+                    ENTRY_T *target = out_ptrs[update.target] + i;
+                    switch (update.kind) {
+                        case VectorUpdateKind::SCAL:
+                            dense_scal(len, alphas[k], target);
+                            break;
+                        case VectorUpdateKind::AXPY:
+                            dense_axpy(
+                                len,
+                                alphas[k],
+                                in_ptrs[update.source] + i,
+                                target
+                            );
+                            break;
+                        case VectorUpdateKind::XPAY:
+                            dense_xpay(
+                                len,
+                                alphas[k],
+                                in_ptrs[update.source] + i,
+                                target
+                            );
+                            break;
+                    }
+                }
+                for (std::uint32_t k = 0; k < args.num_dot_products; ++k) {
+                    const VectorDotProduct &dot = args.dot_products[k];
+                    results[k].add_dense(
+                        len, in_ptrs[dot.lhs] + i, in_ptrs[dot.rhs] + i
+                    );
+                }
+            }
+            continue;
+        }
+
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            for (std::size_t i = 0; i < num_vectors; ++i) {
+                values[i] = writable[i] ? reader_writers[slots[i]][point]
+                                        : readers[slots[i]][point];
+            }
+            for (std::uint32_t k = 0; k < args.num_updates; ++k) {
+                const VectorUpdate &update = args.updates[k];
+                ENTRY_T &target = values[update.target];
+                switch (update.kind) {
+                    case VectorUpdateKind::SCAL:
+                        target = alphas[k] * target;
+                        break;
+                    case VectorUpdateKind::AXPY:
+                        target =
+                            std::fma(alphas[k], values[update.source], target);
+                        break;
+                    case VectorUpdateKind::XPAY:
+                        target =
+                            std::fma(alphas[k], target, values[update.source]);
+                        break;
+                }
+            }
+            for (std::size_t i = 0; i < num_vectors; ++i) {
+                if (writable[i]) {
+                    reader_writers[slots[i]][point] = values[i];
+                }
+            }
+            for (std::uint32_t k = 0; k < args.num_dot_products; ++k) {
+                const VectorDotProduct &dot = args.dot_products[k];
+                results[k].add(values[dot.lhs], values[dot.rhs]);
+            }
+        }
+    }
+
+    PackedScalars<ENTRY_T> packed = {};
+    for (std::uint32_t k = 0; k < args.num_dot_products; ++k) {
+        packed.values[k] = results[k].result();
+    }
+    return packed;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinationTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->regions.size() == regions.size());
+    const std::size_t num_vectors = regions.size();
+    assert(num_vectors > 0);
+
+    assert(task->arglen == sizeof(LinearCombinationArgs));
+    const LinearCombinationArgs &args =
+        *static_cast<const LinearCombinationArgs *>(task->args);
+    const std::size_t num_inputs = args.num_inputs;
+    const std::size_t num_outputs = args.num_outputs;
+    assert(num_inputs <= num_vectors);
+    assert(num_outputs <= LEGION_SOLVERS_MAX_FUSED_UPDATES);
+
+    assert(task->futures.size() == 1);
+    const PackedScalars<ENTRY_T> coefficients =
+        task->futures[0].get_result<PackedScalars<ENTRY_T>>();
+
+    // Read-write vectors get a reader-writer; all others get a reader.
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> readers;
+    std::vector<AffineReaderWriter<ENTRY_T, DIM, COORD_T>> reader_writers;
+    std::vector<std::size_t> slots;
+    std::vector<bool> writable;
+    for (std::size_t i = 0; i < num_vectors; ++i) {
+        const auto &req = task->regions[i];
+        assert(req.privilege_fields.size() == 1);
+        const Legion::FieldID fid = *req.privilege_fields.begin();
+        if (req.privilege == LEGION_READ_WRITE) {
+            slots.push_back(reader_writers.size());
+            writable.push_back(true);
+            reader_writers.emplace_back(regions[i], fid);
+        } else {
+            assert(req.privilege == LEGION_READ_ONLY);
+            slots.push_back(readers.size());
+            writable.push_back(false);
+            readers.emplace_back(regions[i], fid);
+        }
+    }
+    std::vector<ENTRY_T> signs;
+    for (std::size_t k = 0; k < num_outputs; ++k) {
+        assert(args.outputs[k].target < num_vectors);
+        assert(writable[args.outputs[k].target]);
+        assert(
+            args.outputs[k].first + num_inputs <=
+            static_cast<std::size_t>(LEGION_SOLVERS_MAX_PACKED_SCALARS)
+        );
+        signs.push_back(
+            (args.outputs[k].mode == LinearCombinationMode::SUBTRACT)
+                ? static_cast<ENTRY_T>(-1)
+                : static_cast<ENTRY_T>(1)
+        );
+    }
+
+    const Legion::Domain domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+
+    std::vector<const ENTRY_T *> in_ptrs(num_vectors);
+    std::vector<ENTRY_T *> out_ptrs(num_vectors);
+    std::vector<ENTRY_T> values(num_vectors);
+    std::vector<ENTRY_T> results(num_outputs * B);
+
+    for (RectIterator rect_iter(domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+
+        bool col_major = true;
+        bool row_major = true;
+        for (const auto &reader : readers) {
+            col_major = col_major && reader.accessor.is_dense_col_major(rect);
+            row_major = row_major && reader.accessor.is_dense_row_major(rect);
+        }
+        for (const auto &reader_writer : reader_writers) {
+            col_major =
+                col_major && reader_writer.accessor.is_dense_col_major(rect);
+            row_major =
+                row_major && reader_writer.accessor.is_dense_row_major(rect);
+        }
+
+        if (col_major || row_major) {
+            for (std::size_t i = 0; i < num_vectors; ++i) {
+                if (writable[i]) {
+                    out_ptrs[i] = reader_writers[slots[i]].ptr(rect.lo);
+                    in_ptrs[i] = out_ptrs[i];
+                } else {
+                    out_ptrs[i] = nullptr;
+                    in_ptrs[i] = readers[slots[i]].ptr(rect.lo);
+                }
+            }
+            // Outputs are formed block by block in a buffer and stored only
+            // once all of them have been computed, since targets may be
+            // inputs of other outputs.
+            const std::size_t n = rect.volume();
+            for (std::size_t i = 0; i < n; i += B) {
+                const std::size_t len = std::min(B, n - i);
+                for (std::size_t k = 0; k < num_outputs; ++k) {
+                    const LinearCombinationOutput &output = args.outputs[k];
+                    ENTRY_T *result = results.data() + k * B;
+                    const bool assign =
+                        (output.mode == LinearCombinationMode::ASSIGN);
+                    for (std::size_t l = 0; l < len; ++l) {
+                        result[l] = assign ? static_cast<ENTRY_T>(0)
+                                           : in_ptrs[output.target][i + l];
+                    }
+                    for (std::size_t j = 0; j < num_inputs; ++j) {
+                        dense_axpy(
+                            len,
+                            signs[k] * coefficients.values[output.first + j],
+                            in_ptrs[j] + i,
+                            result
+                        );
+                    }
+                }
+                for (std::size_t k = 0; k < num_outputs; ++k) {
+                    const ENTRY_T *result = results.data() + k * B;
+                    ENTRY_T *target = out_ptrs[args.outputs[k].target] + i;
+                    for (std::size_t l = 0; l < len; ++l) {
+                        target[l] = result[l];
+                    }
+                }
+            }
+            continue;
+        }
+
         for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
             const Legion::Point<DIM, COORD_T> point = *point_iter;
-            result += v_reader[point] * w_reader[point];
+            for (std::size_t i = 0; i < num_vectors; ++i) {
+                values[i] = writable[i] ? reader_writers[slots[i]][point]
+                                        : readers[slots[i]][point];
+            }
+            for (std::size_t k = 0; k < num_outputs; ++k) {
+                const LinearCombinationOutput &output = args.outputs[k];
+                ENTRY_T result = (output.mode == LinearCombinationMode::ASSIGN)
+                                     ? static_cast<ENTRY_T>(0)
+                                     : values[output.target];
+                for (std::size_t j = 0; j < num_inputs; ++j) {
+                    result = std::fma(
+                        signs[k] * coefficients.values[output.first + j],
+                        values[j],
+                        result
+                    );
+                }
+                reader_writers[slots[output.target]][point] = result;
+            }
         }
     }
-    return result;
 }
 
 
@@ -227,19 +1059,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_S32_INDICES
     #ifdef LEGION_SOLVERS_USE_U32_INDICES
@@ -247,19 +1097,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_U32_INDICES
     #ifdef LEGION_SOLVERS_USE_S64_INDICES
@@ -267,19 +1135,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template float DotTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template float AxpyDotTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<float> MultiUpdateDotTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_S64_INDICES
 #endif // LEGION_SOLVERS_USE_FLOAT
@@ -289,19 +1175,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_S32_INDICES
     #ifdef LEGION_SOLVERS_USE_U32_INDICES
@@ -309,19 +1213,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_U32_INDICES
     #ifdef LEGION_SOLVERS_USE_S64_INDICES
@@ -329,19 +1251,37 @@ ENTRY_T DotTask<ENTRY_T, DIM, COORD_T>::task_body(
             template void ScalTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 1
         #if LEGION_SOLVERS_MAX_DIM >= 2
             template void ScalTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 2
         #if LEGION_SOLVERS_MAX_DIM >= 3
             template void ScalTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void AxpyTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template void XpayTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void ConvertTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void AxpyConvertTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
             template double DotTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template double AxpyDotTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void XpayAxpyTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template PackedScalars<double> MultiUpdateDotTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void LinearCombinationTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
         #endif // LEGION_SOLVERS_MAX_DIM >= 3
     #endif // LEGION_SOLVERS_USE_S64_INDICES
 #endif // LEGION_SOLVERS_USE_DOUBLE
@@ -1,9 +1,14 @@
 #ifndef LEGION_SOLVERS_LINEAR_ALGEBRA_TASKS_HPP_INCLUDED
 #define LEGION_SOLVERS_LINEAR_ALGEBRA_TASKS_HPP_INCLUDED
 
+#include <cstdint> // for std::uint8_t, std::uint32_t
+
 #include "LegionUtilities.hpp" // for TaskFlags
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_MAX_*
+#include "PackedScalars.hpp"   // for PackedScalars
 #include "TaskBaseClasses.hpp" // for TaskTDI
 #include "TaskIDs.hpp"         // for *_TASK_BLOCK_ID
+#include "VectorKernels.hpp"   // for DotProductMode
 
 namespace LegionSolvers {
 
@@ -31,7 +36,7 @@ struct ScalTask
 
 template <typename ENTRY_T, int DIM, typename COORD_T>
 struct AxpyTask
-    : public TaskTDI<AXPY_TASK_BLOCK_ID, ScalTask, ENTRY_T, DIM, COORD_T> {
+    : public TaskTDI<AXPY_TASK_BLOCK_ID, AxpyTask, ENTRY_T, DIM, COORD_T> {
 
     static constexpr const char *task_base_name = "axpy";
 
@@ -52,7 +57,7 @@ struct AxpyTask
 
 template <typename ENTRY_T, int DIM, typename COORD_T>
 struct XpayTask
-    : public TaskTDI<XPAY_TASK_BLOCK_ID, ScalTask, ENTRY_T, DIM, COORD_T> {
+    : public TaskTDI<XPAY_TASK_BLOCK_ID, XpayTask, ENTRY_T, DIM, COORD_T> {
 
     static constexpr const char *task_base_name = "xpay";
 
@@ -71,6 +76,64 @@ struct XpayTask
 }; // struct XpayTask
 
 
+// Computes y = x, where x has the other entry type (see OtherPrecision) and
+// is converted to ENTRY_T. Regions are y (write-discard) and x (read-only).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct ConvertTask
+    : public TaskTDI<
+          CONVERT_TASK_BLOCK_ID,
+          ConvertTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "convert";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct ConvertTask
+
+
+// Computes y = alpha * x + y, where x has the other entry type (see
+// OtherPrecision) and is converted to ENTRY_T before the update, so that the
+// sum is formed in ENTRY_T. Regions are y (read-write) and x (read-only);
+// alpha is given as for AxpyTask.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AxpyConvertTask
+    : public TaskTDI<
+          AXPY_CONVERT_TASK_BLOCK_ID,
+          AxpyConvertTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "axpy_convert";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AxpyConvertTask
+
+
 template <typename ENTRY_T, int DIM, typename COORD_T>
 struct DotTask
     : public TaskTDI<DOT_TASK_BLOCK_ID, DotTask, ENTRY_T, DIM, COORD_T> {
@@ -92,6 +155,205 @@ struct DotTask
 }; // struct DotTask
 
 
+// Selects the task futures [first, first + count) that are combined, as in
+// the single-coefficient tasks above, into one coefficient of a fused task.
+struct CoefficientFutures {
+    std::uint32_t first;
+    std::uint32_t count;
+}; // struct CoefficientFutures
+
+
+// Computes y = alpha * x + y and returns dot(y, z) from the updated y in a
+// single pass. Regions are y (read-write), x (read-only), and optionally z
+// (read-only); if z is omitted, the squared norm dot(y, y) is returned. The
+// futures give alpha, and the optional task argument is a DotProductMode.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct AxpyDotTask
+    : public TaskTDI<
+          AXPY_DOT_TASK_BLOCK_ID,
+          AxpyDotTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "axpy_dot";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = ENTRY_T;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct AxpyDotTask
+
+
+struct XpayAxpyArgs {
+    CoefficientFutures beta;
+    CoefficientFutures alpha;
+}; // struct XpayAxpyArgs
+
+
+// Computes z = alpha * y + z followed by y = x + beta * y, both from the
+// incoming value of y, in a single pass. This is the tail of a CG iteration
+// (x += alpha * p; p = r + beta * p). Regions are y (read-write), x
+// (read-only), and z (read-write); the task argument is an XpayAxpyArgs.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct XpayAxpyTask
+    : public TaskTDI<
+          XPAY_AXPY_TASK_BLOCK_ID,
+          XpayAxpyTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "xpay_axpy";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct XpayAxpyTask
+
+
+enum class VectorUpdateKind : std::uint8_t {
+    SCAL, // target = alpha * target
+    AXPY, // target = alpha * source + target
+    XPAY, // target = source + alpha * target
+}; // enum class VectorUpdateKind
+
+
+// target and source index the region requirements of a MultiUpdateDotTask,
+// and alpha its coefficients.
+struct VectorUpdate {
+    VectorUpdateKind kind;
+    std::uint32_t target;
+    std::uint32_t source;
+    std::uint32_t alpha;
+}; // struct VectorUpdate
+
+
+struct VectorDotProduct {
+    std::uint32_t lhs;
+    std::uint32_t rhs;
+}; // struct VectorDotProduct
+
+
+// The task argument of a MultiUpdateDotTask<ENTRY_T, ...> is this struct
+// followed by num_coefficients ScalarProgram<ENTRY_T>, which are evaluated
+// on the task futures (see Scalar::compile). Updates that share a
+// coefficient share its program.
+struct MultiUpdateDotArgs {
+    DotProductMode mode;
+    std::uint32_t num_updates;
+    std::uint32_t num_dot_products;
+    std::uint32_t num_coefficients;
+    VectorUpdate updates[LEGION_SOLVERS_MAX_FUSED_UPDATES];
+    VectorDotProduct dot_products[LEGION_SOLVERS_MAX_PACKED_SCALARS];
+}; // struct MultiUpdateDotArgs
+
+
+// Applies a sequence of in-place vector updates and then computes several
+// dot products of the updated vectors, streaming each vector through memory
+// once. Each region requirement names one vector (with one field); update
+// targets must be read-write and all other vectors read-only. Updates are
+// applied in order, so later updates observe the results of earlier ones.
+// Dot products are returned packed; index launches should reduce them with
+// PACKED_SUM_REDOP_ID<ENTRY_T>.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct MultiUpdateDotTask : public TaskTDI<
+                                MULTI_UPDATE_DOT_TASK_BLOCK_ID,
+                                MultiUpdateDotTask,
+                                ENTRY_T,
+                                DIM,
+                                COORD_T> {
+
+    static constexpr const char *task_base_name = "multi_update_dot";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = PackedScalars<ENTRY_T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct MultiUpdateDotTask
+
+
+enum class LinearCombinationMode : std::uint8_t {
+    ASSIGN,   // target = sum
+    ADD,      // target = target + sum
+    SUBTRACT, // target = target - sum
+}; // enum class LinearCombinationMode
+
+
+// Output of a LinearCombinationTask: vector target is combined, according to
+// mode, with the sum over input vectors j of coefficient first + j times
+// vector j.
+struct LinearCombinationOutput {
+    std::uint32_t target;
+    std::uint32_t first;
+    LinearCombinationMode mode;
+}; // struct LinearCombinationOutput
+
+
+struct LinearCombinationArgs {
+    std::uint32_t num_inputs;
+    std::uint32_t num_outputs;
+    LinearCombinationOutput outputs[LEGION_SOLVERS_MAX_FUSED_UPDATES];
+}; // struct LinearCombinationArgs
+
+
+// Computes several linear combinations of the same vectors in a single pass,
+// with coefficients taken from a PackedScalars<ENTRY_T> future (the only
+// task future), so that coefficient vectors computed by a task never pass
+// through the top-level task. Each region requirement names one vector
+// (with one field); the first num_inputs are the inputs. Targets must be
+// read-write and all other vectors read-only. Targets may be inputs: every
+// output is computed from the incoming values of the inputs.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct LinearCombinationTask : public TaskTDI<
+                                   LINEAR_COMBINATION_TASK_BLOCK_ID,
+                                   LinearCombinationTask,
+                                   ENTRY_T,
+                                   DIM,
+                                   COORD_T> {
+
+    static constexpr const char *task_base_name = "linear_combination";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct LinearCombinationTask
+
+
 } // namespace LegionSolvers
 
 #endif // LEGION_SOLVERS_LINEAR_ALGEBRA_TASKS_HPP_INCLUDED
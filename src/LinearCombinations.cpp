@@ -0,0 +1,184 @@
+#include "LinearCombinations.hpp"
+
+#include <algorithm> // for std::find
+#include <cassert>   // for assert
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::LinearCombinationMode;
+using LegionSolvers::LinearCombinationOutput;
+using LegionSolvers::LinearCombinations;
+using LegionSolvers::LinearCombinationTask;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+LinearCombinations<ENTRY_T, DIM, COORD_T>::LinearCombinations(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::vector<const Vector *> &inputs,
+    const Legion::Future &coefficients
+)
+    : ctx(ctx), rt(rt), coefficients(coefficients), args{} {
+    assert(!inputs.empty());
+    for (const Vector *input : inputs) { vector_index(*input, false); }
+    assert(vectors.size() == inputs.size()); // inputs must be distinct
+    args.num_inputs = static_cast<std::uint32_t>(inputs.size());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint32_t LinearCombinations<ENTRY_T, DIM, COORD_T>::vector_index(
+    const Vector &x, bool write
+) {
+    const auto iter = std::find(vectors.begin(), vectors.end(), &x);
+    const std::uint32_t index =
+        static_cast<std::uint32_t>(iter - vectors.begin());
+    if (iter == vectors.end()) {
+        assert(
+            vectors.empty() ||
+            (x.get_index_space() == vectors[0]->get_index_space())
+        );
+        vectors.push_back(&x);
+        written.push_back(write);
+    } else if (write) {
+        written[index] = true;
+    }
+    return index;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinations<ENTRY_T, DIM, COORD_T>::output(
+    LinearCombinationMode mode, Vector &target, std::uint32_t first
+) {
+    assert(args.num_outputs < LEGION_SOLVERS_MAX_FUSED_UPDATES);
+    assert(
+        first + args.num_inputs <=
+        static_cast<std::uint32_t>(LEGION_SOLVERS_MAX_PACKED_SCALARS)
+    );
+    args.outputs[args.num_outputs++] =
+        LinearCombinationOutput{vector_index(target, true), first, mode};
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinations<ENTRY_T, DIM, COORD_T>::assign(
+    Vector &target, std::uint32_t first
+) {
+    output(LinearCombinationMode::ASSIGN, target, first);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinations<ENTRY_T, DIM, COORD_T>::add(
+    Vector &target, std::uint32_t first
+) {
+    output(LinearCombinationMode::ADD, target, first);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinations<ENTRY_T, DIM, COORD_T>::subtract(
+    Vector &target, std::uint32_t first
+) {
+    output(LinearCombinationMode::SUBTRACT, target, first);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void LinearCombinations<ENTRY_T, DIM, COORD_T>::execute() const {
+    assert(args.num_outputs > 0);
+    const Vector &first = *vectors[0];
+    Legion::IndexLauncher launcher{
+        LinearCombinationTask<ENTRY_T, DIM, COORD_T>::task_id,
+        first.get_color_space(),
+        Legion::TaskArgument{&args, sizeof(LinearCombinationArgs)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                first.get_aligned_partition(*vectors[i]),
+                0,
+                written[i] ? LEGION_READ_WRITE : LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                vectors[i]->get_logical_region()})
+            .add_field(vectors[i]->get_fid());
+    }
+    launcher.add_future(coefficients);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::LinearCombinations<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::LinearCombinations<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::LinearCombinations<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,69 @@
+#ifndef LEGION_SOLVERS_LINEAR_COMBINATIONS_HPP_INCLUDED
+#define LEGION_SOLVERS_LINEAR_COMBINATIONS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"  // for DistributedVector
+#include "LinearAlgebraTasks.hpp" // for LinearCombinationArgs, ...
+
+namespace LegionSolvers {
+
+
+// Records linear combinations of a fixed list of input vectors, with
+// coefficients taken from a PackedScalars<ENTRY_T> future, and issues all of
+// them as a single LinearCombinationTask index launch (a multi-axpy), so that
+// each input is streamed through memory once however many outputs use it.
+// The combination written to a target with coefficients starting at first is
+// the sum over inputs j of component first + j of the future times input j.
+// Targets may be inputs; every output is computed from the incoming values
+// of the inputs. All vectors must be defined over the same index space; the
+// launch uses the partition of the first input.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class LinearCombinations {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::Future coefficients;
+    LinearCombinationArgs args;
+    std::vector<const Vector *> vectors;
+    std::vector<bool> written;
+
+    // Region requirement index of x, which is added if necessary.
+    std::uint32_t vector_index(const Vector &x, bool write);
+
+    void output(
+        LinearCombinationMode mode, Vector &target, std::uint32_t first
+    );
+
+  public:
+
+    explicit LinearCombinations(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const std::vector<const Vector *> &inputs,
+        const Legion::Future &coefficients
+    );
+
+    // target = sum
+    void assign(Vector &target, std::uint32_t first);
+
+    // target = target + sum
+    void add(Vector &target, std::uint32_t first);
+
+    // target = target - sum
+    void subtract(Vector &target, std::uint32_t first);
+
+    // Issues the recorded combinations.
+    void execute() const;
+
+}; // class LinearCombinations
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_LINEAR_COMBINATIONS_HPP_INCLUDED
@@ -0,0 +1,197 @@
+#ifndef LEGION_SOLVERS_MATRIX_MARKET_PARSER_HPP_INCLUDED
+#define LEGION_SOLVERS_MATRIX_MARKET_PARSER_HPP_INCLUDED
+
+#include <cstdint> // for std::uint8_t, std::uint64_t
+#include <cstdio>  // for std::fprintf, stderr
+#include <cstdlib> // for std::abort, std::strtod
+
+namespace LegionSolvers {
+
+
+enum class MatrixMarketField : std::uint8_t {
+    REAL,
+    INTEGER,
+    PATTERN, // no entries are stored; every nonzero is one
+}; // enum class MatrixMarketField
+
+
+enum class MatrixMarketSymmetry : std::uint8_t {
+    GENERAL,
+    SYMMETRIC,      // only the lower triangle is stored
+    SKEW_SYMMETRIC, // only the strictly lower triangle is stored
+}; // enum class MatrixMarketSymmetry
+
+
+// The banner and size line of a Matrix Market file in coordinate format,
+// and the byte range [data_begin, data_end) of its entry lines.
+struct MatrixMarketHeader {
+    MatrixMarketField field;
+    MatrixMarketSymmetry symmetry;
+    std::uint64_t num_rows;
+    std::uint64_t num_cols;
+    std::uint64_t num_entries; // as stored, before symmetric expansion
+    std::uint64_t data_begin;
+    std::uint64_t data_end;
+}; // struct MatrixMarketHeader
+
+
+// One entry line of a Matrix Market file, with 1-based indices.
+struct MatrixMarketEntry {
+    std::uint64_t row;
+    std::uint64_t col;
+    double value;
+}; // struct MatrixMarketEntry
+
+
+// Reports a malformed or unsupported Matrix Market file and aborts. Unlike
+// the assertions on the library's own invariants, these checks concern the
+// contents of user files, so they are kept in release builds.
+inline void check_matrix_market(bool condition, const char *message) {
+    if (!condition) {
+        std::fprintf(stderr, "LegionSolvers: Matrix Market: %s\n", message);
+        std::abort();
+    }
+}
+
+
+// The parsers below read from [p, end), where end points to a newline or to
+// a NUL terminator, advance p past what they consume, and never allocate.
+
+
+inline bool is_matrix_market_digit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+
+inline void skip_matrix_market_blanks(const char *&p, const char *end) {
+    while ((p != end) && ((*p == ' ') || (*p == '\t') || (*p == '\r'))) {
+        ++p;
+    }
+}
+
+
+// Parses an unsigned decimal integer of at most 19 digits.
+inline bool parse_matrix_market_index(
+    const char *&p, const char *end, std::uint64_t &value
+) {
+    const char *q = p;
+    std::uint64_t result = 0;
+    while ((q != end) && is_matrix_market_digit(*q)) {
+        result = 10 * result + static_cast<std::uint64_t>(*q - '0');
+        ++q;
+    }
+    if ((q == p) || (q - p > 19)) { return false; }
+    value = result;
+    p = q;
+    return true;
+}
+
+
+// Parses a decimal floating-point number, with optional sign, fraction, and
+// exponent. Numbers whose significand has at most 19 digits and fits in 53
+// bits, and whose decimal exponent is at most 22 in magnitude, are computed
+// as one exact product or quotient of two doubles, and are therefore
+// correctly rounded; these include every integer and all the fixed-format
+// output of common writers. Anything else (longer significands, large
+// exponents, inf, nan) falls back to std::strtod, which is also correctly
+// rounded but several times slower.
+inline bool
+parse_matrix_market_real(const char *&p, const char *end, double &value) {
+    static constexpr double POWERS_OF_TEN[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char *q = p;
+    const bool negative = (q != end) && (*q == '-');
+    if ((q != end) && ((*q == '-') || (*q == '+'))) { ++q; }
+    std::uint64_t significand = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+    while ((q != end) && is_matrix_market_digit(*q)) {
+        if (num_digits < 19) {
+            significand =
+                10 * significand + static_cast<std::uint64_t>(*q - '0');
+            if (significand != 0) { ++num_digits; }
+        } else {
+            truncated = true;
+            ++exponent;
+        }
+        has_digits = true;
+        ++q;
+    }
+    if ((q != end) && (*q == '.')) {
+        ++q;
+        while ((q != end) && is_matrix_market_digit(*q)) {
+            if (num_digits < 19) {
+                significand =
+                    10 * significand + static_cast<std::uint64_t>(*q - '0');
+                if (significand != 0) { ++num_digits; }
+                --exponent;
+            } else {
+                truncated = true;
+            }
+            has_digits = true;
+            ++q;
+        }
+    }
+    if (has_digits && (q != end) && ((*q == 'e') || (*q == 'E'))) {
+        const char *r = q + 1;
+        const bool negative_exponent = (r != end) && (*r == '-');
+        if ((r != end) && ((*r == '-') || (*r == '+'))) { ++r; }
+        if ((r != end) && is_matrix_market_digit(*r)) {
+            int e = 0;
+            while ((r != end) && is_matrix_market_digit(*r)) {
+                if (e < 100'000) { e = 10 * e + (*r - '0'); }
+                ++r;
+            }
+            exponent += negative_exponent ? -e : e;
+            q = r;
+        }
+    }
+    if (has_digits && !truncated && (significand <= (1ULL << 53)) &&
+        (exponent >= -22) && (exponent <= 22)) {
+        const double s = static_cast<double>(significand);
+        const double result = (exponent < 0) ? s / POWERS_OF_TEN[-exponent]
+                                             : s * POWERS_OF_TEN[exponent];
+        value = negative ? -result : result;
+        p = q;
+        return true;
+    }
+    char *stop = nullptr;
+    const double result = std::strtod(p, &stop);
+    if ((stop == p) || (stop > end)) { return false; }
+    value = result;
+    p = stop;
+    return true;
+}
+
+
+// Parses the entry line [line, end). Returns false for blank lines and
+// comment lines, which are skipped, and aborts on any other line that is
+// not two indices followed, unless pattern, by a value.
+inline bool parse_matrix_market_entry(
+    const char *line, const char *end, bool pattern, MatrixMarketEntry &entry
+) {
+    const char *p = line;
+    skip_matrix_market_blanks(p, end);
+    if ((p == end) || (*p == '%')) { return false; }
+    bool ok = parse_matrix_market_index(p, end, entry.row);
+    skip_matrix_market_blanks(p, end);
+    ok = ok && parse_matrix_market_index(p, end, entry.col);
+    if (pattern) {
+        entry.value = 1.0;
+    } else {
+        skip_matrix_market_blanks(p, end);
+        ok = ok && parse_matrix_market_real(p, end, entry.value);
+    }
+    skip_matrix_market_blanks(p, end);
+    check_matrix_market(ok && (p == end), "malformed entry line");
+    return true;
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MATRIX_MARKET_PARSER_HPP_INCLUDED
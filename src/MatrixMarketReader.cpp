@@ -0,0 +1,414 @@
+#include "MatrixMarketReader.hpp"
+
+#include <cassert> // for assert
+#include <cctype>  // for std::tolower
+#include <cstdint> // for std::uint64_t
+#include <cstring> // for std::memcpy
+#include <fstream> // for std::ifstream
+#include <limits>  // for std::numeric_limits
+#include <map>     // for std::map
+#include <sstream> // for std::istringstream
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp"         // for create_field_space
+#include "LibraryOptions.hpp"          // for LEGION_SOLVERS_MAPPER_ID
+#include "MatrixMarketParser.hpp"      // for check_matrix_market
+#include "MatrixMarketReaderTasks.hpp" // for MatrixMarket*Task
+#include "SELLMatrixTasks.hpp"         // for sell_extent
+
+using LegionSolvers::COOMatrix;
+using LegionSolvers::CSRMatrix;
+using LegionSolvers::MatrixMarketAssemblyArgs;
+using LegionSolvers::MatrixMarketCountTask;
+using LegionSolvers::MatrixMarketField;
+using LegionSolvers::MatrixMarketFillTask;
+using LegionSolvers::MatrixMarketHeader;
+using LegionSolvers::MatrixMarketReadTask;
+using LegionSolvers::MatrixMarketReader;
+using LegionSolvers::MatrixMarketSizeTask;
+using LegionSolvers::MatrixMarketSymmetry;
+using LegionSolvers::check_matrix_market;
+using LegionSolvers::create_field_space;
+using LegionSolvers::sell_extent;
+
+
+inline std::string matrix_market_keyword(std::string word) {
+    for (char &c : word) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return word;
+}
+
+
+// The 1D extent [0, size), which must be addressable by COORD_T.
+template <typename COORD_T>
+Legion::Rect<1, COORD_T> matrix_market_extent(std::uint64_t size) {
+    check_matrix_market(
+        size <= static_cast<std::uint64_t>(std::numeric_limits<COORD_T>::max()),
+        "matrix too large for the index type"
+    );
+    return sell_extent(COORD_T{0}, size);
+}
+
+
+MatrixMarketHeader
+LegionSolvers::read_matrix_market_header(const std::string &path) {
+    std::ifstream file{path, std::ios::binary};
+    check_matrix_market(static_cast<bool>(file), "cannot open file");
+
+    std::string line;
+    std::getline(file, line);
+    std::istringstream banner{line};
+    std::string tag;
+    std::string object;
+    std::string format;
+    std::string field;
+    std::string symmetry;
+    banner >> tag >> object >> format >> field >> symmetry;
+    check_matrix_market(tag == "%%MatrixMarket", "missing banner");
+    check_matrix_market(
+        matrix_market_keyword(object) == "matrix", "object is not a matrix"
+    );
+    check_matrix_market(
+        matrix_market_keyword(format) == "coordinate",
+        "only the coordinate format is supported"
+    );
+
+    MatrixMarketHeader header;
+    field = matrix_market_keyword(field);
+    if (field == "real") {
+        header.field = MatrixMarketField::REAL;
+    } else if (field == "integer") {
+        header.field = MatrixMarketField::INTEGER;
+    } else {
+        check_matrix_market(
+            field == "pattern", "only real, integer, and pattern are supported"
+        );
+        header.field = MatrixMarketField::PATTERN;
+    }
+    symmetry = matrix_market_keyword(symmetry);
+    if (symmetry == "general") {
+        header.symmetry = MatrixMarketSymmetry::GENERAL;
+    } else if (symmetry == "symmetric") {
+        header.symmetry = MatrixMarketSymmetry::SYMMETRIC;
+    } else {
+        check_matrix_market(
+            symmetry == "skew-symmetric",
+            "only general, symmetric, and skew-symmetric are supported"
+        );
+        header.symmetry = MatrixMarketSymmetry::SKEW_SYMMETRIC;
+    }
+
+    // Comments and blank lines may precede the size line.
+    while (std::getline(file, line)) {
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if ((first != std::string::npos) && (line[first] != '%')) { break; }
+    }
+    std::istringstream size_line{line};
+    size_line >> header.num_rows >> header.num_cols >> header.num_entries;
+    check_matrix_market(static_cast<bool>(size_line), "malformed size line");
+
+    const std::streamoff data_begin =
+        file.eof() ? std::streamoff{-1} : std::streamoff{file.tellg()};
+    file.clear();
+    file.seekg(0, std::ios::end);
+    header.data_end = static_cast<std::uint64_t>(file.tellg());
+    header.data_begin = (data_begin < 0)
+                          ? header.data_end
+                          : static_cast<std::uint64_t>(data_begin);
+    return header;
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+MatrixMarketReader<ENTRY_T, COORD_T>::MatrixMarketReader(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::string &path,
+    std::size_t num_readers,
+    std::size_t num_pieces
+)
+    : ctx(ctx), rt(rt), header(read_matrix_market_header(path)),
+      range_space(rt->create_index_space(
+          ctx, matrix_market_extent<COORD_T>(header.num_rows)
+      )),
+      domain_space(
+          (header.num_cols == header.num_rows)
+              ? range_space
+              : rt->create_index_space(
+                    ctx, matrix_market_extent<COORD_T>(header.num_cols)
+                )
+      ),
+      color_space(rt->create_index_space(
+          ctx,
+          Legion::Rect<1>{0, static_cast<Legion::coord_t>(num_pieces) - 1}
+      )),
+      range_partition(
+          rt->create_equal_partition(ctx, range_space, color_space)
+      ) {
+    using Index = Legion::Point<1, COORD_T>;
+
+    assert(num_readers > 0);
+    assert(num_pieces > 0);
+    const std::vector<std::size_t> field_sizes{
+        sizeof(Index), sizeof(Index), sizeof(ENTRY_T)};
+    const std::vector<Legion::FieldID> fids{ROW_FID, COL_FID, ENTRY_FID};
+
+    // The nonzeros of each byte range of the file, in COO form.
+    std::vector<char> args(sizeof(MatrixMarketHeader) + path.size());
+    std::memcpy(args.data(), &header, sizeof(MatrixMarketHeader));
+    std::memcpy(
+        args.data() + sizeof(MatrixMarketHeader), path.data(), path.size()
+    );
+    const Legion::IndexSpace reader_space = rt->create_index_space(
+        ctx,
+        Legion::Rect<1>{0, static_cast<Legion::coord_t>(num_readers) - 1}
+    );
+    Legion::IndexLauncher count_launcher{
+        MatrixMarketCountTask<ENTRY_T, 1, COORD_T>::task_id,
+        reader_space,
+        Legion::TaskArgument{args.data(), args.size()},
+        Legion::ArgumentMap{}};
+    count_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    const Legion::FutureMap counts =
+        rt->execute_index_space(ctx, count_launcher);
+
+    // The total is checked to be addressable by COORD_T before the offsets
+    // of the reader pieces are narrowed to it.
+    const Legion::Domain reader_domain =
+        rt->get_index_space_domain(ctx, reader_space);
+    std::uint64_t num_triples = 0;
+    for (Legion::Domain::DomainPointIterator it(reader_domain); it; ++it) {
+        num_triples += counts.get_result<std::uint64_t>(*it);
+    }
+    const Legion::IndexSpace triple_space = rt->create_index_space(
+        ctx, matrix_market_extent<COORD_T>(num_triples)
+    );
+    std::map<Legion::DomainPoint, Legion::Domain> reader_pieces;
+    std::uint64_t first_triple = 0;
+    for (Legion::Domain::DomainPointIterator it(reader_domain); it; ++it) {
+        const std::uint64_t count = counts.get_result<std::uint64_t>(*it);
+        reader_pieces[*it] =
+            sell_extent(static_cast<COORD_T>(first_triple), count);
+        first_triple += count;
+    }
+    const Legion::FieldSpace triple_field_space =
+        create_field_space(ctx, rt, field_sizes, fids);
+    const Legion::LogicalRegion triple_region =
+        rt->create_logical_region(ctx, triple_space, triple_field_space);
+    const Legion::IndexPartition reader_partition =
+        rt->create_partition_by_domain(
+            ctx,
+            triple_space,
+            reader_pieces,
+            reader_space,
+            true,
+            LEGION_DISJOINT_COMPLETE_KIND
+        );
+    Legion::IndexLauncher read_launcher{
+        MatrixMarketReadTask<ENTRY_T, 1, COORD_T>::task_id,
+        reader_space,
+        Legion::TaskArgument{args.data(), args.size()},
+        Legion::ArgumentMap{}};
+    read_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    const Legion::LogicalPartition reader_logical_partition =
+        rt->get_logical_partition(ctx, triple_region, reader_partition);
+    for (const Legion::FieldID fid : fids) {
+        read_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                reader_logical_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                triple_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, read_launcher);
+
+    // The nonzeros of the rows of each piece, sorted by column and summed.
+    const Legion::IndexPartition triple_partition =
+        rt->create_partition_by_preimage(
+            ctx,
+            range_partition,
+            triple_region,
+            triple_region,
+            ROW_FID,
+            color_space
+        );
+    const Legion::LogicalPartition triple_logical_partition =
+        rt->get_logical_partition(ctx, triple_region, triple_partition);
+    std::vector<Legion::RegionRequirement> triple_requirements;
+    for (const Legion::FieldID fid : fids) {
+        triple_requirements.push_back(Legion::RegionRequirement{
+            triple_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            triple_region});
+        triple_requirements.back().add_field(fid);
+    }
+    const MatrixMarketAssemblyArgs assembly_args{range_partition};
+    Legion::IndexLauncher size_launcher{
+        MatrixMarketSizeTask<ENTRY_T, 1, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&assembly_args, sizeof(MatrixMarketAssemblyArgs)},
+        Legion::ArgumentMap{}};
+    size_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : triple_requirements) {
+        size_launcher.add_region_requirement(requirement);
+    }
+    const Legion::FutureMap sizes = rt->execute_index_space(ctx, size_launcher);
+
+    std::map<Legion::DomainPoint, Legion::Domain> kernel_pieces;
+    std::uint64_t num_nonzeros = 0;
+    for (Legion::Domain::DomainPointIterator it(
+             rt->get_index_space_domain(ctx, color_space)
+         );
+         it;
+         ++it) {
+        const std::uint64_t size = sizes.get_result<std::uint64_t>(*it);
+        kernel_pieces[*it] =
+            sell_extent(static_cast<COORD_T>(num_nonzeros), size);
+        num_nonzeros += size;
+    }
+    kernel_space = rt->create_index_space(
+        ctx, matrix_market_extent<COORD_T>(num_nonzeros)
+    );
+    kernel_field_space = create_field_space(ctx, rt, field_sizes, fids);
+    kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    kernel_partition = rt->create_partition_by_domain(
+        ctx,
+        kernel_space,
+        kernel_pieces,
+        color_space,
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND
+    );
+    rowptr_field_space = create_field_space(
+        ctx, rt, {sizeof(Legion::Rect<1, COORD_T>)}, {ROWPTR_FID}
+    );
+    rowptr_region =
+        rt->create_logical_region(ctx, range_space, rowptr_field_space);
+
+    Legion::IndexLauncher fill_launcher{
+        MatrixMarketFillTask<ENTRY_T, 1, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&assembly_args, sizeof(MatrixMarketAssemblyArgs)},
+        Legion::ArgumentMap{}};
+    fill_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : triple_requirements) {
+        fill_launcher.add_region_requirement(requirement);
+    }
+    fill_launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(ROWPTR_FID);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid : fids) {
+        fill_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, fill_launcher);
+
+    rt->destroy_index_partition(ctx, triple_partition);
+    rt->destroy_index_partition(ctx, reader_partition);
+    rt->destroy_logical_region(ctx, triple_region);
+    rt->destroy_field_space(ctx, triple_field_space);
+    rt->destroy_index_space(ctx, triple_space);
+    rt->destroy_index_space(ctx, reader_space);
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+MatrixMarketReader<ENTRY_T, COORD_T>::~MatrixMarketReader() {
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_partition(ctx, range_partition);
+    rt->destroy_index_space(ctx, color_space);
+    if (domain_space != range_space) {
+        rt->destroy_index_space(ctx, domain_space);
+    }
+    rt->destroy_index_space(ctx, range_space);
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+std::size_t MatrixMarketReader<ENTRY_T, COORD_T>::get_num_nonzeros() const {
+    return rt->get_index_space_domain(ctx, kernel_space).get_volume();
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+std::unique_ptr<CSRMatrix<ENTRY_T, 1, COORD_T>>
+MatrixMarketReader<ENTRY_T, COORD_T>::make_csr_matrix() const {
+    return std::make_unique<CSRMatrix<ENTRY_T, 1, COORD_T>>(
+        ctx,
+        rt,
+        kernel_region,
+        COL_FID,
+        ENTRY_FID,
+        rowptr_region,
+        ROWPTR_FID,
+        domain_space,
+        range_partition
+    );
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+std::unique_ptr<COOMatrix<ENTRY_T, 1, COORD_T>>
+MatrixMarketReader<ENTRY_T, COORD_T>::make_coo_matrix() const {
+    return std::make_unique<COOMatrix<ENTRY_T, 1, COORD_T>>(
+        ctx,
+        rt,
+        kernel_region,
+        ROW_FID,
+        COL_FID,
+        ENTRY_FID,
+        domain_space,
+        range_space,
+        kernel_partition
+    );
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template class LegionSolvers::MatrixMarketReader<float, int>;
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template class LegionSolvers::MatrixMarketReader<float, unsigned>;
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template class LegionSolvers::MatrixMarketReader<float, long long>;
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template class LegionSolvers::MatrixMarketReader<double, int>;
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template class LegionSolvers::MatrixMarketReader<double, unsigned>;
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template class LegionSolvers::MatrixMarketReader<double, long long>;
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
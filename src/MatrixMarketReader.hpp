@@ -0,0 +1,121 @@
+#ifndef LEGION_SOLVERS_MATRIX_MARKET_READER_HPP_INCLUDED
+#define LEGION_SOLVERS_MATRIX_MARKET_READER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <string>  // for std::string
+
+#include <legion.h> // for Legion::*
+
+#include "COOMatrix.hpp"          // for COOMatrix
+#include "CSRMatrix.hpp"          // for CSRMatrix
+#include "MatrixMarketParser.hpp" // for MatrixMarketHeader
+
+namespace LegionSolvers {
+
+
+// Reads the banner, comments, and size line of the Matrix Market file at
+// path, which must store a real, integer, or pattern matrix in coordinate
+// format. Complex and Hermitian matrices, and dense (array format)
+// matrices, are not supported.
+MatrixMarketHeader read_matrix_market_header(const std::string &path);
+
+
+// A sparse matrix read from a Matrix Market file in parallel, and stored in
+// regions owned by the reader over the 1D row space [0, num_rows) and
+// column space [0, num_cols) (the same index space for square matrices).
+//
+// The entry lines of the file are divided into num_readers equal byte
+// ranges, each parsed by its own MatrixMarketCountTask and then
+// MatrixMarketReadTask into a piece of an intermediate COO region, with
+// the mirror images of the off-diagonal entries of symmetric and
+// skew-symmetric matrices. No task reads more than its range and the end
+// of the last line that starts in it, so the load time scales with the
+// number of readers as long as the file system does. The nonzeros are then
+// gathered by the pieces of an equal partition of the rows into num_pieces
+// pieces (by dependent partitioning), where MatrixMarketSizeTask and
+// MatrixMarketFillTask sort them by column and sum repeated entries.
+//
+// The result is one kernel region with the row index, column index, and
+// entry of each nonzero, in row-major order, and a row pointer region over
+// the row space, so that it can be used as a CSR or as a COO matrix.
+template <typename ENTRY_T, typename COORD_T>
+class MatrixMarketReader {
+
+  public:
+
+    static constexpr Legion::FieldID ROW_FID = 0;
+    static constexpr Legion::FieldID COL_FID = 1;
+    static constexpr Legion::FieldID ENTRY_FID = 2;
+    static constexpr Legion::FieldID ROWPTR_FID = 0;
+
+  private:
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const MatrixMarketHeader header;
+    const Legion::IndexSpace range_space;
+    const Legion::IndexSpace domain_space;
+    const Legion::IndexSpace color_space;
+    const Legion::IndexPartition range_partition;
+    Legion::IndexSpace kernel_space;
+    Legion::FieldSpace kernel_field_space;
+    Legion::LogicalRegion kernel_region;
+    Legion::IndexPartition kernel_partition;
+    Legion::FieldSpace rowptr_field_space;
+    Legion::LogicalRegion rowptr_region;
+
+  public:
+
+    explicit MatrixMarketReader(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const std::string &path,
+        std::size_t num_readers,
+        std::size_t num_pieces
+    );
+
+    MatrixMarketReader(const MatrixMarketReader &) = delete;
+
+    MatrixMarketReader &operator=(const MatrixMarketReader &) = delete;
+
+    ~MatrixMarketReader();
+
+    const MatrixMarketHeader &get_header() const { return header; }
+
+    // Number of nonzeros after symmetric expansion and summation of
+    // repeated entries.
+    std::size_t get_num_nonzeros() const;
+
+    Legion::IndexSpace get_range_space() const { return range_space; }
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_color_space() const { return color_space; }
+
+    // Equal partition of the rows into num_pieces pieces.
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    // Nonzeros of the rows of each piece of the range partition.
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::LogicalRegion get_kernel_region() const { return kernel_region; }
+
+    Legion::LogicalRegion get_rowptr_region() const { return rowptr_region; }
+
+    // The matrix as a CSRMatrix or COOMatrix over the regions of *this,
+    // which must outlive it.
+    std::unique_ptr<CSRMatrix<ENTRY_T, 1, COORD_T>> make_csr_matrix() const;
+
+    std::unique_ptr<COOMatrix<ENTRY_T, 1, COORD_T>> make_coo_matrix() const;
+
+}; // class MatrixMarketReader
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MATRIX_MARKET_READER_HPP_INCLUDED
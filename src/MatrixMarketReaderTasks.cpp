@@ -0,0 +1,399 @@
+#include "MatrixMarketReaderTasks.hpp"
+
+#include <algorithm> // for std::copy, std::min, std::stable_sort
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint64_t
+#include <cstring>   // for std::memchr
+#include <fstream>   // for std::ifstream
+#include <numeric>   // for std::iota
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+
+#include "LegionUtilities.hpp"    // for AffineReader, AffineWriter
+#include "LibraryOptions.hpp"     // for LEGION_SOLVERS_MATRIX_MARKET_*
+#include "MatrixMarketParser.hpp" // for parse_matrix_market_entry, ...
+#include "PieceRows.hpp"          // for PieceRows, collect_piece_rows
+#include "SELLMatrixTasks.hpp"    // for sell_extent
+
+using LegionSolvers::AffineWriter;
+using LegionSolvers::LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE;
+using LegionSolvers::MatrixMarketAssemblyArgs;
+using LegionSolvers::MatrixMarketCountTask;
+using LegionSolvers::MatrixMarketEntry;
+using LegionSolvers::MatrixMarketField;
+using LegionSolvers::MatrixMarketFillTask;
+using LegionSolvers::MatrixMarketHeader;
+using LegionSolvers::MatrixMarketReadTask;
+using LegionSolvers::MatrixMarketSizeTask;
+using LegionSolvers::MatrixMarketSymmetry;
+using LegionSolvers::PieceRows;
+using LegionSolvers::SparseFormat;
+using LegionSolvers::check_matrix_market;
+using LegionSolvers::collect_piece_rows;
+using LegionSolvers::parse_matrix_market_entry;
+using LegionSolvers::parse_matrix_market_index;
+using LegionSolvers::sell_extent;
+using LegionSolvers::skip_matrix_market_blanks;
+
+
+inline const MatrixMarketHeader &
+matrix_market_header(const Legion::Task *task) {
+    assert(task->arglen > sizeof(MatrixMarketHeader));
+    return *static_cast<const MatrixMarketHeader *>(task->args);
+}
+
+
+inline std::string matrix_market_path(const Legion::Task *task) {
+    return std::string{
+        static_cast<const char *>(task->args) + sizeof(MatrixMarketHeader),
+        task->arglen - sizeof(MatrixMarketHeader)};
+}
+
+
+// Calls f(line, end) for each line that starts in the byte range of the
+// launch point of a reader task (see MatrixMarketReaderTasks.hpp), where
+// *end is the newline that ends the line, or a NUL terminator after the
+// last line of the file. The file is read sequentially, in blocks of
+// LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE bytes, into a buffer that only
+// grows if a single line is longer than that.
+template <typename F>
+void for_each_matrix_market_line(const Legion::Task *task, const F &f) {
+    const MatrixMarketHeader &header = matrix_market_header(task);
+    const std::uint64_t num_ranges = task->index_domain.get_volume();
+    const std::uint64_t r = static_cast<std::uint64_t>(
+        task->index_point[0] - task->index_domain.lo()[0]
+    );
+    const std::uint64_t size = header.data_end - header.data_begin;
+    const std::uint64_t begin = header.data_begin + size * r / num_ranges;
+    const std::uint64_t end = header.data_begin + size * (r + 1) / num_ranges;
+    if (begin == end) { return; }
+
+    // The first line of the range is the one after the first newline at or
+    // after begin - 1, unless the range starts at the first entry line.
+    bool skipping = (begin != header.data_begin);
+    std::uint64_t position = skipping ? begin - 1 : begin; // of buffer[0]
+    std::ifstream file{matrix_market_path(task), std::ios::binary};
+    check_matrix_market(static_cast<bool>(file), "cannot open file");
+    file.seekg(static_cast<std::streamoff>(position));
+
+    std::vector<char> buffer(LEGION_SOLVERS_MATRIX_MARKET_READ_SIZE + 1);
+    std::size_t filled = 0;
+    std::size_t next = 0; // start of the first unprocessed line
+    while (true) {
+        if (next > 0) {
+            std::copy(
+                buffer.begin() + static_cast<std::ptrdiff_t>(next),
+                buffer.begin() + static_cast<std::ptrdiff_t>(filled),
+                buffer.begin()
+            );
+            position += next;
+            filled -= next;
+            next = 0;
+        }
+        if (filled + 1 == buffer.size()) { buffer.resize(2 * filled + 1); }
+        const std::uint64_t remaining = header.data_end - position - filled;
+        const std::size_t count = static_cast<std::size_t>(
+            std::min<std::uint64_t>(buffer.size() - 1 - filled, remaining)
+        );
+        file.read(buffer.data() + filled, static_cast<std::streamsize>(count));
+        check_matrix_market(
+            static_cast<std::size_t>(file.gcount()) == count,
+            "file changed while being read"
+        );
+        filled += count;
+        buffer[filled] = '\0';
+        const bool at_end = (position + filled == header.data_end);
+
+        const char *const data = buffer.data();
+        if (skipping) {
+            const void *newline = std::memchr(data, '\n', filled);
+            if (newline == nullptr) {
+                if (at_end) { return; }
+                next = filled;
+                continue;
+            }
+            next = static_cast<std::size_t>(
+                static_cast<const char *>(newline) - data + 1
+            );
+            skipping = false;
+        }
+        while (next < filled) {
+            if (position + next >= end) { return; }
+            const char *const line = data + next;
+            const void *newline = std::memchr(line, '\n', filled - next);
+            if (newline == nullptr) {
+                if (at_end) {
+                    f(line, data + filled);
+                    return;
+                }
+                break;
+            }
+            f(line, static_cast<const char *>(newline));
+            next = static_cast<std::size_t>(
+                static_cast<const char *>(newline) - data + 1
+            );
+        }
+        if (at_end && (next == filled)) { return; }
+    }
+}
+
+
+// Number of nonzeros that the line [line, end) contributes: none for blank
+// and comment lines, two for off-diagonal entries of symmetric and
+// skew-symmetric matrices, and one otherwise. Only indices are parsed.
+inline std::uint64_t matrix_market_multiplicity(
+    const MatrixMarketHeader &header, const char *line, const char *end
+) {
+    const char *p = line;
+    skip_matrix_market_blanks(p, end);
+    if ((p == end) || (*p == '%')) { return 0; }
+    if (header.symmetry == MatrixMarketSymmetry::GENERAL) { return 1; }
+    std::uint64_t row = 0;
+    std::uint64_t col = 0;
+    bool ok = parse_matrix_market_index(p, end, row);
+    skip_matrix_market_blanks(p, end);
+    ok = ok && parse_matrix_market_index(p, end, col);
+    check_matrix_market(ok, "malformed entry line");
+    return (row == col) ? 1 : 2;
+}
+
+
+// The nonzeros of the rows of the piece of an assembly task, sorted by
+// column within each row, with the entries of repeated columns summed in
+// the order of the kernel space (i.e., in file order).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+PieceRows<ENTRY_T, DIM, COORD_T> assemble_piece_rows(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+
+    assert(task->arglen == sizeof(MatrixMarketAssemblyArgs));
+    const MatrixMarketAssemblyArgs &args =
+        *static_cast<const MatrixMarketAssemblyArgs *>(task->args);
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_piece_rows<ENTRY_T, DIM, COORD_T>(
+            task,
+            regions,
+            ctx,
+            rt,
+            SparseFormat::COO,
+            rt->get_index_subspace(ctx, args.range_partition, task->index_point)
+        );
+    const auto column_less = [&](std::size_t a, std::size_t b) {
+        const Index &x = piece.columns[a];
+        const Index &y = piece.columns[b];
+        for (int d = 0; d < DIM; ++d) {
+            if (x[d] != y[d]) { return x[d] < y[d]; }
+        }
+        return false;
+    };
+
+    PieceRows<ENTRY_T, DIM, COORD_T> result;
+    result.rows = piece.rows;
+    result.offsets.push_back(0);
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < piece.rows.size(); ++i) {
+        order.resize(piece.length(i));
+        std::iota(order.begin(), order.end(), piece.offsets[i]);
+        std::stable_sort(order.begin(), order.end(), column_less);
+        for (const std::size_t j : order) {
+            if ((result.columns.size() > result.offsets.back()) &&
+                (result.columns.back() == piece.columns[j])) {
+                result.entries.back() += piece.entries[j];
+            } else {
+                result.columns.push_back(piece.columns[j]);
+                result.entries.push_back(piece.entries[j]);
+            }
+        }
+        result.offsets.push_back(result.columns.size());
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint64_t MatrixMarketCountTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.empty());
+    assert(task->regions.empty());
+    const MatrixMarketHeader &header = matrix_market_header(task);
+    std::uint64_t count = 0;
+    for_each_matrix_market_line(
+        task,
+        [&](const char *line, const char *end) {
+            count += matrix_market_multiplicity(header, line, end);
+        }
+    );
+    return count;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MatrixMarketReadTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+
+    assert(regions.size() == 3);
+    assert(task->regions.size() == 3);
+    std::vector<Legion::FieldID> fids;
+    for (const auto &requirement : task->regions) {
+        assert(requirement.privilege_fields.size() == 1);
+        fids.push_back(*requirement.privilege_fields.begin());
+    }
+    AffineWriter<Index, 1, COORD_T> row_writer{regions[0], fids[0]};
+    AffineWriter<Index, 1, COORD_T> col_writer{regions[1], fids[1]};
+    AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[2], fids[2]};
+
+    const MatrixMarketHeader &header = matrix_market_header(task);
+    using Symmetry = MatrixMarketSymmetry;
+    const bool pattern = (header.field == MatrixMarketField::PATTERN);
+    const bool mirrored = (header.symmetry != Symmetry::GENERAL);
+    const bool skew = (header.symmetry == Symmetry::SKEW_SYMMETRIC);
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    KernelIterator k(kernel_domain);
+    const auto write = [&](std::uint64_t row, std::uint64_t col, ENTRY_T v) {
+        assert(k());
+        row_writer[*k] = Index{static_cast<COORD_T>(row)};
+        col_writer[*k] = Index{static_cast<COORD_T>(col)};
+        entry_writer[*k] = v;
+        ++k;
+    };
+    for_each_matrix_market_line(
+        task,
+        [&](const char *line, const char *end) {
+            MatrixMarketEntry entry;
+            if (!parse_matrix_market_entry(line, end, pattern, entry)) {
+                return;
+            }
+            check_matrix_market(
+                (1 <= entry.row) && (entry.row <= header.num_rows) &&
+                    (1 <= entry.col) && (entry.col <= header.num_cols),
+                "entry index out of range"
+            );
+            const ENTRY_T value = static_cast<ENTRY_T>(entry.value);
+            write(entry.row - 1, entry.col - 1, value);
+            if (mirrored && (entry.row != entry.col)) {
+                write(entry.col - 1, entry.row - 1, skew ? -value : value);
+            }
+        }
+    );
+    assert(!k());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::uint64_t MatrixMarketSizeTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 3);
+    assert(task->regions.size() == 3);
+    return assemble_piece_rows<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt)
+        .columns.size();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MatrixMarketFillTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using KernelIndex = Legion::Point<1, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+
+    assert(regions.size() == 7);
+    assert(task->regions.size() == 7);
+    std::vector<Legion::FieldID> fids;
+    for (std::size_t r = 3; r < 7; ++r) {
+        assert(task->regions[r].privilege_fields.size() == 1);
+        fids.push_back(*task->regions[r].privilege_fields.begin());
+    }
+    AffineWriter<RowExtent, DIM, COORD_T> rowptr_writer{regions[3], fids[0]};
+    AffineWriter<Index, 1, COORD_T> row_writer{regions[4], fids[1]};
+    AffineWriter<Index, 1, COORD_T> col_writer{regions[5], fids[2]};
+    AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[6], fids[3]};
+
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        assemble_piece_rows<ENTRY_T, DIM, COORD_T>(task, regions, ctx, rt);
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[4].region.get_index_space()
+    );
+    assert(kernel_domain.dense());
+    assert(kernel_domain.get_volume() == piece.columns.size());
+    const COORD_T first = kernel_domain.bounds<1, COORD_T>().lo[0];
+    for (std::size_t i = 0; i < piece.rows.size(); ++i) {
+        rowptr_writer[piece.rows[i]] = sell_extent(
+            static_cast<COORD_T>(first + piece.offsets[i]), piece.length(i)
+        );
+        for (std::size_t j = piece.offsets[i]; j < piece.offsets[i + 1]; ++j) {
+            const KernelIndex k{static_cast<COORD_T>(first + j)};
+            row_writer[k] = piece.rows[i];
+            col_writer[k] = piece.columns[j];
+            entry_writer[k] = piece.entries[j];
+        }
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template std::uint64_t MatrixMarketCountTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template std::uint64_t MatrixMarketCountTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template std::uint64_t MatrixMarketCountTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template std::uint64_t MatrixMarketCountTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template std::uint64_t MatrixMarketCountTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template std::uint64_t MatrixMarketCountTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketReadTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template std::uint64_t MatrixMarketSizeTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        template void MatrixMarketFillTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,160 @@
+#ifndef LEGION_SOLVERS_MATRIX_MARKET_READER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_MATRIX_MARKET_READER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint64_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for MATRIX_MARKET_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// The tasks below are defined for DIM = 1 only, the dimension of the row and
+// column spaces of a matrix read from a file, and are registered for it by
+// preregister_1d_tdi_tasks.
+//
+// The task argument of MatrixMarketCountTask and MatrixMarketReadTask is a
+// MatrixMarketHeader (see MatrixMarketParser.hpp) followed by the path of
+// the file, without terminator. Each point r of a launch over R points reads
+// the entry lines that start in the r-th of R equal byte ranges of the
+// entry data, so that the lines of the file are divided among the points
+// without any of them having to look at the others' ranges.
+
+
+// Returns the number of nonzeros, after symmetric expansion, of the entry
+// lines of one byte range of a Matrix Market file. There are no regions.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct MatrixMarketCountTask
+    : public TaskTDI<
+          MATRIX_MARKET_COUNT_TASK_BLOCK_ID,
+          MatrixMarketCountTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "matrix_market_count";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = std::uint64_t;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct MatrixMarketCountTask
+
+
+// Writes the nonzeros counted by MatrixMarketCountTask, in COO form with
+// 0-based indices, in file order. The mirror image of each off-diagonal
+// entry of a symmetric (skew-symmetric) matrix follows it, with the same
+// (negated) value. Regions are row indices, column indices, and entries
+// (write-discard, one piece of a 1D space with as many points as the
+// count, one requirement each).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct MatrixMarketReadTask
+    : public TaskTDI<
+          MATRIX_MARKET_READ_TASK_BLOCK_ID,
+          MatrixMarketReadTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "matrix_market_read";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct MatrixMarketReadTask
+
+
+// Task argument of MatrixMarketSizeTask and MatrixMarketFillTask: the
+// partition of the rows into pieces, whose colors are the launch points.
+struct MatrixMarketAssemblyArgs {
+    Legion::IndexPartition range_partition;
+}; // struct MatrixMarketAssemblyArgs
+
+
+// Returns the number of distinct (row, column) pairs among the COO nonzeros
+// of the rows of one piece. Regions are row indices, column indices, and
+// entries (read-only, the nonzeros whose row lies in the piece, as for
+// collect_piece_rows).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct MatrixMarketSizeTask
+    : public TaskTDI<
+          MATRIX_MARKET_SIZE_TASK_BLOCK_ID,
+          MatrixMarketSizeTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "matrix_market_size";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = std::uint64_t;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct MatrixMarketSizeTask
+
+
+// Writes the rows of one piece in CSR form, sized by MatrixMarketSizeTask:
+// within each row, nonzeros are sorted by column, and the entries of
+// repeated (row, column) pairs are summed. The first three regions are as
+// for MatrixMarketSizeTask; they are followed by the row pointers (range
+// piece), and the row indices, column indices, and entries of the result
+// (kernel piece), all write-discard. The row indices make the result a
+// valid COO matrix as well.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct MatrixMarketFillTask
+    : public TaskTDI<
+          MATRIX_MARKET_FILL_TASK_BLOCK_ID,
+          MatrixMarketFillTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "matrix_market_fill";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct MatrixMarketFillTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MATRIX_MARKET_READER_TASKS_HPP_INCLUDED
@@ -0,0 +1,203 @@
+#include "MatrixPowersKernel.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+
+#include "CSRMatrixTasks.hpp" // for CSRMatrixPowersTask
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::CSRMatrixPowersTask;
+using LegionSolvers::MatrixPowersKernel;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+MatrixPowersKernel<ENTRY_T, DIM, COORD_T>::MatrixPowersKernel(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+    int depth
+)
+    : ctx(ctx), rt(rt), matrix(matrix), depth(depth) {
+    assert((depth >= 1) && (depth <= LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH));
+    const Legion::IndexSpace space = matrix.get_range_space();
+    assert(matrix.get_domain_space() == space);
+    const Legion::IndexSpace color_space =
+        rt->get_index_partition_color_space_name(
+            ctx, matrix.get_range_partition()
+        );
+    ghost_partitions.push_back(matrix.get_range_partition());
+    kernel_partitions.push_back(matrix.get_kernel_partition());
+    for (int k = 1; k <= depth; ++k) {
+        const Legion::IndexPartition columns =
+            matrix.domain_partition_from_kernel_partition(
+                space, kernel_partitions[k - 1]
+            );
+        ghost_partitions.push_back(rt->create_partition_by_union(
+            ctx, space, ghost_partitions[k - 1], columns, color_space
+        ));
+        rt->destroy_index_partition(ctx, columns);
+        if (k < depth) {
+            kernel_partitions.push_back(
+                matrix.kernel_partition_from_range_partition(
+                    ghost_partitions[k]
+                )
+            );
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+MatrixPowersKernel<ENTRY_T, DIM, COORD_T>::~MatrixPowersKernel() {
+    // Depth 0 partitions belong to the matrix.
+    for (int k = 1; k <= depth; ++k) {
+        rt->destroy_index_partition(ctx, ghost_partitions[k]);
+        if (k < depth) {
+            rt->destroy_index_partition(ctx, kernel_partitions[k]);
+        }
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MatrixPowersKernel<ENTRY_T, DIM, COORD_T>::apply(
+    const KrylovBasis<ENTRY_T> &basis,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid,
+    const std::vector<Legion::LogicalRegion> &output_regions,
+    const std::vector<Legion::FieldID> &output_fids
+) const {
+    const std::size_t L = output_regions.size();
+    assert((L >= 1) && (L <= static_cast<std::size_t>(depth)));
+    assert(L <= basis.length);
+    assert(output_fids.size() == L);
+
+    const Legion::LogicalRegion rowptr_region = matrix.get_rowptr_region();
+    const Legion::LogicalRegion kernel_region = matrix.get_kernel_region();
+    Legion::IndexLauncher launcher{
+        CSRMatrixPowersTask<ENTRY_T, DIM, COORD_T>::task_id,
+        rt->get_index_partition_color_space_name(ctx, ghost_partitions[0]),
+        Legion::TaskArgument{&basis, sizeof(KrylovBasis<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, ghost_partitions[L]),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    for (std::size_t k = 1; k <= L; ++k) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rt->get_logical_partition(
+                    ctx, rowptr_region, ghost_partitions[L - k]
+                ),
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(matrix.get_fid_rowptr());
+    }
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partitions[L - 1]);
+    for (const Legion::FieldID fid :
+         {matrix.get_fid_col(), matrix.get_fid_entry()}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    for (std::size_t k = 0; k < L; ++k) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rt->get_logical_partition(
+                    ctx, output_regions[k], ghost_partitions[0]
+                ),
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                output_regions[k]})
+            .add_field(output_fids[k]);
+    }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MatrixPowersKernel<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MatrixPowersKernel<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MatrixPowersKernel<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,75 @@
+#ifndef LEGION_SOLVERS_MATRIX_POWERS_KERNEL_HPP_INCLUDED
+#define LEGION_SOLVERS_MATRIX_POWERS_KERNEL_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CSRMatrix.hpp"   // for CSRMatrix
+#include "KrylovBasis.hpp" // for KrylovBasis
+
+namespace LegionSolvers {
+
+
+// Computes up to depth vectors v_1, ..., v_L of a Krylov basis of a square
+// CSRMatrix A from v_0 in one index launch over the range partition of A
+// (see CSRMatrixPowersTask). Each piece reads v_0 once over its ghost piece
+// of depth L, the points reachable from the piece by at most L steps along
+// the nonzeros of A, so that the L products exchange halos once instead of
+// L times, at the cost of computing the products near piece boundaries
+// redundantly.
+//
+// Ghost partitions are derived once, when the kernel is constructed, by
+// alternating the kernel_partition_from_range_partition and
+// domain_partition_from_kernel_partition interfaces of AbstractMatrix:
+// the ghost piece of depth k + 1 is the union of the ghost piece of depth
+// k and the columns of its rows.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class MatrixPowersKernel {
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix;
+    const int depth;
+    std::vector<Legion::IndexPartition> ghost_partitions;  // depth 0..depth
+    std::vector<Legion::IndexPartition> kernel_partitions; // depth 0..depth-1
+
+  public:
+
+    explicit MatrixPowersKernel(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+        int depth
+    );
+
+    MatrixPowersKernel(const MatrixPowersKernel &) = delete;
+
+    MatrixPowersKernel &operator=(const MatrixPowersKernel &) = delete;
+
+    ~MatrixPowersKernel();
+
+    int get_depth() const { return depth; }
+
+    // Ghost partition of depth k; depth 0 is the range partition of A.
+    Legion::IndexPartition get_ghost_partition(int k) const {
+        return ghost_partitions[k];
+    }
+
+    // Computes v_1, ..., v_L, where L = output_regions.size() is at most
+    // the depth of the kernel and the length of basis, into fields of
+    // regions over the range space of A, from v_0 = input.
+    void apply(
+        const KrylovBasis<ENTRY_T> &basis,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid,
+        const std::vector<Legion::LogicalRegion> &output_regions,
+        const std::vector<Legion::FieldID> &output_fids
+    ) const;
+
+}; // class MatrixPowersKernel
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MATRIX_POWERS_KERNEL_HPP_INCLUDED
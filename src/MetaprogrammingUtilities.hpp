@@ -53,6 +53,22 @@ struct ToString<long long> {
 };
 
 
+// The other floating-point entry type: double for float and float for
+// double. Mixed-precision tasks convert between an entry type and this one.
+template <typename T>
+struct OtherPrecision;
+
+template <>
+struct OtherPrecision<float> {
+    typedef double type;
+};
+
+template <>
+struct OtherPrecision<double> {
+    typedef float type;
+};
+
+
 template <int... NS>
 struct IntList {};
 
@@ -0,0 +1,319 @@
+#include "MultiVector.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::make_unique
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp"  // for create_field_space
+#include "LibraryOptions.hpp"   // for LEGION_SOLVERS_USE_*, ...
+#include "MultiVectorTasks.hpp" // for BlockDotTask, BlockUpdateTask, ...
+#include "TaskIDs.hpp"          // for BLOCK_SUM_REDOP_ID
+
+using LegionSolvers::BLOCK_SUM_REDOP_ID;
+using LegionSolvers::BlockDotTask;
+using LegionSolvers::BlockUpdateArgs;
+using LegionSolvers::BlockUpdateKind;
+using LegionSolvers::BlockUpdateTask;
+using LegionSolvers::MultiVector;
+
+
+// Fields 0, ..., num_vectors - 1.
+inline std::vector<Legion::FieldID> consecutive_fids(std::size_t num_vectors) {
+    std::vector<Legion::FieldID> result;
+    for (std::size_t j = 0; j < num_vectors; ++j) {
+        result.push_back(static_cast<Legion::FieldID>(j));
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+MultiVector<ENTRY_T, DIM, COORD_T>::MultiVector(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexPartition index_partition,
+    std::size_t num_vectors
+)
+    : ctx(ctx), rt(rt),
+      index_space(rt->get_parent_index_space(ctx, index_partition)),
+      fids(consecutive_fids(num_vectors)),
+      field_space(LegionSolvers::create_field_space(
+          ctx, rt, std::vector<std::size_t>(num_vectors, sizeof(ENTRY_T)), fids
+      )),
+      logical_region(rt->create_logical_region(ctx, index_space, field_space)),
+      index_partition(index_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, index_partition)
+      ),
+      logical_partition(
+          rt->get_logical_partition(ctx, logical_region, index_partition)
+      ),
+      owns_region(true) {
+    assert((num_vectors > 0) && (num_vectors <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    for (const Legion::FieldID fid : fids) {
+        vectors.push_back(std::make_unique<Vector>(
+            ctx, rt, logical_region, fid, index_partition
+        ));
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+MultiVector<ENTRY_T, DIM, COORD_T>::MultiVector(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::LogicalRegion logical_region,
+    const std::vector<Legion::FieldID> &fids,
+    Legion::IndexPartition index_partition
+)
+    : ctx(ctx), rt(rt), index_space(logical_region.get_index_space()),
+      fids(fids), field_space(logical_region.get_field_space()),
+      logical_region(logical_region), index_partition(index_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, index_partition)
+      ),
+      logical_partition(
+          rt->get_logical_partition(ctx, logical_region, index_partition)
+      ),
+      owns_region(false) {
+    assert(rt->get_parent_index_space(ctx, index_partition) == index_space);
+    assert((!fids.empty()) && (fids.size() <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    for (const Legion::FieldID fid : fids) {
+        vectors.push_back(std::make_unique<Vector>(
+            ctx, rt, logical_region, fid, index_partition
+        ));
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+MultiVector<ENTRY_T, DIM, COORD_T>::~MultiVector() {
+    vectors.clear();
+    if (owns_region) {
+        rt->destroy_logical_region(ctx, logical_region);
+        rt->destroy_field_space(ctx, field_space);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::LogicalPartition
+MultiVector<ENTRY_T, DIM, COORD_T>::get_aligned_partition(
+    const MultiVector &x
+) const {
+    assert(x.index_space == index_space);
+    if (x.index_partition == index_partition) {
+        return x.logical_partition;
+    } else {
+        return rt->get_logical_partition(
+            ctx, x.logical_region, index_partition
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::constant_fill(ENTRY_T value) {
+    for (const Legion::FieldID fid : fids) {
+        rt->fill_field<ENTRY_T>(
+            ctx, logical_region, logical_region, fid, value
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::copy(const MultiVector &x) {
+    assert(x.fids.size() == fids.size());
+    Legion::IndexCopyLauncher launcher{color_space};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_copy_requirements(
+        Legion::RegionRequirement{
+            get_aligned_partition(x),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            x.logical_region},
+        Legion::RegionRequirement{
+            logical_partition,
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            logical_region}
+    );
+    for (std::size_t j = 0; j < fids.size(); ++j) {
+        launcher.add_src_field(0, x.fids[j]);
+        launcher.add_dst_field(0, fids[j]);
+    }
+    rt->issue_copy_operation(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future
+MultiVector<ENTRY_T, DIM, COORD_T>::dot(const MultiVector &x) const {
+    Legion::IndexLauncher launcher{
+        BlockDotTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_region_requirement(Legion::RegionRequirement{
+        logical_partition,
+        0,
+        LEGION_READ_ONLY,
+        LEGION_EXCLUSIVE,
+        logical_region});
+    for (const Legion::FieldID fid : fids) {
+        launcher.region_requirements.back().add_field(fid);
+    }
+    launcher.add_region_requirement(Legion::RegionRequirement{
+        get_aligned_partition(x),
+        0,
+        LEGION_READ_ONLY,
+        LEGION_EXCLUSIVE,
+        x.logical_region});
+    for (const Legion::FieldID fid : x.fids) {
+        launcher.region_requirements.back().add_field(fid);
+    }
+    return rt->execute_index_space(
+        ctx, launcher, BLOCK_SUM_REDOP_ID<ENTRY_T>
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::update(
+    BlockUpdateKind kind,
+    const Legion::Future &coefficients,
+    const MultiVector &x
+) {
+    assert(x.logical_region != logical_region);
+    assert((kind != BlockUpdateKind::XPAY) || (x.fids.size() == fids.size()));
+    const BlockUpdateArgs args{kind};
+    Legion::IndexLauncher launcher{
+        BlockUpdateTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(BlockUpdateArgs)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_region_requirement(Legion::RegionRequirement{
+        logical_partition,
+        0,
+        LEGION_READ_WRITE,
+        LEGION_EXCLUSIVE,
+        logical_region});
+    for (const Legion::FieldID fid : fids) {
+        launcher.region_requirements.back().add_field(fid);
+    }
+    launcher.add_region_requirement(Legion::RegionRequirement{
+        get_aligned_partition(x),
+        0,
+        LEGION_READ_ONLY,
+        LEGION_EXCLUSIVE,
+        x.logical_region});
+    for (const Legion::FieldID fid : x.fids) {
+        launcher.region_requirements.back().add_field(fid);
+    }
+    launcher.add_future(coefficients);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::add(
+    const Legion::Future &coefficients, const MultiVector &x
+) {
+    update(BlockUpdateKind::ADD, coefficients, x);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::subtract(
+    const Legion::Future &coefficients, const MultiVector &x
+) {
+    update(BlockUpdateKind::SUBTRACT, coefficients, x);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void MultiVector<ENTRY_T, DIM, COORD_T>::xpay(
+    const Legion::Future &coefficients, const MultiVector &x
+) {
+    update(BlockUpdateKind::XPAY, coefficients, x);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::MultiVector<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::MultiVector<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::MultiVector<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,130 @@
+#ifndef LEGION_SOLVERS_MULTI_VECTOR_HPP_INCLUDED
+#define LEGION_SOLVERS_MULTI_VECTOR_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp" // for DistributedVector
+#include "MultiVectorTasks.hpp"  // for BlockUpdateKind
+
+namespace LegionSolvers {
+
+
+// A block of k vectors, at most LEGION_SOLVERS_MAX_BLOCK_SIZE, stored as k
+// fields of a single logical region over an index space that is divided
+// into pieces by an application-supplied index partition, such as the
+// right-hand sides and solutions of several linear systems with the same
+// operator. The region is either created and owned by the multi-vector,
+// with fields 0, ..., k - 1, or supplied by the application with a list of
+// k fields, in which case the multi-vector operates on it in place.
+//
+// Block operations are issued as one index launch over the color space of
+// the partition, and read each entry of each vector once: products with an
+// operator go through AbstractLinearOperator::matmat, and the k-by-m
+// blocks of coefficients that combine multi-vectors (see BlockScalars) are
+// Legion futures. Each vector of the block is also available as a
+// DistributedVector for single-vector operations. As for
+// DistributedVector, operations on two multi-vectors require both to be
+// defined over the same index space, and use the partition of *this.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class MultiVector {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::IndexSpace index_space;
+    const std::vector<Legion::FieldID> fids;
+    const Legion::FieldSpace field_space;
+    const Legion::LogicalRegion logical_region;
+    const Legion::IndexPartition index_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::LogicalPartition logical_partition;
+    const bool owns_region;
+    std::vector<std::unique_ptr<Vector>> vectors;
+
+    void update(
+        BlockUpdateKind kind,
+        const Legion::Future &coefficients,
+        const MultiVector &x
+    );
+
+  public:
+
+    explicit MultiVector(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::IndexPartition index_partition,
+        std::size_t num_vectors
+    );
+
+    // Wraps fields fids of an existing region over the parent index space of
+    // index_partition, which remains owned by the caller.
+    explicit MultiVector(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::LogicalRegion logical_region,
+        const std::vector<Legion::FieldID> &fids,
+        Legion::IndexPartition index_partition
+    );
+
+    MultiVector(const MultiVector &) = delete;
+
+    MultiVector &operator=(const MultiVector &) = delete;
+
+    ~MultiVector();
+
+    std::size_t get_num_vectors() const { return fids.size(); }
+
+    const std::vector<Legion::FieldID> &get_fids() const { return fids; }
+
+    Legion::IndexSpace get_index_space() const { return index_space; }
+
+    Legion::LogicalRegion get_logical_region() const { return logical_region; }
+
+    Legion::IndexPartition get_index_partition() const {
+        return index_partition;
+    }
+
+    Legion::IndexSpace get_color_space() const { return color_space; }
+
+    Legion::LogicalPartition get_logical_partition() const {
+        return logical_partition;
+    }
+
+    // Vector j of the block, operating on its field in place.
+    Vector &get_vector(std::size_t j) { return *vectors[j]; }
+
+    const Vector &get_vector(std::size_t j) const { return *vectors[j]; }
+
+    // Logical partition of x's region by the index partition of *this.
+    Legion::LogicalPartition get_aligned_partition(const MultiVector &x) const;
+
+    void constant_fill(ENTRY_T value);
+
+    // *this = x
+    void copy(const MultiVector &x);
+
+    // Returns the k-by-m block (*this)^T * x, where x has m vectors, as a
+    // BlockScalars<ENTRY_T> future.
+    Legion::Future dot(const MultiVector &x) const;
+
+    // *this = *this + x * M, for a future M with as many rows as x has
+    // vectors and as many columns as *this has vectors.
+    void add(const Legion::Future &coefficients, const MultiVector &x);
+
+    // *this = *this - x * M
+    void subtract(const Legion::Future &coefficients, const MultiVector &x);
+
+    // *this = x + *this * M, for a square future M.
+    void xpay(const Legion::Future &coefficients, const MultiVector &x);
+
+}; // class MultiVector
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MULTI_VECTOR_HPP_INCLUDED
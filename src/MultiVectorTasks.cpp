@@ -0,0 +1,443 @@
+#include "MultiVectorTasks.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+#include <cstddef> // for std::size_t
+#include <limits>  // for std::numeric_limits
+#include <vector>  // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineReaderWriter
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*, ...
+#include "VectorKernels.hpp"   // for dense_block_dot, dense_block_update, ...
+
+using LegionSolvers::BlockDotTask;
+using LegionSolvers::BlockScalars;
+using LegionSolvers::BlockSolveArgs;
+using LegionSolvers::BlockSolveTask;
+using LegionSolvers::BlockUpdateArgs;
+using LegionSolvers::BlockUpdateKind;
+using LegionSolvers::BlockUpdateTask;
+using LegionSolvers::dense_block_dot;
+using LegionSolvers::dense_block_update;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+using LegionSolvers::max_thread_ranges;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+BlockScalars<ENTRY_T> BlockDotTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 2);
+    assert(task->regions.size() == 2);
+    const auto &x_req = task->regions[0];
+    const auto &y_req = task->regions[1];
+
+    const std::size_t k = x_req.instance_fields.size();
+    const std::size_t m = y_req.instance_fields.size();
+    assert((k > 0) && (k <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    assert((m > 0) && (m <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    const bool symmetric = (x_req.region == y_req.region) &&
+                           (x_req.instance_fields == y_req.instance_fields);
+
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> x_readers;
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> y_readers;
+    for (std::size_t i = 0; i < k; ++i) {
+        x_readers.emplace_back(regions[0], x_req.instance_fields[i]);
+    }
+    for (std::size_t j = 0; j < m; ++j) {
+        y_readers.emplace_back(regions[1], y_req.instance_fields[j]);
+    }
+
+    const Legion::Domain domain =
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space());
+    assert(
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space()) ==
+        domain
+    );
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    // As in DotTask, per-thread results are merged in thread order.
+    BlockScalars<ENTRY_T> result = {};
+    std::vector<BlockScalars<ENTRY_T>> thread_results(
+        max_thread_ranges(parallel), BlockScalars<ENTRY_T>{}
+    );
+    const ENTRY_T *x_ptrs[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    const ENTRY_T *y_ptrs[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (RectIterator rect_iter(domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        bool dense = true;
+        for (std::size_t i = 0; dense && (i < k); ++i) {
+            dense = is_dense_rect(rect, x_readers[i], y_readers[0]);
+        }
+        for (std::size_t j = 1; dense && (j < m); ++j) {
+            dense = is_dense_rect(rect, x_readers[0], y_readers[j]);
+        }
+        if (dense) {
+            for (std::size_t i = 0; i < k; ++i) {
+                x_ptrs[i] = x_readers[i].ptr(rect.lo);
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                y_ptrs[j] = y_readers[j].ptr(rect.lo);
+            }
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int thread, std::size_t begin, std::size_t end) {
+                    const ENTRY_T *x[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+                    const ENTRY_T *y[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+                    for (std::size_t i = 0; i < k; ++i) {
+                        x[i] = x_ptrs[i] + begin;
+                    }
+                    for (std::size_t j = 0; j < m; ++j) {
+                        y[j] = y_ptrs[j] + begin;
+                    }
+                    dense_block_dot(
+                        end - begin,
+                        k,
+                        x,
+                        m,
+                        y,
+                        symmetric,
+                        thread_results[thread].values
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            for (std::size_t i = 0; i < k; ++i) {
+                const ENTRY_T xi = x_readers[i][point];
+                for (std::size_t j = (symmetric ? i : 0); j < m; ++j) {
+                    result(i, j) += xi * y_readers[j][point];
+                }
+            }
+        }
+    }
+    for (const auto &thread_result : thread_results) {
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                result(i, j) += thread_result(i, j);
+            }
+        }
+    }
+    if (symmetric) {
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < i; ++j) { result(i, j) = result(j, i); }
+        }
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void BlockUpdateTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 2);
+    assert(task->regions.size() == 2);
+    const auto &y_req = task->regions[0];
+    const auto &x_req = task->regions[1];
+
+    assert(task->arglen == sizeof(BlockUpdateArgs));
+    const BlockUpdateArgs &args =
+        *static_cast<const BlockUpdateArgs *>(task->args);
+    const bool xpay = (args.kind == BlockUpdateKind::XPAY);
+
+    const std::size_t m = y_req.instance_fields.size();
+    const std::size_t k = x_req.instance_fields.size();
+    assert((m > 0) && (m <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    assert((k > 0) && (k <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    assert(!xpay || (k == m));
+
+    assert(task->futures.size() == 1);
+    BlockScalars<ENTRY_T> coefficients =
+        task->futures[0].get_result<BlockScalars<ENTRY_T>>();
+    if (args.kind == BlockUpdateKind::SUBTRACT) {
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < m; ++j) {
+                coefficients(i, j) = -coefficients(i, j);
+            }
+        }
+    }
+
+    std::vector<AffineReaderWriter<ENTRY_T, DIM, COORD_T>> y_writers;
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> x_readers;
+    for (std::size_t j = 0; j < m; ++j) {
+        y_writers.emplace_back(regions[0], y_req.instance_fields[j]);
+    }
+    for (std::size_t i = 0; i < k; ++i) {
+        x_readers.emplace_back(regions[1], x_req.instance_fields[i]);
+    }
+
+    const Legion::Domain domain =
+        rt->get_index_space_domain(ctx, y_req.region.get_index_space());
+    assert(
+        rt->get_index_space_domain(ctx, x_req.region.get_index_space()) ==
+        domain
+    );
+
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    using PointIterator = Legion::PointInRectIterator<DIM, COORD_T>;
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+
+    const bool parallel = is_omp_processor(ctx, rt);
+    std::vector<std::vector<ENTRY_T>> scratch(max_thread_ranges(parallel));
+    if (xpay) {
+        for (auto &thread_scratch : scratch) { thread_scratch.resize(m * B); }
+    }
+
+    const ENTRY_T *x_ptrs[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    ENTRY_T *y_ptrs[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    ENTRY_T old_y[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (RectIterator rect_iter(domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        bool dense = true;
+        for (std::size_t j = 0; dense && (j < m); ++j) {
+            dense = is_dense_rect(rect, y_writers[j], x_readers[0]);
+        }
+        for (std::size_t i = 1; dense && (i < k); ++i) {
+            dense = is_dense_rect(rect, y_writers[0], x_readers[i]);
+        }
+        if (dense) {
+            for (std::size_t i = 0; i < k; ++i) {
+                x_ptrs[i] = x_readers[i].ptr(rect.lo);
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                y_ptrs[j] = y_writers[j].ptr(rect.lo);
+            }
+            for_each_thread_range(
+                parallel,
+                rect.volume(),
+                [&](int thread, std::size_t begin, std::size_t end) {
+                    const ENTRY_T *x[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+                    ENTRY_T *y[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+                    for (std::size_t i = 0; i < k; ++i) {
+                        x[i] = x_ptrs[i] + begin;
+                    }
+                    for (std::size_t j = 0; j < m; ++j) {
+                        y[j] = y_ptrs[j] + begin;
+                    }
+                    dense_block_update(
+                        end - begin,
+                        k,
+                        x,
+                        m,
+                        y,
+                        coefficients.values,
+                        xpay,
+                        scratch[thread].data()
+                    );
+                }
+            );
+            continue;
+        }
+        for (PointIterator point_iter(rect); point_iter(); ++point_iter) {
+            const Legion::Point<DIM, COORD_T> point = *point_iter;
+            for (std::size_t j = 0; j < m; ++j) {
+                old_y[j] = y_writers[j][point];
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                ENTRY_T value = xpay ? x_readers[j][point] : old_y[j];
+                for (std::size_t i = 0; i < k; ++i) {
+                    const ENTRY_T source =
+                        xpay ? old_y[i] : x_readers[i][point];
+                    value += coefficients(i, j) * source;
+                }
+                y_writers[j][point] = value;
+            }
+        }
+    }
+}
+
+
+template <typename T>
+BlockScalars<T> BlockSolveTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->arglen == sizeof(BlockSolveArgs));
+    const BlockSolveArgs &args =
+        *static_cast<const BlockSolveArgs *>(task->args);
+    const std::size_t n = args.size;
+    const std::size_t m = args.num_columns;
+    assert((n > 0) && (n <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+    assert((m > 0) && (m <= LEGION_SOLVERS_MAX_BLOCK_SIZE));
+
+    assert(task->futures.size() == 2);
+    const BlockScalars<T> g = task->futures[0].get_result<BlockScalars<T>>();
+    const BlockScalars<T> h = task->futures[1].get_result<BlockScalars<T>>();
+
+    T scale = static_cast<T>(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (g(i, i) > scale) { scale = g(i, i); }
+    }
+    const T threshold =
+        static_cast<T>(n) * std::numeric_limits<T>::epsilon() * scale;
+
+    // Lower Cholesky factor L, column by column; dropped columns stay zero.
+    BlockScalars<T> l = {};
+    bool kept[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (std::size_t j = 0; j < n; ++j) {
+        T pivot = g(j, j);
+        for (std::size_t p = 0; p < j; ++p) { pivot -= l(j, p) * l(j, p); }
+        kept[j] = (pivot > threshold);
+        if (!kept[j]) { continue; }
+        l(j, j) = std::sqrt(pivot);
+        for (std::size_t i = j + 1; i < n; ++i) {
+            T value = g(i, j);
+            for (std::size_t p = 0; p < j; ++p) { value -= l(i, p) * l(j, p); }
+            l(i, j) = value / l(j, j);
+        }
+    }
+
+    // L * L^T * X = H, one column at a time.
+    BlockScalars<T> result = {};
+    T z[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (std::size_t c = 0; c < m; ++c) {
+        for (std::size_t i = 0; i < n; ++i) {
+            z[i] = static_cast<T>(0);
+            if (!kept[i]) { continue; }
+            T value = h(i, c);
+            for (std::size_t p = 0; p < i; ++p) { value -= l(i, p) * z[p]; }
+            z[i] = value / l(i, i);
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            if (!kept[i]) { continue; }
+            T value = z[i];
+            for (std::size_t p = i + 1; p < n; ++p) {
+                value -= l(p, i) * result(p, c);
+            }
+            result(i, c) = value / l(i, i);
+        }
+    }
+    return result;
+}
+
+
+#ifdef LEGION_SOLVERS_USE_FLOAT
+template BlockScalars<float> BlockSolveTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_FLOAT
+
+
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+template BlockScalars<double> BlockSolveTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_DOUBLE
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<float> BlockDotTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<float> BlockDotTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<float> BlockDotTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<float> BlockDotTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<float> BlockDotTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<float> BlockDotTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<float> BlockDotTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<float> BlockDotTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<float> BlockDotTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<double> BlockDotTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<double> BlockDotTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<double> BlockDotTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<double> BlockDotTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<double> BlockDotTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<double> BlockDotTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template BlockScalars<double> BlockDotTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template BlockScalars<double> BlockDotTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template BlockScalars<double> BlockDotTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void BlockUpdateTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,133 @@
+#ifndef LEGION_SOLVERS_MULTI_VECTOR_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_MULTI_VECTOR_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint8_t, std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PackedScalars.hpp"   // for BlockScalars
+#include "TaskBaseClasses.hpp" // for TaskT, TaskTDI
+#include "TaskIDs.hpp"         // for BLOCK_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Computes the k-by-m block of dot products X^T Y of two multi-vectors in
+// one piece of their index space, where entry (i, j) is the dot product of
+// vector i of X and vector j of Y. Regions are X and Y (read-only, k and m
+// fields, in the order of RegionRequirement::instance_fields). When both
+// requirements name the same region and fields, only the upper triangle is
+// computed and then mirrored. Returns a BlockScalars<ENTRY_T>, to be
+// combined across the launch by BLOCK_SUM_REDOP_ID<ENTRY_T>.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BlockDotTask
+    : public TaskTDI<
+          BLOCK_DOT_TASK_BLOCK_ID,
+          BlockDotTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "block_dot";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = BlockScalars<ENTRY_T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BlockDotTask
+
+
+enum class BlockUpdateKind : std::uint8_t {
+    ADD,      // Y = Y + X * M
+    SUBTRACT, // Y = Y - X * M
+    XPAY,     // Y = X + Y * M
+}; // enum class BlockUpdateKind
+
+
+struct BlockUpdateArgs {
+    BlockUpdateKind kind;
+}; // struct BlockUpdateArgs
+
+
+// Updates a multi-vector Y of m vectors by a multi-vector X of k vectors
+// times a k-by-m matrix M, in one piece of their index space, as selected
+// by BlockUpdateKind (for XPAY, k = m). Regions are Y (read-write, m
+// fields) and X (read-only, k fields), in the order of
+// RegionRequirement::instance_fields; the only future is M, a
+// BlockScalars<ENTRY_T>, and the task argument is a BlockUpdateArgs.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct BlockUpdateTask
+    : public TaskTDI<
+          BLOCK_UPDATE_TASK_BLOCK_ID,
+          BlockUpdateTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "block_update";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BlockUpdateTask
+
+
+struct BlockSolveArgs {
+    std::uint32_t size;
+    std::uint32_t num_columns;
+}; // struct BlockSolveArgs
+
+
+// Returns G^{-1} H for a symmetric positive semidefinite size-by-size
+// matrix G and a size-by-num_columns matrix H, the two futures (both
+// BlockScalars<T>), by Cholesky factorization of G; the task argument is a
+// BlockSolveArgs. These are the k-by-k coefficient solves of the block
+// Krylov solvers, where G is a Gram matrix that becomes singular when the
+// vectors of a block become linearly dependent (for instance, when one
+// right-hand side has converged). Pivots below size * epsilon times the
+// largest diagonal entry of G are therefore dropped, and the matching rows
+// of the result are zero, which solves the problem restricted to the
+// remaining directions.
+template <typename T>
+struct BlockSolveTask
+    : public TaskT<BLOCK_SOLVE_TASK_BLOCK_ID, BlockSolveTask, T> {
+
+    static constexpr const char *task_base_name = "block_solve";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = BlockScalars<T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct BlockSolveTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_MULTI_VECTOR_TASKS_HPP_INCLUDED
@@ -0,0 +1,144 @@
+#ifndef LEGION_SOLVERS_PACKED_SCALARS_HPP_INCLUDED
+#define LEGION_SOLVERS_PACKED_SCALARS_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <cstring> // for std::memcpy
+
+#include <legion.h> // for Legion::*
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_MAX_PACKED_SCALARS, ...
+
+namespace LegionSolvers {
+
+
+// Fixed-size bundle of scalars returned by tasks that compute several
+// reductions in a single pass, so that they travel in one future and are
+// combined across an index launch by a single reduction.
+template <typename T>
+struct PackedScalars {
+    T values[LEGION_SOLVERS_MAX_PACKED_SCALARS];
+}; // struct PackedScalars
+
+
+// Fixed-size dense matrix of scalars, with at most
+// LEGION_SOLVERS_MAX_BLOCK_SIZE rows and columns, returned by the block
+// tasks of MultiVector and the block Krylov solvers. Entry (i, j) is stored
+// at values[i * LEGION_SOLVERS_MAX_BLOCK_SIZE + j] whatever the actual
+// dimensions, which travel separately.
+template <typename T>
+struct BlockScalars {
+
+    T values[LEGION_SOLVERS_MAX_BLOCK_SIZE * LEGION_SOLVERS_MAX_BLOCK_SIZE];
+
+    T &operator()(std::size_t i, std::size_t j) {
+        return values[i * LEGION_SOLVERS_MAX_BLOCK_SIZE + j];
+    }
+
+    const T &operator()(std::size_t i, std::size_t j) const {
+        return values[i * LEGION_SOLVERS_MAX_BLOCK_SIZE + j];
+    }
+
+}; // struct BlockScalars
+
+
+template <typename T>
+struct AtomicWord;
+
+template <>
+struct AtomicWord<float> {
+    using type = std::uint32_t;
+};
+
+template <>
+struct AtomicWord<double> {
+    using type = std::uint64_t;
+};
+
+
+template <typename T>
+inline void atomic_add(T &lhs, T rhs) {
+    using Word = typename AtomicWord<T>::type;
+    Word *const target = reinterpret_cast<Word *>(&lhs);
+    Word expected = __atomic_load_n(target, __ATOMIC_RELAXED);
+    Word desired;
+    do {
+        T value;
+        std::memcpy(&value, &expected, sizeof(T));
+        value += rhs;
+        std::memcpy(&desired, &value, sizeof(T));
+    } while (!__atomic_compare_exchange_n(
+        target, &expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+    ));
+}
+
+
+// Elementwise sum of PackedScalars, registered with the Legion runtime as
+// PACKED_SUM_REDOP_ID<T> by preregister_tasks.
+template <typename T>
+struct PackedSumReduction {
+
+    using LHS = PackedScalars<T>;
+    using RHS = PackedScalars<T>;
+
+    static const RHS identity;
+
+    template <bool EXCLUSIVE>
+    static void apply(LHS &lhs, RHS rhs) {
+        for (int i = 0; i < LEGION_SOLVERS_MAX_PACKED_SCALARS; ++i) {
+            if constexpr (EXCLUSIVE) {
+                lhs.values[i] += rhs.values[i];
+            } else {
+                atomic_add(lhs.values[i], rhs.values[i]);
+            }
+        }
+    }
+
+    template <bool EXCLUSIVE>
+    static void fold(RHS &rhs1, RHS rhs2) {
+        apply<EXCLUSIVE>(rhs1, rhs2);
+    }
+
+}; // struct PackedSumReduction
+
+template <typename T>
+const PackedScalars<T> PackedSumReduction<T>::identity = {};
+
+
+// Elementwise sum of BlockScalars, registered with the Legion runtime as
+// BLOCK_SUM_REDOP_ID<T> by preregister_tasks.
+template <typename T>
+struct BlockSumReduction {
+
+    using LHS = BlockScalars<T>;
+    using RHS = BlockScalars<T>;
+
+    static const RHS identity;
+
+    template <bool EXCLUSIVE>
+    static void apply(LHS &lhs, RHS rhs) {
+        constexpr std::size_t SIZE =
+            LEGION_SOLVERS_MAX_BLOCK_SIZE * LEGION_SOLVERS_MAX_BLOCK_SIZE;
+        for (std::size_t i = 0; i < SIZE; ++i) {
+            if constexpr (EXCLUSIVE) {
+                lhs.values[i] += rhs.values[i];
+            } else {
+                atomic_add(lhs.values[i], rhs.values[i]);
+            }
+        }
+    }
+
+    template <bool EXCLUSIVE>
+    static void fold(RHS &rhs1, RHS rhs2) {
+        apply<EXCLUSIVE>(rhs1, rhs2);
+    }
+
+}; // struct BlockSumReduction
+
+template <typename T>
+const BlockScalars<T> BlockSumReduction<T>::identity = {};
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_PACKED_SCALARS_HPP_INCLUDED
@@ -0,0 +1,161 @@
+#ifndef LEGION_SOLVERS_PIECE_ROWS_HPP_INCLUDED
+#define LEGION_SOLVERS_PIECE_ROWS_HPP_INCLUDED
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <map>     // for std::map
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for AffineReader
+
+namespace LegionSolvers {
+
+
+enum class SparseFormat : std::uint8_t {
+    CSR,
+    COO,
+}; // enum class SparseFormat
+
+
+// The nonzeros of the rows of one piece of the range space, grouped by row.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct PieceRows {
+
+    std::vector<Legion::Point<DIM, COORD_T>> rows;
+    std::vector<std::size_t> offsets; // of the nonzeros of each row
+    std::vector<Legion::Point<DIM, COORD_T>> columns;
+    std::vector<ENTRY_T> entries;
+    std::vector<Legion::Point<1, COORD_T>> kernel_points;
+
+    std::size_t length(std::size_t i) const {
+        return offsets[i + 1] - offsets[i];
+    }
+
+}; // struct PieceRows
+
+
+// Collects the nonzeros of the rows of one piece of the range space of a
+// CSR or COO matrix from the first three regions of a task, ordered by the
+// point iteration order of the rows and, within each row, by their order in
+// the kernel space. For CSR sources, regions are row pointers (range piece),
+// column indices, and entries (kernel piece), and range_space is unused; for
+// COO sources, they are row indices, column indices, and entries (kernel
+// piece, i.e., the nonzeros of the rows in range_space).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+PieceRows<ENTRY_T, DIM, COORD_T> collect_piece_rows(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    SparseFormat source_format,
+    Legion::IndexSpace range_space
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+    using KernelIterator = Legion::PointInDomainIterator<1, COORD_T>;
+    using KernelRectIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    const auto &source_req = task->regions[0];
+    const auto &col_req = task->regions[1];
+    const auto &entry_req = task->regions[2];
+
+    assert(source_req.privilege_fields.size() == 1);
+    const Legion::FieldID source_fid = *source_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    AffineReader<Index, 1, COORD_T> col_reader{regions[1], col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{regions[2], entry_fid};
+
+    PieceRows<ENTRY_T, DIM, COORD_T> result;
+    result.offsets.push_back(0);
+
+    if (source_format == SparseFormat::CSR) {
+        AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{
+            regions[0], source_fid};
+        const Legion::Domain range_domain = rt->get_index_space_domain(
+            ctx, source_req.region.get_index_space()
+        );
+        for (PointIterator row(range_domain); row(); ++row) {
+            result.rows.push_back(*row);
+            for (KernelRectIterator k(rowptr_reader[*row]); k(); ++k) {
+                result.columns.push_back(col_reader[*k]);
+                result.entries.push_back(entry_reader[*k]);
+                result.kernel_points.push_back(*k);
+            }
+            result.offsets.push_back(result.columns.size());
+        }
+        return result;
+    }
+
+    // COO nonzeros may appear in any order, so bucket them by row. The rows
+    // of a dense range piece are located by their offset in its bounds, in
+    // the point iteration order (first dimension fastest); those of sparse
+    // pieces through a map.
+    AffineReader<Index, 1, COORD_T> row_reader{regions[0], source_fid};
+    const Legion::Domain range_domain =
+        rt->get_index_space_domain(ctx, range_space);
+    const Legion::Domain kernel_domain =
+        rt->get_index_space_domain(ctx, source_req.region.get_index_space());
+    const bool dense_range = range_domain.dense();
+    const Legion::Rect<DIM, COORD_T> range_bounds =
+        range_domain.bounds<DIM, COORD_T>();
+    std::map<Legion::DomainPoint, std::size_t> position;
+    for (PointIterator row(range_domain); row(); ++row) {
+        if (!dense_range) {
+            position[Legion::DomainPoint{*row}] = result.rows.size();
+        }
+        result.rows.push_back(*row);
+    }
+    const auto row_position = [&](const Index &row) {
+        if (!dense_range) { return position.at(Legion::DomainPoint{row}); }
+        std::size_t offset = 0;
+        std::size_t stride = 1;
+        for (int d = 0; d < DIM; ++d) {
+            assert(range_bounds.lo[d] <= row[d]);
+            assert(row[d] <= range_bounds.hi[d]);
+            offset += static_cast<std::size_t>(row[d] - range_bounds.lo[d]) *
+                      stride;
+            stride *= static_cast<std::size_t>(
+                range_bounds.hi[d] - range_bounds.lo[d] + 1
+            );
+        }
+        return offset;
+    };
+    std::vector<std::size_t> row_of_entry;
+    result.offsets.assign(result.rows.size() + 1, 0);
+    for (KernelIterator k(kernel_domain); k(); ++k) {
+        const std::size_t i = row_position(row_reader[*k]);
+        row_of_entry.push_back(i);
+        ++result.offsets[i + 1];
+    }
+    for (std::size_t i = 0; i < result.rows.size(); ++i) {
+        result.offsets[i + 1] += result.offsets[i];
+    }
+    result.columns.resize(row_of_entry.size());
+    result.entries.resize(row_of_entry.size());
+    result.kernel_points.resize(row_of_entry.size());
+    std::vector<std::size_t> next{
+        result.offsets.begin(), result.offsets.end() - 1};
+    std::size_t j = 0;
+    for (KernelIterator k(kernel_domain); k(); ++k, ++j) {
+        const std::size_t slot = next[row_of_entry[j]]++;
+        result.columns[slot] = col_reader[*k];
+        result.entries[slot] = entry_reader[*k];
+        result.kernel_points[slot] = *k;
+    }
+    return result;
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_PIECE_ROWS_HPP_INCLUDED
@@ -0,0 +1,239 @@
+#include "PipelinedCGSolver.hpp"
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*
+#include "Scalar.hpp"         // for Scalar
+
+using LegionSolvers::PipelinedCGSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+PipelinedCGSolver<ENTRY_T, DIM, COORD_T>::PipelinedCGSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const AbstractLinearOperator<ENTRY_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    Legion::IndexPartition partition,
+    const AbstractLinearOperator<ENTRY_T> *preconditioner,
+    std::size_t check_interval,
+    std::size_t replacement_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), preconditioner(preconditioner),
+      check_interval(check_interval),
+      replacement_interval(replacement_interval),
+      rhs(ctx, rt, rhs_region, rhs_fid, partition),
+      solution(ctx, rt, solution_region, solution_fid, partition),
+      r(ctx, rt, partition), w(ctx, rt, partition), n(ctx, rt, partition),
+      p(ctx, rt, partition), s(ctx, rt, partition), z(ctx, rt, partition),
+      u(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                       : nullptr),
+      m(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                       : nullptr),
+      q(preconditioner ? std::make_unique<Vector>(ctx, rt, partition)
+                       : nullptr),
+      residual_norm(static_cast<ENTRY_T>(0)) {
+    assert(check_interval > 0);
+    assert(rhs_region.get_index_space() == solution_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void PipelinedCGSolver<ENTRY_T, DIM, COORD_T>::apply(
+    const AbstractLinearOperator<ENTRY_T> &op,
+    Vector &output,
+    const Vector &input
+) {
+    op.matvec(
+        output.get_logical_region(),
+        output.get_fid(),
+        input.get_logical_region(),
+        input.get_fid()
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void PipelinedCGSolver<ENTRY_T, DIM, COORD_T>::replace_residual(
+    bool initial
+) {
+    // r = b - A * x, using n as scratch space; n is overwritten by the next
+    // iteration before it is read.
+    apply(matrix, n, solution);
+    r.copy(rhs);
+    r.axpy(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-1)}, n);
+    if (preconditioner) { apply(*preconditioner, *u, r); }
+    apply(matrix, w, get_u());
+    if (initial) { return; }
+    apply(matrix, s, p);
+    if (preconditioner) { apply(*preconditioner, *q, s); }
+    apply(matrix, z, get_q());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future PipelinedCGSolver<ENTRY_T, DIM, COORD_T>::dot_products(
+    Operations &operations
+) {
+    operations.dot(r, get_u());
+    operations.dot(w, get_u());
+    if (preconditioner) { operations.dot(r, r); }
+    return operations.execute();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t PipelinedCGSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    replace_residual(true);
+    // With beta = 0, the first iteration sets p = u, s = w, q = m, and z = n
+    // whatever their contents, as long as they are finite.
+    for (Vector *v : {&p, &s, &z, q.get()}) {
+        if (v) { v->constant_fill(static_cast<ENTRY_T>(0)); }
+    }
+
+    Operations initial{ctx, rt};
+    Legion::Future packed = dot_products(initial);
+    const Scalar<ENTRY_T> rhs_norm_squared = rhs.dot(rhs);
+    const Scalar<ENTRY_T> zero{ctx, rt, static_cast<ENTRY_T>(0)};
+    Scalar<ENTRY_T> gamma_old = zero;
+    Scalar<ENTRY_T> alpha_old = zero;
+
+    std::size_t iteration = 0;
+    while (true) {
+        const Scalar<ENTRY_T> gamma =
+            Scalar<ENTRY_T>::packed(ctx, rt, packed, 0);
+        const Scalar<ENTRY_T> delta =
+            Scalar<ENTRY_T>::packed(ctx, rt, packed, 1);
+
+        const bool last = (iteration == max_iterations);
+        if (last || (iteration % check_interval == 0)) {
+            const Scalar<ENTRY_T> rr =
+                preconditioner ? Scalar<ENTRY_T>::packed(ctx, rt, packed, 2)
+                               : gamma;
+            const ENTRY_T rr_value = rr.get_value();
+            const ENTRY_T threshold =
+                tolerance * tolerance * rhs_norm_squared.get_value();
+            residual_norm = std::sqrt(rr_value);
+            if (last || (rr_value <= threshold)) { return iteration; }
+        }
+
+        // m = M * w; n = A * m, overlapping the reduction of gamma and delta.
+        if (preconditioner) { apply(*preconditioner, *m, w); }
+        apply(matrix, n, get_m());
+
+        // As in CGSolver, the residual may already be exactly zero, making
+        // every denominator zero until the next check.
+        const Scalar<ENTRY_T> beta =
+            (iteration == 0) ? zero : gamma.divide_if_positive(gamma_old);
+        const Scalar<ENTRY_T> alpha =
+            (iteration == 0)
+                ? gamma.divide_if_positive(delta)
+                : gamma.divide_if_positive(
+                      delta - beta * gamma.divide_if_positive(alpha_old)
+                  );
+
+        Operations operations{ctx, rt};
+        operations.xpay(z, beta, n);
+        if (preconditioner) { operations.xpay(*q, beta, *m); }
+        operations.xpay(s, beta, w);
+        operations.xpay(p, beta, get_u());
+        operations.axpy(solution, alpha, p);
+        operations.axpy(r, -alpha, s);
+        if (preconditioner) { operations.axpy(*u, -alpha, *q); }
+        operations.axpy(w, -alpha, z);
+        ++iteration;
+
+        if ((replacement_interval > 0) &&
+            (iteration % replacement_interval == 0)) {
+            operations.execute();
+            replace_residual(false);
+            Operations replaced{ctx, rt};
+            packed = dot_products(replaced);
+        } else {
+            packed = dot_products(operations);
+        }
+        gamma_old = gamma;
+        alpha_old = alpha;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::PipelinedCGSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::PipelinedCGSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::PipelinedCGSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
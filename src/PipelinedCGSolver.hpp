@@ -0,0 +1,110 @@
+#ifndef LEGION_SOLVERS_PIPELINED_CG_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_PIPELINED_CG_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "DistributedVector.hpp"      // for DistributedVector
+#include "FusedVectorOperations.hpp"  // for FusedVectorOperations
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a symmetric positive definite linear operator A by
+// the pipelined (optionally preconditioned) conjugate gradient method of
+// Ghysels and Vanroose. Arguments are as in CGSolver.
+//
+// The recurrences are rearranged so that each iteration needs a single
+// reduction: all vector updates and the dot products (r, u), (w, u), and,
+// with a preconditioner, (r, r) are issued as one fused index launch (see
+// FusedVectorOperations). The preconditioner apply m = M * w and the
+// operator apply n = A * m that follow depend only on regions written by
+// that launch, not on its reduction, so Legion runs them while the dot
+// products are still being combined across pieces. Only the coefficients
+// of the next fused launch wait for the reduction.
+//
+// The extra recurrences make pipelined CG lose accuracy faster than CG. To
+// counter this, every replacement_interval iterations (never if zero) the
+// recursively updated vectors r, u, w, s, q, and z are recomputed from x and
+// the search direction p, at the cost of three operator and two
+// preconditioner applies.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class PipelinedCGSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using Operations = FusedVectorOperations<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const AbstractLinearOperator<ENTRY_T> &matrix;
+    const AbstractLinearOperator<ENTRY_T> *const preconditioner;
+    const std::size_t check_interval;
+    const std::size_t replacement_interval;
+    const Vector rhs;
+    Vector solution;
+    Vector r, w, n, p, s, z; // r = b - A * x, w = A * u, n = A * m
+    const std::unique_ptr<Vector> u, m, q; // only with preconditioner
+    ENTRY_T residual_norm;
+
+    // With a preconditioner, u = M * r, m = M * w, and q = M * s; without
+    // one, these are r, w, and s themselves.
+    Vector &get_u() { return preconditioner ? *u : r; }
+    Vector &get_m() { return preconditioner ? *m : w; }
+    Vector &get_q() { return preconditioner ? *q : s; }
+
+    void apply(
+        const AbstractLinearOperator<ENTRY_T> &op,
+        Vector &output,
+        const Vector &input
+    );
+
+    // Recomputes r, u, and w from x, and, unless initial, s, q, and z from p.
+    void replace_residual(bool initial);
+
+    // Adds the dot products (r, u), (w, u), and (r, r) to operations, in
+    // that order (the last is omitted without a preconditioner, since it
+    // equals the first), and executes them.
+    Legion::Future dot_products(Operations &operations);
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 10;
+
+    static constexpr std::size_t DEFAULT_REPLACEMENT_INTERVAL = 50;
+
+    explicit PipelinedCGSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const AbstractLinearOperator<ENTRY_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        Legion::IndexPartition partition,
+        const AbstractLinearOperator<ENTRY_T> *preconditioner = nullptr,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL,
+        std::size_t replacement_interval = DEFAULT_REPLACEMENT_INTERVAL
+    );
+
+    PipelinedCGSolver(const PipelinedCGSolver &) = delete;
+
+    PipelinedCGSolver &operator=(const PipelinedCGSolver &) = delete;
+
+    // Iterates until the residual norm is at most tolerance times the norm
+    // of b, as observed at a convergence check, or until max_iterations
+    // iterations have been performed. Returns the number of iterations.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norm of the residual b - A * x at the last convergence check, as
+    // updated by the pipelined CG recurrences.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class PipelinedCGSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_PIPELINED_CG_SOLVER_HPP_INCLUDED
@@ -0,0 +1,559 @@
+#include "SELLMatrix.hpp"
+
+#include <cassert>  // for assert
+#include <cstdint>  // for std::uint32_t
+#include <iostream> // for std::cout, std::endl
+#include <map>      // for std::map
+
+#include "COOMatrixTasks.hpp"  // for COOMatvecTask
+#include "LegionUtilities.hpp" // for create_field_space
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_USE_*, ...
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+
+using LegionSolvers::COOMatvecTask;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::SELLChunk;
+using LegionSolvers::SELLConversionArgs;
+using LegionSolvers::SELLFillTask;
+using LegionSolvers::SELLMatrix;
+using LegionSolvers::SELLMatvecTask;
+using LegionSolvers::SELLPieceSize;
+using LegionSolvers::SELLSizeTask;
+using LegionSolvers::SparseFormat;
+using LegionSolvers::sell_extent;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+SELLMatrix<ENTRY_T, DIM, COORD_T>::SELLMatrix(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &source,
+    std::size_t chunk_height,
+    std::size_t sort_window,
+    bool verbose
+)
+    : ctx(ctx), rt(rt), chunk_height(chunk_height), sort_window(sort_window),
+      domain_space(source.get_domain_space()),
+      range_space(source.get_range_space()),
+      range_partition(source.get_range_partition()),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, range_partition)
+      ) {
+    const Legion::LogicalRegion rowptr_region = source.get_rowptr_region();
+    const Legion::LogicalRegion source_region = source.get_kernel_region();
+    const Legion::LogicalPartition source_partition =
+        rt->get_logical_partition(
+            ctx, source_region, source.get_kernel_partition()
+        );
+    std::vector<Legion::RegionRequirement> requirements{
+        Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region},
+        Legion::RegionRequirement{
+            source_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            source_region},
+        Legion::RegionRequirement{
+            source_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            source_region}};
+    requirements[0].add_field(source.get_fid_rowptr());
+    requirements[1].add_field(source.get_fid_col());
+    requirements[2].add_field(source.get_fid_entry());
+    convert(SparseFormat::CSR, requirements, verbose);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+SELLMatrix<ENTRY_T, DIM, COORD_T>::SELLMatrix(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const COOMatrix<ENTRY_T, DIM, COORD_T> &source,
+    Legion::IndexPartition range_partition,
+    std::size_t chunk_height,
+    std::size_t sort_window,
+    bool verbose
+)
+    : ctx(ctx), rt(rt), chunk_height(chunk_height), sort_window(sort_window),
+      domain_space(source.get_domain_space()),
+      range_space(source.get_range_space()),
+      range_partition(range_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, range_partition)
+      ) {
+    assert(rt->get_parent_index_space(ctx, range_partition) == range_space);
+    assert(rt->is_index_partition_disjoint(ctx, range_partition));
+    const Legion::IndexPartition source_kernel_partition =
+        source.kernel_partition_from_range_partition(range_partition);
+    const Legion::LogicalRegion source_region = source.get_kernel_region();
+    const Legion::LogicalPartition source_partition =
+        rt->get_logical_partition(ctx, source_region, source_kernel_partition);
+    std::vector<Legion::RegionRequirement> requirements{
+        Legion::RegionRequirement{
+            source_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            source_region},
+        Legion::RegionRequirement{
+            source_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            source_region},
+        Legion::RegionRequirement{
+            source_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            source_region}};
+    requirements[0].add_field(source.get_fid_row());
+    requirements[1].add_field(source.get_fid_col());
+    requirements[2].add_field(source.get_fid_entry());
+    convert(SparseFormat::COO, requirements, verbose);
+    rt->destroy_index_partition(ctx, source_kernel_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SELLMatrix<ENTRY_T, DIM, COORD_T>::convert(
+    SparseFormat source_format,
+    const std::vector<Legion::RegionRequirement> &source_requirements,
+    bool verbose
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+
+    assert((chunk_height > 0) &&
+           (chunk_height <= LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT));
+    assert(sort_window > 0);
+    assert(source_requirements.size() == 3);
+
+    SELLConversionArgs args;
+    args.source_format = source_format;
+    args.chunk_height = static_cast<std::uint32_t>(chunk_height);
+    args.sort_window = static_cast<std::uint32_t>(sort_window);
+    args.range_partition = range_partition;
+
+    Legion::IndexLauncher size_launcher{
+        SELLSizeTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(SELLConversionArgs)},
+        Legion::ArgumentMap{}};
+    size_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : source_requirements) {
+        size_launcher.add_region_requirement(requirement);
+    }
+    const Legion::FutureMap sizes = rt->execute_index_space(ctx, size_launcher);
+
+    // Each piece gets one contiguous run of lanes, chunks, and slots.
+    std::map<Legion::DomainPoint, Legion::Domain> lane_pieces;
+    std::map<Legion::DomainPoint, Legion::Domain> chunk_pieces;
+    std::map<Legion::DomainPoint, Legion::Domain> slot_pieces;
+    COORD_T num_lanes = 0;
+    COORD_T num_chunks = 0;
+    num_entries = 0;
+    num_slots = 0;
+    const Legion::Domain colors = rt->get_index_space_domain(ctx, color_space);
+    for (Legion::Domain::DomainPointIterator it(colors); it; ++it) {
+        const SELLPieceSize size = sizes.get_result<SELLPieceSize>(*it);
+        lane_pieces[*it] = sell_extent(num_lanes, size.num_rows);
+        chunk_pieces[*it] = sell_extent(num_chunks, size.num_chunks);
+        slot_pieces[*it] =
+            sell_extent(static_cast<COORD_T>(num_slots), size.num_slots);
+        num_lanes = static_cast<COORD_T>(num_lanes + size.num_rows);
+        num_chunks = static_cast<COORD_T>(num_chunks + size.num_chunks);
+        num_entries += size.num_entries;
+        num_slots += size.num_slots;
+    }
+
+    const Legion::IndexSpace lane_space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, num_lanes)
+    );
+    const Legion::IndexSpace chunk_space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, num_chunks)
+    );
+    const Legion::IndexSpace kernel_space = rt->create_index_space(
+        ctx, sell_extent(COORD_T{0}, num_slots)
+    );
+    lane_partition = rt->create_partition_by_domain(
+        ctx,
+        lane_space,
+        lane_pieces,
+        color_space,
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND
+    );
+    chunk_partition = rt->create_partition_by_domain(
+        ctx,
+        chunk_space,
+        chunk_pieces,
+        color_space,
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND
+    );
+    kernel_partition = rt->create_partition_by_domain(
+        ctx,
+        kernel_space,
+        slot_pieces,
+        color_space,
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND
+    );
+
+    const Legion::FieldSpace lane_field_space = create_field_space(
+        ctx, rt, {sizeof(Index)}, {LANE_ROW_FID}
+    );
+    const Legion::FieldSpace chunk_field_space = create_field_space(
+        ctx, rt, {sizeof(SELLChunk<COORD_T>)}, {CHUNK_FID}
+    );
+    const Legion::FieldSpace kernel_field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(Index), sizeof(Index), sizeof(ENTRY_T)},
+        {SLOT_ROW_FID, SLOT_COL_FID, SLOT_ENTRY_FID}
+    );
+    lane_region = rt->create_logical_region(ctx, lane_space, lane_field_space);
+    chunk_region =
+        rt->create_logical_region(ctx, chunk_space, chunk_field_space);
+    kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+
+    Legion::IndexLauncher fill_launcher{
+        SELLFillTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(SELLConversionArgs)},
+        Legion::ArgumentMap{}};
+    fill_launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    for (const auto &requirement : source_requirements) {
+        fill_launcher.add_region_requirement(requirement);
+    }
+    fill_launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, lane_region, lane_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            lane_region})
+        .add_field(LANE_ROW_FID);
+    fill_launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, chunk_region, chunk_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            chunk_region})
+        .add_field(CHUNK_FID);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (Legion::FieldID fid : {SLOT_ROW_FID, SLOT_COL_FID, SLOT_ENTRY_FID}) {
+        fill_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, fill_launcher);
+
+    domain_partition =
+        domain_partition_from_kernel_partition(domain_space, kernel_partition);
+
+    if (verbose) {
+        const double padding =
+            (num_entries > 0)
+                ? 100.0 * static_cast<double>(num_slots - num_entries) /
+                      static_cast<double>(num_entries)
+                : 0.0;
+        std::cout << "[LegionSolvers] SELL-C-sigma conversion (C = "
+                  << chunk_height << ", sigma = " << sort_window << "): "
+                  << num_entries << " nonzeros in " << num_slots
+                  << " slots (" << padding << "% padding)." << std::endl;
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+SELLMatrix<ENTRY_T, DIM, COORD_T>::~SELLMatrix() {
+    rt->destroy_index_partition(ctx, domain_partition);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_logical_region(ctx, chunk_region);
+    rt->destroy_logical_region(ctx, lane_region);
+    rt->destroy_field_space(ctx, kernel_region.get_field_space());
+    rt->destroy_field_space(ctx, chunk_region.get_field_space());
+    rt->destroy_field_space(ctx, lane_region.get_field_space());
+    rt->destroy_index_space(ctx, kernel_region.get_index_space());
+    rt->destroy_index_space(ctx, chunk_region.get_index_space());
+    rt->destroy_index_space(ctx, lane_region.get_index_space());
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+SELLMatrix<ENTRY_T, DIM, COORD_T>::kernel_partition_from_domain_partition(
+    Legion::IndexPartition domain_partition
+) const {
+    return rt->create_partition_by_preimage(
+        ctx,
+        domain_partition,
+        kernel_region,
+        kernel_region,
+        SLOT_COL_FID,
+        rt->get_index_partition_color_space_name(ctx, domain_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+SELLMatrix<ENTRY_T, DIM, COORD_T>::kernel_partition_from_range_partition(
+    Legion::IndexPartition range_partition
+) const {
+    return rt->create_partition_by_preimage(
+        ctx,
+        range_partition,
+        kernel_region,
+        kernel_region,
+        SLOT_ROW_FID,
+        rt->get_index_partition_color_space_name(ctx, range_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+SELLMatrix<ENTRY_T, DIM, COORD_T>::domain_partition_from_kernel_partition(
+    Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+) const {
+    return rt->create_partition_by_image(
+        ctx,
+        domain_space,
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+        kernel_region,
+        SLOT_COL_FID,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+SELLMatrix<ENTRY_T, DIM, COORD_T>::range_partition_from_kernel_partition(
+    Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+) const {
+    return rt->create_partition_by_image(
+        ctx,
+        range_space,
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition),
+        kernel_region,
+        SLOT_ROW_FID,
+        rt->get_index_partition_color_space_name(ctx, kernel_partition)
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SELLMatrix<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == range_space);
+    assert(input_region.get_index_space() == domain_space);
+    const std::uint32_t C = static_cast<std::uint32_t>(chunk_height);
+    Legion::IndexLauncher launcher{
+        SELLMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&C, sizeof(std::uint32_t)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, chunk_region, chunk_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            chunk_region})
+        .add_field(CHUNK_FID);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, lane_region, lane_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            lane_region})
+        .add_field(LANE_ROW_FID);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(SLOT_COL_FID);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            kernel_logical_partition,
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            kernel_region})
+        .add_field(SLOT_ENTRY_FID);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, domain_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SELLMatrix<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == domain_space);
+    assert(input_region.get_index_space() == range_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    Legion::IndexLauncher launcher{
+        COOMatvecTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, domain_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid :
+         {SLOT_COL_FID, SLOT_ROW_FID, SLOT_ENTRY_FID}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SELLMatrix<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SELLMatrix<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SELLMatrix<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
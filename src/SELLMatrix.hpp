@@ -0,0 +1,178 @@
+#ifndef LEGION_SOLVERS_SELL_MATRIX_HPP_INCLUDED
+#define LEGION_SOLVERS_SELL_MATRIX_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractMatrix.hpp"  // for AbstractMatrix
+#include "COOMatrix.hpp"       // for COOMatrix
+#include "CSRMatrix.hpp"       // for CSRMatrix
+#include "SELLMatrixTasks.hpp" // for SparseFormat
+
+namespace LegionSolvers {
+
+
+// A sparse matrix in SELL-C-sigma (sliced ELLPACK) format, converted from a
+// CSRMatrix or COOMatrix into regions owned by this object.
+//
+// The rows of each piece of a range partition are ordered by decreasing
+// number of nonzeros within windows of sigma consecutive rows, and then cut
+// into chunks of C rows. The nonzeros of a chunk are stored column by column
+// and padded to the length of its longest row, so that C consecutive slots
+// hold one nonzero of each of its rows and products process C rows at a
+// time in SIMD registers. Sorting keeps rows of similar lengths together,
+// which bounds the padding; the number of slots per nonzero is available
+// after conversion (and printed if verbose).
+//
+// Slots form a 1D kernel region with the row index, column index, and entry
+// of each slot, as in COOMatrix; chunks and the lane-to-row map are stored in
+// auxiliary regions. Chunks never span pieces of the range partition.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class SELLMatrix : public AbstractMatrix<ENTRY_T> {
+
+    static constexpr Legion::FieldID LANE_ROW_FID = 0;
+    static constexpr Legion::FieldID CHUNK_FID = 0;
+    static constexpr Legion::FieldID SLOT_ROW_FID = 0;
+    static constexpr Legion::FieldID SLOT_COL_FID = 1;
+    static constexpr Legion::FieldID SLOT_ENTRY_FID = 2;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const std::size_t chunk_height;
+    const std::size_t sort_window;
+    const Legion::IndexSpace domain_space;
+    const Legion::IndexSpace range_space;
+    const Legion::IndexPartition range_partition;
+    const Legion::IndexSpace color_space;
+    Legion::LogicalRegion lane_region;
+    Legion::LogicalRegion chunk_region;
+    Legion::LogicalRegion kernel_region;
+    Legion::IndexPartition lane_partition;
+    Legion::IndexPartition chunk_partition;
+    Legion::IndexPartition kernel_partition;
+    Legion::IndexPartition domain_partition;
+    std::size_t num_entries;
+    std::size_t num_slots;
+
+    // Sizes, allocates, and fills the regions of this matrix. The source
+    // requirements are the first three region requirements of SELLSizeTask
+    // and SELLFillTask.
+    void convert(
+        SparseFormat source_format,
+        const std::vector<Legion::RegionRequirement> &source_requirements,
+        bool verbose
+    );
+
+  public:
+
+    // Converts a CSR matrix, using its range and kernel partitions.
+    explicit SELLMatrix(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const CSRMatrix<ENTRY_T, DIM, COORD_T> &source,
+        std::size_t chunk_height,
+        std::size_t sort_window,
+        bool verbose = true
+    );
+
+    // Converts a COO matrix, assigning the rows of each piece of
+    // range_partition (which must be disjoint) to one piece of the result.
+    explicit SELLMatrix(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const COOMatrix<ENTRY_T, DIM, COORD_T> &source,
+        Legion::IndexPartition range_partition,
+        std::size_t chunk_height,
+        std::size_t sort_window,
+        bool verbose = true
+    );
+
+    SELLMatrix(const SELLMatrix &) = delete;
+
+    SELLMatrix &operator=(const SELLMatrix &) = delete;
+
+    virtual ~SELLMatrix();
+
+    std::size_t get_chunk_height() const { return chunk_height; }
+
+    std::size_t get_sort_window() const { return sort_window; }
+
+    std::size_t get_num_entries() const { return num_entries; }
+
+    std::size_t get_num_slots() const { return num_slots; }
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_range_space() const { return range_space; }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::IndexPartition get_domain_partition() const {
+        return domain_partition;
+    }
+
+    virtual Legion::IndexSpace get_kernel_space() const override {
+        return kernel_region.get_index_space();
+    }
+
+    virtual Legion::LogicalRegion get_kernel_region() const override {
+        return kernel_region;
+    }
+
+    virtual std::vector<Legion::LogicalRegion>
+    get_auxiliary_regions() const override {
+        return {lane_region, chunk_region};
+    }
+
+    // Slots whose column lies in each piece (preimage of the columns).
+    virtual Legion::IndexPartition kernel_partition_from_domain_partition(
+        Legion::IndexPartition domain_partition
+    ) const override;
+
+    // Slots whose row lies in each piece (preimage of the rows).
+    virtual Legion::IndexPartition
+    kernel_partition_from_range_partition(Legion::IndexPartition range_partition
+    ) const override;
+
+    // Columns of the slots in each piece (image of the columns).
+    virtual Legion::IndexPartition domain_partition_from_kernel_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Rows of the slots in each piece (image of the rows).
+    virtual Legion::IndexPartition range_partition_from_kernel_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition kernel_partition
+    ) const override;
+
+    // Launches one SELLMatvecTask per piece of the range partition.
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // Launches one COOMatvecTask per piece of the range partition on the
+    // slots, with the row and column indices exchanged, reducing into the
+    // zeroed output; padding slots contribute zero.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class SELLMatrix
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SELL_MATRIX_HPP_INCLUDED
@@ -0,0 +1,467 @@
+#include "SELLMatrixTasks.hpp"
+
+#include <algorithm> // for std::min, std::stable_sort
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint32_t
+#include <numeric>   // for std::iota
+#include <vector>    // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineWriter, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT
+#include "PieceRows.hpp"       // for PieceRows, collect_piece_rows
+#include "SparseKernels.hpp"   // for sell_chunk_matvec
+#include "VectorKernels.hpp"   // for is_dense_rect, for_each_thread_range
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::PieceRows;
+using LegionSolvers::SELLChunk;
+using LegionSolvers::SELLConversionArgs;
+using LegionSolvers::SELLFillTask;
+using LegionSolvers::SELLMatvecTask;
+using LegionSolvers::SELLPieceSize;
+using LegionSolvers::SELLSizeTask;
+using LegionSolvers::SparseFormat;
+using LegionSolvers::collect_piece_rows;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_dense_rect;
+using LegionSolvers::is_omp_processor;
+using LegionSolvers::sell_chunk_matvec;
+using LegionSolvers::sell_extent;
+
+
+// The rows of the piece of a SELL conversion task, for COO sources (see
+// collect_piece_rows).
+inline Legion::IndexSpace sell_piece_range_space(
+    const Legion::Task *task,
+    const SELLConversionArgs &args,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    if (args.source_format == SparseFormat::COO) {
+        return rt->get_index_subspace(
+            ctx, args.range_partition, task->index_point
+        );
+    } else {
+        return Legion::IndexSpace::NO_SPACE;
+    }
+}
+
+
+// Order in which the rows of a piece are assigned to lanes: within each
+// window of sort_window rows, by decreasing length.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::vector<std::size_t> sell_row_order(
+    const PieceRows<ENTRY_T, DIM, COORD_T> &piece, std::size_t sort_window
+) {
+    const std::size_t n = piece.rows.size();
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    for (std::size_t w = 0; w < n; w += sort_window) {
+        std::stable_sort(
+            order.begin() + w,
+            order.begin() + std::min(n, w + sort_window),
+            [&](std::size_t a, std::size_t b) {
+                return piece.length(a) > piece.length(b);
+            }
+        );
+    }
+    return order;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t sell_chunk_width(
+    const PieceRows<ENTRY_T, DIM, COORD_T> &piece,
+    const std::vector<std::size_t> &order,
+    std::size_t first,
+    std::size_t count
+) {
+    std::size_t width = 0;
+    for (std::size_t l = 0; l < count; ++l) {
+        width = std::max(width, piece.length(order[first + l]));
+    }
+    return width;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+SELLPieceSize SELLSizeTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 3);
+    assert(task->regions.size() == 3);
+
+    assert(task->arglen == sizeof(SELLConversionArgs));
+    const SELLConversionArgs &args =
+        *static_cast<const SELLConversionArgs *>(task->args);
+    const std::size_t C = args.chunk_height;
+    const Legion::IndexSpace piece_range_space =
+        sell_piece_range_space(task, args, ctx, rt);
+
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_piece_rows<ENTRY_T, DIM, COORD_T>(
+            task, regions, ctx, rt, args.source_format, piece_range_space
+        );
+    const std::vector<std::size_t> order =
+        sell_row_order(piece, args.sort_window);
+
+    const std::size_t n = piece.rows.size();
+    SELLPieceSize result;
+    result.num_rows = n;
+    result.num_chunks = (n + C - 1) / C;
+    result.num_slots = 0;
+    result.num_entries = piece.entries.size();
+    for (std::size_t first = 0; first < n; first += C) {
+        const std::size_t count = std::min(C, n - first);
+        result.num_slots += C * sell_chunk_width(piece, order, first, count);
+    }
+    return result;
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SELLFillTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using Point1 = Legion::Point<1, COORD_T>;
+
+    assert(regions.size() == 8);
+    assert(task->regions.size() == 8);
+    const auto &lane_req = task->regions[3];
+    const auto &chunk_req = task->regions[4];
+    const auto &slot_row_req = task->regions[5];
+    const auto &slot_col_req = task->regions[6];
+    const auto &slot_entry_req = task->regions[7];
+
+    assert(lane_req.privilege_fields.size() == 1);
+    const Legion::FieldID lane_fid = *lane_req.privilege_fields.begin();
+
+    assert(chunk_req.privilege_fields.size() == 1);
+    const Legion::FieldID chunk_fid = *chunk_req.privilege_fields.begin();
+
+    assert(slot_row_req.privilege_fields.size() == 1);
+    const Legion::FieldID slot_row_fid = *slot_row_req.privilege_fields.begin();
+
+    assert(slot_col_req.privilege_fields.size() == 1);
+    const Legion::FieldID slot_col_fid = *slot_col_req.privilege_fields.begin();
+
+    assert(slot_entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID slot_entry_fid =
+        *slot_entry_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(SELLConversionArgs));
+    const SELLConversionArgs &args =
+        *static_cast<const SELLConversionArgs *>(task->args);
+    const std::size_t C = args.chunk_height;
+    const Legion::IndexSpace piece_range_space =
+        sell_piece_range_space(task, args, ctx, rt);
+
+    const PieceRows<ENTRY_T, DIM, COORD_T> piece =
+        collect_piece_rows<ENTRY_T, DIM, COORD_T>(
+            task, regions, ctx, rt, args.source_format, piece_range_space
+        );
+    const std::vector<std::size_t> order =
+        sell_row_order(piece, args.sort_window);
+
+    AffineWriter<Index, 1, COORD_T> lane_writer{regions[3], lane_fid};
+    AffineWriter<SELLChunk<COORD_T>, 1, COORD_T> chunk_writer{
+        regions[4], chunk_fid};
+    AffineWriter<Index, 1, COORD_T> slot_row_writer{regions[5], slot_row_fid};
+    AffineWriter<Index, 1, COORD_T> slot_col_writer{regions[6], slot_col_fid};
+    AffineWriter<ENTRY_T, 1, COORD_T> slot_entry_writer{
+        regions[7], slot_entry_fid};
+
+    const Legion::Rect<1, COORD_T> lane_rect =
+        rt->get_index_space_domain(ctx, lane_req.region.get_index_space());
+    const Legion::Rect<1, COORD_T> chunk_rect =
+        rt->get_index_space_domain(ctx, chunk_req.region.get_index_space());
+    const Legion::Rect<1, COORD_T> slot_rect = rt->get_index_space_domain(
+        ctx, slot_row_req.region.get_index_space()
+    );
+
+    const std::size_t n = piece.rows.size();
+    COORD_T slot = slot_rect.lo[0];
+    for (std::size_t q = 0, first = 0; first < n; ++q, first += C) {
+        const std::size_t count = std::min(C, n - first);
+        const std::size_t width = sell_chunk_width(piece, order, first, count);
+
+        // Padding repeats the first row of the chunk and the first column
+        // of its longest row.
+        const Index pad_row = piece.rows[order[first]];
+        Index pad_col = pad_row;
+        for (std::size_t l = 0; l < count; ++l) {
+            const std::size_t r = order[first + l];
+            if (piece.length(r) == width) {
+                if (width > 0) { pad_col = piece.columns[piece.offsets[r]]; }
+                break;
+            }
+        }
+
+        SELLChunk<COORD_T> chunk;
+        chunk.slots = sell_extent(slot, C * width);
+        chunk.lanes = sell_extent(
+            static_cast<COORD_T>(lane_rect.lo[0] + first), count
+        );
+        chunk_writer[Point1{static_cast<COORD_T>(chunk_rect.lo[0] + q)}] =
+            chunk;
+
+        for (std::size_t l = 0; l < count; ++l) {
+            lane_writer[Point1{static_cast<COORD_T>(
+                lane_rect.lo[0] + first + l
+            )}] = piece.rows[order[first + l]];
+        }
+
+        for (std::size_t j = 0; j < width; ++j) {
+            for (std::size_t l = 0; l < C; ++l) {
+                const Point1 s{static_cast<COORD_T>(slot + j * C + l)};
+                if ((l < count) && (j < piece.length(order[first + l]))) {
+                    const std::size_t r = order[first + l];
+                    const std::size_t k = piece.offsets[r] + j;
+                    slot_row_writer[s] = piece.rows[r];
+                    slot_col_writer[s] = piece.columns[k];
+                    slot_entry_writer[s] = piece.entries[k];
+                } else {
+                    slot_row_writer[s] =
+                        (l < count) ? piece.rows[order[first + l]] : pad_row;
+                    slot_col_writer[s] = pad_col;
+                    slot_entry_writer[s] = static_cast<ENTRY_T>(0);
+                }
+            }
+        }
+        slot = static_cast<COORD_T>(slot + C * width);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SELLMatvecTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 6);
+    const auto &output = regions[0];
+    const auto &chunk = regions[1];
+    const auto &lane = regions[2];
+    const auto &col = regions[3];
+    const auto &entry = regions[4];
+    const auto &input = regions[5];
+
+    assert(task->regions.size() == 6);
+    const auto &output_req = task->regions[0];
+    const auto &chunk_req = task->regions[1];
+    const auto &lane_req = task->regions[2];
+    const auto &col_req = task->regions[3];
+    const auto &entry_req = task->regions[4];
+    const auto &input_req = task->regions[5];
+
+    assert(output_req.privilege_fields.size() == 1);
+    const Legion::FieldID output_fid = *output_req.privilege_fields.begin();
+
+    assert(chunk_req.privilege_fields.size() == 1);
+    const Legion::FieldID chunk_fid = *chunk_req.privilege_fields.begin();
+
+    assert(lane_req.privilege_fields.size() == 1);
+    const Legion::FieldID lane_fid = *lane_req.privilege_fields.begin();
+
+    assert(col_req.privilege_fields.size() == 1);
+    const Legion::FieldID col_fid = *col_req.privilege_fields.begin();
+
+    assert(entry_req.privilege_fields.size() == 1);
+    const Legion::FieldID entry_fid = *entry_req.privilege_fields.begin();
+
+    assert(input_req.privilege_fields.size() == 1);
+    const Legion::FieldID input_fid = *input_req.privilege_fields.begin();
+
+    assert(task->arglen == sizeof(std::uint32_t));
+    const std::size_t C = *static_cast<const std::uint32_t *>(task->args);
+    assert((C > 0) && (C <= LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT));
+
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    using Index = Legion::Point<DIM, COORD_T>;
+    using Point1 = Legion::Point<1, COORD_T>;
+
+    AffineWriter<ENTRY_T, DIM, COORD_T> output_writer{output, output_fid};
+    AffineReader<SELLChunk<COORD_T>, 1, COORD_T> chunk_reader{
+        chunk, chunk_fid};
+    AffineReader<Index, 1, COORD_T> lane_reader{lane, lane_fid};
+    AffineReader<Index, 1, COORD_T> col_reader{col, col_fid};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{entry, entry_fid};
+    AffineReader<ENTRY_T, DIM, COORD_T> input_reader{input, input_fid};
+
+    const Legion::Domain chunk_domain =
+        rt->get_index_space_domain(ctx, chunk_req.region.get_index_space());
+    const Legion::Domain slot_domain =
+        rt->get_index_space_domain(ctx, col_req.region.get_index_space());
+    const Legion::Rect<1, COORD_T> slot_rect = slot_domain;
+    const bool dense_slots =
+        slot_domain.dense() &&
+        (slot_rect.empty() ||
+         is_dense_rect(slot_rect, col_reader, entry_reader));
+
+    const auto input_ptr = [&](const Index &j) { return input_reader.ptr(j); };
+
+    using ChunkRectIterator = Legion::RectInDomainIterator<1, COORD_T>;
+    using KernelIterator = Legion::PointInRectIterator<1, COORD_T>;
+
+    for (ChunkRectIterator it(chunk_domain); it(); ++it) {
+        const Legion::Rect<1, COORD_T> rect = *it;
+        if (rect.empty()) { continue; }
+        for_each_thread_range(
+            parallel,
+            rect.volume(),
+            [&](int, std::size_t begin, std::size_t end) {
+                ENTRY_T y[LEGION_SOLVERS_MAX_SELL_CHUNK_HEIGHT];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const SELLChunk<COORD_T> c = chunk_reader[Point1{
+                        static_cast<COORD_T>(rect.lo[0] + i)}];
+                    const std::size_t width = c.slots.volume() / C;
+                    if (dense_slots && (width > 0)) {
+                        sell_chunk_matvec(
+                            C,
+                            width,
+                            entry_reader.ptr(c.slots.lo),
+                            col_reader.ptr(c.slots.lo),
+                            input_ptr,
+                            y
+                        );
+                    } else {
+                        for (std::size_t l = 0; l < C; ++l) {
+                            y[l] = static_cast<ENTRY_T>(0);
+                        }
+                        std::size_t s = 0;
+                        for (KernelIterator k(c.slots); k(); ++k, ++s) {
+                            y[s % C] +=
+                                entry_reader[*k] * input_reader[col_reader[*k]];
+                        }
+                    }
+                    std::size_t l = 0;
+                    for (KernelIterator k(c.lanes); k(); ++k, ++l) {
+                        output_writer[lane_reader[*k]] = y[l];
+                    }
+                }
+            }
+        );
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template SELLPieceSize SELLSizeTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template SELLPieceSize SELLSizeTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template SELLPieceSize SELLSizeTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLFillTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void SELLMatvecTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,159 @@
+#ifndef LEGION_SOLVERS_SELL_MATRIX_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_SELL_MATRIX_TASKS_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PieceRows.hpp"       // for SparseFormat
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for SELL_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// One chunk of C rows of a SELL-C-sigma matrix: its slots (C * width points
+// of the kernel space, stored column by column) and its lanes (the points
+// of the lane space holding the row indices of its rows, at most C).
+template <typename COORD_T>
+struct SELLChunk {
+    Legion::Rect<1, COORD_T> slots;
+    Legion::Rect<1, COORD_T> lanes;
+}; // struct SELLChunk
+
+
+// The extent of size points starting at lo. Empty extents are written as
+// [lo + 1, lo], which is empty for unsigned coordinate types as well.
+template <typename COORD_T>
+Legion::Rect<1, COORD_T> sell_extent(COORD_T lo, std::size_t size) {
+    if (size == 0) {
+        return Legion::Rect<1, COORD_T>{static_cast<COORD_T>(lo + 1), lo};
+    } else {
+        return Legion::Rect<1, COORD_T>{
+            lo, static_cast<COORD_T>(lo + size - 1)};
+    }
+}
+
+
+// Task argument of SELLSizeTask and SELLFillTask. The range partition is
+// used only for COO sources, to find the rows of each piece.
+struct SELLConversionArgs {
+    SparseFormat source_format;
+    std::uint32_t chunk_height;
+    std::uint32_t sort_window;
+    Legion::IndexPartition range_partition;
+}; // struct SELLConversionArgs
+
+
+struct SELLPieceSize {
+    std::uint64_t num_rows;
+    std::uint64_t num_chunks;
+    std::uint64_t num_slots;
+    std::uint64_t num_entries;
+}; // struct SELLPieceSize
+
+
+// Computes the size of the SELL-C-sigma form of the rows of one piece of
+// the range space of a sparse matrix. For CSR sources, regions are row
+// pointers (range piece), column indices, and entries (kernel piece); for
+// COO sources, they are row indices, column indices, and entries (kernel
+// piece, i.e., the nonzeros of the rows in the range piece).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct SELLSizeTask
+    : public TaskTDI<
+          SELL_SIZE_TASK_BLOCK_ID,
+          SELLSizeTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "sell_size";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = SELLPieceSize;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct SELLSizeTask
+
+
+// Writes the SELL-C-sigma form of the rows of one piece of the range space,
+// sized by SELLSizeTask. The first three regions are as for SELLSizeTask;
+// they are followed by the lane row indices (lane piece), the chunks (chunk
+// piece), and the row indices, column indices, and entries of the slots
+// (kernel piece), all write-discard. Within each window of sort_window
+// consecutive rows, rows are ordered by decreasing length before being
+// grouped into chunks. Padding slots have entry zero and repeat a column
+// and row of their chunk, so that they stay within the dependent partitions
+// of the matrix.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct SELLFillTask
+    : public TaskTDI<
+          SELL_FILL_TASK_BLOCK_ID,
+          SELLFillTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "sell_fill";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct SELLFillTask
+
+
+// Computes output = A * input for the rows of a SELL-C-sigma matrix A in one
+// piece of its range space. Regions are output (write-discard, range piece),
+// chunks (read-only, chunk piece), lane row indices (read-only, lane piece),
+// slot column indices and entries (read-only, kernel piece, one requirement
+// each), and input (read-only, domain piece). The task argument is the
+// chunk height, as a std::uint32_t.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct SELLMatvecTask
+    : public TaskTDI<
+          SELL_MATVEC_TASK_BLOCK_ID,
+          SELLMatvecTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "sell_matvec";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct SELLMatvecTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SELL_MATRIX_TASKS_HPP_INCLUDED
@@ -0,0 +1,312 @@
+#ifndef LEGION_SOLVERS_SIMD_UTILITIES_HPP_INCLUDED
+#define LEGION_SOLVERS_SIMD_UTILITIES_HPP_INCLUDED
+
+#include <cmath> // for std::fma
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+    #include <immintrin.h> // for __m256*, __m512*, _mm*_*
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h> // for float32x4_t, float64x2_t, v*q_f*
+#endif
+
+namespace LegionSolvers {
+
+
+// SIMDPack<T> holds one hardware vector register worth of T values. The
+// primary template is a single-lane scalar fallback, so kernels written
+// against this interface compile for any entry type; the specializations
+// below are selected at compile time by the target instruction set.
+
+template <typename T>
+struct SIMDPack {
+
+    static constexpr int width = 1;
+
+    T value;
+
+    static SIMDPack zero() { return {static_cast<T>(0)}; }
+
+    static SIMDPack broadcast(T x) { return {x}; }
+
+    static SIMDPack load(const T *ptr) { return {*ptr}; }
+
+    void store(T *ptr) const { *ptr = value; }
+
+    T sum() const { return value; }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {a.value + b.value};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {a.value - b.value};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {a.value * b.value};
+    }
+
+    // Returns a * b + c with a single rounding.
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {std::fma(a.value, b.value, c.value)};
+    }
+
+}; // struct SIMDPack
+
+
+#if defined(__AVX512F__)
+
+    #define LEGION_SOLVERS_SIMD_ISA "AVX-512"
+
+template <>
+struct SIMDPack<float> {
+
+    static constexpr int width = 16;
+
+    __m512 value;
+
+    static SIMDPack zero() { return {_mm512_setzero_ps()}; }
+
+    static SIMDPack broadcast(float x) { return {_mm512_set1_ps(x)}; }
+
+    static SIMDPack load(const float *ptr) { return {_mm512_loadu_ps(ptr)}; }
+
+    void store(float *ptr) const { _mm512_storeu_ps(ptr, value); }
+
+    float sum() const { return _mm512_reduce_add_ps(value); }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {_mm512_add_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {_mm512_sub_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {_mm512_mul_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {_mm512_fmadd_ps(a.value, b.value, c.value)};
+    }
+
+}; // struct SIMDPack<float>
+
+template <>
+struct SIMDPack<double> {
+
+    static constexpr int width = 8;
+
+    __m512d value;
+
+    static SIMDPack zero() { return {_mm512_setzero_pd()}; }
+
+    static SIMDPack broadcast(double x) { return {_mm512_set1_pd(x)}; }
+
+    static SIMDPack load(const double *ptr) { return {_mm512_loadu_pd(ptr)}; }
+
+    void store(double *ptr) const { _mm512_storeu_pd(ptr, value); }
+
+    double sum() const { return _mm512_reduce_add_pd(value); }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {_mm512_add_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {_mm512_sub_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {_mm512_mul_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {_mm512_fmadd_pd(a.value, b.value, c.value)};
+    }
+
+}; // struct SIMDPack<double>
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+    #define LEGION_SOLVERS_SIMD_ISA "AVX2"
+
+template <>
+struct SIMDPack<float> {
+
+    static constexpr int width = 8;
+
+    __m256 value;
+
+    static SIMDPack zero() { return {_mm256_setzero_ps()}; }
+
+    static SIMDPack broadcast(float x) { return {_mm256_set1_ps(x)}; }
+
+    static SIMDPack load(const float *ptr) { return {_mm256_loadu_ps(ptr)}; }
+
+    void store(float *ptr) const { _mm256_storeu_ps(ptr, value); }
+
+    float sum() const {
+        __m128 lo = _mm_add_ps(
+            _mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)
+        );
+        lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+        lo = _mm_add_ss(lo, _mm_movehdup_ps(lo));
+        return _mm_cvtss_f32(lo);
+    }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {_mm256_add_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {_mm256_sub_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {_mm256_mul_ps(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {_mm256_fmadd_ps(a.value, b.value, c.value)};
+    }
+
+}; // struct SIMDPack<float>
+
+template <>
+struct SIMDPack<double> {
+
+    static constexpr int width = 4;
+
+    __m256d value;
+
+    static SIMDPack zero() { return {_mm256_setzero_pd()}; }
+
+    static SIMDPack broadcast(double x) { return {_mm256_set1_pd(x)}; }
+
+    static SIMDPack load(const double *ptr) { return {_mm256_loadu_pd(ptr)}; }
+
+    void store(double *ptr) const { _mm256_storeu_pd(ptr, value); }
+
+    double sum() const {
+        const __m128d lo = _mm_add_pd(
+            _mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1)
+        );
+        return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+    }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {_mm256_add_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {_mm256_sub_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {_mm256_mul_pd(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {_mm256_fmadd_pd(a.value, b.value, c.value)};
+    }
+
+}; // struct SIMDPack<double>
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    #define LEGION_SOLVERS_SIMD_ISA "NEON"
+
+template <>
+struct SIMDPack<float> {
+
+    static constexpr int width = 4;
+
+    float32x4_t value;
+
+    static SIMDPack zero() { return {vdupq_n_f32(0.0f)}; }
+
+    static SIMDPack broadcast(float x) { return {vdupq_n_f32(x)}; }
+
+    static SIMDPack load(const float *ptr) { return {vld1q_f32(ptr)}; }
+
+    void store(float *ptr) const { vst1q_f32(ptr, value); }
+
+    float sum() const { return vaddvq_f32(value); }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {vaddq_f32(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {vsubq_f32(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {vmulq_f32(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {vfmaq_f32(c.value, a.value, b.value)};
+    }
+
+}; // struct SIMDPack<float>
+
+template <>
+struct SIMDPack<double> {
+
+    static constexpr int width = 2;
+
+    float64x2_t value;
+
+    static SIMDPack zero() { return {vdupq_n_f64(0.0)}; }
+
+    static SIMDPack broadcast(double x) { return {vdupq_n_f64(x)}; }
+
+    static SIMDPack load(const double *ptr) { return {vld1q_f64(ptr)}; }
+
+    void store(double *ptr) const { vst1q_f64(ptr, value); }
+
+    double sum() const { return vaddvq_f64(value); }
+
+    friend SIMDPack operator+(SIMDPack a, SIMDPack b) {
+        return {vaddq_f64(a.value, b.value)};
+    }
+
+    friend SIMDPack operator-(SIMDPack a, SIMDPack b) {
+        return {vsubq_f64(a.value, b.value)};
+    }
+
+    friend SIMDPack operator*(SIMDPack a, SIMDPack b) {
+        return {vmulq_f64(a.value, b.value)};
+    }
+
+    friend SIMDPack fmadd(SIMDPack a, SIMDPack b, SIMDPack c) {
+        return {vfmaq_f64(c.value, a.value, b.value)};
+    }
+
+}; // struct SIMDPack<double>
+
+#else
+
+    #define LEGION_SOLVERS_SIMD_ISA "scalar"
+
+#endif
+
+
+// Requests complete unrolling of the loop that follows. Used for loops over
+// compile-time dimensions (block sizes, stencil points), whose operands
+// should stay in registers.
+#if defined(__clang__)
+    #define LEGION_SOLVERS_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+    #define LEGION_SOLVERS_UNROLL _Pragma("GCC unroll 32")
+#else
+    #define LEGION_SOLVERS_UNROLL
+#endif
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SIMD_UTILITIES_HPP_INCLUDED
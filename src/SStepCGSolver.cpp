@@ -0,0 +1,245 @@
+#include "SStepCGSolver.hpp"
+
+#include <algorithm> // for std::max
+#include <cassert>   // for assert
+#include <cmath>     // for std::sqrt
+#include <cstdint>   // for std::uint32_t
+
+#include "FusedVectorOperations.hpp" // for FusedVectorOperations
+#include "LibraryOptions.hpp"        // for LEGION_SOLVERS_USE_*, ...
+#include "LinearCombinations.hpp"    // for LinearCombinations
+#include "SStepCGSolverTasks.hpp"    // for SStepCGCoefficientsTask, ...
+#include "Scalar.hpp"                // for Scalar
+
+using LegionSolvers::SStepCGSolver;
+using LegionSolvers::Scalar;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+SStepCGSolver<ENTRY_T, DIM, COORD_T>::SStepCGSolver(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+    Legion::LogicalRegion rhs_region,
+    Legion::FieldID rhs_fid,
+    Legion::LogicalRegion solution_region,
+    Legion::FieldID solution_fid,
+    std::size_t num_steps,
+    KrylovBasisKind basis_kind,
+    ENTRY_T lambda_min,
+    ENTRY_T lambda_max,
+    std::size_t check_interval
+)
+    : ctx(ctx), rt(rt), matrix(matrix), num_steps(num_steps),
+      basis(make_krylov_basis<ENTRY_T>(
+          basis_kind,
+          static_cast<std::uint32_t>(num_steps),
+          lambda_min,
+          lambda_max
+      )),
+      check_interval(check_interval),
+      powers(ctx, rt, matrix, static_cast<int>(num_steps)),
+      rhs(ctx, rt, rhs_region, rhs_fid, matrix.get_range_partition()),
+      solution(
+          ctx, rt, solution_region, solution_fid, matrix.get_range_partition()
+      ),
+      residual_norm(static_cast<ENTRY_T>(0)) {
+    assert(num_steps >= 1);
+    assert(check_interval > 0);
+    assert(rhs_region.get_index_space() == matrix.get_range_space());
+    assert(solution_region.get_index_space() == matrix.get_range_space());
+    for (std::size_t i = 0; i < 2 * num_steps + 1; ++i) {
+        vectors.push_back(
+            std::make_unique<Vector>(ctx, rt, matrix.get_range_partition())
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SStepCGSolver<ENTRY_T, DIM, COORD_T>::compute_basis() {
+    std::vector<Legion::LogicalRegion> regions;
+    std::vector<Legion::FieldID> fids;
+    for (std::size_t k = 1; k <= num_steps; ++k) {
+        regions.push_back(get_p(k).get_logical_region());
+        fids.push_back(get_p(k).get_fid());
+    }
+    powers.apply(
+        basis, get_p(0).get_logical_region(), get_p(0).get_fid(), regions, fids
+    );
+    if (num_steps == 1) { return; }
+    regions.clear();
+    fids.clear();
+    for (std::size_t k = 1; k < num_steps; ++k) {
+        regions.push_back(get_r(k).get_logical_region());
+        fids.push_back(get_r(k).get_fid());
+    }
+    powers.apply(
+        basis, get_r(0).get_logical_region(), get_r(0).get_fid(), regions, fids
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future SStepCGSolver<ENTRY_T, DIM, COORD_T>::gram_matrix() const {
+    FusedVectorOperations<ENTRY_T, DIM, COORD_T> operations{ctx, rt};
+    const std::uint32_t size = static_cast<std::uint32_t>(vectors.size());
+    for (std::uint32_t i = 0; i < size; ++i) {
+        for (std::uint32_t j = i; j < size; ++j) {
+            const std::uint32_t index =
+                operations.dot(*vectors[i], *vectors[j]);
+            assert(index == packed_upper_index(size, i, j));
+        }
+    }
+    return operations.execute();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::Future SStepCGSolver<ENTRY_T, DIM, COORD_T>::coefficients(
+    const Legion::Future &gram
+) const {
+    const SStepCGArgs<ENTRY_T> args{
+        static_cast<std::uint32_t>(num_steps), basis};
+    Legion::TaskLauncher launcher{
+        SStepCGCoefficientsTask<ENTRY_T>::task_id,
+        Legion::TaskArgument{&args, sizeof(SStepCGArgs<ENTRY_T>)}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher.add_future(gram);
+    return rt->execute_task(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SStepCGSolver<ENTRY_T, DIM, COORD_T>::update(
+    const Legion::Future &coefficients
+) {
+    // The new x, r, and p are combinations of Y with the coefficient blocks
+    // of SStepCGCoefficientsTask.
+    const std::uint32_t size = static_cast<std::uint32_t>(vectors.size());
+    std::vector<const Vector *> inputs;
+    for (const auto &v : vectors) { inputs.push_back(v.get()); }
+    LinearCombinations<ENTRY_T, DIM, COORD_T> combinations{
+        ctx, rt, inputs, coefficients};
+    combinations.add(solution, 0);
+    combinations.assign(get_r(0), size);
+    combinations.assign(get_p(0), 2 * size);
+    combinations.execute();
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+std::size_t SStepCGSolver<ENTRY_T, DIM, COORD_T>::solve(
+    std::size_t max_iterations, ENTRY_T tolerance
+) {
+    // r = b - A * x, using p_1 as scratch space; p = r.
+    matrix.matvec(
+        get_p(1).get_logical_region(),
+        get_p(1).get_fid(),
+        solution.get_logical_region(),
+        solution.get_fid()
+    );
+    get_r(0).copy(rhs);
+    get_r(0).axpy(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-1)}, get_p(1));
+    get_p(0).copy(get_r(0));
+
+    const Scalar<ENTRY_T> rhs_norm_squared = rhs.dot(rhs);
+    const std::uint32_t rr_index =
+        static_cast<std::uint32_t>(3 * vectors.size());
+
+    std::size_t iteration = 0;
+    std::size_t outer_iteration = 0;
+    while (true) {
+        compute_basis();
+        const Legion::Future packed = coefficients(gram_matrix());
+
+        const bool last = (iteration >= max_iterations);
+        if (last || (outer_iteration % check_interval == 0)) {
+            const ENTRY_T rr_value =
+                Scalar<ENTRY_T>::packed(ctx, rt, packed, rr_index).get_value();
+            const ENTRY_T threshold =
+                tolerance * tolerance * rhs_norm_squared.get_value();
+            residual_norm =
+                std::sqrt(std::max(rr_value, static_cast<ENTRY_T>(0)));
+            if (last || (rr_value <= threshold)) { return iteration; }
+        }
+
+        update(packed);
+        iteration += num_steps;
+        ++outer_iteration;
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::SStepCGSolver<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::SStepCGSolver<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::SStepCGSolver<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
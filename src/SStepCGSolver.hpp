@@ -0,0 +1,108 @@
+#ifndef LEGION_SOLVERS_SSTEP_CG_SOLVER_HPP_INCLUDED
+#define LEGION_SOLVERS_SSTEP_CG_SOLVER_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CSRMatrix.hpp"          // for CSRMatrix
+#include "DistributedVector.hpp"  // for DistributedVector
+#include "KrylovBasis.hpp"        // for KrylovBasis, KrylovBasisKind
+#include "MatrixPowersKernel.hpp" // for MatrixPowersKernel
+
+namespace LegionSolvers {
+
+
+// Solves A * x = b for a symmetric positive definite CSRMatrix A by the
+// s-step (communication-avoiding) conjugate gradient method, which performs
+// num_steps = s CG iterations per outer iteration with three collective
+// operations instead of 3s:
+//   1. a matrix-powers kernel (see MatrixPowersKernel) computes the Krylov
+//      basis vectors p_1, ..., p_s of the search direction p and r_1, ...,
+//      r_{s-1} of the residual r, exchanging one ghost region of depth s;
+//   2. one fused launch reduces the Gram matrix of Y = [p_0, ..., p_s, r_0,
+//      ..., r_{s-1}] (p_0 = p, r_0 = r) in place of 2s dot products;
+//   3. the s inner iterations run on coordinates in Y in a single task
+//      (see SStepCGCoefficientsTask), and one LinearCombinationTask launch
+//      applies their result to x, r, and p.
+//
+// The basis (see make_krylov_basis) must be well conditioned for CG to
+// converge at the rate of classic CG: the Newton and Chebyshev bases need an
+// interval [lambda_min, lambda_max] containing (or roughly approximating)
+// the spectrum of A. The solver is unpreconditioned, and num_steps is at
+// most LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH. Vectors are partitioned like
+// the range of A, as the matrix-powers kernel requires.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class SStepCGSolver {
+
+    using Vector = DistributedVector<ENTRY_T, DIM, COORD_T>;
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix;
+    const std::size_t num_steps;
+    const KrylovBasis<ENTRY_T> basis;
+    const std::size_t check_interval;
+    const MatrixPowersKernel<ENTRY_T, DIM, COORD_T> powers;
+    const Vector rhs;
+    Vector solution;
+    // Y = [p_0, ..., p_s, r_0, ..., r_{s-1}].
+    std::vector<std::unique_ptr<Vector>> vectors;
+    ENTRY_T residual_norm;
+
+    Vector &get_p(std::size_t k) { return *vectors[k]; }
+    Vector &get_r(std::size_t k) { return *vectors[num_steps + 1 + k]; }
+
+    // Computes p_1, ..., p_s and r_1, ..., r_{s-1}.
+    void compute_basis();
+
+    // Returns the Gram matrix of Y, packed as in packed_upper_index.
+    Legion::Future gram_matrix() const;
+
+    // Launches the SStepCGCoefficientsTask of one outer iteration.
+    Legion::Future coefficients(const Legion::Future &gram) const;
+
+    // Updates x, r, and p from the coefficients of one outer iteration.
+    void update(const Legion::Future &coefficients);
+
+  public:
+
+    static constexpr std::size_t DEFAULT_CHECK_INTERVAL = 1;
+
+    explicit SStepCGSolver(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const CSRMatrix<ENTRY_T, DIM, COORD_T> &matrix,
+        Legion::LogicalRegion rhs_region,
+        Legion::FieldID rhs_fid,
+        Legion::LogicalRegion solution_region,
+        Legion::FieldID solution_fid,
+        std::size_t num_steps,
+        KrylovBasisKind basis_kind,
+        ENTRY_T lambda_min,
+        ENTRY_T lambda_max,
+        std::size_t check_interval = DEFAULT_CHECK_INTERVAL
+    );
+
+    SStepCGSolver(const SStepCGSolver &) = delete;
+
+    SStepCGSolver &operator=(const SStepCGSolver &) = delete;
+
+    // Iterates until the residual norm is at most tolerance times the norm
+    // of b, as observed at a convergence check every check_interval outer
+    // iterations, or until at least max_iterations CG iterations have been
+    // performed. Returns the number of CG iterations, a multiple of s.
+    std::size_t solve(std::size_t max_iterations, ENTRY_T tolerance);
+
+    // Norm of the residual b - A * x at the last convergence check, as
+    // updated by the s-step CG recurrences.
+    ENTRY_T get_residual_norm() const { return residual_norm; }
+
+}; // class SStepCGSolver
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SSTEP_CG_SOLVER_HPP_INCLUDED
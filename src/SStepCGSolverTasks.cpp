@@ -0,0 +1,109 @@
+#include "SStepCGSolverTasks.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+
+using LegionSolvers::PackedScalars;
+using LegionSolvers::SStepCGArgs;
+using LegionSolvers::SStepCGCoefficientsTask;
+using LegionSolvers::multiply_in_basis;
+using LegionSolvers::packed_upper_index;
+
+
+template <typename T>
+PackedScalars<T> SStepCGCoefficientsTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    constexpr std::size_t MAX_SIZE =
+        2 * LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH + 1;
+
+    assert(task->arglen == sizeof(SStepCGArgs<T>));
+    const SStepCGArgs<T> &args =
+        *static_cast<const SStepCGArgs<T> *>(task->args);
+    const std::uint32_t s = args.num_steps;
+    const std::uint32_t m = 2 * s + 1;
+    assert((s >= 1) && (s <= args.basis.length));
+    assert(3 * m + 2 <= LEGION_SOLVERS_MAX_PACKED_SCALARS);
+
+    assert(task->futures.size() == 1);
+    const PackedScalars<T> packed_gram =
+        task->futures[0].get_result<PackedScalars<T>>();
+    T gram[MAX_SIZE][MAX_SIZE];
+    for (std::uint32_t i = 0; i < m; ++i) {
+        for (std::uint32_t j = i; j < m; ++j) {
+            gram[i][j] = packed_gram.values[packed_upper_index(m, i, j)];
+            gram[j][i] = gram[i][j];
+        }
+    }
+    const auto inner = [&](const T *a, const T *b) {
+        T result = static_cast<T>(0);
+        for (std::uint32_t i = 0; i < m; ++i) {
+            T row = static_cast<T>(0);
+            for (std::uint32_t j = 0; j < m; ++j) { row += gram[i][j] * b[j]; }
+            result += a[i] * row;
+        }
+        return result;
+    };
+
+    // Coordinates of x - x_0, r, and p; the p-block of Y has s + 1 vectors
+    // and the r-block has s.
+    T x[MAX_SIZE] = {};
+    T r[MAX_SIZE] = {};
+    T p[MAX_SIZE] = {};
+    T product[MAX_SIZE];
+    r[s + 1] = static_cast<T>(1);
+    p[0] = static_cast<T>(1);
+
+    PackedScalars<T> result = {};
+    T rr = inner(r, r);
+    result.values[3 * m] = rr;
+    for (std::uint32_t j = 0; j < s; ++j) {
+        if (!(rr > static_cast<T>(0))) { break; } // converged
+        multiply_in_basis(args.basis, s, p, product);
+        multiply_in_basis(args.basis, s - 1, p + s + 1, product + s + 1);
+        const T curvature = inner(p, product);
+        if (!(curvature > static_cast<T>(0))) { break; } // breakdown
+        const T alpha = rr / curvature;
+        for (std::uint32_t i = 0; i < m; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * product[i];
+        }
+        const T rr_new = inner(r, r);
+        const T beta = rr_new / rr;
+        for (std::uint32_t i = 0; i < m; ++i) { p[i] = r[i] + beta * p[i]; }
+        rr = rr_new;
+    }
+
+    for (std::uint32_t i = 0; i < m; ++i) {
+        result.values[i] = x[i];
+        result.values[m + i] = r[i];
+        result.values[2 * m + i] = p[i];
+    }
+    result.values[3 * m + 1] = rr;
+    return result;
+}
+
+
+#ifdef LEGION_SOLVERS_USE_FLOAT
+template PackedScalars<float> SStepCGCoefficientsTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_FLOAT
+
+
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+template PackedScalars<double> SStepCGCoefficientsTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+#endif // LEGION_SOLVERS_USE_DOUBLE
@@ -0,0 +1,67 @@
+#ifndef LEGION_SOLVERS_SSTEP_CG_SOLVER_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_SSTEP_CG_SOLVER_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "KrylovBasis.hpp"     // for KrylovBasis
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "PackedScalars.hpp"   // for PackedScalars
+#include "TaskBaseClasses.hpp" // for TaskT
+#include "TaskIDs.hpp"         // for SSTEP_CG_COEFFICIENTS_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Position of the Gram matrix entry (i, j), i <= j, among the packed upper
+// triangle (row by row) of a symmetric size-by-size matrix.
+constexpr std::uint32_t
+packed_upper_index(std::uint32_t size, std::uint32_t i, std::uint32_t j) {
+    return i * size - i * (i - 1) / 2 + (j - i);
+}
+
+
+template <typename T>
+struct SStepCGArgs {
+    std::uint32_t num_steps;
+    KrylovBasis<T> basis;
+}; // struct SStepCGArgs
+
+
+// Performs the num_steps = s inner iterations of one outer iteration of
+// s-step CG in the coordinates of the basis Y = [p_0, ..., p_s, r_0, ...,
+// r_{s-1}] of m = 2s + 1 vectors, where p_k and r_k are the Krylov basis
+// vectors (see KrylovBasis) generated by p and r. The only future is the
+// Gram matrix Y^T Y, packed as in packed_upper_index; the task argument is
+// an SStepCGArgs<T>. Returns, packed, the coordinates of the increment of
+// x (components [0, m)), of the new r ([m, 2m)), and of the new p
+// ([2m, 3m)), followed by the squared norms of r before (3m) and after
+// (3m + 1) the inner iterations.
+template <typename T>
+struct SStepCGCoefficientsTask : public TaskT<
+                                     SSTEP_CG_COEFFICIENTS_TASK_BLOCK_ID,
+                                     SStepCGCoefficientsTask,
+                                     T> {
+
+    static constexpr const char *task_base_name = "sstep_cg_coefficients";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = PackedScalars<T>;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct SStepCGCoefficientsTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SSTEP_CG_SOLVER_TASKS_HPP_INCLUDED
@@ -1,9 +1,189 @@
 #include "Scalar.hpp"
 
+#include <cassert> // for assert
+#include <memory>  // for std::make_shared
+
 #include "LibraryOptions.hpp" // for LEGION_SOLVERS_MAPPER_ID
-#include "UtilityTasks.hpp"   // for *ScalarTask
+#include "ScalarProgram.hpp"  // for ScalarProgram, evaluate_scalar_program
+#include "UtilityTasks.hpp"   // for PrintScalarTask, ...
 
 using LegionSolvers::Scalar;
+using LegionSolvers::ScalarExpression;
+using LegionSolvers::ScalarInstruction;
+using LegionSolvers::ScalarOpCode;
+using LegionSolvers::ScalarProgram;
+
+
+template <typename T>
+std::shared_ptr<ScalarExpression<T>> make_leaf(
+    ScalarOpCode opcode,
+    const Legion::Future &future,
+    std::uint32_t component,
+    const T &constant
+) {
+    return std::make_shared<ScalarExpression<T>>(ScalarExpression<T>{
+        opcode, future, component, constant, nullptr, nullptr, 1});
+}
+
+
+// Appends the postfix form of node to program.
+template <typename T>
+void emit(
+    const ScalarExpression<T> &node,
+    ScalarProgram<T> &program,
+    std::vector<Legion::Future> &futures
+) {
+    if (node.lhs) { emit(*node.lhs, program, futures); }
+    if (node.rhs) { emit(*node.rhs, program, futures); }
+    assert(
+        program.num_instructions <
+        LegionSolvers::LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH
+    );
+    const std::uint32_t i = program.num_instructions++;
+    ScalarInstruction &instruction = program.instructions[i];
+    instruction.opcode = node.opcode;
+    instruction.component = 0;
+    instruction.operand = 0;
+    program.constants[i] = static_cast<T>(0);
+    if ((node.opcode == ScalarOpCode::FUTURE) ||
+        (node.opcode == ScalarOpCode::PACKED)) {
+        std::size_t index = 0;
+        while ((index < futures.size()) && !(futures[index] == node.future)) {
+            ++index;
+        }
+        if (index == futures.size()) { futures.push_back(node.future); }
+        instruction.operand = static_cast<std::uint16_t>(index);
+        instruction.component = static_cast<std::uint8_t>(node.component);
+    } else if (node.opcode == ScalarOpCode::CONSTANT) {
+        program.constants[i] = node.constant;
+    }
+}
+
+
+template <typename T>
+Scalar<T>::Scalar(
+    Legion::Context ctx, Legion::Runtime *rt, const Legion::Future &future
+)
+    : ctx(ctx), rt(rt),
+      expression(make_leaf(ScalarOpCode::FUTURE, future, 0, T{})) {}
+
+
+template <typename T>
+Scalar<T>::Scalar(Legion::Context ctx, Legion::Runtime *rt, const T &value)
+    : ctx(ctx), rt(rt), expression(make_leaf(
+                            ScalarOpCode::CONSTANT, Legion::Future{}, 0, value
+                        )) {}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::packed(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const Legion::Future &future,
+    std::uint32_t index
+) {
+    assert(index < LEGION_SOLVERS_MAX_PACKED_SCALARS);
+    return Scalar<T>{
+        ctx, rt, make_leaf(ScalarOpCode::PACKED, future, index, T{})};
+}
+
+
+template <typename T>
+ScalarProgram<T> Scalar<T>::compile(std::vector<Legion::Future> &futures
+) const {
+    ScalarProgram<T> program;
+    program.num_instructions = 0;
+    emit(*expression, program, futures);
+    return program;
+}
+
+
+template <typename T>
+Legion::Future Scalar<T>::get_future() const {
+    if (expression->opcode == ScalarOpCode::FUTURE) {
+        return expression->future;
+    }
+    std::vector<Legion::Future> futures;
+    const ScalarProgram<T> program = compile(futures);
+    Legion::Future result;
+    if (futures.empty()) {
+        result = Legion::Future::from_value(
+            rt, evaluate_scalar_program(program, futures)
+        );
+    } else {
+        Legion::TaskLauncher launcher(
+            EvaluateScalarProgramTask<T>::task_id,
+            Legion::TaskArgument(&program, sizeof(ScalarProgram<T>))
+        );
+        launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+        for (const Legion::Future &future : futures) {
+            launcher.add_future(future);
+        }
+        result = rt->execute_task(ctx, launcher);
+    }
+    *expression = *make_leaf(ScalarOpCode::FUTURE, result, 0, T{});
+    return result;
+}
+
+
+template <typename T>
+T Scalar<T>::get_value() const {
+    std::vector<Legion::Future> futures;
+    return evaluate_scalar_program(compile(futures), futures);
+}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::unary(ScalarOpCode opcode) const {
+    if (expression->length + 1 > LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH) {
+        get_future();
+    }
+    auto result = std::make_shared<ScalarExpression<T>>(ScalarExpression<T>{
+        opcode,
+        Legion::Future{},
+        0,
+        T{},
+        expression,
+        nullptr,
+        expression->length + 1});
+    if (expression->opcode == ScalarOpCode::CONSTANT) { // fold constants
+        const T value = Scalar<T>{ctx, rt, result}.get_value();
+        return Scalar<T>{ctx, rt, value};
+    }
+    return Scalar<T>{ctx, rt, result};
+}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::binary(ScalarOpCode opcode, const Scalar<T> &rhs) const {
+    // Evaluate the longer operand first if the result would be too long.
+    const Scalar<T> &longer =
+        (expression->length >= rhs.expression->length) ? *this : rhs;
+    const Scalar<T> &shorter =
+        (expression->length >= rhs.expression->length) ? rhs : *this;
+    if (expression->length + rhs.expression->length + 1 >
+        LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH) {
+        longer.get_future();
+    }
+    if (expression->length + rhs.expression->length + 1 >
+        LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH) {
+        shorter.get_future();
+    }
+    auto result = std::make_shared<ScalarExpression<T>>(ScalarExpression<T>{
+        opcode,
+        Legion::Future{},
+        0,
+        T{},
+        expression,
+        rhs.expression,
+        expression->length + rhs.expression->length + 1});
+    if ((expression->opcode == ScalarOpCode::CONSTANT) &&
+        (rhs.expression->opcode == ScalarOpCode::CONSTANT)) { // fold constants
+        const T value = Scalar<T>{ctx, rt, result}.get_value();
+        return Scalar<T>{ctx, rt, value};
+    }
+    return Scalar<T>{ctx, rt, result};
+}
 
 
 template <typename T>
@@ -14,60 +194,49 @@ Scalar<T> Scalar<T>::operator+() const {
 
 template <typename T>
 Scalar<T> Scalar<T>::operator-() const {
-    Legion::TaskLauncher launcher(
-        NegateScalarTask<T>::task_id, Legion::TaskArgument()
-    );
-    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
-    return Scalar<T>{ctx, rt, rt->execute_task(ctx, launcher)};
+    return unary(ScalarOpCode::NEGATE);
 }
 
 
 template <typename T>
 Scalar<T> Scalar<T>::operator+(const Scalar<T> &rhs) const {
-    Legion::TaskLauncher launcher(
-        AddScalarTask<T>::task_id, Legion::TaskArgument()
-    );
-    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
-    launcher.add_future(rhs.future);
-    return Scalar<T>{ctx, rt, rt->execute_task(ctx, launcher)};
+    return binary(ScalarOpCode::ADD, rhs);
 }
 
 
 template <typename T>
 Scalar<T> Scalar<T>::operator-(const Scalar<T> &rhs) const {
-    Legion::TaskLauncher launcher(
-        SubtractScalarTask<T>::task_id, Legion::TaskArgument()
-    );
-    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
-    launcher.add_future(rhs.future);
-    return Scalar<T>{ctx, rt, rt->execute_task(ctx, launcher)};
+    return binary(ScalarOpCode::SUBTRACT, rhs);
 }
 
 
 template <typename T>
 Scalar<T> Scalar<T>::operator*(const Scalar<T> &rhs) const {
-    Legion::TaskLauncher launcher(
-        MultiplyScalarTask<T>::task_id, Legion::TaskArgument()
-    );
-    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
-    launcher.add_future(rhs.future);
-    return Scalar<T>{ctx, rt, rt->execute_task(ctx, launcher)};
+    return binary(ScalarOpCode::MULTIPLY, rhs);
 }
 
 
 template <typename T>
 Scalar<T> Scalar<T>::operator/(const Scalar<T> &rhs) const {
-    Legion::TaskLauncher launcher(
-        DivideScalarTask<T>::task_id, Legion::TaskArgument()
-    );
-    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
-    launcher.add_future(rhs.future);
-    return Scalar<T>{ctx, rt, rt->execute_task(ctx, launcher)};
+    return binary(ScalarOpCode::DIVIDE, rhs);
+}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::divide_if_positive(const Scalar<T> &rhs) const {
+    return binary(ScalarOpCode::DIVIDE_IF_POSITIVE, rhs);
+}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::divide_if_nonzero(const Scalar<T> &rhs) const {
+    return binary(ScalarOpCode::DIVIDE_IF_NONZERO, rhs);
+}
+
+
+template <typename T>
+Scalar<T> Scalar<T>::sqrt() const {
+    return unary(ScalarOpCode::SQRT);
 }
 
 
@@ -77,7 +246,7 @@ Legion::Future Scalar<T>::print() const {
         PrintScalarTask<T>::task_id, Legion::TaskArgument()
     );
     launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
+    launcher.add_future(get_future());
     return rt->execute_task(ctx, launcher);
 }
 
@@ -88,31 +257,73 @@ Legion::Future Scalar<T>::print(Legion::Future dummy) const {
         PrintScalarTask<T>::task_id, Legion::TaskArgument()
     );
     launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
-    launcher.add_future(future);
+    launcher.add_future(get_future());
     launcher.add_future(dummy);
     return rt->execute_task(ctx, launcher);
 }
 
 
 #ifdef LEGION_SOLVERS_USE_FLOAT
+template Scalar<float>::Scalar(
+    Legion::Context, Legion::Runtime *, const Legion::Future &
+);
+template Scalar<float>::Scalar(
+    Legion::Context, Legion::Runtime *, const float &
+);
+template Scalar<float> Scalar<float>::packed(
+    Legion::Context, Legion::Runtime *, const Legion::Future &, std::uint32_t
+);
+template ScalarProgram<float> Scalar<float>::compile(
+    std::vector<Legion::Future> &
+) const;
+template Legion::Future Scalar<float>::get_future() const;
+template float Scalar<float>::get_value() const;
 template Scalar<float> Scalar<float>::operator+() const;
 template Scalar<float> Scalar<float>::operator-() const;
 template Scalar<float> Scalar<float>::operator+(const Scalar<float> &) const;
 template Scalar<float> Scalar<float>::operator-(const Scalar<float> &) const;
 template Scalar<float> Scalar<float>::operator*(const Scalar<float> &) const;
 template Scalar<float> Scalar<float>::operator/(const Scalar<float> &) const;
+template Scalar<float> Scalar<float>::divide_if_positive(
+    const Scalar<float> &
+) const;
+template Scalar<float> Scalar<float>::divide_if_nonzero(
+    const Scalar<float> &
+) const;
+template Scalar<float> Scalar<float>::sqrt() const;
 template Legion::Future Scalar<float>::print() const;
 template Legion::Future Scalar<float>::print(Legion::Future) const;
 #endif // LEGION_SOLVERS_USE_FLOAT
 
 
 #ifdef LEGION_SOLVERS_USE_DOUBLE
+template Scalar<double>::Scalar(
+    Legion::Context, Legion::Runtime *, const Legion::Future &
+);
+template Scalar<double>::Scalar(
+    Legion::Context, Legion::Runtime *, const double &
+);
+template Scalar<double> Scalar<double>::packed(
+    Legion::Context, Legion::Runtime *, const Legion::Future &, std::uint32_t
+);
+template ScalarProgram<double> Scalar<double>::compile(
+    std::vector<Legion::Future> &
+) const;
+template Legion::Future Scalar<double>::get_future() const;
+template double Scalar<double>::get_value() const;
 template Scalar<double> Scalar<double>::operator+() const;
 template Scalar<double> Scalar<double>::operator-() const;
 template Scalar<double> Scalar<double>::operator+(const Scalar<double> &) const;
 template Scalar<double> Scalar<double>::operator-(const Scalar<double> &) const;
 template Scalar<double> Scalar<double>::operator*(const Scalar<double> &) const;
 template Scalar<double> Scalar<double>::operator/(const Scalar<double> &) const;
+template Scalar<double> Scalar<double>::divide_if_positive(
+    const Scalar<double> &
+) const;
+template Scalar<double> Scalar<double>::divide_if_nonzero(
+    const Scalar<double> &
+) const;
+template Scalar<double> Scalar<double>::sqrt() const;
 template Legion::Future Scalar<double>::print() const;
 template Legion::Future Scalar<double>::print(Legion::Future) const;
 #endif // LEGION_SOLVERS_USE_DOUBLE
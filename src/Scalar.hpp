@@ -1,38 +1,86 @@
 #ifndef LEGION_SOLVERS_SCALAR_HPP_INCLUDED
 #define LEGION_SOLVERS_SCALAR_HPP_INCLUDED
 
+#include <cstdint> // for std::uint32_t
+#include <memory>  // for std::shared_ptr
+#include <vector>  // for std::vector
+
 #include <legion.h> // for Legion::*
 
+#include "ScalarProgram.hpp" // for ScalarProgram, ScalarOpCode
+
 namespace LegionSolvers {
 
 
+// Node of the expression tree behind a Scalar. Once a node has been
+// evaluated into a future, it is rewritten in place as a FUTURE leaf, so that
+// every Scalar sharing it reuses the result.
+template <typename T>
+struct ScalarExpression {
+    ScalarOpCode opcode;
+    Legion::Future future;  // FUTURE, PACKED
+    std::uint32_t component; // PACKED
+    T constant;              // CONSTANT
+    std::shared_ptr<ScalarExpression> lhs;
+    std::shared_ptr<ScalarExpression> rhs;
+    std::uint32_t length; // number of instructions in postfix form
+}; // struct ScalarExpression
+
+
+// A scalar value held in a Legion future, or an arithmetic expression of
+// such values. Arithmetic operators build an expression tree lazily without
+// launching tasks. The tree is compiled into a single ScalarProgram when the
+// value is consumed: by get_future() (which launches one
+// EvaluateScalarProgramTask), by get_value(), or by a vector operation that
+// takes the program directly as its coefficient (see compile()).
 template <typename T>
 class Scalar {
 
     const Legion::Context ctx;
     Legion::Runtime *const rt;
-    Legion::Future future;
+    std::shared_ptr<ScalarExpression<T>> expression;
+
+    explicit Scalar(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        std::shared_ptr<ScalarExpression<T>> expression
+    )
+        : ctx(ctx), rt(rt), expression(expression) {}
+
+    Scalar unary(ScalarOpCode opcode) const;
+
+    Scalar binary(ScalarOpCode opcode, const Scalar &rhs) const;
 
   public:
 
     explicit Scalar(
         Legion::Context ctx, Legion::Runtime *rt, const Legion::Future &future
-    )
-        : ctx(ctx), rt(rt), future(future) {}
+    );
 
-    explicit Scalar(Legion::Context ctx, Legion::Runtime *rt, const T &value)
-        : ctx(ctx), rt(rt), future(Legion::Future::from_value(rt, value)) {}
+    explicit Scalar(Legion::Context ctx, Legion::Runtime *rt, const T &value);
+
+    // Component index of a PackedScalars<T> future.
+    static Scalar packed(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const Legion::Future &future,
+        std::uint32_t index
+    );
 
     Scalar(const Scalar &) = default; // NOTE: should not be explicit
 
     Scalar &operator=(const Scalar &rhs) {
-        future = rhs.future;
+        expression = rhs.expression;
         return *this; // no need to overwrite ctx or rt
     }
 
-    Legion::Future get_future() const { return future; }
+    // Compiles this expression. Futures it refers to are looked up in, or
+    // appended to, futures; the program indexes into that list.
+    ScalarProgram<T> compile(std::vector<Legion::Future> &futures) const;
+
+    Legion::Future get_future() const;
 
-    T get_value() const { return future.get_result<T>(); }
+    T get_value() const;
 
     Scalar operator+() const;
 
@@ -46,6 +94,15 @@ class Scalar {
 
     Scalar operator/(const Scalar &rhs) const;
 
+    // *this / rhs, or 0 unless rhs > 0. Guards the step lengths of Krylov
+    // methods, whose denominators vanish once the residual is exactly zero.
+    Scalar divide_if_positive(const Scalar &rhs) const;
+
+    // *this / rhs, or 0 if rhs == 0, for denominators of either sign.
+    Scalar divide_if_nonzero(const Scalar &rhs) const;
+
+    Scalar sqrt() const;
+
     Legion::Future print() const;
 
     Legion::Future print(Legion::Future dummy) const;
@@ -0,0 +1,131 @@
+#ifndef LEGION_SOLVERS_SCALAR_PROGRAM_HPP_INCLUDED
+#define LEGION_SOLVERS_SCALAR_PROGRAM_HPP_INCLUDED
+
+#include <cassert> // for assert
+#include <cmath>   // for std::sqrt
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint16_t, std::uint32_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::Future
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH
+#include "PackedScalars.hpp"  // for PackedScalars
+
+namespace LegionSolvers {
+
+
+enum class ScalarOpCode : std::uint8_t {
+    FUTURE,   // push futures[operand]
+    PACKED,   // push futures[operand].values[component] (a PackedScalars)
+    CONSTANT, // push constants[i], where i is the index of this instruction
+    NEGATE,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    DIVIDE_IF_POSITIVE, // quotient, or 0 unless the divisor is > 0
+    DIVIDE_IF_NONZERO,  // quotient, or 0 if the divisor is 0
+    SQRT,
+}; // enum class ScalarOpCode
+
+
+struct ScalarInstruction {
+    ScalarOpCode opcode;
+    std::uint8_t component;
+    std::uint16_t operand;
+}; // struct ScalarInstruction
+
+
+// A scalar expression in postfix form, compiled from a Scalar<T> expression
+// tree. ScalarProgram is trivially copyable, so it can be passed by value as
+// a task argument; the futures it refers to are passed as task futures.
+template <typename T>
+struct ScalarProgram {
+    std::uint32_t num_instructions;
+    ScalarInstruction instructions[LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH];
+    T constants[LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH];
+}; // struct ScalarProgram
+
+
+template <typename T>
+T evaluate_scalar_program(
+    const ScalarProgram<T> &program, const std::vector<Legion::Future> &futures
+) {
+    assert(program.num_instructions > 0);
+    assert(
+        program.num_instructions <= LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH
+    );
+    T stack[LEGION_SOLVERS_MAX_SCALAR_PROGRAM_LENGTH];
+    std::size_t top = 0;
+    for (std::uint32_t i = 0; i < program.num_instructions; ++i) {
+        const ScalarInstruction &instruction = program.instructions[i];
+        switch (instruction.opcode) {
+            case ScalarOpCode::FUTURE:
+                assert(instruction.operand < futures.size());
+                stack[top++] = futures[instruction.operand].get_result<T>();
+                break;
+            case ScalarOpCode::PACKED:
+                assert(instruction.operand < futures.size());
+                assert(
+                    instruction.component < LEGION_SOLVERS_MAX_PACKED_SCALARS
+                );
+                stack[top++] = futures[instruction.operand]
+                                   .get_result<PackedScalars<T>>()
+                                   .values[instruction.component];
+                break;
+            case ScalarOpCode::CONSTANT:
+                stack[top++] = program.constants[i];
+                break;
+            case ScalarOpCode::NEGATE:
+                assert(top >= 1);
+                stack[top - 1] = -stack[top - 1];
+                break;
+            case ScalarOpCode::ADD:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = stack[top - 1] + stack[top];
+                break;
+            case ScalarOpCode::SUBTRACT:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = stack[top - 1] - stack[top];
+                break;
+            case ScalarOpCode::MULTIPLY:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = stack[top - 1] * stack[top];
+                break;
+            case ScalarOpCode::DIVIDE:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = stack[top - 1] / stack[top];
+                break;
+            case ScalarOpCode::DIVIDE_IF_POSITIVE:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = (stack[top] > static_cast<T>(0))
+                                     ? stack[top - 1] / stack[top]
+                                     : static_cast<T>(0);
+                break;
+            case ScalarOpCode::DIVIDE_IF_NONZERO:
+                assert(top >= 2);
+                --top;
+                stack[top - 1] = (stack[top] != static_cast<T>(0))
+                                     ? stack[top - 1] / stack[top]
+                                     : static_cast<T>(0);
+                break;
+            case ScalarOpCode::SQRT:
+                assert(top >= 1);
+                stack[top - 1] = std::sqrt(stack[top - 1]);
+                break;
+        }
+    }
+    assert(top == 1);
+    return stack[0];
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SCALAR_PROGRAM_HPP_INCLUDED
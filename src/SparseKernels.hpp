@@ -0,0 +1,308 @@
+#ifndef LEGION_SOLVERS_SPARSE_KERNELS_HPP_INCLUDED
+#define LEGION_SOLVERS_SPARSE_KERNELS_HPP_INCLUDED
+
+#include <cmath>   // for std::fma
+#include <cstddef> // for std::size_t
+
+#include <legion.h> // for Legion::Rect
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_SPARSE_*, ...
+#include "SIMDUtilities.hpp"  // for SIMDPack, LEGION_SOLVERS_UNROLL
+
+namespace LegionSolvers {
+
+
+// Hints that *ptr will be read soon. Sparse kernels use this for the input
+// vector entries they gather, whose addresses depend on column indices and
+// are therefore invisible to hardware stream prefetchers.
+template <typename T>
+inline void prefetch_for_read(const T *ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr, 0, 3);
+#else
+    (void)ptr;
+#endif
+}
+
+
+// Returns the sum of entries[k] * *x_ptr(columns[k]) for k in [begin, end).
+// Entries and column indices are read once, in order. The input vector
+// entries of the nonzeros LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE positions
+// ahead are prefetched, looking past the end of the row (typically into the
+// next one) up to prefetch_end, so that short rows benefit as well. Four
+// independent accumulators hide the latency of the fused multiply-adds.
+template <typename ENTRY_T, typename COLUMN_T, typename X_PTR>
+ENTRY_T sparse_row_dot(
+    std::size_t begin,
+    std::size_t end,
+    std::size_t prefetch_end,
+    const ENTRY_T *entries,
+    const COLUMN_T *columns,
+    const X_PTR &x_ptr
+) {
+    constexpr std::size_t D = LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE;
+    ENTRY_T acc0 = static_cast<ENTRY_T>(0);
+    ENTRY_T acc1 = static_cast<ENTRY_T>(0);
+    ENTRY_T acc2 = static_cast<ENTRY_T>(0);
+    ENTRY_T acc3 = static_cast<ENTRY_T>(0);
+    std::size_t k = begin;
+    for (; k + 4 <= end; k += 4) {
+        if (k + D + 4 <= prefetch_end) {
+            prefetch_for_read(x_ptr(columns[k + D]));
+            prefetch_for_read(x_ptr(columns[k + D + 1]));
+            prefetch_for_read(x_ptr(columns[k + D + 2]));
+            prefetch_for_read(x_ptr(columns[k + D + 3]));
+        }
+        acc0 = std::fma(entries[k], *x_ptr(columns[k]), acc0);
+        acc1 = std::fma(entries[k + 1], *x_ptr(columns[k + 1]), acc1);
+        acc2 = std::fma(entries[k + 2], *x_ptr(columns[k + 2]), acc2);
+        acc3 = std::fma(entries[k + 3], *x_ptr(columns[k + 3]), acc3);
+    }
+    for (; k < end; ++k) {
+        if (k + D < prefetch_end) { prefetch_for_read(x_ptr(columns[k + D])); }
+        acc0 = std::fma(entries[k], *x_ptr(columns[k]), acc0);
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+
+// y[i] = sum of entries[k] * *x_ptr(columns[k]) for each of the n rows,
+// where k ranges over rows[i] offset by kernel_lo, the index of entries[0]
+// and columns[0], which are valid below num_entries. Row i + 1 starts where
+// row i ends in the common case, so the row extents, entries, and column
+// indices are each streamed through memory once.
+template <
+    typename ENTRY_T,
+    typename COORD_T,
+    typename COLUMN_T,
+    typename X_PTR>
+void dense_csr_matvec(
+    std::size_t n,
+    ENTRY_T *y,
+    const Legion::Rect<1, COORD_T> *rows,
+    COORD_T kernel_lo,
+    std::size_t num_entries,
+    const ENTRY_T *entries,
+    const COLUMN_T *columns,
+    const X_PTR &x_ptr
+) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const Legion::Rect<1, COORD_T> &row = rows[i];
+        if (row.empty()) {
+            y[i] = static_cast<ENTRY_T>(0);
+            continue;
+        }
+        const std::size_t begin = row.lo[0] - kernel_lo;
+        const std::size_t end = row.hi[0] - kernel_lo + 1;
+        y[i] = sparse_row_dot(
+            begin, end, num_entries, entries, columns, x_ptr
+        );
+    }
+}
+
+
+// Sparse matrix times multi-vector: y[j][i] = sum of entries[k] *
+// *x_ptr(j, columns[k]) for each of the n rows i and each of the m vectors
+// j, where k ranges over rows[i] as in dense_csr_matvec. Each entry and
+// column index is read once for all m vectors rather than once per vector,
+// and the m input entries of a column are prefetched together. At most
+// LEGION_SOLVERS_MAX_BLOCK_SIZE vectors are supported.
+template <
+    typename ENTRY_T,
+    typename COORD_T,
+    typename COLUMN_T,
+    typename X_PTR>
+void dense_csr_matmat(
+    std::size_t n,
+    std::size_t m,
+    ENTRY_T *const *y,
+    const Legion::Rect<1, COORD_T> *rows,
+    COORD_T kernel_lo,
+    std::size_t num_entries,
+    const ENTRY_T *entries,
+    const COLUMN_T *columns,
+    const X_PTR &x_ptr
+) {
+    constexpr std::size_t D = LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE;
+    ENTRY_T sums[LEGION_SOLVERS_MAX_BLOCK_SIZE];
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+            sums[j] = static_cast<ENTRY_T>(0);
+        }
+        const Legion::Rect<1, COORD_T> &row = rows[i];
+        if (!row.empty()) {
+            const std::size_t begin = row.lo[0] - kernel_lo;
+            const std::size_t end = row.hi[0] - kernel_lo + 1;
+            for (std::size_t k = begin; k < end; ++k) {
+                if (k + D < num_entries) {
+                    for (std::size_t j = 0; j < m; ++j) {
+                        prefetch_for_read(x_ptr(j, columns[k + D]));
+                    }
+                }
+                const ENTRY_T entry = entries[k];
+                const COLUMN_T &column = columns[k];
+                for (std::size_t j = 0; j < m; ++j) {
+                    sums[j] = std::fma(entry, *x_ptr(j, column), sums[j]);
+                }
+            }
+        }
+        for (std::size_t j = 0; j < m; ++j) { y[j][i] = sums[j]; }
+    }
+}
+
+
+// For each of the n rows i, adds entries[k] * x[i] to column columns[k] by
+// calling reduce(columns[k], value), where k ranges over rows[i] offset by
+// kernel_lo as in dense_csr_matvec. The row extents, entries, column
+// indices, and x are each streamed through memory once; the scattered
+// reductions are the only irregular accesses.
+template <
+    typename ENTRY_T,
+    typename COORD_T,
+    typename COLUMN_T,
+    typename REDUCE>
+void dense_csr_transpose_matvec(
+    std::size_t n,
+    const ENTRY_T *x,
+    const Legion::Rect<1, COORD_T> *rows,
+    COORD_T kernel_lo,
+    const ENTRY_T *entries,
+    const COLUMN_T *columns,
+    const REDUCE &reduce
+) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const Legion::Rect<1, COORD_T> &row = rows[i];
+        if (row.empty()) { continue; }
+        const std::size_t begin = row.lo[0] - kernel_lo;
+        const std::size_t end = row.hi[0] - kernel_lo + 1;
+        const ENTRY_T xi = x[i];
+        for (std::size_t k = begin; k < end; ++k) {
+            reduce(columns[k], entries[k] * xi);
+        }
+    }
+}
+
+
+// For k in [0, n), adds entries[k] * *x_ptr(columns[k]) to row rows[k] by
+// calling reduce(rows[k], value). Consecutive nonzeros in the same row, as in
+// row-sorted COO, are summed locally first, so that reduce is called once per
+// run of equal rows rather than once per nonzero.
+template <
+    typename ENTRY_T,
+    typename ROW_T,
+    typename COLUMN_T,
+    typename X_PTR,
+    typename REDUCE>
+void dense_coo_matvec(
+    std::size_t n,
+    const ROW_T *rows,
+    const COLUMN_T *columns,
+    const ENTRY_T *entries,
+    const X_PTR &x_ptr,
+    const REDUCE &reduce
+) {
+    constexpr std::size_t D = LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE;
+    std::size_t k = 0;
+    while (k < n) {
+        const ROW_T &row = rows[k];
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        for (; (k < n) && (rows[k] == row); ++k) {
+            if (k + D < n) { prefetch_for_read(x_ptr(columns[k + D])); }
+            sum = std::fma(entries[k], *x_ptr(columns[k]), sum);
+        }
+        reduce(row, sum);
+    }
+}
+
+
+// Computes y[l] for the C rows (lanes) l of one SELL-C-sigma chunk of the
+// given width, whose C * width slots are stored column by column: slot
+// j * C + l holds the j-th nonzero (or padding) of lane l. Lanes are
+// processed SIMDPack<ENTRY_T>::width at a time, so each group of rows
+// advances by one vector multiply-add per column, with the input entries
+// gathered into a pack.
+template <typename ENTRY_T, typename COLUMN_T, typename X_PTR>
+void sell_chunk_matvec(
+    std::size_t C,
+    std::size_t width,
+    const ENTRY_T *entries,
+    const COLUMN_T *columns,
+    const X_PTR &x_ptr,
+    ENTRY_T *y
+) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    for (std::size_t l = 0; l < C; ++l) { y[l] = static_cast<ENTRY_T>(0); }
+    for (std::size_t j = 0; j < width; ++j) {
+        const ENTRY_T *e = entries + j * C;
+        const COLUMN_T *c = columns + j * C;
+        std::size_t l = 0;
+        for (; l + W <= C; l += W) {
+            ENTRY_T gathered[W];
+            for (std::size_t w = 0; w < W; ++w) {
+                gathered[w] = *x_ptr(c[l + w]);
+            }
+            fmadd(Pack::load(e + l), Pack::load(gathered), Pack::load(y + l))
+                .store(y + l);
+        }
+        for (; l < C; ++l) { y[l] = std::fma(e[l], *x_ptr(c[l]), y[l]); }
+    }
+}
+
+
+// y += A * x for one dense BLOCK_SIZE-by-BLOCK_SIZE block A, stored row by
+// row. Both loops are unrolled, so x and y live in registers.
+template <int BLOCK_SIZE, typename ENTRY_T>
+inline void dense_block_multiply_add(
+    const ENTRY_T *block, const ENTRY_T *x, ENTRY_T *y
+) {
+    LEGION_SOLVERS_UNROLL
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        LEGION_SOLVERS_UNROLL
+        for (int j = 0; j < BLOCK_SIZE; ++j) {
+            y[i] = std::fma(block[i * BLOCK_SIZE + j], x[j], y[i]);
+        }
+    }
+}
+
+
+// y = sum of block k times the input block of columns[k] for k in
+// [begin, end), where block k occupies blocks[k * BLOCK_SIZE * BLOCK_SIZE]
+// onwards and x_ptr(column, c) points to component c of an input block. One
+// column index is read per block rather than per entry, and the input blocks
+// of the blocks LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE entries ahead (up to
+// prefetch_end) are prefetched, as in sparse_row_dot.
+template <
+    int BLOCK_SIZE,
+    typename ENTRY_T,
+    typename COLUMN_T,
+    typename X_PTR>
+void bsr_row_multiply(
+    std::size_t begin,
+    std::size_t end,
+    std::size_t prefetch_end,
+    const ENTRY_T *blocks,
+    const COLUMN_T *columns,
+    const X_PTR &x_ptr,
+    ENTRY_T *y
+) {
+    constexpr std::size_t B = BLOCK_SIZE;
+    constexpr std::size_t D =
+        (LEGION_SOLVERS_SPARSE_PREFETCH_DISTANCE + B * B - 1) / (B * B);
+    LEGION_SOLVERS_UNROLL
+    for (std::size_t i = 0; i < B; ++i) { y[i] = static_cast<ENTRY_T>(0); }
+    for (std::size_t k = begin; k < end; ++k) {
+        if (k + D < prefetch_end) {
+            prefetch_for_read(x_ptr(columns[k + D], 0));
+        }
+        ENTRY_T x[B];
+        LEGION_SOLVERS_UNROLL
+        for (std::size_t j = 0; j < B; ++j) { x[j] = *x_ptr(columns[k], j); }
+        dense_block_multiply_add<BLOCK_SIZE>(blocks + k * B * B, x, y);
+    }
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SPARSE_KERNELS_HPP_INCLUDED
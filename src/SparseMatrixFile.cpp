@@ -0,0 +1,416 @@
+#include "SparseMatrixFile.hpp"
+
+#include <cassert> // for assert
+#include <cstdint> // for std::uint64_t
+#include <cstring> // for std::memcpy, std::memset
+#include <limits>  // for std::numeric_limits
+#include <map>     // for std::map
+
+#include <fcntl.h>    // for open, O_CREAT, O_RDONLY, O_WRONLY
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for close, ftruncate
+
+#include "LegionUtilities.hpp"       // for create_field_space
+#include "LibraryOptions.hpp"        // for LEGION_SOLVERS_MAPPER_ID
+#include "SELLMatrixTasks.hpp"       // for sell_extent
+#include "SparseMatrixFileTasks.hpp" // for SparseMatrixFileWriteTask
+
+using LegionSolvers::COOMatrix;
+using LegionSolvers::CSRMatrix;
+using LegionSolvers::SparseMatrixFileHeader;
+using LegionSolvers::SparseMatrixFilePiece;
+using LegionSolvers::SparseMatrixFileReader;
+using LegionSolvers::SparseMatrixFileWriteTask;
+using LegionSolvers::create_field_space;
+using LegionSolvers::is_sparse_matrix_file_header;
+using LegionSolvers::make_sparse_matrix_file_header;
+using LegionSolvers::sell_extent;
+using LegionSolvers::write_sparse_matrix_file_bytes;
+
+
+// The 1D extent [0, size), which must be addressable by COORD_T.
+template <typename COORD_T>
+Legion::Rect<1, COORD_T> sparse_matrix_file_extent(std::uint64_t size) {
+    assert(
+        size <= static_cast<std::uint64_t>(std::numeric_limits<COORD_T>::max())
+    );
+    return sell_extent(COORD_T{0}, size);
+}
+
+
+// The size of space, which must be a 1D interval [0, size).
+template <typename COORD_T>
+std::uint64_t sparse_matrix_file_dimension(
+    Legion::Context ctx, Legion::Runtime *rt, Legion::IndexSpace space
+) {
+    const Legion::Domain domain = rt->get_index_space_domain(ctx, space);
+    if (domain.empty()) { return 0; }
+    assert(domain.dense());
+    assert((domain.bounds<1, COORD_T>().lo[0] == 0));
+    return domain.get_volume();
+}
+
+
+// The first index of domain, which must be a nonempty 1D interval.
+template <typename COORD_T>
+std::uint64_t sparse_matrix_file_piece_start(const Legion::Domain &domain) {
+    assert(domain.dense());
+    return static_cast<std::uint64_t>(domain.bounds<1, COORD_T>().lo[0]);
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+void LegionSolvers::write_sparse_matrix_file(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::string &path,
+    const CSRMatrix<ENTRY_T, 1, COORD_T> &matrix
+) {
+    const std::uint64_t num_rows = sparse_matrix_file_dimension<COORD_T>(
+        ctx, rt, matrix.get_range_space()
+    );
+    const std::uint64_t num_cols = sparse_matrix_file_dimension<COORD_T>(
+        ctx, rt, matrix.get_domain_space()
+    );
+    const std::uint64_t num_nonzeros = sparse_matrix_file_dimension<COORD_T>(
+        ctx, rt, matrix.get_kernel_space()
+    );
+    const Legion::IndexPartition range_partition =
+        matrix.get_range_partition();
+    const Legion::IndexPartition kernel_partition =
+        matrix.get_kernel_partition();
+    const Legion::IndexSpace color_space =
+        rt->get_index_partition_color_space_name(ctx, range_partition);
+
+    // The partition hint: where each piece starts in the row and kernel
+    // spaces, which must be covered by the pieces in color order.
+    std::vector<SparseMatrixFilePiece> pieces;
+    std::uint64_t next_row = 0;
+    std::uint64_t next_nonzero = 0;
+    for (Legion::Domain::DomainPointIterator it(
+             rt->get_index_space_domain(ctx, color_space)
+         );
+         it;
+         ++it) {
+        const Legion::Domain rows = rt->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, range_partition, *it)
+        );
+        const Legion::Domain nonzeros = rt->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, kernel_partition, *it)
+        );
+        assert(
+            rows.empty() ||
+            (sparse_matrix_file_piece_start<COORD_T>(rows) == next_row)
+        );
+        assert(
+            nonzeros.empty() ||
+            (sparse_matrix_file_piece_start<COORD_T>(nonzeros) == next_nonzero)
+        );
+        pieces.push_back(SparseMatrixFilePiece{next_row, next_nonzero});
+        next_row += rows.get_volume();
+        next_nonzero += nonzeros.get_volume();
+    }
+    assert(next_row == num_rows);
+    assert(next_nonzero == num_nonzeros);
+    pieces.push_back(SparseMatrixFilePiece{num_rows, num_nonzeros});
+    const SparseMatrixFileHeader header =
+        make_sparse_matrix_file_header<ENTRY_T, COORD_T>(
+            num_rows, num_cols, num_nonzeros, pieces.size() - 1
+        );
+
+    // Size the file and blank its header, so that it is not recognized as
+    // a sparse matrix file until the header is written below.
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    assert(fd >= 0);
+    const int truncated =
+        ::ftruncate(fd, static_cast<off_t>(header.file_size));
+    assert(truncated == 0);
+    (void)truncated;
+    SparseMatrixFileHeader blank;
+    std::memset(&blank, 0, sizeof(SparseMatrixFileHeader));
+    write_sparse_matrix_file_bytes(fd, 0, &blank, sizeof(blank));
+    write_sparse_matrix_file_bytes(
+        fd,
+        header.piece_offset,
+        pieces.data(),
+        pieces.size() * sizeof(SparseMatrixFilePiece)
+    );
+    ::close(fd);
+
+    std::vector<char> args(sizeof(SparseMatrixFileHeader) + path.size());
+    std::memcpy(args.data(), &header, sizeof(SparseMatrixFileHeader));
+    std::memcpy(
+        args.data() + sizeof(SparseMatrixFileHeader), path.data(), path.size()
+    );
+    Legion::IndexLauncher launcher{
+        SparseMatrixFileWriteTask<ENTRY_T, 1, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{args.data(), args.size()},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    const Legion::LogicalRegion rowptr_region = matrix.get_rowptr_region();
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            rowptr_region})
+        .add_field(matrix.get_fid_rowptr());
+    const Legion::LogicalRegion kernel_region = matrix.get_kernel_region();
+    const Legion::LogicalPartition kernel_logical_partition =
+        rt->get_logical_partition(ctx, kernel_region, kernel_partition);
+    for (const Legion::FieldID fid :
+         {matrix.get_fid_col(), matrix.get_fid_entry()}) {
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                kernel_logical_partition,
+                0,
+                LEGION_READ_ONLY,
+                LEGION_EXCLUSIVE,
+                kernel_region})
+            .add_field(fid);
+    }
+    rt->execute_index_space(ctx, launcher).wait_all_results();
+
+    const int header_fd = ::open(path.c_str(), O_WRONLY);
+    assert(header_fd >= 0);
+    write_sparse_matrix_file_bytes(header_fd, 0, &header, sizeof(header));
+    ::close(header_fd);
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+SparseMatrixFileReader<ENTRY_T, COORD_T>::SparseMatrixFileReader(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::string &path,
+    std::size_t num_pieces
+)
+    : ctx(ctx), rt(rt) {
+    using Index = Legion::Point<1, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    assert(fd >= 0);
+    struct stat status;
+    const int stat_result = ::fstat(fd, &status);
+    assert(stat_result == 0);
+    (void)stat_result;
+    mapping_size = static_cast<std::size_t>(status.st_size);
+    assert(mapping_size >= sizeof(SparseMatrixFileHeader));
+    mapping = ::mmap(
+        nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0
+    );
+    assert(mapping != MAP_FAILED);
+    ::close(fd);
+    char *const data = static_cast<char *>(mapping);
+    std::memcpy(&header, data, sizeof(SparseMatrixFileHeader));
+    assert((
+        is_sparse_matrix_file_header<ENTRY_T, COORD_T>(header, mapping_size)
+    ));
+
+    range_space = rt->create_index_space(
+        ctx, sparse_matrix_file_extent<COORD_T>(header.num_rows)
+    );
+    domain_space = (header.num_cols == header.num_rows)
+                     ? range_space
+                     : rt->create_index_space(
+                           ctx,
+                           sparse_matrix_file_extent<COORD_T>(header.num_cols)
+                       );
+    kernel_space = rt->create_index_space(
+        ctx, sparse_matrix_file_extent<COORD_T>(header.num_nonzeros)
+    );
+    kernel_field_space = create_field_space(
+        ctx,
+        rt,
+        {sizeof(Index), sizeof(Index), sizeof(ENTRY_T)},
+        {ROW_FID, COL_FID, ENTRY_FID}
+    );
+    kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    rowptr_field_space =
+        create_field_space(ctx, rt, {sizeof(RowExtent)}, {ROWPTR_FID});
+    rowptr_region =
+        rt->create_logical_region(ctx, range_space, rowptr_field_space);
+
+    // Unrestricted, so that Legion may copy the data wherever the mapping
+    // is not visible, and unmapped, since *this never accesses it.
+    const auto attach = [&](Legion::LogicalRegion region,
+                            Legion::FieldID fid,
+                            std::uint64_t offset,
+                            std::uint64_t size) {
+        if (size == 0) { return; }
+        Legion::AttachLauncher launcher{
+            LEGION_EXTERNAL_INSTANCE, region, region, false, false};
+        launcher.attach_array_soa(data + offset, true, {fid});
+        attachments.push_back(rt->attach_external_resource(ctx, launcher));
+    };
+    attach(rowptr_region, ROWPTR_FID, header.rowptr_offset, header.num_rows);
+    attach(kernel_region, ROW_FID, header.row_offset, header.num_nonzeros);
+    attach(kernel_region, COL_FID, header.col_offset, header.num_nonzeros);
+    attach(kernel_region, ENTRY_FID, header.entry_offset, header.num_nonzeros);
+
+    if (num_pieces == 0) {
+        const SparseMatrixFilePiece *const pieces =
+            reinterpret_cast<const SparseMatrixFilePiece *>(
+                data + header.piece_offset
+            );
+        assert(pieces[0].first_row == 0);
+        assert(pieces[0].first_nonzero == 0);
+        assert(pieces[header.num_pieces].first_row == header.num_rows);
+        assert(pieces[header.num_pieces].first_nonzero == header.num_nonzeros);
+        color_space = rt->create_index_space(
+            ctx,
+            Legion::Rect<1>{
+                0, static_cast<Legion::coord_t>(header.num_pieces) - 1}
+        );
+        std::map<Legion::DomainPoint, Legion::Domain> range_pieces;
+        std::map<Legion::DomainPoint, Legion::Domain> kernel_pieces;
+        std::size_t p = 0;
+        for (Legion::Domain::DomainPointIterator it(
+                 rt->get_index_space_domain(ctx, color_space)
+             );
+             it;
+             ++it, ++p) {
+            const SparseMatrixFilePiece &first = pieces[p];
+            const SparseMatrixFilePiece &last = pieces[p + 1];
+            assert(first.first_row <= last.first_row);
+            assert(first.first_nonzero <= last.first_nonzero);
+            range_pieces[*it] = sell_extent(
+                static_cast<COORD_T>(first.first_row),
+                last.first_row - first.first_row
+            );
+            kernel_pieces[*it] = sell_extent(
+                static_cast<COORD_T>(first.first_nonzero),
+                last.first_nonzero - first.first_nonzero
+            );
+        }
+        range_partition = rt->create_partition_by_domain(
+            ctx,
+            range_space,
+            range_pieces,
+            color_space,
+            true,
+            LEGION_DISJOINT_COMPLETE_KIND
+        );
+        kernel_partition = rt->create_partition_by_domain(
+            ctx,
+            kernel_space,
+            kernel_pieces,
+            color_space,
+            true,
+            LEGION_DISJOINT_COMPLETE_KIND
+        );
+    } else {
+        color_space = rt->create_index_space(
+            ctx,
+            Legion::Rect<1>{0, static_cast<Legion::coord_t>(num_pieces) - 1}
+        );
+        range_partition =
+            rt->create_equal_partition(ctx, range_space, color_space);
+        kernel_partition = rt->create_partition_by_image_range(
+            ctx,
+            kernel_space,
+            rt->get_logical_partition(ctx, rowptr_region, range_partition),
+            rowptr_region,
+            ROWPTR_FID,
+            color_space
+        );
+    }
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+SparseMatrixFileReader<ENTRY_T, COORD_T>::~SparseMatrixFileReader() {
+    // The mapping must outlive the attachments, which are not flushed back:
+    // it is private, so there is nowhere for changes to go.
+    std::vector<Legion::Future> detached;
+    for (const Legion::PhysicalRegion &attachment : attachments) {
+        detached.push_back(
+            rt->detach_external_resource(ctx, attachment, false)
+        );
+    }
+    for (const Legion::Future &future : detached) { future.get_void_result(); }
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_index_partition(ctx, range_partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    if (domain_space != range_space) {
+        rt->destroy_index_space(ctx, domain_space);
+    }
+    rt->destroy_index_space(ctx, range_space);
+    ::munmap(mapping, mapping_size);
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+std::unique_ptr<CSRMatrix<ENTRY_T, 1, COORD_T>>
+SparseMatrixFileReader<ENTRY_T, COORD_T>::make_csr_matrix() const {
+    return std::make_unique<CSRMatrix<ENTRY_T, 1, COORD_T>>(
+        ctx,
+        rt,
+        kernel_region,
+        COL_FID,
+        ENTRY_FID,
+        rowptr_region,
+        ROWPTR_FID,
+        domain_space,
+        range_partition
+    );
+}
+
+
+template <typename ENTRY_T, typename COORD_T>
+std::unique_ptr<COOMatrix<ENTRY_T, 1, COORD_T>>
+SparseMatrixFileReader<ENTRY_T, COORD_T>::make_coo_matrix() const {
+    return std::make_unique<COOMatrix<ENTRY_T, 1, COORD_T>>(
+        ctx,
+        rt,
+        kernel_region,
+        ROW_FID,
+        COL_FID,
+        ENTRY_FID,
+        domain_space,
+        range_space,
+        kernel_partition
+    );
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<float, int>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<float, 1, int> &);
+        template class LegionSolvers::SparseMatrixFileReader<float, int>;
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<float, unsigned>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<float, 1, unsigned> &);
+        template class LegionSolvers::SparseMatrixFileReader<float, unsigned>;
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<float, long long>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<float, 1, long long> &);
+        template class LegionSolvers::SparseMatrixFileReader<float, long long>;
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<double, int>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<double, 1, int> &);
+        template class LegionSolvers::SparseMatrixFileReader<double, int>;
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<double, unsigned>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<double, 1, unsigned> &);
+        template class LegionSolvers::SparseMatrixFileReader<double, unsigned>;
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template void LegionSolvers::write_sparse_matrix_file<double, long long>(Legion::Context, Legion::Runtime *, const std::string &, const CSRMatrix<double, 1, long long> &);
+        template class LegionSolvers::SparseMatrixFileReader<double, long long>;
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,133 @@
+#ifndef LEGION_SOLVERS_SPARSE_MATRIX_FILE_HPP_INCLUDED
+#define LEGION_SOLVERS_SPARSE_MATRIX_FILE_HPP_INCLUDED
+
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <string>  // for std::string
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "COOMatrix.hpp"              // for COOMatrix
+#include "CSRMatrix.hpp"              // for CSRMatrix
+#include "SparseMatrixFileFormat.hpp" // for SparseMatrixFileHeader
+
+namespace LegionSolvers {
+
+
+// Writes matrix to a binary sparse matrix file at path (see
+// SparseMatrixFileFormat.hpp), replacing any existing file, with the pieces
+// of its range partition as partition hint. Each piece is written in
+// parallel by a SparseMatrixFileWriteTask that streams it from the regions
+// of the matrix; the header is written last, once all pieces are complete,
+// so that an interrupted write leaves a file that readers reject.
+//
+// The kernel, range, and domain spaces of matrix must be [0, num_nonzeros),
+// [0, num_rows), and [0, num_cols), and the pieces of its range partition
+// consecutive intervals of rows in color order, as they are for an equal
+// partition; matrices assembled by MatrixMarketReader satisfy all of these.
+template <typename ENTRY_T, typename COORD_T>
+void write_sparse_matrix_file(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const std::string &path,
+    const CSRMatrix<ENTRY_T, 1, COORD_T> &matrix
+);
+
+
+// A sparse matrix loaded from a binary sparse matrix file without parsing
+// or copying: the file is memory-mapped, and each of its arrays is attached
+// as the instance of one field of the regions owned by the reader, with the
+// same field IDs as MatrixMarketReader. Loading thus costs one header check
+// and the dependent partitioning below; the arrays are faulted in from the
+// page cache by the first tasks that read them. Tasks that run where the
+// mapping is not visible, e.g., on GPUs or other nodes, read copies that
+// Legion makes from the attached instances as usual.
+//
+// The mapping is private (copy-on-write), so tasks that modify the regions
+// never modify the file. The regions stay attached, and the file mapped,
+// until the reader is destroyed.
+//
+// By default, the rows are partitioned as in the partition hint of the
+// file, which costs no dependent partitioning at all. With num_pieces > 0,
+// they are partitioned into num_pieces equal pieces instead, and the
+// nonzeros by image of the row pointers.
+template <typename ENTRY_T, typename COORD_T>
+class SparseMatrixFileReader {
+
+  public:
+
+    static constexpr Legion::FieldID ROW_FID = 0;
+    static constexpr Legion::FieldID COL_FID = 1;
+    static constexpr Legion::FieldID ENTRY_FID = 2;
+    static constexpr Legion::FieldID ROWPTR_FID = 0;
+
+  private:
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    void *mapping;
+    std::size_t mapping_size;
+    SparseMatrixFileHeader header;
+    Legion::IndexSpace range_space;
+    Legion::IndexSpace domain_space;
+    Legion::IndexSpace kernel_space;
+    Legion::IndexSpace color_space;
+    Legion::FieldSpace kernel_field_space;
+    Legion::LogicalRegion kernel_region;
+    Legion::FieldSpace rowptr_field_space;
+    Legion::LogicalRegion rowptr_region;
+    std::vector<Legion::PhysicalRegion> attachments;
+    Legion::IndexPartition range_partition;
+    Legion::IndexPartition kernel_partition;
+
+  public:
+
+    explicit SparseMatrixFileReader(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        const std::string &path,
+        std::size_t num_pieces = 0
+    );
+
+    SparseMatrixFileReader(const SparseMatrixFileReader &) = delete;
+
+    SparseMatrixFileReader &operator=(const SparseMatrixFileReader &) = delete;
+
+    ~SparseMatrixFileReader();
+
+    const SparseMatrixFileHeader &get_header() const { return header; }
+
+    std::size_t get_num_nonzeros() const { return header.num_nonzeros; }
+
+    Legion::IndexSpace get_range_space() const { return range_space; }
+
+    Legion::IndexSpace get_domain_space() const { return domain_space; }
+
+    Legion::IndexSpace get_color_space() const { return color_space; }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    // Nonzeros of the rows of each piece of the range partition.
+    Legion::IndexPartition get_kernel_partition() const {
+        return kernel_partition;
+    }
+
+    Legion::LogicalRegion get_kernel_region() const { return kernel_region; }
+
+    Legion::LogicalRegion get_rowptr_region() const { return rowptr_region; }
+
+    // The matrix as a CSRMatrix or COOMatrix over the regions of *this,
+    // which must outlive it.
+    std::unique_ptr<CSRMatrix<ENTRY_T, 1, COORD_T>> make_csr_matrix() const;
+
+    std::unique_ptr<COOMatrix<ENTRY_T, 1, COORD_T>> make_coo_matrix() const;
+
+}; // class SparseMatrixFileReader
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SPARSE_MATRIX_FILE_HPP_INCLUDED
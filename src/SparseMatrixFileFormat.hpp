@@ -0,0 +1,171 @@
+#ifndef LEGION_SOLVERS_SPARSE_MATRIX_FILE_FORMAT_HPP_INCLUDED
+#define LEGION_SOLVERS_SPARSE_MATRIX_FILE_FORMAT_HPP_INCLUDED
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <cstring> // for std::memcmp, std::memcpy, std::memset
+#include <string>  // for std::string
+
+#include <unistd.h> // for pwrite
+
+#include <legion.h> // for Legion::*
+
+#include "MetaprogrammingUtilities.hpp" // for ToString
+
+namespace LegionSolvers {
+
+
+// A binary sparse matrix file holds a matrix over the 1D row space
+// [0, num_rows) and column space [0, num_cols) in the in-memory layout of
+// the library's regions, so that it can be attached without conversion:
+//
+//   header    SparseMatrixFileHeader
+//   pieces    num_pieces + 1 SparseMatrixFilePiece
+//   rowptr    num_rows Rect<1, COORD_T>, as for CSRMatrix
+//   row       num_nonzeros Point<1, COORD_T>, as for COOMatrix
+//   col       num_nonzeros Point<1, COORD_T>
+//   entry     num_nonzeros ENTRY_T
+//
+// The nonzeros are in row-major order, so the file holds the matrix in CSR
+// and in COO form at once. Each array starts at a multiple of
+// SPARSE_MATRIX_FILE_ALIGNMENT, so that it is page-aligned when the file is
+// memory-mapped. The pieces are a partition hint: the first row and first
+// nonzero of each piece of the row partition the file was written from,
+// followed by num_rows and num_nonzeros.
+//
+// Numbers are stored in the byte order of the writer, which readers check
+// with byte_order. Files of another version, byte order, or entry or index
+// type (as named by ToString) are rejected rather than converted.
+
+
+constexpr char SPARSE_MATRIX_FILE_MAGIC[8] = {
+    'L', 'S', 'S', 'P', 'M', 'A', 'T', '\n'};
+
+constexpr std::uint32_t SPARSE_MATRIX_FILE_VERSION = 1;
+
+constexpr std::uint32_t SPARSE_MATRIX_FILE_BYTE_ORDER = 0x01020304;
+
+constexpr std::uint64_t SPARSE_MATRIX_FILE_ALIGNMENT = 4'096;
+
+
+struct SparseMatrixFilePiece {
+    std::uint64_t first_row;
+    std::uint64_t first_nonzero;
+}; // struct SparseMatrixFilePiece
+
+
+struct SparseMatrixFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    char entry_type[16]; // ToString<ENTRY_T>::value(), NUL-padded
+    char coord_type[16]; // ToString<COORD_T>::value(), NUL-padded
+    std::uint64_t entry_size;
+    std::uint64_t coord_size;
+    std::uint64_t num_rows;
+    std::uint64_t num_cols;
+    std::uint64_t num_nonzeros;
+    std::uint64_t num_pieces;
+    std::uint64_t piece_offset;
+    std::uint64_t rowptr_offset;
+    std::uint64_t row_offset;
+    std::uint64_t col_offset;
+    std::uint64_t entry_offset;
+    std::uint64_t file_size;
+}; // struct SparseMatrixFileHeader
+
+
+inline std::uint64_t sparse_matrix_file_align(std::uint64_t offset) {
+    return (offset + SPARSE_MATRIX_FILE_ALIGNMENT - 1) /
+           SPARSE_MATRIX_FILE_ALIGNMENT * SPARSE_MATRIX_FILE_ALIGNMENT;
+}
+
+
+inline void set_sparse_matrix_file_tag(char (&tag)[16], const std::string &s) {
+    assert(s.size() < sizeof(tag));
+    std::memset(tag, 0, sizeof(tag));
+    std::memcpy(tag, s.data(), s.size());
+}
+
+
+// The header of the file of a matrix with the given dimensions, with the
+// offsets of its arrays laid out as above.
+template <typename ENTRY_T, typename COORD_T>
+SparseMatrixFileHeader make_sparse_matrix_file_header(
+    std::uint64_t num_rows,
+    std::uint64_t num_cols,
+    std::uint64_t num_nonzeros,
+    std::uint64_t num_pieces
+) {
+    SparseMatrixFileHeader header;
+    std::memset(&header, 0, sizeof(SparseMatrixFileHeader));
+    std::memcpy(header.magic, SPARSE_MATRIX_FILE_MAGIC, sizeof(header.magic));
+    header.version = SPARSE_MATRIX_FILE_VERSION;
+    header.byte_order = SPARSE_MATRIX_FILE_BYTE_ORDER;
+    set_sparse_matrix_file_tag(header.entry_type, ToString<ENTRY_T>::value());
+    set_sparse_matrix_file_tag(header.coord_type, ToString<COORD_T>::value());
+    header.entry_size = sizeof(ENTRY_T);
+    header.coord_size = sizeof(COORD_T);
+    header.num_rows = num_rows;
+    header.num_cols = num_cols;
+    header.num_nonzeros = num_nonzeros;
+    header.num_pieces = num_pieces;
+    header.piece_offset = sparse_matrix_file_align(sizeof(header));
+    header.rowptr_offset = sparse_matrix_file_align(
+        header.piece_offset + (num_pieces + 1) * sizeof(SparseMatrixFilePiece)
+    );
+    header.row_offset = sparse_matrix_file_align(
+        header.rowptr_offset + num_rows * sizeof(Legion::Rect<1, COORD_T>)
+    );
+    header.col_offset = sparse_matrix_file_align(
+        header.row_offset + num_nonzeros * sizeof(Legion::Point<1, COORD_T>)
+    );
+    header.entry_offset = sparse_matrix_file_align(
+        header.col_offset + num_nonzeros * sizeof(Legion::Point<1, COORD_T>)
+    );
+    header.file_size = header.entry_offset + num_nonzeros * sizeof(ENTRY_T);
+    return header;
+}
+
+
+// Whether header, read from a file of file_size bytes, is that of a file
+// written by this version of the library, on a machine of the same byte
+// order, for the given entry and index types: the header that the writer
+// would have made for the same dimensions.
+template <typename ENTRY_T, typename COORD_T>
+bool is_sparse_matrix_file_header(
+    const SparseMatrixFileHeader &header, std::uint64_t file_size
+) {
+    if (header.num_pieces == 0) { return false; }
+    const SparseMatrixFileHeader expected =
+        make_sparse_matrix_file_header<ENTRY_T, COORD_T>(
+            header.num_rows,
+            header.num_cols,
+            header.num_nonzeros,
+            header.num_pieces
+        );
+    return (std::memcmp(&header, &expected, sizeof(header)) == 0) &&
+           (header.file_size == file_size);
+}
+
+
+// Writes size bytes from data at offset in the file open for writing as fd.
+inline void write_sparse_matrix_file_bytes(
+    int fd, std::uint64_t offset, const void *data, std::size_t size
+) {
+    const char *p = static_cast<const char *>(data);
+    while (size > 0) {
+        const ssize_t count =
+            ::pwrite(fd, p, size, static_cast<off_t>(offset));
+        assert(count > 0);
+        p += count;
+        offset += static_cast<std::uint64_t>(count);
+        size -= static_cast<std::size_t>(count);
+    }
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SPARSE_MATRIX_FILE_FORMAT_HPP_INCLUDED
@@ -0,0 +1,182 @@
+#include "SparseMatrixFileTasks.hpp"
+
+#include <algorithm> // for std::max, std::min
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint64_t
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+
+#include <fcntl.h>  // for open, O_WRONLY
+#include <unistd.h> // for close
+
+#include "LegionUtilities.hpp"        // for AffineReader
+#include "LibraryOptions.hpp"         // for LEGION_SOLVERS_SPARSE_MATRIX_*
+#include "SparseMatrixFileFormat.hpp" // for SparseMatrixFileHeader, ...
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE;
+using LegionSolvers::SparseMatrixFileHeader;
+using LegionSolvers::SparseMatrixFileWriteTask;
+using LegionSolvers::write_sparse_matrix_file_bytes;
+
+
+inline const SparseMatrixFileHeader &
+sparse_matrix_file_header(const Legion::Task *task) {
+    assert(task->arglen > sizeof(SparseMatrixFileHeader));
+    return *static_cast<const SparseMatrixFileHeader *>(task->args);
+}
+
+
+inline std::string sparse_matrix_file_path(const Legion::Task *task) {
+    return std::string{
+        static_cast<const char *>(task->args) + sizeof(SparseMatrixFileHeader),
+        task->arglen - sizeof(SparseMatrixFileHeader)};
+}
+
+
+// Writes count values of type T, produced in order by next(), to the array
+// of the file open as fd that starts at offset, in blocks of at most
+// LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE bytes.
+template <typename T, typename F>
+void write_sparse_matrix_file_array(
+    int fd, std::uint64_t offset, std::uint64_t count, const F &next
+) {
+    const std::uint64_t block_size = std::max<std::uint64_t>(
+        LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE / sizeof(T), 1
+    );
+    std::vector<T> buffer;
+    buffer.reserve(
+        static_cast<std::size_t>(std::min<std::uint64_t>(block_size, count))
+    );
+    for (std::uint64_t i = 0; i < count; i += buffer.size()) {
+        buffer.clear();
+        const std::uint64_t size =
+            std::min<std::uint64_t>(block_size, count - i);
+        for (std::uint64_t j = 0; j < size; ++j) { buffer.push_back(next()); }
+        write_sparse_matrix_file_bytes(
+            fd, offset + i * sizeof(T), buffer.data(), buffer.size() * sizeof(T)
+        );
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void SparseMatrixFileWriteTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using Index = Legion::Point<DIM, COORD_T>;
+    using KernelIndex = Legion::Point<1, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+
+    assert(regions.size() == 3);
+    assert(task->regions.size() == 3);
+    std::vector<Legion::FieldID> fids;
+    for (const auto &requirement : task->regions) {
+        assert(requirement.privilege_fields.size() == 1);
+        fids.push_back(*requirement.privilege_fields.begin());
+    }
+    AffineReader<RowExtent, DIM, COORD_T> rowptr_reader{regions[0], fids[0]};
+    AffineReader<Index, 1, COORD_T> col_reader{regions[1], fids[1]};
+    AffineReader<ENTRY_T, 1, COORD_T> entry_reader{regions[2], fids[2]};
+
+    const SparseMatrixFileHeader &header = sparse_matrix_file_header(task);
+    const Legion::Domain range_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    const Legion::Domain kernel_domain = rt->get_index_space_domain(
+        ctx, task->regions[1].region.get_index_space()
+    );
+    if (range_domain.empty()) {
+        assert(kernel_domain.empty());
+        return;
+    }
+    assert(range_domain.dense());
+    assert(kernel_domain.empty() || kernel_domain.dense());
+    const Legion::Rect<DIM, COORD_T> rows = range_domain.bounds<DIM, COORD_T>();
+    const COORD_T first_row = rows.lo[0];
+    const COORD_T first_nonzero =
+        kernel_domain.empty() ? COORD_T{0}
+                              : kernel_domain.bounds<1, COORD_T>().lo[0];
+    const std::uint64_t row_base = static_cast<std::uint64_t>(first_row);
+    const std::uint64_t kernel_base =
+        static_cast<std::uint64_t>(first_nonzero);
+    const std::uint64_t num_rows = range_domain.get_volume();
+    const std::uint64_t num_nonzeros = kernel_domain.get_volume();
+
+    const int fd = ::open(sparse_matrix_file_path(task).c_str(), O_WRONLY);
+    assert(fd >= 0);
+
+    COORD_T row = first_row;
+    write_sparse_matrix_file_array<RowExtent>(
+        fd,
+        header.rowptr_offset + row_base * sizeof(RowExtent),
+        num_rows,
+        [&]() { return rowptr_reader[Index{row++}]; }
+    );
+
+    // Row indices are not stored by CSRMatrix; they are recovered from the
+    // row pointers, skipping empty rows.
+    row = first_row;
+    std::uint64_t remaining = rowptr_reader[Index{row}].volume();
+    write_sparse_matrix_file_array<Index>(
+        fd,
+        header.row_offset + kernel_base * sizeof(Index),
+        num_nonzeros,
+        [&]() {
+            while (remaining == 0) {
+                ++row;
+                assert(row <= rows.hi[0]);
+                remaining = rowptr_reader[Index{row}].volume();
+            }
+            --remaining;
+            return Index{row};
+        }
+    );
+
+    COORD_T k = first_nonzero;
+    write_sparse_matrix_file_array<Index>(
+        fd,
+        header.col_offset + kernel_base * sizeof(Index),
+        num_nonzeros,
+        [&]() { return col_reader[KernelIndex{k++}]; }
+    );
+    k = first_nonzero;
+    write_sparse_matrix_file_array<ENTRY_T>(
+        fd,
+        header.entry_offset + kernel_base * sizeof(ENTRY_T),
+        num_nonzeros,
+        [&]() { return entry_reader[KernelIndex{k++}]; }
+    );
+
+    ::close(fd);
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template void SparseMatrixFileWriteTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template void SparseMatrixFileWriteTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template void SparseMatrixFileWriteTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        template void SparseMatrixFileWriteTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        template void SparseMatrixFileWriteTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        template void SparseMatrixFileWriteTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,55 @@
+#ifndef LEGION_SOLVERS_SPARSE_MATRIX_FILE_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_SPARSE_MATRIX_FILE_TASKS_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for SPARSE_MATRIX_FILE_WRITE_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Writes the rows of one piece of a CSR matrix into a binary sparse matrix
+// file (see SparseMatrixFileFormat.hpp) that write_sparse_matrix_file has
+// already created with its final size: their row pointers, and the row
+// indices, column indices, and entries of their nonzeros, each streamed
+// through a buffer of LEGION_SOLVERS_SPARSE_MATRIX_FILE_WRITE_SIZE bytes.
+// Regions are row pointers (range piece), column indices, and entries
+// (kernel piece), all read-only. The nonzeros of the piece must be the
+// consecutive kernel points of its consecutive rows.
+//
+// Defined for DIM = 1 only, and registered by preregister_1d_tdi_tasks. The
+// task argument is the SparseMatrixFileHeader of the file followed by its
+// path, without terminator.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct SparseMatrixFileWriteTask
+    : public TaskTDI<
+          SPARSE_MATRIX_FILE_WRITE_TASK_BLOCK_ID,
+          SparseMatrixFileWriteTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "sparse_matrix_file_write";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct SparseMatrixFileWriteTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_SPARSE_MATRIX_FILE_TASKS_HPP_INCLUDED
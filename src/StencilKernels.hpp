@@ -0,0 +1,90 @@
+#ifndef LEGION_SOLVERS_STENCIL_KERNELS_HPP_INCLUDED
+#define LEGION_SOLVERS_STENCIL_KERNELS_HPP_INCLUDED
+
+#include <cmath>   // for std::fma
+#include <cstddef> // for std::size_t, std::ptrdiff_t
+
+#include "SIMDUtilities.hpp" // for SIMDPack, LEGION_SOLVERS_UNROLL
+
+namespace LegionSolvers {
+
+
+// y[i] = sum over stencil points s of coefficients[s] * x[i + offsets[s]]
+// for i in [0, n), where offsets are in units of entries. Consecutive points
+// are computed SIMDPack<ENTRY_T>::width at a time from unaligned loads of the
+// shifted input lines, with the coefficients broadcast once per line; the
+// loop over stencil points is unrolled.
+template <int NUM_POINTS, typename ENTRY_T>
+void constant_stencil_line(
+    std::size_t n,
+    ENTRY_T *y,
+    const ENTRY_T *x,
+    const std::ptrdiff_t *offsets,
+    const ENTRY_T *coefficients
+) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    Pack c[NUM_POINTS];
+    LEGION_SOLVERS_UNROLL
+    for (int s = 0; s < NUM_POINTS; ++s) {
+        c[s] = Pack::broadcast(coefficients[s]);
+    }
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        Pack sum = Pack::zero();
+        LEGION_SOLVERS_UNROLL
+        for (int s = 0; s < NUM_POINTS; ++s) {
+            sum = fmadd(c[s], Pack::load(x + i + offsets[s]), sum);
+        }
+        sum.store(y + i);
+    }
+    for (; i < n; ++i) {
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        LEGION_SOLVERS_UNROLL
+        for (int s = 0; s < NUM_POINTS; ++s) {
+            sum = std::fma(coefficients[s], x[i + offsets[s]], sum);
+        }
+        y[i] = sum;
+    }
+}
+
+
+// As constant_stencil_line, with per-point coefficients: the coefficient of
+// stencil point s at point i is coefficients[s][i].
+template <int NUM_POINTS, typename ENTRY_T>
+void variable_stencil_line(
+    std::size_t n,
+    ENTRY_T *y,
+    const ENTRY_T *x,
+    const std::ptrdiff_t *offsets,
+    const ENTRY_T *const *coefficients
+) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        Pack sum = Pack::zero();
+        LEGION_SOLVERS_UNROLL
+        for (int s = 0; s < NUM_POINTS; ++s) {
+            sum = fmadd(
+                Pack::load(coefficients[s] + i),
+                Pack::load(x + i + offsets[s]),
+                sum
+            );
+        }
+        sum.store(y + i);
+    }
+    for (; i < n; ++i) {
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        LEGION_SOLVERS_UNROLL
+        for (int s = 0; s < NUM_POINTS; ++s) {
+            sum = std::fma(coefficients[s][i], x[i + offsets[s]], sum);
+        }
+        y[i] = sum;
+    }
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_STENCIL_KERNELS_HPP_INCLUDED
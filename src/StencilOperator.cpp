@@ -0,0 +1,336 @@
+#include "StencilOperator.hpp"
+
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <map>     // for std::map
+#include <vector>  // for std::vector
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*, ...
+#include "TaskIDs.hpp"        // for LEGION_REDOP_SUM
+
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::StencilApplyTask;
+using LegionSolvers::StencilArgs;
+using LegionSolvers::StencilOperator;
+using LegionSolvers::StencilTransposeApplyTask;
+using LegionSolvers::stencil_mirror;
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+StencilOperator<ENTRY_T, DIM, COORD_T>::StencilOperator(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexSpace grid_space,
+    Legion::IndexPartition range_partition,
+    StencilShape shape,
+    const std::vector<ENTRY_T> &coefficients
+)
+    : ctx(ctx), rt(rt), grid_space(grid_space),
+      grid(rt->get_index_space_domain(ctx, grid_space).bounds<DIM, COORD_T>()
+      ),
+      range_partition(range_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, range_partition)
+      ),
+      coefficient_region(Legion::LogicalRegion::NO_REGION), args{},
+      halo_partition(resize_partition(grid_space, range_partition, true)) {
+    assert(rt->get_parent_index_space(ctx, range_partition) == grid_space);
+    assert(
+        static_cast<int>(coefficients.size()) == stencil_size(shape, DIM)
+    );
+    args.shape = shape;
+    args.variable = false;
+    for (std::size_t s = 0; s < coefficients.size(); ++s) {
+        args.coefficients[s] = coefficients[s];
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+StencilOperator<ENTRY_T, DIM, COORD_T>::StencilOperator(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::IndexSpace grid_space,
+    Legion::IndexPartition range_partition,
+    StencilShape shape,
+    Legion::LogicalRegion coefficient_region,
+    const std::vector<Legion::FieldID> &coefficient_fids
+)
+    : ctx(ctx), rt(rt), grid_space(grid_space),
+      grid(rt->get_index_space_domain(ctx, grid_space).bounds<DIM, COORD_T>()
+      ),
+      range_partition(range_partition),
+      color_space(
+          rt->get_index_partition_color_space_name(ctx, range_partition)
+      ),
+      coefficient_region(coefficient_region), args{},
+      halo_partition(resize_partition(grid_space, range_partition, true)) {
+    assert(rt->get_parent_index_space(ctx, range_partition) == grid_space);
+    assert(coefficient_region.get_index_space() == grid_space);
+    assert(
+        static_cast<int>(coefficient_fids.size()) == stencil_size(shape, DIM)
+    );
+    args.shape = shape;
+    args.variable = true;
+    for (std::size_t s = 0; s < coefficient_fids.size(); ++s) {
+        args.coefficient_fids[s] = coefficient_fids[s];
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+StencilOperator<ENTRY_T, DIM, COORD_T>::~StencilOperator() {
+    rt->destroy_index_partition(ctx, halo_partition);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition
+StencilOperator<ENTRY_T, DIM, COORD_T>::resize_partition(
+    Legion::IndexSpace space, Legion::IndexPartition partition, bool grow
+) const {
+    const Legion::IndexSpace colors =
+        rt->get_index_partition_color_space_name(ctx, partition);
+    std::map<Legion::DomainPoint, Legion::Domain> pieces;
+    const Legion::Domain color_domain =
+        rt->get_index_space_domain(ctx, colors);
+    for (Legion::Domain::DomainPointIterator it(color_domain); it; ++it) {
+        const Legion::Domain piece = rt->get_index_space_domain(
+            ctx, rt->get_index_subspace(ctx, partition, *it)
+        );
+        Legion::Rect<DIM, COORD_T> rect = piece.bounds<DIM, COORD_T>();
+        if (!piece.empty()) {
+            // Compare before stepping, so that unsigned coordinates at the
+            // grid boundary do not wrap around.
+            for (int d = 0; d < DIM; ++d) {
+                if (rect.lo[d] > grid.lo[d]) {
+                    rect.lo[d] = static_cast<COORD_T>(
+                        grow ? rect.lo[d] - 1 : rect.lo[d] + 1
+                    );
+                }
+                if (rect.hi[d] < grid.hi[d]) {
+                    rect.hi[d] = static_cast<COORD_T>(
+                        grow ? rect.hi[d] + 1 : rect.hi[d] - 1
+                    );
+                }
+            }
+        }
+        pieces[*it] = rect;
+    }
+    return rt->create_partition_by_domain(
+        ctx, space, pieces, colors, true, LEGION_COMPUTE_KIND
+    );
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition StencilOperator<ENTRY_T, DIM, COORD_T>::
+    domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const {
+    assert(domain_space == grid_space);
+    return resize_partition(domain_space, range_partition, true);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+Legion::IndexPartition StencilOperator<ENTRY_T, DIM, COORD_T>::
+    range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const {
+    assert(range_space == grid_space);
+    return resize_partition(range_space, domain_partition, false);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilOperator<ENTRY_T, DIM, COORD_T>::apply(
+    const StencilArgs<ENTRY_T> &stencil,
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    assert(output_region.get_index_space() == grid_space);
+    assert(input_region.get_index_space() == grid_space);
+    Legion::IndexLauncher launcher{
+        StencilApplyTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&stencil, sizeof(StencilArgs<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, range_partition),
+            0,
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, halo_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    if (stencil.variable) { add_coefficient_requirement(launcher); }
+    rt->execute_index_space(ctx, launcher);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilOperator<ENTRY_T, DIM, COORD_T>::add_coefficient_requirement(
+    Legion::IndexLauncher &launcher
+) const {
+    const int num_points = get_num_points();
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(
+                ctx, coefficient_region, range_partition
+            ),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            coefficient_region})
+        .add_fields(std::vector<Legion::FieldID>{
+            args.coefficient_fids, args.coefficient_fids + num_points});
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilOperator<ENTRY_T, DIM, COORD_T>::matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    apply(args, output_region, output_fid, input_region, input_fid);
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilOperator<ENTRY_T, DIM, COORD_T>::transpose_matvec(
+    Legion::LogicalRegion output_region,
+    Legion::FieldID output_fid,
+    Legion::LogicalRegion input_region,
+    Legion::FieldID input_fid
+) const {
+    if (!args.variable) {
+        StencilArgs<ENTRY_T> transposed = args;
+        const int num_points = get_num_points();
+        for (int s = 0; s < num_points; ++s) {
+            transposed.coefficients[s] =
+                args.coefficients[stencil_mirror(args.shape, DIM, s)];
+        }
+        apply(transposed, output_region, output_fid, input_region, input_fid);
+        return;
+    }
+    assert(output_region.get_index_space() == grid_space);
+    assert(input_region.get_index_space() == grid_space);
+    rt->fill_field<ENTRY_T>(
+        ctx,
+        output_region,
+        output_region,
+        output_fid,
+        static_cast<ENTRY_T>(0)
+    );
+    Legion::IndexLauncher launcher{
+        StencilTransposeApplyTask<ENTRY_T, DIM, COORD_T>::task_id,
+        color_space,
+        Legion::TaskArgument{&args, sizeof(StencilArgs<ENTRY_T>)},
+        Legion::ArgumentMap{}};
+    launcher.map_id = LEGION_SOLVERS_MAPPER_ID;
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, output_region, halo_partition),
+            0,
+            LEGION_REDOP_SUM<ENTRY_T>,
+            LEGION_EXCLUSIVE,
+            output_region})
+        .add_field(output_fid);
+    launcher
+        .add_region_requirement(Legion::RegionRequirement{
+            rt->get_logical_partition(ctx, input_region, range_partition),
+            0,
+            LEGION_READ_ONLY,
+            LEGION_EXCLUSIVE,
+            input_region})
+        .add_field(input_fid);
+    add_coefficient_requirement(launcher);
+    rt->execute_index_space(ctx, launcher);
+}
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<float, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<float, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<float, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<float, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<float, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<float, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<float, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<float, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<float, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<double, 1, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<double, 2, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<double, 3, int>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<double, 1, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<double, 2, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<double, 3, unsigned>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template class LegionSolvers::StencilOperator<double, 1, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template class LegionSolvers::StencilOperator<double, 2, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template class LegionSolvers::StencilOperator<double, 3, long long>;
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
@@ -0,0 +1,133 @@
+#ifndef LEGION_SOLVERS_STENCIL_OPERATOR_HPP_INCLUDED
+#define LEGION_SOLVERS_STENCIL_OPERATOR_HPP_INCLUDED
+
+#include <vector> // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AbstractLinearOperator.hpp" // for AbstractLinearOperator
+#include "StencilOperatorTasks.hpp"   // for StencilShape, StencilArgs
+
+namespace LegionSolvers {
+
+
+// A matrix-free linear operator on a structured grid, the index space
+// grid_space, given by a STAR or BOX stencil (see stencil_offset) whose
+// coefficients are either constant or stored per grid point in fields of a
+// coefficient region over grid_space. Neighbours outside the grid are
+// treated as zero, i.e., the operator has homogeneous Dirichlet boundary
+// conditions. Nothing is assembled: each product reads the input vector and
+// the coefficients (if any) once.
+//
+// Products are computed over an application-supplied partition of the grid.
+// The input is read through a halo partition whose pieces are the bounding
+// boxes of the range pieces grown by one point in every dimension (and
+// clipped to the grid), so pieces that are not boxes read more input than
+// they need.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+class StencilOperator : public AbstractLinearOperator<ENTRY_T> {
+
+    const Legion::Context ctx;
+    Legion::Runtime *const rt;
+    const Legion::IndexSpace grid_space;
+    const Legion::Rect<DIM, COORD_T> grid;
+    const Legion::IndexPartition range_partition;
+    const Legion::IndexSpace color_space;
+    const Legion::LogicalRegion coefficient_region;
+    StencilArgs<ENTRY_T> args;
+    const Legion::IndexPartition halo_partition;
+
+    // Partitions space (a subspace of the grid) by the bounding boxes of the
+    // pieces of partition, grown (or shrunk) by one point in every dimension
+    // away from the grid boundary.
+    Legion::IndexPartition resize_partition(
+        Legion::IndexSpace space, Legion::IndexPartition partition, bool grow
+    ) const;
+
+    // Launches one StencilApplyTask per piece of the range partition.
+    void apply(
+        const StencilArgs<ENTRY_T> &stencil,
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const;
+
+    // Adds the coefficients over the range partition to launcher.
+    void add_coefficient_requirement(Legion::IndexLauncher &launcher) const;
+
+  public:
+
+    explicit StencilOperator(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::IndexSpace grid_space,
+        Legion::IndexPartition range_partition,
+        StencilShape shape,
+        const std::vector<ENTRY_T> &coefficients
+    );
+
+    explicit StencilOperator(
+        Legion::Context ctx,
+        Legion::Runtime *rt,
+        Legion::IndexSpace grid_space,
+        Legion::IndexPartition range_partition,
+        StencilShape shape,
+        Legion::LogicalRegion coefficient_region,
+        const std::vector<Legion::FieldID> &coefficient_fids
+    );
+
+    StencilOperator(const StencilOperator &) = delete;
+
+    StencilOperator &operator=(const StencilOperator &) = delete;
+
+    virtual ~StencilOperator();
+
+    Legion::IndexSpace get_grid_space() const { return grid_space; }
+
+    int get_num_points() const { return stencil_size(args.shape, DIM); }
+
+    const StencilArgs<ENTRY_T> &get_stencil_args() const { return args; }
+
+    Legion::IndexPartition get_range_partition() const {
+        return range_partition;
+    }
+
+    Legion::IndexPartition get_domain_partition() const {
+        return halo_partition;
+    }
+
+    // Neighbourhoods of the pieces of range_partition.
+    virtual Legion::IndexPartition domain_partition_from_range_partition(
+        Legion::IndexSpace domain_space, Legion::IndexPartition range_partition
+    ) const override;
+
+    // Points whose neighbourhoods lie in the pieces of domain_partition.
+    virtual Legion::IndexPartition range_partition_from_domain_partition(
+        Legion::IndexSpace range_space, Legion::IndexPartition domain_partition
+    ) const override;
+
+    virtual void matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+    // With constant coefficients, applies the mirrored stencil (see
+    // stencil_mirror) as matvec does. With variable coefficients, zeroes
+    // output and scatters each range piece into its halo piece by
+    // StencilTransposeApplyTask.
+    virtual void transpose_matvec(
+        Legion::LogicalRegion output_region,
+        Legion::FieldID output_fid,
+        Legion::LogicalRegion input_region,
+        Legion::FieldID input_fid
+    ) const override;
+
+}; // class StencilOperator
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_STENCIL_OPERATOR_HPP_INCLUDED
@@ -0,0 +1,464 @@
+#include "StencilOperatorTasks.hpp"
+
+#include <algorithm> // for std::max, std::min
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t, std::ptrdiff_t
+#include <vector>    // for std::vector
+
+#include "LegionUtilities.hpp" // for AffineReader, AffineWriter, ...
+#include "LibraryOptions.hpp"  // for LEGION_SOLVERS_STENCIL_*, ...
+#include "StencilKernels.hpp"  // for constant_stencil_line, ...
+#include "TaskIDs.hpp"         // for LEGION_REDOP_SUM
+#include "VectorKernels.hpp"   // for for_each_thread_range
+
+using LegionSolvers::AffineReader;
+using LegionSolvers::AffineSumAccessor;
+using LegionSolvers::AffineWriter;
+using LegionSolvers::constant_stencil_line;
+using LegionSolvers::for_each_thread_range;
+using LegionSolvers::is_omp_processor;
+using LegionSolvers::LEGION_REDOP_SUM;
+using LegionSolvers::LEGION_SOLVERS_DOT_BLOCK_SIZE;
+using LegionSolvers::LEGION_SOLVERS_MAX_STENCIL_SIZE;
+using LegionSolvers::LEGION_SOLVERS_STENCIL_LINE_BLOCK;
+using LegionSolvers::LEGION_SOLVERS_STENCIL_TILE_HEIGHT;
+using LegionSolvers::stencil_offset;
+using LegionSolvers::stencil_size;
+using LegionSolvers::StencilApplyTask;
+using LegionSolvers::StencilArgs;
+using LegionSolvers::StencilTransposeApplyTask;
+using LegionSolvers::variable_stencil_line;
+
+
+// The accessors and stencil of one StencilApplyTask, and the two ways of
+// applying the stencil to a rect of output points: point by point with
+// neighbours checked against the grid bounds, and, for rects whose
+// neighbours all lie in the grid, line by line on raw pointers.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct StencilPiece {
+
+    using Point = Legion::Point<DIM, COORD_T>;
+    using Rect = Legion::Rect<DIM, COORD_T>;
+
+    const StencilArgs<ENTRY_T> args;
+    const int num_points;
+    Rect grid;
+    int offsets[LEGION_SOLVERS_MAX_STENCIL_SIZE][DIM];
+    AffineWriter<ENTRY_T, DIM, COORD_T> output;
+    AffineReader<ENTRY_T, DIM, COORD_T> input;
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> coefficients;
+
+    explicit StencilPiece(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    )
+        : args(*static_cast<const StencilArgs<ENTRY_T> *>(task->args)),
+          num_points(stencil_size(args.shape, DIM)),
+          output(regions[0], *task->regions[0].privilege_fields.begin()),
+          input(regions[1], *task->regions[1].privilege_fields.begin()) {
+        assert(task->regions[0].privilege_fields.size() == 1);
+        assert(task->regions[1].privilege_fields.size() == 1);
+        grid = rt->get_index_space_domain(
+                     ctx, task->regions[1].parent.get_index_space()
+        )
+                   .bounds<DIM, COORD_T>();
+        for (int s = 0; s < num_points; ++s) {
+            for (int d = 0; d < DIM; ++d) {
+                offsets[s][d] = stencil_offset(args.shape, s, d);
+            }
+        }
+        if (args.variable) {
+            assert(regions.size() == 3);
+            for (int s = 0; s < num_points; ++s) {
+                coefficients.emplace_back(
+                    regions[2], args.coefficient_fids[s]
+                );
+            }
+        } else {
+            assert(regions.size() == 2);
+        }
+    }
+
+    ENTRY_T coefficient(int s, const Point &p) const {
+        return args.variable ? coefficients[s][p] : args.coefficients[s];
+    }
+
+    void apply_point(const Point &p) const {
+        ENTRY_T sum = static_cast<ENTRY_T>(0);
+        for (int s = 0; s < num_points; ++s) {
+            Point q;
+            bool inside = true;
+            for (int d = 0; d < DIM; ++d) {
+                const long long c =
+                    static_cast<long long>(p[d]) + offsets[s][d];
+                if ((c < static_cast<long long>(grid.lo[d])) ||
+                    (c > static_cast<long long>(grid.hi[d]))) {
+                    inside = false;
+                    break;
+                }
+                q[d] = static_cast<COORD_T>(c);
+            }
+            if (inside) { sum += coefficient(s, p) * input[q]; }
+        }
+        output[p] = sum;
+    }
+
+    void apply_points(const Rect &rect) const {
+        for (Legion::PointInRectIterator<DIM, COORD_T> it(rect); it(); ++it) {
+            apply_point(*it);
+        }
+    }
+
+    // Whether every instance is contiguous along the first dimension, so
+    // that lines of points can be passed to the stencil kernels.
+    bool has_unit_line_stride() const {
+        constexpr std::size_t E = sizeof(ENTRY_T);
+        bool result = (output.accessor.strides[0] == E) &&
+                      (input.accessor.strides[0] == E);
+        for (const auto &c : coefficients) {
+            result = result && (c.accessor.strides[0] == E);
+        }
+        return result;
+    }
+
+    // Applies the stencil to a rect whose neighbours all lie in the grid.
+    // The rect is cut into tiles of LEGION_SOLVERS_STENCIL_LINE_BLOCK points
+    // along the first dimension by LEGION_SOLVERS_STENCIL_TILE_HEIGHT lines
+    // along the second, and each tile is swept through the remaining
+    // dimensions, so that the input planes it reuses stay in cache. Tiles
+    // are distributed among threads.
+    template <int NUM_POINTS>
+    void apply_interior(const Rect &rect, bool parallel) const {
+        constexpr std::size_t LB = LEGION_SOLVERS_STENCIL_LINE_BLOCK;
+        constexpr std::size_t TH = LEGION_SOLVERS_STENCIL_TILE_HEIGHT;
+        constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+        constexpr std::size_t E = sizeof(ENTRY_T);
+
+        // Extents, and strides in entries, padded with an empty dimension so
+        // that dimension 1 exists.
+        std::size_t extent[DIM + 1];
+        extent[DIM] = 1;
+        std::ptrdiff_t y_stride[DIM + 1] = {};
+        std::ptrdiff_t x_stride[DIM + 1] = {};
+        std::ptrdiff_t c_stride[NUM_POINTS][DIM + 1] = {};
+        for (int d = 0; d < DIM; ++d) {
+            extent[d] = static_cast<std::size_t>(rect.hi[d] - rect.lo[d]) + 1;
+            y_stride[d] = output.accessor.strides[d] / E;
+            x_stride[d] = input.accessor.strides[d] / E;
+            if (args.variable) {
+                for (int s = 0; s < NUM_POINTS; ++s) {
+                    c_stride[s][d] = coefficients[s].accessor.strides[d] / E;
+                }
+            }
+        }
+        std::ptrdiff_t x_offsets[NUM_POINTS];
+        for (int s = 0; s < NUM_POINTS; ++s) {
+            x_offsets[s] = 0;
+            for (int d = 0; d < DIM; ++d) {
+                x_offsets[s] += offsets[s][d] * x_stride[d];
+            }
+        }
+        ENTRY_T *const y0 = output.ptr(rect.lo);
+        const ENTRY_T *const x0 = input.ptr(rect.lo);
+        const ENTRY_T *c0[NUM_POINTS] = {};
+        if (args.variable) {
+            for (int s = 0; s < NUM_POINTS; ++s) {
+                c0[s] = coefficients[s].ptr(rect.lo);
+            }
+        }
+
+        const std::size_t n1 = extent[1];
+        std::size_t num_planes = 1;
+        for (int d = 2; d < DIM; ++d) { num_planes *= extent[d]; }
+        const std::size_t tiles0 = (extent[0] + LB - 1) / LB;
+        const std::size_t tiles1 = (n1 + TH - 1) / TH;
+
+        // for_each_thread_range splits its range at multiples of B, so
+        // scaling the number of tiles by B hands each thread whole tiles.
+        for_each_thread_range(
+            parallel,
+            tiles0 * tiles1 * B,
+            [&](int, std::size_t begin, std::size_t end) {
+                for (std::size_t t = begin / B; t < end / B; ++t) {
+                    const std::size_t i = (t % tiles0) * LB;
+                    const std::size_t n = std::min(LB, extent[0] - i);
+                    const std::size_t j_begin = (t / tiles0) * TH;
+                    const std::size_t j_end = std::min(n1, j_begin + TH);
+                    for (std::size_t k = 0; k < num_planes; ++k) {
+                        std::ptrdiff_t y_base = i;
+                        std::ptrdiff_t x_base = i;
+                        std::ptrdiff_t c_base[NUM_POINTS];
+                        for (int s = 0; s < NUM_POINTS; ++s) {
+                            c_base[s] = i;
+                        }
+                        std::size_t rest = k;
+                        for (int d = 2; d < DIM; ++d) {
+                            const std::ptrdiff_t r = rest % extent[d];
+                            rest /= extent[d];
+                            y_base += r * y_stride[d];
+                            x_base += r * x_stride[d];
+                            for (int s = 0; s < NUM_POINTS; ++s) {
+                                c_base[s] += r * c_stride[s][d];
+                            }
+                        }
+                        for (std::size_t j = j_begin; j < j_end; ++j) {
+                            const std::ptrdiff_t jj = j;
+                            ENTRY_T *y = y0 + y_base + jj * y_stride[1];
+                            const ENTRY_T *x = x0 + x_base + jj * x_stride[1];
+                            if (args.variable) {
+                                const ENTRY_T *c[NUM_POINTS];
+                                for (int s = 0; s < NUM_POINTS; ++s) {
+                                    c[s] = c0[s] + c_base[s] +
+                                           jj * c_stride[s][1];
+                                }
+                                variable_stencil_line<NUM_POINTS>(
+                                    n, y, x, x_offsets, c
+                                );
+                            } else {
+                                constant_stencil_line<NUM_POINTS>(
+                                    n, y, x, x_offsets, args.coefficients
+                                );
+                            }
+                        }
+                    }
+                }
+            }
+        );
+    }
+
+    // Applies the stencil to the points of rect. The interior, whose
+    // neighbours all lie in the grid, goes to apply_interior; the points
+    // outside it form at most 2 * DIM slabs, handled point by point.
+    void apply(const Rect &rect, bool parallel) const {
+        long long lo[DIM];
+        long long hi[DIM];
+        bool has_interior = has_unit_line_stride();
+        for (int d = 0; d < DIM; ++d) {
+            lo[d] = std::max(
+                static_cast<long long>(rect.lo[d]),
+                static_cast<long long>(grid.lo[d]) + 1
+            );
+            hi[d] = std::min(
+                static_cast<long long>(rect.hi[d]),
+                static_cast<long long>(grid.hi[d]) - 1
+            );
+            has_interior = has_interior && (lo[d] <= hi[d]);
+        }
+        if (!has_interior) {
+            apply_points(rect);
+            return;
+        }
+        Rect interior;
+        for (int d = 0; d < DIM; ++d) {
+            interior.lo[d] = static_cast<COORD_T>(lo[d]);
+            interior.hi[d] = static_cast<COORD_T>(hi[d]);
+        }
+        switch (num_points) {
+            case 3: apply_interior<3>(interior, parallel); break;
+            case 5: apply_interior<5>(interior, parallel); break;
+            case 7: apply_interior<7>(interior, parallel); break;
+            case 9: apply_interior<9>(interior, parallel); break;
+            case 27: apply_interior<27>(interior, parallel); break;
+            default: assert(false);
+        }
+        // Slab (d, side) holds the points of rect whose coordinates below
+        // dimension d lie in the interior and whose coordinate d lies on
+        // that side of it. Interior bounds exceed the grid bounds by one, so
+        // interior.lo[d] - 1 does not wrap around.
+        for (int d = 0; d < DIM; ++d) {
+            Rect slab = rect;
+            for (int e = 0; e < d; ++e) {
+                slab.lo[e] = interior.lo[e];
+                slab.hi[e] = interior.hi[e];
+            }
+            slab.hi[d] = static_cast<COORD_T>(interior.lo[d] - 1);
+            apply_points(slab);
+            slab.lo[d] = static_cast<COORD_T>(interior.hi[d] + 1);
+            slab.hi[d] = rect.hi[d];
+            apply_points(slab);
+        }
+    }
+
+}; // struct StencilPiece
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilApplyTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() >= 2);
+    assert(task->regions.size() == regions.size());
+    assert(task->arglen == sizeof(StencilArgs<ENTRY_T>));
+
+    const StencilPiece<ENTRY_T, DIM, COORD_T> piece{task, regions, ctx, rt};
+    const bool parallel = is_omp_processor(ctx, rt);
+
+    const Legion::Domain output_domain = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    using RectIterator = Legion::RectInDomainIterator<DIM, COORD_T>;
+    for (RectIterator rect_iter(output_domain); rect_iter(); ++rect_iter) {
+        const Legion::Rect<DIM, COORD_T> rect = *rect_iter;
+        if (rect.empty()) { continue; }
+        piece.apply(rect, parallel);
+    }
+}
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void StencilTransposeApplyTask<ENTRY_T, DIM, COORD_T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 3);
+    assert(task->regions.size() == 3);
+    assert(task->arglen == sizeof(StencilArgs<ENTRY_T>));
+    const StencilArgs<ENTRY_T> &args =
+        *static_cast<const StencilArgs<ENTRY_T> *>(task->args);
+    assert(args.variable);
+    const int num_points = stencil_size(args.shape, DIM);
+
+    assert(task->regions[0].privilege_fields.size() == 1);
+    assert(task->regions[1].privilege_fields.size() == 1);
+    AffineSumAccessor<ENTRY_T, DIM, COORD_T> output{
+        regions[0],
+        *task->regions[0].privilege_fields.begin(),
+        LEGION_REDOP_SUM<ENTRY_T>};
+    AffineReader<ENTRY_T, DIM, COORD_T> input{
+        regions[1], *task->regions[1].privilege_fields.begin()};
+    std::vector<AffineReader<ENTRY_T, DIM, COORD_T>> coefficients;
+    for (int s = 0; s < num_points; ++s) {
+        coefficients.emplace_back(regions[2], args.coefficient_fids[s]);
+    }
+
+    const Legion::Rect<DIM, COORD_T> grid =
+        rt->get_index_space_domain(
+              ctx, task->regions[0].parent.get_index_space()
+        )
+            .bounds<DIM, COORD_T>();
+    const Legion::Domain input_domain = rt->get_index_space_domain(
+        ctx, task->regions[1].region.get_index_space()
+    );
+
+    // Scattering is bound by the reductions, which go to a halo piece shared
+    // with neighbouring pieces, so points are simply visited in order.
+    using PointIterator = Legion::PointInDomainIterator<DIM, COORD_T>;
+    for (PointIterator it(input_domain); it(); ++it) {
+        const Legion::Point<DIM, COORD_T> p = *it;
+        const ENTRY_T x = input[p];
+        for (int s = 0; s < num_points; ++s) {
+            Legion::Point<DIM, COORD_T> q;
+            bool inside = true;
+            for (int d = 0; d < DIM; ++d) {
+                const long long c = static_cast<long long>(p[d]) +
+                                    stencil_offset(args.shape, s, d);
+                if ((c < static_cast<long long>(grid.lo[d])) ||
+                    (c > static_cast<long long>(grid.hi[d]))) {
+                    inside = false;
+                    break;
+                }
+                q[d] = static_cast<COORD_T>(c);
+            }
+            if (inside) { output.reduce(q, coefficients[s][p] * x); }
+        }
+    }
+}
+
+
+// clang-format off
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<float, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    #ifdef LEGION_SOLVERS_USE_S32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 1, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 2, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 3, int>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S32_INDICES
+    #ifdef LEGION_SOLVERS_USE_U32_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 1, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 2, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 3, unsigned>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_U32_INDICES
+    #ifdef LEGION_SOLVERS_USE_S64_INDICES
+        #if LEGION_SOLVERS_MAX_DIM >= 1
+            template void StencilApplyTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 1, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 1
+        #if LEGION_SOLVERS_MAX_DIM >= 2
+            template void StencilApplyTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 2, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 2
+        #if LEGION_SOLVERS_MAX_DIM >= 3
+            template void StencilApplyTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+            template void StencilTransposeApplyTask<double, 3, long long>::task_body(const Legion::Task *, const std::vector<Legion::PhysicalRegion> &, Legion::Context, Legion::Runtime *);
+        #endif // LEGION_SOLVERS_MAX_DIM >= 3
+    #endif // LEGION_SOLVERS_USE_S64_INDICES
+#endif // LEGION_SOLVERS_USE_DOUBLE
+// clang-format on
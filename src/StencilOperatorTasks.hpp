@@ -0,0 +1,145 @@
+#ifndef LEGION_SOLVERS_STENCIL_OPERATOR_TASKS_HPP_INCLUDED
+#define LEGION_SOLVERS_STENCIL_OPERATOR_TASKS_HPP_INCLUDED
+
+#include <cstdint> // for std::uint8_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "LegionUtilities.hpp" // for TaskFlags
+#include "TaskBaseClasses.hpp" // for TaskTDI
+#include "TaskIDs.hpp"         // for STENCIL_*_TASK_BLOCK_ID
+
+namespace LegionSolvers {
+
+
+// Neighbourhoods of structured-grid stencils. STAR stencils couple each point
+// to itself and its 2 * DIM face neighbours (3, 5, or 7 points); BOX stencils
+// couple it to all 3^DIM points at distance at most one in every dimension
+// (3, 9, or 27 points).
+enum class StencilShape : std::uint8_t {
+    STAR,
+    BOX,
+}; // enum class StencilShape
+
+
+constexpr int LEGION_SOLVERS_MAX_STENCIL_SIZE = 27;
+
+
+constexpr int stencil_size(StencilShape shape, int dim) {
+    if (shape == StencilShape::STAR) { return 2 * dim + 1; }
+    int result = 1;
+    for (int d = 0; d < dim; ++d) { result *= 3; }
+    return result;
+}
+
+
+// Component d (-1, 0, or +1) of the offset of stencil point s. STAR points
+// are ordered center, -e_0, +e_0, -e_1, +e_1, ...; BOX points are ordered
+// with the offset in the first dimension varying fastest, so that component
+// d of point s is the d-th base-3 digit of s minus one.
+constexpr int stencil_offset(StencilShape shape, int s, int d) {
+    if (shape == StencilShape::STAR) {
+        if ((s == 0) || ((s - 1) / 2 != d)) { return 0; }
+        return ((s - 1) % 2 == 0) ? -1 : +1;
+    }
+    for (int k = 0; k < d; ++k) { s /= 3; }
+    return s % 3 - 1;
+}
+
+
+// Stencil point with the opposite offset of point s. The transpose of a
+// stencil with constant coefficients is the stencil whose point s has the
+// coefficient of point stencil_mirror(shape, dim, s).
+constexpr int stencil_mirror(StencilShape shape, int dim, int s) {
+    if (shape == StencilShape::STAR) {
+        if (s == 0) { return 0; }
+        return ((s - 1) % 2 == 0) ? s + 1 : s - 1;
+    }
+    return stencil_size(shape, dim) - 1 - s;
+}
+
+
+// Task argument of StencilApplyTask. Coefficients are listed in stencil
+// point order (see stencil_offset). If variable is false, coefficients[s] is
+// the coefficient of point s everywhere; otherwise, it is read from field
+// coefficient_fids[s] of the coefficient region at each output point.
+template <typename ENTRY_T>
+struct StencilArgs {
+    StencilShape shape;
+    bool variable;
+    ENTRY_T coefficients[LEGION_SOLVERS_MAX_STENCIL_SIZE];
+    Legion::FieldID coefficient_fids[LEGION_SOLVERS_MAX_STENCIL_SIZE];
+}; // struct StencilArgs
+
+
+// Computes output = A * input for one piece of a structured grid, where A
+// is the stencil described by a StencilArgs<ENTRY_T> task argument and
+// neighbours outside the grid (the index space of the parent region of the
+// input) are treated as zero. Regions are output (write-discard, range
+// piece), input (read-only, a piece containing the neighbours of the range
+// piece), and, for variable coefficients, the coefficients (read-only, range
+// piece, all coefficient fields).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct StencilApplyTask
+    : public TaskTDI<
+          STENCIL_APPLY_TASK_BLOCK_ID,
+          StencilApplyTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "stencil_apply";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct StencilApplyTask
+
+
+// Adds A^T * input to output for one piece of a structured grid, where A is
+// a stencil with variable coefficients described by a StencilArgs<ENTRY_T>
+// task argument: each input point scatters its value, times the
+// coefficients stored at that point, to its neighbours in the grid (the
+// index space of the parent region of the output). Regions are output
+// (reduction by LEGION_REDOP_SUM<ENTRY_T>, a piece containing the
+// neighbours of the range piece), input (read-only, range piece), and the
+// coefficients (read-only, range piece, all coefficient fields).
+template <typename ENTRY_T, int DIM, typename COORD_T>
+struct StencilTransposeApplyTask
+    : public TaskTDI<
+          STENCIL_TRANSPOSE_APPLY_TASK_BLOCK_ID,
+          StencilTransposeApplyTask,
+          ENTRY_T,
+          DIM,
+          COORD_T> {
+
+    static constexpr const char *task_base_name = "stencil_transpose_apply";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = void;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct StencilTransposeApplyTask
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_STENCIL_OPERATOR_TASKS_HPP_INCLUDED
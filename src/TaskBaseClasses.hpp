@@ -137,6 +137,23 @@ struct TaskTDI {
         );
     }
 
+#ifdef LEGION_SOLVERS_USE_OPENMP
+    // Registers task_body as an OMP_PROC variant of the same task. Task
+    // bodies that support it parallelize their dense loops across the
+    // threads of the executing OpenMP processor.
+    static void preregister_omp(bool verbose) {
+        preregister_task<
+            typename TaskClass<T, N, I>::return_type,
+            TaskClass<T, N, I>::task_body>(
+            task_id,
+            task_name(),
+            TaskClass<T, N, I>::flags,
+            verbose,
+            Legion::Processor::OMP_PROC
+        );
+    }
+#endif // LEGION_SOLVERS_USE_OPENMP
+
     // static void announce_cpu(Legion::Context ctx, Legion::Runtime *rt) {
     //     const Legion::Processor proc = rt->get_executing_processor(ctx);
     //     std::cout << "[LegionSolvers] Running CPU task " << task_name()
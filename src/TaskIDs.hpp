@@ -3,6 +3,8 @@
 
 #include <legion.h> // for Legion::*
 
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_REDOP_ID_ORIGIN
+
 namespace LegionSolvers {
 
 
@@ -17,6 +19,50 @@ enum TaskBlockID : Legion::TaskID {
     AXPY_TASK_BLOCK_ID,
     XPAY_TASK_BLOCK_ID,
     DOT_TASK_BLOCK_ID,
+    AXPY_DOT_TASK_BLOCK_ID,
+    XPAY_AXPY_TASK_BLOCK_ID,
+    MULTI_UPDATE_DOT_TASK_BLOCK_ID,
+    UNPACK_SCALAR_TASK_BLOCK_ID,
+    EVALUATE_SCALAR_PROGRAM_TASK_BLOCK_ID,
+    CSR_MATVEC_TASK_BLOCK_ID,
+    COO_MATVEC_TASK_BLOCK_ID,
+    SELL_SIZE_TASK_BLOCK_ID,
+    SELL_FILL_TASK_BLOCK_ID,
+    SELL_MATVEC_TASK_BLOCK_ID,
+    BSR_EXTENT_TASK_BLOCK_ID,
+    BSR_MATVEC_TASK_BLOCK_ID,
+    STENCIL_APPLY_TASK_BLOCK_ID,
+    LINEAR_COMBINATION_TASK_BLOCK_ID,
+    CSR_MATRIX_POWERS_TASK_BLOCK_ID,
+    SSTEP_CG_COEFFICIENTS_TASK_BLOCK_ID,
+    GMRES_LEAST_SQUARES_TASK_BLOCK_ID,
+    CSR_TRANSPOSE_MATVEC_TASK_BLOCK_ID,
+    BSR_TRANSPOSE_MATVEC_TASK_BLOCK_ID,
+    STENCIL_TRANSPOSE_APPLY_TASK_BLOCK_ID,
+    LSQR_STEP_TASK_BLOCK_ID,
+    BLOCK_JACOBI_FACTOR_TASK_BLOCK_ID,
+    BLOCK_JACOBI_APPLY_TASK_BLOCK_ID,
+    AMG_AGGREGATE_TASK_BLOCK_ID,
+    AMG_PROLONGATOR_TASK_BLOCK_ID,
+    AMG_GALERKIN_SIZE_TASK_BLOCK_ID,
+    AMG_GALERKIN_FILL_TASK_BLOCK_ID,
+    AMG_PROLONG_TASK_BLOCK_ID,
+    AMG_RESTRICT_TASK_BLOCK_ID,
+    AMG_COARSE_FACTOR_TASK_BLOCK_ID,
+    AMG_COARSE_SOLVE_TASK_BLOCK_ID,
+    GMG_RESTRICT_TASK_BLOCK_ID,
+    GMG_PROLONG_TASK_BLOCK_ID,
+    CONVERT_TASK_BLOCK_ID,
+    AXPY_CONVERT_TASK_BLOCK_ID,
+    CSR_MATMAT_TASK_BLOCK_ID,
+    BLOCK_DOT_TASK_BLOCK_ID,
+    BLOCK_UPDATE_TASK_BLOCK_ID,
+    BLOCK_SOLVE_TASK_BLOCK_ID,
+    MATRIX_MARKET_COUNT_TASK_BLOCK_ID,
+    MATRIX_MARKET_READ_TASK_BLOCK_ID,
+    MATRIX_MARKET_SIZE_TASK_BLOCK_ID,
+    MATRIX_MARKET_FILL_TASK_BLOCK_ID,
+    SPARSE_MATRIX_FILE_WRITE_TASK_BLOCK_ID,
 }; // enum TaskBlockID
 
 
@@ -30,6 +76,26 @@ constexpr Legion::ReductionOpID LEGION_REDOP_SUM<double> =
     LEGION_REDOP_SUM_FLOAT64;
 
 
+template <typename T>
+constexpr Legion::ReductionOpID PACKED_SUM_REDOP_ID = -1;
+template <>
+constexpr Legion::ReductionOpID PACKED_SUM_REDOP_ID<float> =
+    LEGION_SOLVERS_REDOP_ID_ORIGIN;
+template <>
+constexpr Legion::ReductionOpID PACKED_SUM_REDOP_ID<double> =
+    LEGION_SOLVERS_REDOP_ID_ORIGIN + 1;
+
+
+template <typename T>
+constexpr Legion::ReductionOpID BLOCK_SUM_REDOP_ID = -1;
+template <>
+constexpr Legion::ReductionOpID BLOCK_SUM_REDOP_ID<float> =
+    LEGION_SOLVERS_REDOP_ID_ORIGIN + 2;
+template <>
+constexpr Legion::ReductionOpID BLOCK_SUM_REDOP_ID<double> =
+    LEGION_SOLVERS_REDOP_ID_ORIGIN + 3;
+
+
 // enum ProjectionFunctorID : Legion::ProjectionID {
 //     PFID_KDR_TO_K = LEGION_SOLVERS_PROJECTION_ID_ORIGIN,
 //     PFID_KDR_TO_D,
@@ -1,11 +1,127 @@
 #ifndef LEGION_SOLVERS_TASK_REGISTRATION_HPP_INCLUDED
 #define LEGION_SOLVERS_TASK_REGISTRATION_HPP_INCLUDED
 
-#include "UtilityTasks.hpp" // for *ScalarTask
+#include "AMGPreconditionerTasks.hpp"         // for AMG*Task
+#include "BSRMatrixTasks.hpp"                 // for BSRMatvecTask, ...
+#include "BlockJacobiPreconditionerTasks.hpp" // for BlockJacobi*Task
+#include "COOMatrixTasks.hpp"                 // for COOMatvecTask
+#include "CSRMatrixTasks.hpp"                 // for CSRMatvecTask, ...
+#include "GMGPreconditionerTasks.hpp"         // for GMG*Task
+#include "GMRESSolverTasks.hpp"               // for GMRESLeastSquaresTask
+#include "LSQRSolverTasks.hpp"                // for LSQRStepTask
+#include "LibraryOptions.hpp"                 // for LEGION_SOLVERS_USE_*
+#include "LinearAlgebraTasks.hpp"             // for ScalTask, AxpyTask, ...
+#include "MatrixMarketReaderTasks.hpp"        // for MatrixMarket*Task
+#include "MultiVectorTasks.hpp"               // for Block*Task
+#include "PackedScalars.hpp"                  // for PackedSumReduction, ...
+#include "SELLMatrixTasks.hpp"                // for SELLMatvecTask, ...
+#include "SStepCGSolverTasks.hpp"             // for SStepCGCoefficientsTask
+#include "SparseMatrixFileTasks.hpp"          // for SparseMatrixFileWriteTask
+#include "StencilOperatorTasks.hpp"           // for StencilApplyTask, ...
+#include "TaskIDs.hpp"                        // for PACKED_SUM_REDOP_ID, ...
+#include "UtilityTasks.hpp"                   // for *ScalarTask
 
 namespace LegionSolvers {
 
 
+template <
+    template <typename, int, typename>
+    typename TaskClass,
+    typename ENTRY_T,
+    int DIM,
+    typename COORD_T>
+void preregister_tdi_tasks_for_dim(bool verbose, bool omp) {
+    TaskClass<ENTRY_T, DIM, COORD_T>::preregister_cpu(verbose);
+#ifdef LEGION_SOLVERS_USE_OPENMP
+    if (omp) { TaskClass<ENTRY_T, DIM, COORD_T>::preregister_omp(verbose); }
+#endif // LEGION_SOLVERS_USE_OPENMP
+}
+
+
+template <
+    template <typename, int, typename>
+    typename TaskClass,
+    typename ENTRY_T,
+    typename COORD_T>
+void preregister_tdi_tasks_for_coord(bool verbose, bool omp) {
+#if LEGION_SOLVERS_MAX_DIM >= 1
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 1, COORD_T>(verbose, omp);
+#endif // LEGION_SOLVERS_MAX_DIM >= 1
+#if LEGION_SOLVERS_MAX_DIM >= 2
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 2, COORD_T>(verbose, omp);
+#endif // LEGION_SOLVERS_MAX_DIM >= 2
+#if LEGION_SOLVERS_MAX_DIM >= 3
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 3, COORD_T>(verbose, omp);
+#endif // LEGION_SOLVERS_MAX_DIM >= 3
+}
+
+
+template <
+    template <typename, int, typename>
+    typename TaskClass,
+    typename ENTRY_T>
+void preregister_tdi_tasks_for_entry(bool verbose, bool omp) {
+#ifdef LEGION_SOLVERS_USE_S32_INDICES
+    preregister_tdi_tasks_for_coord<TaskClass, ENTRY_T, int>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_S32_INDICES
+#ifdef LEGION_SOLVERS_USE_U32_INDICES
+    preregister_tdi_tasks_for_coord<TaskClass, ENTRY_T, unsigned>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_U32_INDICES
+#ifdef LEGION_SOLVERS_USE_S64_INDICES
+    preregister_tdi_tasks_for_coord<TaskClass, ENTRY_T, long long>(
+        verbose, omp
+    );
+#endif // LEGION_SOLVERS_USE_S64_INDICES
+}
+
+
+// Registers a CPU variant of TaskClass for every supported combination of
+// entry type, dimension, and index type, and also an OMP_PROC variant if omp
+// is true and LegionSolvers is built with OpenMP support.
+template <template <typename, int, typename> typename TaskClass>
+void preregister_tdi_tasks(bool verbose, bool omp = false) {
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    preregister_tdi_tasks_for_entry<TaskClass, float>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    preregister_tdi_tasks_for_entry<TaskClass, double>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_DOUBLE
+}
+
+
+template <
+    template <typename, int, typename>
+    typename TaskClass,
+    typename ENTRY_T>
+void preregister_1d_tdi_tasks_for_entry(bool verbose, bool omp) {
+#ifdef LEGION_SOLVERS_USE_S32_INDICES
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 1, int>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_S32_INDICES
+#ifdef LEGION_SOLVERS_USE_U32_INDICES
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 1, unsigned>(
+        verbose, omp
+    );
+#endif // LEGION_SOLVERS_USE_U32_INDICES
+#ifdef LEGION_SOLVERS_USE_S64_INDICES
+    preregister_tdi_tasks_for_dim<TaskClass, ENTRY_T, 1, long long>(
+        verbose, omp
+    );
+#endif // LEGION_SOLVERS_USE_S64_INDICES
+}
+
+
+// As preregister_tdi_tasks, for tasks that are only defined for DIM = 1,
+// such as those of MatrixMarketReader.
+template <template <typename, int, typename> typename TaskClass>
+void preregister_1d_tdi_tasks(bool verbose, bool omp = false) {
+#ifdef LEGION_SOLVERS_USE_FLOAT
+    preregister_1d_tdi_tasks_for_entry<TaskClass, float>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_FLOAT
+#ifdef LEGION_SOLVERS_USE_DOUBLE
+    preregister_1d_tdi_tasks_for_entry<TaskClass, double>(verbose, omp);
+#endif // LEGION_SOLVERS_USE_DOUBLE
+}
+
 void preregister_tasks(bool verbose = true) {
     LegionSolvers::PrintScalarTask<float>::preregister(verbose);
     LegionSolvers::PrintScalarTask<double>::preregister(verbose);
@@ -19,6 +135,72 @@ void preregister_tasks(bool verbose = true) {
     LegionSolvers::MultiplyScalarTask<double>::preregister(verbose);
     LegionSolvers::DivideScalarTask<float>::preregister(verbose);
     LegionSolvers::DivideScalarTask<double>::preregister(verbose);
+    LegionSolvers::UnpackScalarTask<float>::preregister(verbose);
+    LegionSolvers::UnpackScalarTask<double>::preregister(verbose);
+    LegionSolvers::EvaluateScalarProgramTask<float>::preregister(verbose);
+    LegionSolvers::EvaluateScalarProgramTask<double>::preregister(verbose);
+    LegionSolvers::SStepCGCoefficientsTask<float>::preregister(verbose);
+    LegionSolvers::SStepCGCoefficientsTask<double>::preregister(verbose);
+    LegionSolvers::GMRESLeastSquaresTask<float>::preregister(verbose);
+    LegionSolvers::GMRESLeastSquaresTask<double>::preregister(verbose);
+    LegionSolvers::LSQRStepTask<float>::preregister(verbose);
+    LegionSolvers::LSQRStepTask<double>::preregister(verbose);
+    LegionSolvers::BlockSolveTask<float>::preregister(verbose);
+    LegionSolvers::BlockSolveTask<double>::preregister(verbose);
+    preregister_tdi_tasks<ScalTask>(verbose, true);
+    preregister_tdi_tasks<AxpyTask>(verbose, true);
+    preregister_tdi_tasks<XpayTask>(verbose, true);
+    preregister_tdi_tasks<ConvertTask>(verbose, true);
+    preregister_tdi_tasks<AxpyConvertTask>(verbose, true);
+    preregister_tdi_tasks<DotTask>(verbose, true);
+    preregister_tdi_tasks<AxpyDotTask>(verbose);
+    preregister_tdi_tasks<XpayAxpyTask>(verbose);
+    preregister_tdi_tasks<MultiUpdateDotTask>(verbose);
+    preregister_tdi_tasks<LinearCombinationTask>(verbose);
+    preregister_tdi_tasks<CSRMatvecTask>(verbose, true);
+    preregister_tdi_tasks<CSRTransposeMatvecTask>(verbose, true);
+    preregister_tdi_tasks<CSRMatmatTask>(verbose, true);
+    preregister_tdi_tasks<CSRMatrixPowersTask>(verbose);
+    preregister_tdi_tasks<COOMatvecTask>(verbose, true);
+    preregister_tdi_tasks<SELLSizeTask>(verbose);
+    preregister_tdi_tasks<SELLFillTask>(verbose);
+    preregister_tdi_tasks<SELLMatvecTask>(verbose, true);
+    preregister_tdi_tasks<BSRExtentTask>(verbose);
+    preregister_tdi_tasks<BSRMatvecTask>(verbose, true);
+    preregister_tdi_tasks<BSRTransposeMatvecTask>(verbose, true);
+    preregister_tdi_tasks<StencilApplyTask>(verbose, true);
+    preregister_tdi_tasks<StencilTransposeApplyTask>(verbose);
+    preregister_tdi_tasks<BlockJacobiFactorTask>(verbose);
+    preregister_tdi_tasks<BlockJacobiApplyTask>(verbose);
+    preregister_tdi_tasks<AMGAggregateTask>(verbose);
+    preregister_tdi_tasks<AMGProlongatorTask>(verbose);
+    preregister_tdi_tasks<AMGGalerkinSizeTask>(verbose);
+    preregister_tdi_tasks<AMGGalerkinFillTask>(verbose);
+    preregister_tdi_tasks<AMGProlongTask>(verbose);
+    preregister_tdi_tasks<AMGRestrictTask>(verbose);
+    preregister_tdi_tasks<AMGCoarseFactorTask>(verbose);
+    preregister_tdi_tasks<AMGCoarseSolveTask>(verbose);
+    preregister_tdi_tasks<GMGRestrictTask>(verbose);
+    preregister_tdi_tasks<GMGProlongTask>(verbose);
+    preregister_tdi_tasks<BlockDotTask>(verbose, true);
+    preregister_tdi_tasks<BlockUpdateTask>(verbose, true);
+    preregister_1d_tdi_tasks<MatrixMarketCountTask>(verbose);
+    preregister_1d_tdi_tasks<MatrixMarketReadTask>(verbose);
+    preregister_1d_tdi_tasks<MatrixMarketSizeTask>(verbose);
+    preregister_1d_tdi_tasks<MatrixMarketFillTask>(verbose);
+    preregister_1d_tdi_tasks<SparseMatrixFileWriteTask>(verbose);
+    Legion::Runtime::register_reduction_op<PackedSumReduction<float>>(
+        PACKED_SUM_REDOP_ID<float>
+    );
+    Legion::Runtime::register_reduction_op<PackedSumReduction<double>>(
+        PACKED_SUM_REDOP_ID<double>
+    );
+    Legion::Runtime::register_reduction_op<BlockSumReduction<float>>(
+        BLOCK_SUM_REDOP_ID<float>
+    );
+    Legion::Runtime::register_reduction_op<BlockSumReduction<double>>(
+        BLOCK_SUM_REDOP_ID<double>
+    );
 }
 
 
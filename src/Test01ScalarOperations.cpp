@@ -29,6 +29,16 @@ void top_level_task(
         LegionSolvers::Scalar<double> v = w - x;
         assert(v.get_value() == 1.0);
     }
+    {
+        // Expressions longer than one ScalarProgram are split automatically.
+        const LegionSolvers::Scalar<double> one{
+            ctx, rt, Legion::Future::from_value(rt, 1.0)};
+        LegionSolvers::Scalar<double> sum = one;
+        for (int i = 1; i < 100; ++i) { sum = sum + one; }
+        assert(sum.get_value() == 100.0);
+        assert((sum * sum).sqrt().get_value() == 100.0);
+        assert((-sum / (one + one)).get_value() == -50.0);
+    }
 }
 
 int main(int argc, char **argv) {
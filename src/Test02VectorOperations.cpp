@@ -1 +1,108 @@
-int main() {}
+#include <cassert> // for assert
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task
+#include "Scalar.hpp"              // for Scalar
+#include "TaskRegistration.hpp"    // for preregister_tasks
+#include "VectorKernels.hpp"       // for DotProductMode
+
+enum TaskIDs : Legion::TaskID { TOP_LEVEL_TASK_ID };
+
+
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void test_vector_operations(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const Legion::Rect<DIM, COORD_T> &bounds,
+    long long num_pieces
+) {
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using LegionSolvers::DotProductMode;
+    using LegionSolvers::Scalar;
+
+    const Legion::IndexSpace index_space = rt->create_index_space(ctx, bounds);
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+    const ENTRY_T n = static_cast<ENTRY_T>(bounds.volume());
+
+    {
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        x.constant_fill(static_cast<ENTRY_T>(1));
+        y.constant_fill(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(2)});
+
+        assert(x.dot(x).get_value() == n);
+        assert(x.dot(y).get_value() == 2 * n);
+
+        y.axpy(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(3)}, x); // y = 5
+        assert(x.dot(y).get_value() == 5 * n);
+
+        y.xpay(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(2)}, x); // y = 11
+        assert(x.dot(y).get_value() == 11 * n);
+
+        x.scal(Scalar<ENTRY_T>{ctx, rt, static_cast<ENTRY_T>(-2)}); // x = -2
+        assert(y.dot(x).get_value() == -22 * n);
+        assert(y.dot(x, DotProductMode::COMPENSATED).get_value() == -22 * n);
+
+        x.copy(y); // x = 11
+        assert(x.dot(x).get_value() == 121 * n);
+
+        // Coefficients computed by Scalar arithmetic stay on futures.
+        const Scalar<ENTRY_T> rr = x.dot(x);
+        const Scalar<ENTRY_T> alpha = -(rr / rr);
+        y.axpy(alpha, x); // y = 0
+        assert(y.dot(y).get_value() == 0);
+
+        // Operands that alias *this are rewritten as scalings.
+        const Scalar<ENTRY_T> two{ctx, rt, static_cast<ENTRY_T>(2)};
+        x.copy(x);       // x = 11
+        x.axpy(-two, x); // x = -11
+        x.xpay(two, x);  // x = -33
+        assert(x.dot(x).get_value() == 1089 * n);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_vector_operations<float, 1, int>(
+        ctx, rt, Legion::Rect<1, int>{0, 999}, 4
+    );
+    test_vector_operations<double, 1, long long>(
+        ctx, rt, Legion::Rect<1, long long>{0, 12'345}, 7
+    );
+    test_vector_operations<double, 2, int>(
+        ctx, rt, Legion::Rect<2, int>{{0, 0}, {99, 49}}, 3
+    );
+    test_vector_operations<float, 3, unsigned>(
+        ctx, rt, Legion::Rect<3, unsigned>{{0, 0, 0}, {9, 19, 29}}, 5
+    );
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
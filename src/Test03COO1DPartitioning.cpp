@@ -0,0 +1,182 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "COOMatrix.hpp"           // for COOMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_LAPLACIAN_1D_TASK_ID, ...
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, create_field_space
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROW;
+using LegionSolvers::FILL_LAPLACIAN_1D_TASK_ID;
+using LegionSolvers::subspace_volume;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+template <typename ENTRY_T, typename COORD_T>
+void test_coo_1d(
+    Legion::Context ctx, Legion::Runtime *rt, COORD_T n, long long num_pieces
+) {
+    using Matrix = LegionSolvers::COOMatrix<ENTRY_T, 1, COORD_T>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T>;
+
+    const Legion::IndexSpace index_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 3 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, COORD_T>),
+             sizeof(Legion::Point<1, COORD_T>),
+             sizeof(ENTRY_T)},
+            {FID_ROW, FID_COL, FID_ENTRY}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+    // Equal numbers of nonzeros per piece, which mostly split rows.
+    const Legion::IndexPartition kernel_partition =
+        rt->create_equal_partition(ctx, kernel_space, color_space);
+
+    {
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        Vector z{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_LAPLACIAN_1D_TASK_ID<ENTRY_T, COORD_T>,
+            Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        for (const Legion::FieldID fid : {FID_ROW, FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        const Matrix A{
+            ctx,
+            rt,
+            kernel_region,
+            FID_ROW,
+            FID_COL,
+            FID_ENTRY,
+            index_space,
+            index_space,
+            kernel_partition};
+
+        // Nonzero k lies in row (k + 1) / 3, so a kernel piece [a, b] touches
+        // rows (a + 1) / 3 through (b + 1) / 3 and the columns adjacent to
+        // them. Conversely, each row piece owns the nonzeros of its rows.
+        const Legion::IndexPartition row_partition =
+            A.kernel_partition_from_range_partition(partition);
+        for (long long c = 0; c < num_pieces; ++c) {
+            const Legion::Rect<1, COORD_T> piece = rt->get_index_space_domain(
+                ctx,
+                rt->get_index_subspace(
+                    ctx, kernel_partition, Legion::DomainPoint{c}
+                )
+            );
+            const std::size_t touched_rows =
+                (piece.hi[0] + 1) / 3 - (piece.lo[0] + 1) / 3 + 1;
+            assert(
+                subspace_volume(ctx, rt, A.get_range_partition(), c) ==
+                touched_rows
+            );
+            assert(
+                subspace_volume(ctx, rt, A.get_domain_partition(), c) <=
+                touched_rows + 2
+            );
+            const std::size_t rows = subspace_volume(ctx, rt, partition, c);
+            const std::size_t first = (c == 0) ? 1 : 0;
+            const std::size_t last = (c == num_pieces - 1) ? 1 : 0;
+            assert(
+                subspace_volume(ctx, rt, row_partition, c) ==
+                3 * rows - first - last
+            );
+        }
+        rt->destroy_index_partition(ctx, row_partition);
+
+        const ENTRY_T m = static_cast<ENTRY_T>(n);
+
+        // y = A * x = (-1, 0, ..., 0, n)
+        A.matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        assert(y.dot(y).get_value() == 1 + m * m);
+        assert(x.dot(y).get_value() == (m - 1) * m);
+
+        // z = A * y = (-2, 1, 0, ..., 0, -n, 2n)
+        A.matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            y.get_logical_region(),
+            y.get_fid()
+        );
+        assert(z.dot(z).get_value() == 5 + 5 * m * m);
+    }
+
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_coo_1d<float, int>(ctx, rt, 1'000, 4);
+    test_coo_1d<float, unsigned>(ctx, rt, 10, 1);
+    test_coo_1d<double, long long>(ctx, rt, 12'345, 7);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,321 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CGSolver.hpp"            // for CGSolver
+#include "COOMatrix.hpp"           // for COOMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_LAPLACIAN_1D_TASK_ID
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, create_field_space
+#include "PipelinedCGSolver.hpp"   // for PipelinedCGSolver
+#include "Scalar.hpp"              // for Scalar
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROW;
+using LegionSolvers::FILL_LAPLACIAN_1D_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Solves A * x = b for the 1D Laplacian A and b = A * (0, 1, ..., n - 1) by
+// CG, starting from x = 0. In exact arithmetic, CG terminates after at most
+// n iterations; the solver checks convergence every 10 iterations.
+template <typename ENTRY_T, typename COORD_T>
+void test_cg_coo_1d(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    COORD_T n,
+    long long num_pieces,
+    ENTRY_T tolerance
+) {
+    using Matrix = LegionSolvers::COOMatrix<ENTRY_T, 1, COORD_T>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T>;
+    using Solver = LegionSolvers::CGSolver<ENTRY_T, 1, COORD_T>;
+    using Scalar = LegionSolvers::Scalar<ENTRY_T>;
+
+    const Legion::IndexSpace index_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 3 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, COORD_T>),
+             sizeof(Legion::Point<1, COORD_T>),
+             sizeof(ENTRY_T)},
+            {FID_ROW, FID_COL, FID_ENTRY}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+    const Legion::IndexPartition kernel_partition =
+        rt->create_equal_partition(ctx, kernel_space, color_space);
+
+    {
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_LAPLACIAN_1D_TASK_ID<ENTRY_T, COORD_T>,
+            Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        for (const Legion::FieldID fid : {FID_ROW, FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        const Matrix A{
+            ctx,
+            rt,
+            kernel_region,
+            FID_ROW,
+            FID_COL,
+            FID_ENTRY,
+            index_space,
+            index_space,
+            kernel_partition};
+        A.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        x.constant_fill(static_cast<ENTRY_T>(0));
+
+        Solver solver{
+            ctx,
+            rt,
+            A,
+            b.get_logical_region(),
+            b.get_fid(),
+            x.get_logical_region(),
+            x.get_fid(),
+            partition};
+        const std::size_t max_iterations = 4 * static_cast<std::size_t>(n);
+        const std::size_t iterations = solver.solve(max_iterations, tolerance);
+        assert(iterations < max_iterations);
+        assert(iterations % Solver::DEFAULT_CHECK_INTERVAL == 0);
+        const ENTRY_T b_norm = b.dot(b).sqrt().get_value();
+        assert(solver.get_residual_norm() <= tolerance * b_norm);
+
+        // The relative error is at most the condition number of A, which is
+        // about (2n / pi)^2 < n^2, times the relative residual.
+        const ENTRY_T bound = static_cast<ENTRY_T>(n) *
+                              static_cast<ENTRY_T>(n) * tolerance;
+        const ENTRY_T x_norm_squared = x_exact.dot(x_exact).get_value();
+        x.axpy(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, x_exact);
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+    }
+
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+// Solves the 2D Poisson problem A * x = 1 on an n-by-n grid, with A the
+// matrix-free 5-point Laplacian, by CG (SOLVER is CGSolver or
+// PipelinedCGSolver) without a preconditioner and with the Jacobi
+// preconditioner diag(A)^{-1}, and checks the true residual of both
+// solutions.
+template <template <typename, int, typename> typename SOLVER>
+void test_cg_stencil_2d(Legion::Context ctx, Legion::Runtime *rt, int n) {
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Solver = SOLVER<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space =
+        rt->create_index_space(ctx, Legion::Rect<2>{{0, 0}, {1, 1}});
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator A{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0, -1.0, -1.0, -1.0, -1.0}};
+        const Operator jacobi{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {0.25, 0.0, 0.0, 0.0, 0.0}};
+
+        Vector b{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+        b.constant_fill(1.0);
+        const double b_norm = b.dot(b).sqrt().get_value();
+        const double tolerance = 1.0e-10;
+
+        const std::vector<const Operator *> preconditioners{nullptr, &jacobi};
+        for (const Operator *preconditioner : preconditioners) {
+            x.constant_fill(0.0);
+            Solver solver{
+                ctx,
+                rt,
+                A,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                1};
+            const std::size_t iterations = solver.solve(
+                static_cast<std::size_t>(n * n), tolerance
+            );
+            assert(iterations < static_cast<std::size_t>(n * n));
+
+            A.matvec(
+                r.get_logical_region(),
+                r.get_fid(),
+                x.get_logical_region(),
+                x.get_fid()
+            );
+            r.xpay(Scalar{ctx, rt, -1.0}, b);
+            assert(r.dot(r).sqrt().get_value() <= 10.0 * tolerance * b_norm);
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+// Solves x = b for b = 1 on an n-by-n grid by CG (SOLVER is CGSolver or
+// PipelinedCGSolver), with A and the preconditioner both the identity, as a
+// StencilOperator. The residual vanishes exactly after one iteration, but
+// convergence is only checked every 10 iterations, so the iterations in
+// between must divide zero by zero safely.
+template <template <typename, int, typename> typename SOLVER>
+void test_cg_exact_convergence(
+    Legion::Context ctx, Legion::Runtime *rt, int n
+) {
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Solver = SOLVER<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space =
+        rt->create_index_space(ctx, Legion::Rect<2>{{0, 0}, {1, 1}});
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator identity{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {1.0, 0.0, 0.0, 0.0, 0.0}};
+
+        Vector b{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        b.constant_fill(1.0);
+
+        const std::vector<const Operator *> preconditioners{
+            nullptr, &identity};
+        for (const Operator *preconditioner : preconditioners) {
+            x.constant_fill(0.0);
+            Solver solver{
+                ctx,
+                rt,
+                identity,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                10};
+            const std::size_t iterations = solver.solve(20, 1.0e-12);
+            assert(iterations == 10);
+            assert(solver.get_residual_norm() == 0.0);
+
+            // Fails if x holds a NaN.
+            x.axpy(Scalar{ctx, rt, -1.0}, b);
+            assert(x.dot(x).get_value() == 0.0);
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_cg_coo_1d<float, int>(ctx, rt, 40, 3, 1.0e-4f);
+    test_cg_coo_1d<double, long long>(ctx, rt, 200, 5, 1.0e-12);
+    test_cg_stencil_2d<LegionSolvers::CGSolver>(ctx, rt, 32);
+    test_cg_stencil_2d<LegionSolvers::PipelinedCGSolver>(ctx, rt, 32);
+    test_cg_exact_convergence<LegionSolvers::CGSolver>(ctx, rt, 8);
+    test_cg_exact_convergence<LegionSolvers::PipelinedCGSolver>(ctx, rt, 8);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
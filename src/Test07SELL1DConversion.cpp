@@ -0,0 +1,244 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "COOMatrix.hpp"           // for COOMatrix
+#include "CSRMatrix.hpp"           // for CSRMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_LAPLACIAN_1D_TASK_ID, ...
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, create_field_space
+#include "SELLMatrix.hpp"          // for SELLMatrix
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROW;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_LAPLACIAN_1D_TASK_ID;
+using LegionSolvers::subspace_volume;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Checks the partitions and products of A, the SELL-C-sigma form of the
+// n-by-n Laplacian over the given partition of its rows.
+template <typename ENTRY_T, typename COORD_T>
+void check_sell_1d(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const LegionSolvers::SELLMatrix<ENTRY_T, 1, COORD_T> &A,
+    Legion::IndexPartition partition,
+    const LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T> &x,
+    LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T> &y,
+    LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T> &z,
+    COORD_T n,
+    long long num_pieces,
+    std::size_t num_slots
+) {
+    assert(A.get_num_entries() == 3 * static_cast<std::size_t>(n) - 2);
+    assert(A.get_num_slots() == num_slots);
+
+    // Padding repeats rows and columns of its own chunk, so each piece still
+    // covers exactly its rows and reads one input entry from each
+    // neighbouring piece.
+    const Legion::IndexPartition range_partition =
+        A.range_partition_from_kernel_partition(
+            A.get_range_space(), A.get_kernel_partition()
+        );
+    for (long long c = 0; c < num_pieces; ++c) {
+        const std::size_t rows = subspace_volume(ctx, rt, partition, c);
+        const std::size_t first = (c == 0) ? 1 : 0;
+        const std::size_t last = (c == num_pieces - 1) ? 1 : 0;
+        assert(subspace_volume(ctx, rt, range_partition, c) == rows);
+        assert(
+            subspace_volume(ctx, rt, A.get_domain_partition(), c) ==
+            rows + (1 - first) + (1 - last)
+        );
+    }
+    rt->destroy_index_partition(ctx, range_partition);
+
+    const ENTRY_T m = static_cast<ENTRY_T>(n);
+
+    // y = A * x = (-1, 0, ..., 0, n)
+    A.matvec(
+        y.get_logical_region(),
+        y.get_fid(),
+        x.get_logical_region(),
+        x.get_fid()
+    );
+    assert(y.dot(y).get_value() == 1 + m * m);
+    assert(x.dot(y).get_value() == (m - 1) * m);
+
+    // z = A * y = (-2, 1, 0, ..., 0, -n, 2n)
+    A.matvec(
+        z.get_logical_region(),
+        z.get_fid(),
+        y.get_logical_region(),
+        y.get_fid()
+    );
+    assert(z.dot(z).get_value() == 5 + 5 * m * m);
+}
+
+
+// Converts the n-by-n Laplacian from CSR and from COO over an equal
+// partition of its rows into num_pieces pieces. Every chunk of this matrix
+// has width 3 unless it holds a single boundary row, which the parameters
+// below avoid, so num_slots is 3 * C times the number of chunks.
+template <typename ENTRY_T, typename COORD_T>
+void test_sell_1d(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    COORD_T n,
+    long long num_pieces,
+    std::size_t chunk_height,
+    std::size_t sort_window,
+    std::size_t num_slots
+) {
+    using CSR = LegionSolvers::CSRMatrix<ENTRY_T, 1, COORD_T>;
+    using COO = LegionSolvers::COOMatrix<ENTRY_T, 1, COORD_T>;
+    using SELL = LegionSolvers::SELLMatrix<ENTRY_T, 1, COORD_T>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T>;
+
+    const Legion::IndexSpace index_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 3 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, COORD_T>),
+             sizeof(Legion::Point<1, COORD_T>),
+             sizeof(ENTRY_T)},
+            {FID_ROW, FID_COL, FID_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, COORD_T>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, index_space, rowptr_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+    const Legion::IndexPartition kernel_partition =
+        rt->create_equal_partition(ctx, kernel_space, color_space);
+
+    {
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        Vector z{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_LAPLACIAN_1D_TASK_ID<ENTRY_T, COORD_T>,
+            Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid : {FID_ROW, FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        {
+            const CSR A{
+                ctx,
+                rt,
+                kernel_region,
+                FID_COL,
+                FID_ENTRY,
+                rowptr_region,
+                FID_ROWPTR,
+                index_space,
+                partition};
+            const SELL B{ctx, rt, A, chunk_height, sort_window};
+            check_sell_1d(
+                ctx, rt, B, partition, x, y, z, n, num_pieces, num_slots
+            );
+        }
+
+        {
+            const COO A{
+                ctx,
+                rt,
+                kernel_region,
+                FID_ROW,
+                FID_COL,
+                FID_ENTRY,
+                index_space,
+                index_space,
+                kernel_partition};
+            const SELL B{ctx, rt, A, partition, chunk_height, sort_window};
+            check_sell_1d(
+                ctx, rt, B, partition, x, y, z, n, num_pieces, num_slots
+            );
+        }
+    }
+
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    // 4 pieces of 250 rows, in 63 chunks of 4 rows each.
+    test_sell_1d<float, int>(ctx, rt, 1'000, 4, 4, 8, 4 * 63 * 12);
+    // Rows 0 to 7 and rows 8 to 9, without sorting.
+    test_sell_1d<float, unsigned>(ctx, rt, 10, 1, 8, 1, 2 * 24);
+    // 7 pieces of 1763 or 1764 rows, in 221 chunks of 8 rows each.
+    test_sell_1d<double, long long>(ctx, rt, 12'345, 7, 8, 64, 7 * 221 * 24);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
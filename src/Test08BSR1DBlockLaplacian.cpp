@@ -0,0 +1,309 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "BSRMatrix.hpp"           // for BSRMatrix, BSRBlock
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for subspace_volume
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, AffineWriter, ...
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::subspace_volume;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+    FILL_BLOCK_LAPLACIAN_FLOAT_INT_2_TASK_ID,
+    FILL_BLOCK_LAPLACIAN_FLOAT_UNSIGNED_3_TASK_ID,
+    FILL_BLOCK_LAPLACIAN_DOUBLE_LONG_LONG_6_TASK_ID,
+};
+
+enum FieldIDs : Legion::FieldID {
+    FID_COL,
+    FID_ENTRY,
+    FID_ROWPTR,
+};
+
+
+// Entry (i, j) of the B-by-B matrix M with ones on its diagonal and
+// superdiagonal.
+constexpr int block_entry(int i, int j) { return (j == i || j == i + 1); }
+
+
+// Writes the n-by-n block matrix tridiag(-M, 2M, -M), i.e., the Kronecker
+// product of tridiag(-1, 2, -1) with M, in BSR form with 3n - 2 blocks, and
+// the vector x[B * i + c] = i. Regions are row pointers, block column
+// indices, blocks, and x, all write-discard.
+template <typename ENTRY_T, typename COORD_T, int B>
+void fill_block_laplacian_1d_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using LegionSolvers::AffineWriter;
+    using Point = Legion::Point<1, COORD_T>;
+    using Block = LegionSolvers::BSRBlock<ENTRY_T, B>;
+
+    assert(regions.size() == 4);
+    assert(task->regions.size() == 4);
+    const Legion::FieldID x_fid = *task->regions[3].privilege_fields.begin();
+
+    AffineWriter<Legion::Rect<1, COORD_T>, 1, COORD_T> rowptr_writer{
+        regions[0], FID_ROWPTR};
+    AffineWriter<Point, 1, COORD_T> col_writer{regions[1], FID_COL};
+    AffineWriter<Block, 1, COORD_T> entry_writer{regions[2], FID_ENTRY};
+    AffineWriter<ENTRY_T, 1, COORD_T> x_writer{regions[3], x_fid};
+
+    const Legion::Rect<1, COORD_T> rows = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    const COORD_T n = rows.hi[0] + 1;
+
+    COORD_T k = 0;
+    for (COORD_T i = 0; i < n; ++i) {
+        const COORD_T first = k;
+        for (COORD_T j = (i > 0) ? i - 1 : 0; (j <= i + 1) && (j < n); ++j) {
+            Block block;
+            for (int r = 0; r < B; ++r) {
+                for (int c = 0; c < B; ++c) {
+                    block.values[r * B + c] = static_cast<ENTRY_T>(
+                        ((i == j) ? 2 : -1) * block_entry(r, c)
+                    );
+                }
+            }
+            col_writer[Point{k}] = Point{j};
+            entry_writer[Point{k}] = block;
+            ++k;
+        }
+        rowptr_writer[Point{i}] = Legion::Rect<1, COORD_T>{first, k - 1};
+        for (COORD_T c = 0; c < B; ++c) {
+            x_writer[Point{B * i + c}] = static_cast<ENTRY_T>(i);
+        }
+    }
+    assert(k == 3 * n - 2);
+}
+
+
+template <
+    typename ENTRY_T,
+    typename COORD_T,
+    int B,
+    Legion::TaskID FILL_TASK_ID>
+void test_bsr_1d(
+    Legion::Context ctx, Legion::Runtime *rt, COORD_T n, long long num_pieces
+) {
+    using Matrix = LegionSolvers::BSRMatrix<ENTRY_T, 1, COORD_T, B>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T>;
+
+    const Legion::IndexSpace node_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, n - 1});
+    const Legion::IndexSpace index_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, B * n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 3 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, COORD_T>),
+             sizeof(LegionSolvers::BSRBlock<ENTRY_T, B>)},
+            {FID_COL, FID_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, COORD_T>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, node_space, rowptr_field_space);
+    const Legion::IndexPartition node_partition =
+        rt->create_equal_partition(ctx, node_space, color_space);
+    // Vectors need not be partitioned along block boundaries.
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+
+    {
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        Vector z{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{FILL_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid : {FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        const Matrix A{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            node_space,
+            index_space,
+            index_space,
+            node_partition};
+
+        // Each piece owns the blocks of its nodes, and reads the components
+        // of one node from each neighbouring piece.
+        const Legion::IndexPartition column_partition =
+            A.kernel_partition_from_domain_partition(A.get_range_partition());
+        for (long long c = 0; c < num_pieces; ++c) {
+            const std::size_t rows =
+                subspace_volume(ctx, rt, node_partition, c);
+            const std::size_t first = (c == 0) ? 1 : 0;
+            const std::size_t last = (c == num_pieces - 1) ? 1 : 0;
+            assert(
+                subspace_volume(ctx, rt, A.get_kernel_partition(), c) ==
+                3 * rows - first - last
+            );
+            assert(
+                subspace_volume(ctx, rt, A.get_range_partition(), c) ==
+                B * rows
+            );
+            assert(
+                subspace_volume(ctx, rt, A.get_domain_partition(), c) ==
+                B * (rows + (1 - first) + (1 - last))
+            );
+            assert(
+                subspace_volume(ctx, rt, column_partition, c) ==
+                3 * rows - first - last
+            );
+        }
+        rt->destroy_index_partition(ctx, column_partition);
+
+        // With e = (1, ..., 1), M * e and M * M * e.
+        ENTRY_T me[B];
+        ENTRY_T mme[B];
+        for (int r = 0; r < B; ++r) {
+            me[r] = static_cast<ENTRY_T>(1 + (r + 1 < B));
+        }
+        for (int r = 0; r < B; ++r) {
+            mme[r] = me[r] + ((r + 1 < B) ? me[r + 1] : 0);
+        }
+        ENTRY_T me_me = 0;
+        ENTRY_T e_me = 0;
+        ENTRY_T mme_mme = 0;
+        for (int r = 0; r < B; ++r) {
+            me_me += me[r] * me[r];
+            e_me += me[r];
+            mme_mme += mme[r] * mme[r];
+        }
+
+        const ENTRY_T m = static_cast<ENTRY_T>(n);
+
+        // y = A * x = (-1, 0, ..., 0, n) (x) M * e
+        A.matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        assert(y.dot(y).get_value() == (1 + m * m) * me_me);
+        assert(x.dot(y).get_value() == (m - 1) * m * e_me);
+
+        // z = A * y = (-2, 1, 0, ..., 0, -n, 2n) (x) M * M * e
+        A.matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            y.get_logical_region(),
+            y.get_fid()
+        );
+        assert(z.dot(z).get_value() == (5 + 5 * m * m) * mme_mme);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_partition(ctx, node_partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, index_space);
+    rt->destroy_index_space(ctx, node_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_bsr_1d<float, int, 2, FILL_BLOCK_LAPLACIAN_FLOAT_INT_2_TASK_ID>(
+        ctx, rt, 100, 4
+    );
+    test_bsr_1d<
+        float,
+        unsigned,
+        3,
+        FILL_BLOCK_LAPLACIAN_FLOAT_UNSIGNED_3_TASK_ID>(ctx, rt, 10, 1);
+    test_bsr_1d<
+        double,
+        long long,
+        6,
+        FILL_BLOCK_LAPLACIAN_DOUBLE_LONG_LONG_6_TASK_ID>(ctx, rt, 12'345, 7);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_task<
+        fill_block_laplacian_1d_task<float, int, 2>>(
+        FILL_BLOCK_LAPLACIAN_FLOAT_INT_2_TASK_ID,
+        "fill_block_laplacian_1d_float_int_2",
+        TaskFlags::LEAF
+    );
+    LegionSolvers::preregister_task<
+        fill_block_laplacian_1d_task<float, unsigned, 3>>(
+        FILL_BLOCK_LAPLACIAN_FLOAT_UNSIGNED_3_TASK_ID,
+        "fill_block_laplacian_1d_float_unsigned_3",
+        TaskFlags::LEAF
+    );
+    LegionSolvers::preregister_task<
+        fill_block_laplacian_1d_task<double, long long, 6>>(
+        FILL_BLOCK_LAPLACIAN_DOUBLE_LONG_LONG_6_TASK_ID,
+        "fill_block_laplacian_1d_double_long_long_6",
+        TaskFlags::LEAF
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,233 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for subspace_volume
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, create_field_space
+#include "Scalar.hpp"              // for Scalar
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::subspace_volume;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Applies the stencil with the given coefficients to the vector of all ones
+// on a grid of the given extents, split into pieces by an equal partition
+// with the given number of colors in each dimension, once with constant
+// coefficients and once with the same coefficients stored per grid point.
+// Checks the sum of the entries of the result and of their squares.
+template <typename ENTRY_T, int DIM, typename COORD_T>
+void test_stencil(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    Legion::Point<DIM, COORD_T> extents,
+    Legion::Point<DIM> colors,
+    LegionSolvers::StencilShape shape,
+    const std::vector<ENTRY_T> &coefficients,
+    ENTRY_T expected_sum,
+    ENTRY_T expected_sum_of_squares
+) {
+    using Operator = LegionSolvers::StencilOperator<ENTRY_T, DIM, COORD_T>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, DIM, COORD_T>;
+    using Scalar = LegionSolvers::Scalar<ENTRY_T>;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx,
+        Legion::Rect<DIM, COORD_T>{
+            Legion::Point<DIM, COORD_T>::ZEROES(),
+            extents - Legion::Point<DIM, COORD_T>::ONES()}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx,
+        Legion::Rect<DIM>{
+            Legion::Point<DIM>::ZEROES(), colors - Legion::Point<DIM>::ONES()}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    const std::size_t num_points = coefficients.size();
+    std::vector<Legion::FieldID> coefficient_fids;
+    for (std::size_t s = 0; s < num_points; ++s) {
+        coefficient_fids.push_back(static_cast<Legion::FieldID>(s));
+    }
+    const Legion::FieldSpace coefficient_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            std::vector<std::size_t>(num_points, sizeof(ENTRY_T)),
+            coefficient_fids
+        );
+    const Legion::LogicalRegion coefficient_region =
+        rt->create_logical_region(ctx, grid_space, coefficient_field_space);
+    for (std::size_t s = 0; s < num_points; ++s) {
+        rt->fill_field<ENTRY_T>(
+            ctx,
+            coefficient_region,
+            coefficient_region,
+            coefficient_fids[s],
+            coefficients[s]
+        );
+    }
+
+    {
+        const Operator A{ctx, rt, grid_space, partition, shape, coefficients};
+        const Operator B{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            shape,
+            coefficient_region,
+            coefficient_fids};
+        assert(A.get_num_points() == static_cast<int>(num_points));
+
+        // Equal partitions of a grid have boxes as pieces, so the points
+        // whose neighbourhoods lie in the halo of a piece form that piece.
+        const Legion::IndexPartition range_partition =
+            A.range_partition_from_domain_partition(
+                grid_space, A.get_domain_partition()
+            );
+        const Legion::Domain color_domain =
+            rt->get_index_space_domain(ctx, color_space);
+        for (Legion::Domain::DomainPointIterator it(color_domain); it; ++it) {
+            assert(
+                subspace_volume(ctx, rt, range_partition, *it) ==
+                subspace_volume(ctx, rt, partition, *it)
+            );
+            assert(
+                subspace_volume(ctx, rt, A.get_domain_partition(), *it) >=
+                subspace_volume(ctx, rt, partition, *it)
+            );
+        }
+        rt->destroy_index_partition(ctx, range_partition);
+
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        Vector z{ctx, rt, partition};
+        x.constant_fill(static_cast<ENTRY_T>(1));
+
+        A.matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        assert(y.dot(x).get_value() == expected_sum);
+        assert(y.dot(y).get_value() == expected_sum_of_squares);
+
+        B.matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        z.axpy(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, y);
+        assert(z.dot(z).get_value() == static_cast<ENTRY_T>(0));
+    }
+
+    rt->destroy_logical_region(ctx, coefficient_region);
+    rt->destroy_field_space(ctx, coefficient_field_space);
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using LegionSolvers::StencilShape;
+
+    // tridiag(-1, 2, -1): A * 1 = (1, 0, ..., 0, 1)
+    test_stencil<float, 1, int>(
+        ctx,
+        rt,
+        Legion::Point<1, int>{1'000},
+        Legion::Point<1>{4},
+        StencilShape::STAR,
+        {2.0f, -1.0f, -1.0f},
+        2.0f,
+        2.0f
+    );
+
+    // 5-point Laplacian on an nx-by-ny grid: entry p of A * 1 is the number
+    // of neighbours of p outside the grid, so the entries sum to
+    // 2 * (nx + ny), and the four corners contribute 4 instead of 2 to the
+    // sum of squares.
+    test_stencil<double, 2, long long>(
+        ctx,
+        rt,
+        Legion::Point<2, long long>{30, 20},
+        Legion::Point<2>{3, 2},
+        StencilShape::STAR,
+        {4.0, -1.0, -1.0, -1.0, -1.0},
+        100.0,
+        108.0
+    );
+
+    // 9-point box of ones on an n-by-n grid: entry p of A * 1 is the number
+    // of points of the grid in the neighbourhood of p, a product of one
+    // factor per dimension that is 3 inside and 2 on the boundary.
+    test_stencil<float, 2, unsigned>(
+        ctx,
+        rt,
+        Legion::Point<2, unsigned>{16, 16},
+        Legion::Point<2>{2, 2},
+        StencilShape::BOX,
+        std::vector<float>(9, 1.0f),
+        46.0f * 46.0f,
+        134.0f * 134.0f
+    );
+
+    // 7-point Laplacian on an nx-by-ny-by-nz grid: the entries sum to
+    // 2 * (nx * ny + ny * nz + nx * nz), and the sum of squares exceeds that
+    // by 8 * (nx + ny + nz) for the edges.
+    test_stencil<float, 3, unsigned>(
+        ctx,
+        rt,
+        Legion::Point<3, unsigned>{12, 10, 8},
+        Legion::Point<3>{2, 2, 1},
+        StencilShape::STAR,
+        {6.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f},
+        592.0f,
+        832.0f
+    );
+
+    // 27-point box of ones: the entries sum to the product of 3 * n - 2
+    // over the dimensions, and their squares to the product of 9 * n - 10.
+    test_stencil<double, 3, int>(
+        ctx,
+        rt,
+        Legion::Point<3, int>{9, 7, 5},
+        Legion::Point<3>{2, 2, 2},
+        StencilShape::BOX,
+        std::vector<double>(27, 1.0),
+        25.0 * 19.0 * 13.0,
+        71.0 * 53.0 * 35.0
+    );
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
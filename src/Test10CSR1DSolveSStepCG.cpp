@@ -0,0 +1,257 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <memory>  // for std::unique_ptr
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CSRMatrix.hpp"           // for CSRMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_LAPLACIAN_1D_TASK_ID
+#include "KrylovBasis.hpp"         // for KrylovBasis, KrylovBasisKind, ...
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, create_field_space
+#include "MatrixPowersKernel.hpp"  // for MatrixPowersKernel
+#include "Scalar.hpp"              // for Scalar
+#include "SStepCGSolver.hpp"       // for SStepCGSolver
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_LAPLACIAN_1D_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Checks the basis vectors computed by the matrix-powers kernel against
+// the recurrence of the basis evaluated by one matrix-vector product per
+// vector, and solves A * x = b for b = A * (0, 1, ..., n - 1) by s-step CG
+// for each basis and s = 1, ..., LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH,
+// starting from x = 0. The spectrum of A lies in [0, 4].
+void test_sstep_cg_csr_1d(
+    Legion::Context ctx, Legion::Runtime *rt, long long n, long long num_pieces
+) {
+    using LegionSolvers::KrylovBasisKind;
+    using Matrix = LegionSolvers::CSRMatrix<double, 1, long long>;
+    using Vector = LegionSolvers::DistributedVector<double, 1, long long>;
+    using Kernel = LegionSolvers::MatrixPowersKernel<double, 1, long long>;
+    using Solver = LegionSolvers::SStepCGSolver<double, 1, long long>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    constexpr int MAX_STEPS =
+        LegionSolvers::LEGION_SOLVERS_MAX_KRYLOV_BASIS_LENGTH;
+    const double tolerance = 1.0e-10;
+
+    const Legion::IndexSpace index_space =
+        rt->create_index_space(ctx, Legion::Rect<1, long long>{0, n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, long long>{0, 3 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, long long>), sizeof(double)},
+            {FID_COL, FID_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, long long>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, index_space, rowptr_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, index_space, color_space);
+
+    {
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_LAPLACIAN_1D_TASK_ID<double, long long>,
+            Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid : {FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        const Matrix A{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            index_space,
+            partition};
+        A.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        const double b_norm = b.dot(b).sqrt().get_value();
+
+        const std::vector<KrylovBasisKind> kinds{
+            KrylovBasisKind::MONOMIAL,
+            KrylovBasisKind::NEWTON,
+            KrylovBasisKind::CHEBYSHEV};
+
+        // Matrix-powers kernel: v_0 = x_exact.
+        {
+            const Kernel kernel{ctx, rt, A, MAX_STEPS};
+            std::vector<std::unique_ptr<Vector>> outputs;
+            std::vector<std::unique_ptr<Vector>> expected;
+            std::vector<Legion::LogicalRegion> output_regions;
+            std::vector<Legion::FieldID> output_fids;
+            for (int k = 0; k < MAX_STEPS; ++k) {
+                outputs.push_back(std::make_unique<Vector>(ctx, rt, partition));
+                expected.push_back(
+                    std::make_unique<Vector>(ctx, rt, partition)
+                );
+                output_regions.push_back(outputs[k]->get_logical_region());
+                output_fids.push_back(outputs[k]->get_fid());
+            }
+            for (const KrylovBasisKind kind : kinds) {
+                const LegionSolvers::KrylovBasis<double> basis =
+                    LegionSolvers::make_krylov_basis<double>(
+                        kind, MAX_STEPS, 0.0, 4.0
+                    );
+                kernel.apply(
+                    basis,
+                    x_exact.get_logical_region(),
+                    x_exact.get_fid(),
+                    output_regions,
+                    output_fids
+                );
+                for (int k = 0; k < MAX_STEPS; ++k) {
+                    const Vector &current =
+                        (k == 0) ? x_exact : *expected[k - 1];
+                    Vector &next = *expected[k];
+                    A.matvec(
+                        next.get_logical_region(),
+                        next.get_fid(),
+                        current.get_logical_region(),
+                        current.get_fid()
+                    );
+                    next.axpy(Scalar{ctx, rt, -basis.shift[k]}, current);
+                    if (k > 0) {
+                        const Vector &previous =
+                            (k == 1) ? x_exact : *expected[k - 2];
+                        next.axpy(
+                            Scalar{ctx, rt, -basis.previous[k]}, previous
+                        );
+                    }
+                    next.scal(Scalar{ctx, rt, 1.0 / basis.scale[k]});
+                }
+                for (int k = 0; k < MAX_STEPS; ++k) {
+                    const double norm_squared =
+                        expected[k]->dot(*expected[k]).get_value();
+                    outputs[k]->axpy(Scalar{ctx, rt, -1.0}, *expected[k]);
+                    assert(
+                        outputs[k]->dot(*outputs[k]).get_value() <=
+                        1.0e-20 * norm_squared
+                    );
+                }
+            }
+        }
+
+        // s-step CG. The relative error is at most the condition number of
+        // A, which is less than n^2, times the relative residual.
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+        const std::size_t max_iterations = 4 * static_cast<std::size_t>(n);
+        for (const KrylovBasisKind kind : kinds) {
+            for (int s = 1; s <= MAX_STEPS; ++s) {
+                x.constant_fill(0.0);
+                Solver solver{
+                    ctx,
+                    rt,
+                    A,
+                    b.get_logical_region(),
+                    b.get_fid(),
+                    x.get_logical_region(),
+                    x.get_fid(),
+                    static_cast<std::size_t>(s),
+                    kind,
+                    0.0,
+                    4.0};
+                const std::size_t iterations =
+                    solver.solve(max_iterations, tolerance);
+                assert(iterations < max_iterations);
+                assert(iterations % static_cast<std::size_t>(s) == 0);
+                assert(solver.get_residual_norm() <= tolerance * b_norm);
+                x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+                assert(
+                    x.dot(x).get_value() <= bound * bound * x_norm_squared
+                );
+            }
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, index_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_sstep_cg_csr_1d(ctx, rt, 200, 5);
+    test_sstep_cg_csr_1d(ctx, rt, 50, 1);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
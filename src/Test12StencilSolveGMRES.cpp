@@ -0,0 +1,144 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "GMRESSolver.hpp"         // for GMRESSolver
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task
+#include "Scalar.hpp"              // for Scalar
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+enum TaskIDs : Legion::TaskID { TOP_LEVEL_TASK_ID };
+
+
+// Solves the 2D convection-diffusion problem A * x = 1 on an n-by-n grid,
+// with A the nonsymmetric 5-point stencil of the Laplacian plus a
+// first-order upwind convection term, by GMRES(restart) without a
+// preconditioner and with the (right) Jacobi preconditioner diag(A)^{-1},
+// and checks the true residual of both solutions.
+template <typename ENTRY_T>
+void test_gmres_stencil_2d(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    int n,
+    int num_pieces,
+    std::size_t restart,
+    std::size_t check_interval,
+    ENTRY_T tolerance
+) {
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<ENTRY_T, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 2, int>;
+    using Solver = LegionSolvers::GMRESSolver<ENTRY_T, 2, int>;
+    using Scalar = LegionSolvers::Scalar<ENTRY_T>;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        // Diffusion coefficient 1, convection velocity (0.5, 0.25), with
+        // the convection term discretized upwind.
+        const Operator A{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {static_cast<ENTRY_T>(4.75),
+             static_cast<ENTRY_T>(-1.5),
+             static_cast<ENTRY_T>(-1.0),
+             static_cast<ENTRY_T>(-1.25),
+             static_cast<ENTRY_T>(-1.0)}};
+        const Operator jacobi{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {static_cast<ENTRY_T>(1) / static_cast<ENTRY_T>(4.75),
+             static_cast<ENTRY_T>(0),
+             static_cast<ENTRY_T>(0),
+             static_cast<ENTRY_T>(0),
+             static_cast<ENTRY_T>(0)}};
+
+        Vector b{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+        b.constant_fill(static_cast<ENTRY_T>(1));
+        const ENTRY_T b_norm = b.dot(b).sqrt().get_value();
+
+        const std::vector<const Operator *> preconditioners{nullptr, &jacobi};
+        for (const Operator *preconditioner : preconditioners) {
+            x.constant_fill(static_cast<ENTRY_T>(0));
+            Solver solver{
+                ctx,
+                rt,
+                A,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                restart,
+                check_interval};
+            const std::size_t iterations = solver.solve(
+                static_cast<std::size_t>(n * n), tolerance
+            );
+            assert(iterations < static_cast<std::size_t>(n * n));
+            assert(solver.get_residual_norm() <= tolerance * b_norm);
+
+            A.matvec(
+                r.get_logical_region(),
+                r.get_fid(),
+                x.get_logical_region(),
+                x.get_fid()
+            );
+            r.xpay(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, b);
+            assert(
+                r.dot(r).sqrt().get_value() <=
+                static_cast<ENTRY_T>(10) * tolerance * b_norm
+            );
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_gmres_stencil_2d<float>(ctx, rt, 16, 2, 30, 1, 1.0e-4f);
+    test_gmres_stencil_2d<double>(ctx, rt, 32, 4, 30, 5, 1.0e-10);
+    test_gmres_stencil_2d<double>(ctx, rt, 32, 4, 8, 3, 1.0e-10);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
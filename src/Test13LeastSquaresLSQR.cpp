@@ -0,0 +1,391 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "COOMatrix.hpp"           // for COOMatrix
+#include "CSRMatrix.hpp"           // for CSRMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "LSQRSolver.hpp"          // for LSQRSolver, LSQRStopReason
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, AffineWriter, ...
+#include "Scalar.hpp"              // for Scalar
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+    FILL_TALL_FLOAT_INT_TASK_ID,
+    FILL_TALL_DOUBLE_LONG_LONG_TASK_ID,
+};
+
+enum FieldIDs : Legion::FieldID {
+    FID_ROW,
+    FID_COL,
+    FID_ENTRY,
+    FID_ROWPTR,
+};
+
+
+// Writes the 2n-by-n matrix whose first n rows are the upper bidiagonal
+// matrix bidiag(4, -1) and whose last n rows are the lower bidiagonal matrix
+// bidiag(2, 1), in row-sorted COO form and, sharing the kernel region, in
+// CSR form, with 4n - 2 nonzeros, and the vector x[j] = j. Regions are row
+// indices, column indices, entries, row pointers, and x, all write-discard.
+template <typename ENTRY_T, typename COORD_T>
+void fill_tall_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using LegionSolvers::AffineWriter;
+    using Point = Legion::Point<1, COORD_T>;
+    using RowExtent = Legion::Rect<1, COORD_T>;
+
+    assert(regions.size() == 5);
+    assert(task->regions.size() == 5);
+    const Legion::FieldID x_fid = *task->regions[4].privilege_fields.begin();
+
+    AffineWriter<Point, 1, COORD_T> row_writer{regions[0], FID_ROW};
+    AffineWriter<Point, 1, COORD_T> col_writer{regions[1], FID_COL};
+    AffineWriter<ENTRY_T, 1, COORD_T> entry_writer{regions[2], FID_ENTRY};
+    AffineWriter<RowExtent, 1, COORD_T> rowptr_writer{regions[3], FID_ROWPTR};
+    AffineWriter<ENTRY_T, 1, COORD_T> x_writer{regions[4], x_fid};
+
+    const Legion::Rect<1, COORD_T> columns = rt->get_index_space_domain(
+        ctx, task->regions[4].region.get_index_space()
+    );
+    const COORD_T n = columns.hi[0] + 1;
+
+    COORD_T k = 0;
+    const auto add = [&](COORD_T i, COORD_T j, ENTRY_T value) {
+        row_writer[Point{k}] = Point{i};
+        col_writer[Point{k}] = Point{j};
+        entry_writer[Point{k}] = value;
+        ++k;
+    };
+    for (COORD_T i = 0; i < 2 * n; ++i) {
+        const COORD_T first = k;
+        if (i < n) {
+            add(i, i, static_cast<ENTRY_T>(4));
+            if (i + 1 < n) { add(i, i + 1, static_cast<ENTRY_T>(-1)); }
+        } else {
+            if (i > n) { add(i, i - n - 1, static_cast<ENTRY_T>(2)); }
+            add(i, i - n, static_cast<ENTRY_T>(1));
+        }
+        rowptr_writer[Point{i}] = RowExtent{first, k - 1};
+    }
+    assert(k == 4 * n - 2);
+    for (COORD_T j = 0; j < n; ++j) {
+        x_writer[Point{j}] = static_cast<ENTRY_T>(j);
+    }
+}
+
+
+// Checks that COOMatrix and CSRMatrix apply the same transpose of the tall
+// matrix written by fill_tall_task, and that (A x, y) = (x, A^T y) for
+// y = A x. Then solves min |b - A x| by LSQR, starting from x = 0, for a
+// consistent right-hand side b = A * (0, 1, ..., n - 1), where the solution
+// must be recovered, and for the inconsistent b = 1, where the normal
+// equations must be satisfied.
+template <typename ENTRY_T, typename COORD_T, Legion::TaskID FILL_TASK_ID>
+void test_lsqr_tall(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    COORD_T n,
+    long long num_pieces,
+    ENTRY_T tolerance
+) {
+    using LegionSolvers::LSQRStopReason;
+    using COO = LegionSolvers::COOMatrix<ENTRY_T, 1, COORD_T>;
+    using CSR = LegionSolvers::CSRMatrix<ENTRY_T, 1, COORD_T>;
+    using Vector = LegionSolvers::DistributedVector<ENTRY_T, 1, COORD_T>;
+    using Solver = LegionSolvers::LSQRSolver<ENTRY_T, 1, COORD_T>;
+    using Scalar = LegionSolvers::Scalar<ENTRY_T>;
+
+    const Legion::IndexSpace domain_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, n - 1});
+    const Legion::IndexSpace range_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 2 * n - 1});
+    const Legion::IndexSpace kernel_space =
+        rt->create_index_space(ctx, Legion::Rect<1, COORD_T>{0, 4 * n - 3});
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<1>{0, static_cast<int>(num_pieces) - 1}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<1, COORD_T>),
+             sizeof(Legion::Point<1, COORD_T>),
+             sizeof(ENTRY_T)},
+            {FID_ROW, FID_COL, FID_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, COORD_T>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, range_space, rowptr_field_space);
+    const Legion::IndexPartition domain_partition =
+        rt->create_equal_partition(ctx, domain_space, color_space);
+    const Legion::IndexPartition range_partition =
+        rt->create_equal_partition(ctx, range_space, color_space);
+    const Legion::IndexPartition kernel_partition =
+        rt->create_equal_partition(ctx, kernel_space, color_space);
+
+    {
+        Vector x_exact{ctx, rt, domain_partition};
+        Vector x{ctx, rt, domain_partition};
+        Vector z{ctx, rt, domain_partition};
+        Vector b{ctx, rt, range_partition};
+        Vector r{ctx, rt, range_partition};
+
+        Legion::TaskLauncher launcher{FILL_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        for (const Legion::FieldID fid : {FID_ROW, FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        const COO A{
+            ctx,
+            rt,
+            kernel_region,
+            FID_ROW,
+            FID_COL,
+            FID_ENTRY,
+            domain_space,
+            range_space,
+            kernel_partition};
+        const CSR A_csr{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            domain_space,
+            range_partition};
+
+        // b = A * x_exact; x = A^T * b (COO) and z = A^T * b (CSR).
+        A.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        A.transpose_matvec(
+            x.get_logical_region(),
+            x.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        A_csr.transpose_matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        const ENTRY_T b_b = b.dot(b).get_value();
+        const ENTRY_T x_exact_x = x_exact.dot(x).get_value();
+        const ENTRY_T identity_bound = static_cast<ENTRY_T>(n) * tolerance;
+        assert(std::abs(b_b - x_exact_x) <= identity_bound * b_b);
+        const ENTRY_T x_x = x.dot(x).get_value();
+        z.axpy(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, x);
+        assert(z.dot(z).get_value() <= tolerance * tolerance * x_x);
+
+        // Consistent: the solution of A * x = b is recovered.
+        x.constant_fill(static_cast<ENTRY_T>(0));
+        {
+            Solver solver{
+                ctx,
+                rt,
+                A,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                range_partition,
+                domain_partition};
+            const std::size_t max_iterations = 2 * static_cast<std::size_t>(n);
+            const std::size_t iterations =
+                solver.solve(max_iterations, tolerance, tolerance);
+            assert(iterations < max_iterations);
+            assert(solver.get_stop_reason() == LSQRStopReason::RESIDUAL);
+        }
+        const ENTRY_T x_norm_squared = x_exact.dot(x_exact).get_value();
+        x.axpy(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, x_exact);
+        const ENTRY_T bound = static_cast<ENTRY_T>(100) * tolerance;
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+
+        // Inconsistent: A^T (b - A x) vanishes at the solution.
+        b.constant_fill(static_cast<ENTRY_T>(1));
+        x.constant_fill(static_cast<ENTRY_T>(0));
+        ENTRY_T matrix_norm;
+        {
+            Solver solver{
+                ctx,
+                rt,
+                A_csr,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                range_partition,
+                domain_partition,
+                1};
+            const std::size_t max_iterations = 2 * static_cast<std::size_t>(n);
+            const std::size_t iterations =
+                solver.solve(max_iterations, tolerance, tolerance);
+            assert(iterations < max_iterations);
+            assert(solver.get_stop_reason() == LSQRStopReason::LEAST_SQUARES);
+            matrix_norm = solver.get_matrix_norm();
+        }
+        A.matvec(
+            r.get_logical_region(),
+            r.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        r.xpay(Scalar{ctx, rt, static_cast<ENTRY_T>(-1)}, b);
+        A.transpose_matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            r.get_logical_region(),
+            r.get_fid()
+        );
+        const ENTRY_T r_norm = r.dot(r).sqrt().get_value();
+        const ENTRY_T z_norm = z.dot(z).sqrt().get_value();
+        const ENTRY_T normal_bound = static_cast<ENTRY_T>(10) * tolerance;
+        assert(z_norm <= normal_bound * matrix_norm * r_norm);
+    }
+
+    rt->destroy_index_partition(ctx, kernel_partition);
+    rt->destroy_index_partition(ctx, range_partition);
+    rt->destroy_index_partition(ctx, domain_partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, range_space);
+    rt->destroy_index_space(ctx, domain_space);
+}
+
+
+// Checks (A x, y) = (x, A^T y) for the nonsymmetric convection-diffusion
+// stencil of Test11StencilSolveBiCGStab on an n-by-n grid, with y = A x and
+// x = 1, whose boundary makes A x nonconstant.
+void test_stencil_transpose_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n
+) {
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space =
+        rt->create_index_space(ctx, Legion::Rect<2>{{0, 0}, {1, 1}});
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator A{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.75, -1.5, -1.0, -1.25, -1.0}};
+        Vector x{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+        Vector z{ctx, rt, partition};
+        x.constant_fill(1.0);
+        A.matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        A.transpose_matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            y.get_logical_region(),
+            y.get_fid()
+        );
+        const double y_y = y.dot(y).get_value();
+        assert(std::abs(y_y - x.dot(z).get_value()) <= 1.0e-12 * y_y);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_lsqr_tall<float, int, FILL_TALL_FLOAT_INT_TASK_ID>(
+        ctx, rt, 20, 3, 1.0e-5f
+    );
+    test_lsqr_tall<double, long long, FILL_TALL_DOUBLE_LONG_LONG_TASK_ID>(
+        ctx, rt, 100, 4, 1.0e-12
+    );
+    test_stencil_transpose_2d(ctx, rt, 16);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_task<fill_tall_task<float, int>>(
+        FILL_TALL_FLOAT_INT_TASK_ID, "fill_tall_float_int", TaskFlags::LEAF
+    );
+    LegionSolvers::preregister_task<fill_tall_task<double, long long>>(
+        FILL_TALL_DOUBLE_LONG_LONG_TASK_ID,
+        "fill_tall_double_long_long",
+        TaskFlags::LEAF
+    );
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,270 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "BiCGStabSolver.hpp"            // for BiCGStabSolver
+#include "BlockJacobiPreconditioner.hpp" // for BlockJacobiPreconditioner, ...
+#include "CGSolver.hpp"                  // for CGSolver
+#include "CSRMatrix.hpp"                 // for CSRMatrix
+#include "DistributedVector.hpp"         // for DistributedVector
+#include "ExampleSystems.hpp"            // for FID_*, FILL_GRID_*_TASK_ID
+#include "LegionSolversMapper.hpp"       // for mapper_registration_callback
+#include "LegionUtilities.hpp"           // for preregister_task, ...
+#include "Scalar.hpp"                    // for Scalar
+#include "TaskRegistration.hpp"          // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_CONVECTION_ENTRY;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_GRID_MATRICES_TASK_ID;
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Checks the transpose of the ILU0 block-Jacobi preconditioner M of the
+// convection-diffusion operator, (M^{-1} u, w) = (u, M^{-T} w), and solves
+// A * x = b for b = A * x_exact, starting from x = 0, with and without
+// block-Jacobi preconditioning: by CG with IC0 for the Laplacian, and by
+// BiCGStab with ILU0 for the convection-diffusion operator. The blocks are
+// num_pieces strips of the grid. Preconditioning must converge and cut the
+// iteration count (about twofold for CG and threefold for BiCGStab with
+// n = 32 and four pieces).
+void test_block_jacobi_csr_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n, int num_pieces
+) {
+    using LegionSolvers::IncompleteFactorization;
+    using Matrix = LegionSolvers::CSRMatrix<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Preconditioner =
+        LegionSolvers::BlockJacobiPreconditioner<double, 2, int>;
+    using CG = LegionSolvers::CGSolver<double, 2, int>;
+    using BiCGStab = LegionSolvers::BiCGStabSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double tolerance = 1.0e-10;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace kernel_space = rt->create_index_space(
+        ctx, Legion::Rect<1, int>{0, 5 * n * n - 4 * n - 1}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<2, int>), sizeof(double), sizeof(double)},
+            {FID_COL, FID_ENTRY, FID_CONVECTION_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, int>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, grid_space, rowptr_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_MATRICES_TASK_ID, Legion::TaskArgument{&n, sizeof(int)}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid :
+             {FID_COL, FID_ENTRY, FID_CONVECTION_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        rt->execute_task(ctx, launcher);
+
+        Legion::TaskLauncher x_launcher{
+            FILL_GRID_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        x_launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        x_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, x_launcher);
+
+        const Matrix laplacian{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            grid_space,
+            partition};
+        const Matrix convection{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_CONVECTION_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            grid_space,
+            partition};
+        const Preconditioner ic0{
+            ctx, rt, laplacian, IncompleteFactorization::IC0};
+        const Preconditioner ilu0{
+            ctx, rt, convection, IncompleteFactorization::ILU0};
+
+        // (M^{-1} u, w) = (u, M^{-T} w) for u = x_exact and w = A * x_exact.
+        convection.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        ilu0.matvec(
+            x.get_logical_region(),
+            x.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        ilu0.transpose_matvec(
+            r.get_logical_region(),
+            r.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        const double forward = x.dot(b).get_value();
+        const double adjoint = x_exact.dot(r).get_value();
+        assert(std::abs(forward - adjoint) <= 1.0e-12 * std::abs(forward));
+
+        // The relative error is at most the condition number of A, which is
+        // less than n^2, times the relative residual.
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+        const std::size_t max_iterations = static_cast<std::size_t>(n * n);
+
+        // CG on the Laplacian, without and with IC0.
+        laplacian.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        std::vector<std::size_t> cg_iterations;
+        for (const Preconditioner *preconditioner : {
+                 static_cast<const Preconditioner *>(nullptr), &ic0}) {
+            x.constant_fill(0.0);
+            CG solver{
+                ctx,
+                rt,
+                laplacian,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                1};
+            cg_iterations.push_back(solver.solve(max_iterations, tolerance));
+            assert(cg_iterations.back() < max_iterations);
+            x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+            assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+        }
+        assert(3 * cg_iterations[1] < 2 * cg_iterations[0]);
+
+        // BiCGStab on the convection-diffusion operator, without and with
+        // ILU0.
+        convection.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        std::vector<std::size_t> bicgstab_iterations;
+        for (const Preconditioner *preconditioner : {
+                 static_cast<const Preconditioner *>(nullptr), &ilu0}) {
+            x.constant_fill(0.0);
+            BiCGStab solver{
+                ctx,
+                rt,
+                convection,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                1};
+            bicgstab_iterations.push_back(
+                solver.solve(max_iterations, tolerance)
+            );
+            assert(bicgstab_iterations.back() < max_iterations);
+            x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+            assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+        }
+        assert(2 * bicgstab_iterations[1] < bicgstab_iterations[0]);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_block_jacobi_csr_2d(ctx, rt, 32, 4);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
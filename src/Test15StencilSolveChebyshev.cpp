@@ -0,0 +1,231 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs, std::cos, std::sin
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CGSolver.hpp"                // for CGSolver
+#include "ChebyshevPreconditioner.hpp" // for ChebyshevPreconditioner, ...
+#include "DistributedVector.hpp"       // for DistributedVector
+#include "ExampleSystems.hpp"          // for FILL_GRID_VECTOR_TASK_ID
+#include "LegionSolversMapper.hpp"     // for mapper_registration_callback
+#include "LegionUtilities.hpp"         // for preregister_task
+#include "Scalar.hpp"                  // for Scalar
+#include "StencilOperator.hpp"         // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"        // for preregister_tasks
+
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Estimates the spectrum of the 5-point Laplacian A on an n-by-n grid by
+// Lanczos from b = A * x_exact, and checks that the bounds contain it. Then
+// solves A * x = b from x = 0 by CG without a preconditioner and with a
+// Chebyshev polynomial preconditioner of the given degree, which must cut
+// the iteration count more than threefold (103 against 23 iterations for
+// n = 32 and degree 8), and checks that one smoothing step from x = 0
+// reduces the error. Finally checks the transpose of a Chebyshev
+// preconditioner of the nonsymmetric convection-diffusion operator of
+// Test11StencilSolveBiCGStab, (p(A) u, w) = (u, p(A^T) w).
+void test_chebyshev_stencil_2d(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    int n,
+    int num_pieces,
+    std::size_t degree
+) {
+    using LegionSolvers::EigenvalueBounds;
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Chebyshev = LegionSolvers::ChebyshevPreconditioner<double, 2, int>;
+    using CG = LegionSolvers::CGSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double pi = 3.14159265358979323846;
+    const double tolerance = 1.0e-10;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator laplacian{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0, -1.0, -1.0, -1.0, -1.0}};
+        const Operator convection{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.75, -1.5, -1.0, -1.25, -1.0}};
+
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        laplacian.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+
+        // The eigenvalues of A are 4 - 2 cos(pi k / (n + 1)) - 2 cos(pi l /
+        // (n + 1)) for 1 <= k, l <= n.
+        const double angle = pi / static_cast<double>(n + 1);
+        const double lambda_min =
+            8.0 * std::sin(angle / 2) * std::sin(angle / 2);
+        const double lambda_max = 4.0 + 4.0 * std::cos(angle);
+        const EigenvalueBounds<double> bounds =
+            Chebyshev::estimate_eigenvalue_bounds(
+                ctx,
+                rt,
+                laplacian,
+                b.get_logical_region(),
+                b.get_fid(),
+                partition,
+                20
+            );
+        assert(lambda_min <= bounds.lower);
+        assert(bounds.lower < bounds.upper);
+        assert(lambda_max <= bounds.upper);
+        assert(bounds.upper <= 1.1 * lambda_max);
+
+        // CG without and with the Chebyshev preconditioner. The relative
+        // error is at most the condition number of A, which is less than
+        // n^2, times the relative residual.
+        const Chebyshev chebyshev{
+            ctx, rt, laplacian, partition, degree, bounds};
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+        const std::size_t max_iterations = static_cast<std::size_t>(n * n);
+        std::vector<std::size_t> cg_iterations;
+        for (const Chebyshev *preconditioner : {
+                 static_cast<const Chebyshev *>(nullptr), &chebyshev}) {
+            x.constant_fill(0.0);
+            CG solver{
+                ctx,
+                rt,
+                laplacian,
+                b.get_logical_region(),
+                b.get_fid(),
+                x.get_logical_region(),
+                x.get_fid(),
+                partition,
+                preconditioner,
+                1};
+            cg_iterations.push_back(solver.solve(max_iterations, tolerance));
+            assert(cg_iterations.back() < max_iterations);
+            x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+            assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+        }
+        assert(3 * cg_iterations[1] < cg_iterations[0]);
+
+        // One smoothing step on the upper part of the spectrum.
+        const Chebyshev smoother{
+            ctx,
+            rt,
+            laplacian,
+            partition,
+            3,
+            EigenvalueBounds<double>{bounds.upper / 30.0, bounds.upper}};
+        x.constant_fill(0.0);
+        smoother.smooth(
+            x.get_logical_region(),
+            x.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() < x_norm_squared);
+
+        // (p(A) u, w) = (u, p(A^T) w) for u = x_exact and w = A * x_exact.
+        // The eigenvalues of A are real and lie in (0, 9.5).
+        const Chebyshev nonsymmetric{
+            ctx,
+            rt,
+            convection,
+            partition,
+            degree,
+            EigenvalueBounds<double>{0.5, 9.5}};
+        convection.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.matvec(
+            x.get_logical_region(),
+            x.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.transpose_matvec(
+            r.get_logical_region(),
+            r.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        const double forward = x.dot(b).get_value();
+        const double adjoint = x_exact.dot(r).get_value();
+        assert(std::abs(forward - adjoint) <= 1.0e-12 * std::abs(forward));
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_chebyshev_stencil_2d(ctx, rt, 32, 4, 8);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,281 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "AMGPreconditioner.hpp"   // for AMGPreconditioner, AMGOptions
+#include "CGSolver.hpp"            // for CGSolver
+#include "CSRMatrix.hpp"           // for CSRMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_GRID_*_TASK_ID
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, ...
+#include "Scalar.hpp"              // for Scalar
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_CONVECTION_ENTRY;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_GRID_MATRICES_TASK_ID;
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Builds smoothed-aggregation AMG preconditioners of the 5-point Laplacian
+// and of the convection-diffusion operator on an n-by-n grid, split into
+// num_pieces strips, with coarse levels of at least 64 rows per piece so
+// that the partitions of the levels shrink. Checks the transpose of the
+// convection-diffusion preconditioner, (M^{-1} u, w) = (u, M^{-T} w), then
+// solves the Laplacian system A * x = b for b = A * x_exact from x = 0 by
+// CG with AMG, and returns the number of iterations, which must be small
+// (17 for n = 32 and n = 64 in a serial prototype of the same hierarchy,
+// against 103 and 203 without a preconditioner).
+std::size_t test_amg_csr_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n, int num_pieces
+) {
+    using LegionSolvers::AMGLevelInfo;
+    using LegionSolvers::AMGOptions;
+    using Matrix = LegionSolvers::CSRMatrix<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Preconditioner = LegionSolvers::AMGPreconditioner<double, 2, int>;
+    using CG = LegionSolvers::CGSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double tolerance = 1.0e-10;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace kernel_space = rt->create_index_space(
+        ctx, Legion::Rect<1, int>{0, 5 * n * n - 4 * n - 1}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<2, int>), sizeof(double), sizeof(double)},
+            {FID_COL, FID_ENTRY, FID_CONVECTION_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, int>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, grid_space, rowptr_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    std::size_t iterations = 0;
+    {
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_MATRICES_TASK_ID, Legion::TaskArgument{&n, sizeof(int)}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid :
+             {FID_COL, FID_ENTRY, FID_CONVECTION_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        rt->execute_task(ctx, launcher);
+
+        Legion::TaskLauncher x_launcher{
+            FILL_GRID_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        x_launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        x_launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, x_launcher);
+
+        const Matrix laplacian{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            grid_space,
+            partition};
+        const Matrix convection{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_CONVECTION_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            grid_space,
+            partition};
+        AMGOptions options;
+        options.min_rows_per_piece = 64;
+        const Preconditioner amg{ctx, rt, laplacian, options, true};
+        const Preconditioner nonsymmetric{ctx, rt, convection, options};
+
+        // Every level but the coarsest is at most 90% of the one above, and
+        // the coarsest is small or at the level limit, where it is reported
+        // as having stopped early if it is not small.
+        const std::vector<AMGLevelInfo> &levels = amg.get_level_info();
+        assert(levels.size() == amg.get_num_levels());
+        assert(levels.front().num_rows == static_cast<std::size_t>(n * n));
+        for (std::size_t k = 1; k < levels.size(); ++k) {
+            assert(10 * levels[k].num_rows <= 9 * levels[k - 1].num_rows);
+            assert(levels[k].num_pieces <= levels[k - 1].num_pieces);
+            assert(levels[k - 1].prolongator_bytes > 0);
+        }
+        assert(
+            (levels.back().num_rows <= options.max_coarse_size) ||
+            (levels.size() == options.max_levels)
+        );
+        assert(
+            levels.back().stopped_early ==
+            (levels.back().num_rows > options.max_coarse_size)
+        );
+        assert(amg.get_setup_seconds() >= 0.0);
+
+        // (M^{-1} u, w) = (u, M^{-T} w) for u = x_exact and w = A * x_exact.
+        convection.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.matvec(
+            x.get_logical_region(),
+            x.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.transpose_matvec(
+            r.get_logical_region(),
+            r.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        const double forward = x.dot(b).get_value();
+        const double adjoint = x_exact.dot(r).get_value();
+        assert(std::abs(forward - adjoint) <= 1.0e-10 * std::abs(forward));
+
+        // CG on the Laplacian with AMG. The relative error is at most the
+        // condition number of A, which is less than n^2, times the relative
+        // residual.
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+        laplacian.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        x.constant_fill(0.0);
+        CG solver{
+            ctx,
+            rt,
+            laplacian,
+            b.get_logical_region(),
+            b.get_fid(),
+            x.get_logical_region(),
+            x.get_fid(),
+            partition,
+            &amg,
+            1};
+        iterations = solver.solve(static_cast<std::size_t>(n * n), tolerance);
+        assert(iterations <= 25);
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+
+        // A hierarchy cut off at two levels ends above max_coarse_size, so
+        // its coarsest level is solved by Chebyshev iteration rather than
+        // factored, and it still preconditions CG.
+        AMGOptions truncated_options = options;
+        truncated_options.max_levels = 2;
+        const Preconditioner truncated{ctx, rt, laplacian, truncated_options};
+        assert(truncated.get_num_levels() == 2);
+        assert(truncated.get_level_info().back().stopped_early);
+        x.constant_fill(0.0);
+        CG truncated_solver{
+            ctx,
+            rt,
+            laplacian,
+            b.get_logical_region(),
+            b.get_fid(),
+            x.get_logical_region(),
+            x.get_fid(),
+            partition,
+            &truncated,
+            1};
+        truncated_solver.solve(static_cast<std::size_t>(n * n), tolerance);
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, grid_space);
+    return iterations;
+}
+
+
+// The iteration count of CG with AMG must stay roughly constant under mesh
+// refinement.
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    const std::size_t coarse = test_amg_csr_2d(ctx, rt, 32, 4);
+    const std::size_t fine = test_amg_csr_2d(ctx, rt, 64, 4);
+    assert(fine <= coarse + 3);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,214 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "CGSolver.hpp"            // for CGSolver
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FILL_GRID_VECTOR_TASK_ID
+#include "GMGPreconditioner.hpp"   // for GMGPreconditioner, GMGOptions
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task
+#include "Scalar.hpp"              // for Scalar
+#include "StencilOperator.hpp"     // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Builds geometric multigrid preconditioners of the 5-point Laplacian and
+// of the convection-diffusion operator of Test11StencilSolveBiCGStab on an
+// n-by-n grid (n odd), split into num_pieces strips, with coarse levels of
+// at least 64 points per piece so that the lower levels are agglomerated.
+// Checks the grids of the levels and the transpose of the
+// convection-diffusion preconditioner, (M^{-1} u, w) = (u, M^{-T} w), then
+// solves the Laplacian system A * x = b for b = A * x_exact from x = 0 by
+// CG with GMG, and returns the number of iterations, which must be small
+// (16 for n = 31 and n = 63 in a serial prototype of the same hierarchy,
+// against 100 and 200 without a preconditioner).
+std::size_t test_gmg_stencil_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n, int num_pieces
+) {
+    using LegionSolvers::GMGOptions;
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using Preconditioner = LegionSolvers::GMGPreconditioner<double, 2, int>;
+    using CG = LegionSolvers::CGSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double tolerance = 1.0e-10;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    std::size_t iterations = 0;
+    {
+        const Operator laplacian{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0, -1.0, -1.0, -1.0, -1.0}};
+        const Operator convection{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.75, -1.5, -1.0, -1.25, -1.0}};
+
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+        Vector r{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        GMGOptions options;
+        options.min_points_per_piece = 64;
+        const Preconditioner gmg{ctx, rt, laplacian, options, true};
+        const Preconditioner nonsymmetric{ctx, rt, convection, options};
+
+        // Level k is a grid of (n + 1) / 2^k - 1 points per side, down to
+        // at most max_coarse_size points, with no more pieces than the level
+        // above.
+        assert(gmg.get_num_levels() > 1);
+        std::size_t previous_pieces = static_cast<std::size_t>(num_pieces);
+        for (std::size_t k = 0; k < gmg.get_num_levels(); ++k) {
+            const int m = ((n + 1) >> k) - 1;
+            const Legion::Rect<2, int> level_grid =
+                rt->get_index_space_domain(ctx, gmg.get_level_space(k));
+            assert(level_grid.lo[0] == 0 && level_grid.hi[0] == m - 1);
+            assert(level_grid.lo[1] == 0 && level_grid.hi[1] == m - 1);
+            const std::size_t pieces =
+                rt->get_index_space_domain(
+                      ctx,
+                      rt->get_index_partition_color_space_name(
+                          ctx, gmg.get_level_partition(k)
+                      )
+                )
+                    .get_volume();
+            assert(pieces <= previous_pieces);
+            previous_pieces = pieces;
+        }
+        const std::size_t coarsest_points =
+            rt->get_index_space_domain(
+                  ctx, gmg.get_level_space(gmg.get_num_levels() - 1)
+            )
+                .get_volume();
+        assert(
+            (coarsest_points <= options.max_coarse_size) ||
+            (gmg.get_num_levels() == options.max_levels)
+        );
+
+        // (M^{-1} u, w) = (u, M^{-T} w) for u = x_exact and w = A * x_exact.
+        convection.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.matvec(
+            x.get_logical_region(),
+            x.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        nonsymmetric.transpose_matvec(
+            r.get_logical_region(),
+            r.get_fid(),
+            b.get_logical_region(),
+            b.get_fid()
+        );
+        const double forward = x.dot(b).get_value();
+        const double adjoint = x_exact.dot(r).get_value();
+        assert(std::abs(forward - adjoint) <= 1.0e-10 * std::abs(forward));
+
+        // CG on the Laplacian with GMG. The relative error is at most the
+        // condition number of A, which is less than n^2, times the relative
+        // residual.
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+        laplacian.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        x.constant_fill(0.0);
+        CG solver{
+            ctx,
+            rt,
+            laplacian,
+            b.get_logical_region(),
+            b.get_fid(),
+            x.get_logical_region(),
+            x.get_fid(),
+            partition,
+            &gmg,
+            1};
+        iterations = solver.solve(static_cast<std::size_t>(n * n), tolerance);
+        assert(iterations <= 25);
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+    return iterations;
+}
+
+
+// The iteration count of CG with GMG must stay roughly constant under mesh
+// refinement.
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    const std::size_t coarse = test_gmg_stencil_2d(ctx, rt, 31, 4);
+    const std::size_t fine = test_gmg_stencil_2d(ctx, rt, 63, 4);
+    assert(fine <= coarse + 3);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,164 @@
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"         // for DistributedVector
+#include "ExampleSystems.hpp"            // for FILL_GRID_VECTOR_TASK_ID
+#include "GMGPreconditioner.hpp"         // for GMGPreconditioner
+#include "IterativeRefinementSolver.hpp" // for IterativeRefinementSolver
+#include "LegionSolversMapper.hpp"       // for mapper_registration_callback
+#include "LegionUtilities.hpp"           // for preregister_task
+#include "Scalar.hpp"                    // for Scalar
+#include "StencilOperator.hpp"           // for StencilOperator, StencilShape
+#include "TaskRegistration.hpp"          // for preregister_tasks
+
+using LegionSolvers::FILL_GRID_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+
+// Checks the precision conversions of DistributedVector on x_exact, whose
+// entries are integers below 2^24 and hence exact in float. Then solves the
+// 5-point Laplacian system A * x = b on an n-by-n grid, for b = A * x_exact,
+// by iterative refinement from x = 0, with inner CG solves in float
+// preconditioned by geometric multigrid in float, and checks that the
+// residual and error reach double-precision levels, far below the unit
+// roundoff of float (about 6e-8), in a few refinement steps.
+void test_mixed_precision_stencil_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n, int num_pieces
+) {
+    using LegionSolvers::StencilShape;
+    using Operator = LegionSolvers::StencilOperator<double, 2, int>;
+    using LowOperator = LegionSolvers::StencilOperator<float, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using LowVector = LegionSolvers::DistributedVector<float, 2, int>;
+    using LowGMG = LegionSolvers::GMGPreconditioner<float, 2, int>;
+    using Solver = LegionSolvers::IterativeRefinementSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double tolerance = 1.0e-12;
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        const Operator laplacian{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0, -1.0, -1.0, -1.0, -1.0}};
+        const LowOperator low_laplacian{
+            ctx,
+            rt,
+            grid_space,
+            partition,
+            StencilShape::STAR,
+            {4.0f, -1.0f, -1.0f, -1.0f, -1.0f}};
+
+        Vector x_exact{ctx, rt, partition};
+        Vector x{ctx, rt, partition};
+        Vector b{ctx, rt, partition};
+        LowVector low{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x_exact.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x_exact.get_logical_region()})
+            .add_field(x_exact.get_fid());
+        rt->execute_task(ctx, launcher);
+        const double x_norm_squared = x_exact.dot(x_exact).get_value();
+
+        // x_exact -> float -> double is exact, and so is x_exact - 2 * low
+        // + x_exact.
+        low.convert(x_exact);
+        x.convert(low);
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() == 0.0);
+        x.copy(x_exact);
+        x.axpy_convert(Scalar{ctx, rt, -2.0}, low);
+        x.axpy(Scalar{ctx, rt, 1.0}, x_exact);
+        assert(x.dot(x).get_value() == 0.0);
+
+        // Iterative refinement. The relative error is at most the condition
+        // number of A, which is less than n^2, times the relative residual.
+        laplacian.matvec(
+            b.get_logical_region(),
+            b.get_fid(),
+            x_exact.get_logical_region(),
+            x_exact.get_fid()
+        );
+        const LowGMG gmg{ctx, rt, low_laplacian};
+        x.constant_fill(0.0);
+        Solver solver{
+            ctx,
+            rt,
+            laplacian,
+            low_laplacian,
+            b.get_logical_region(),
+            b.get_fid(),
+            x.get_logical_region(),
+            x.get_fid(),
+            partition,
+            &gmg,
+            1};
+        const std::size_t steps = solver.solve(10, tolerance, 50);
+        assert(steps <= 6);
+        assert(solver.get_inner_iterations() > 0);
+        const double b_norm_squared = b.dot(b).get_value();
+        const double residual_norm = solver.get_residual_norm();
+        assert(
+            residual_norm * residual_norm <=
+            tolerance * tolerance * b_norm_squared
+        );
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        x.axpy(Scalar{ctx, rt, -1.0}, x_exact);
+        assert(x.dot(x).get_value() <= bound * bound * x_norm_squared);
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_mixed_precision_stencil_2d(ctx, rt, 63, 4);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -0,0 +1,311 @@
+#include <cassert> // for assert
+#include <cmath>   // for std::abs
+#include <cstddef> // for std::size_t
+#include <vector>  // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "BlockCGSolver.hpp"       // for BlockCGSolver
+#include "CGSolver.hpp"            // for CGSolver
+#include "CSRMatrix.hpp"           // for CSRMatrix
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FID_*, FILL_GRID_MATRICES_TASK_ID
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, ...
+#include "MultiVector.hpp"         // for MultiVector
+#include "PackedScalars.hpp"       // for BlockScalars
+#include "Scalar.hpp"              // for Scalar
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FID_COL;
+using LegionSolvers::FID_ENTRY;
+using LegionSolvers::FID_ROWPTR;
+using LegionSolvers::FILL_GRID_MATRICES_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+    FILL_VECTORS_TASK_ID,
+};
+
+
+// Writes, on an n-by-n grid, k vectors x_c[i, j] = ((2c + 3) i + (c + 1) j^2
+// + c) mod 17 - 8. The only region is x, with k fields, write-discard.
+void fill_vectors_task(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(regions.size() == 1);
+    assert(task->regions.size() == 1);
+    const std::vector<Legion::FieldID> &x_fids =
+        task->regions[0].instance_fields;
+    std::vector<LegionSolvers::AffineWriter<double, 2, int>> x_writers;
+    for (const Legion::FieldID fid : x_fids) {
+        x_writers.emplace_back(regions[0], fid);
+    }
+
+    const Legion::Rect<2, int> grid = rt->get_index_space_domain(
+        ctx, task->regions[0].region.get_index_space()
+    );
+    for (Legion::PointInRectIterator<2, int> iter{grid}; iter(); ++iter) {
+        const int i = (*iter)[0];
+        const int j = (*iter)[1];
+        for (int c = 0; c < static_cast<int>(x_writers.size()); ++c) {
+            const int value = ((2 * c + 3) * i + (c + 1) * j * j + c) % 17;
+            x_writers[c][*iter] = static_cast<double>(value - 8);
+        }
+    }
+}
+
+
+// Checks, for the 5-point Laplacian A on an n-by-n grid split into
+// num_pieces strips and num_vectors = k right-hand sides:
+//   1. the sparse matrix times multi-vector product against one matvec per
+//      vector, and the block dot product against one dot per pair;
+//   2. block CG on A * X = B for B = A * X_exact from X = 0, which must
+//      reach the tolerance on every column in fewer iterations than CG on
+//      the first column alone (62 against 105 for n = 32 and k = 8 in a
+//      serial prototype), or, for k = 1, in as many iterations as CG, up to
+//      rounding;
+//   3. block CG with two equal right-hand sides, whose block Gram matrices
+//      are singular, which must converge all the same.
+void test_block_cg_csr_2d(
+    Legion::Context ctx, Legion::Runtime *rt, int n, int num_pieces, int k
+) {
+    using LegionSolvers::BlockScalars;
+    using Matrix = LegionSolvers::CSRMatrix<double, 2, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 2, int>;
+    using MultiVector = LegionSolvers::MultiVector<double, 2, int>;
+    using BlockCG = LegionSolvers::BlockCGSolver<double, 2, int>;
+    using CG = LegionSolvers::CGSolver<double, 2, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const double tolerance = 1.0e-10;
+    const std::size_t num_vectors = static_cast<std::size_t>(k);
+
+    const Legion::IndexSpace grid_space = rt->create_index_space(
+        ctx, Legion::Rect<2, int>{{0, 0}, {n - 1, n - 1}}
+    );
+    const Legion::IndexSpace kernel_space = rt->create_index_space(
+        ctx, Legion::Rect<1, int>{0, 5 * n * n - 4 * n - 1}
+    );
+    const Legion::IndexSpace color_space = rt->create_index_space(
+        ctx, Legion::Rect<2>{{0, 0}, {num_pieces - 1, 0}}
+    );
+    const Legion::FieldSpace kernel_field_space =
+        LegionSolvers::create_field_space(
+            ctx,
+            rt,
+            {sizeof(Legion::Point<2, int>), sizeof(double)},
+            {FID_COL, FID_ENTRY}
+        );
+    const Legion::FieldSpace rowptr_field_space =
+        LegionSolvers::create_field_space(
+            ctx, rt, {sizeof(Legion::Rect<1, int>)}, {FID_ROWPTR}
+        );
+    const Legion::LogicalRegion kernel_region =
+        rt->create_logical_region(ctx, kernel_space, kernel_field_space);
+    const Legion::LogicalRegion rowptr_region =
+        rt->create_logical_region(ctx, grid_space, rowptr_field_space);
+    const Legion::IndexPartition partition =
+        rt->create_equal_partition(ctx, grid_space, color_space);
+
+    {
+        MultiVector x_exact{ctx, rt, partition, num_vectors};
+        MultiVector x{ctx, rt, partition, num_vectors};
+        MultiVector b{ctx, rt, partition, num_vectors};
+        Vector r{ctx, rt, partition};
+        Vector y{ctx, rt, partition};
+
+        Legion::TaskLauncher launcher{
+            FILL_GRID_MATRICES_TASK_ID, Legion::TaskArgument{&n, sizeof(int)}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                rowptr_region,
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                rowptr_region})
+            .add_field(FID_ROWPTR);
+        for (const Legion::FieldID fid : {FID_COL, FID_ENTRY}) {
+            launcher
+                .add_region_requirement(Legion::RegionRequirement{
+                    kernel_region,
+                    LEGION_WRITE_DISCARD,
+                    LEGION_EXCLUSIVE,
+                    kernel_region})
+                .add_field(fid);
+        }
+        rt->execute_task(ctx, launcher);
+
+        Legion::TaskLauncher x_launcher{
+            FILL_VECTORS_TASK_ID, Legion::TaskArgument{}};
+        x_launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        x_launcher.add_region_requirement(Legion::RegionRequirement{
+            x_exact.get_logical_region(),
+            LEGION_WRITE_DISCARD,
+            LEGION_EXCLUSIVE,
+            x_exact.get_logical_region()});
+        for (const Legion::FieldID fid : x_exact.get_fids()) {
+            x_launcher.region_requirements.back().add_field(fid);
+        }
+        rt->execute_task(ctx, x_launcher);
+
+        const Matrix laplacian{
+            ctx,
+            rt,
+            kernel_region,
+            FID_COL,
+            FID_ENTRY,
+            rowptr_region,
+            FID_ROWPTR,
+            grid_space,
+            partition};
+
+        // 1. B = A * X_exact in one pass over A, against A * x_c.
+        laplacian.matmat(
+            b.get_logical_region(),
+            b.get_fids(),
+            x_exact.get_logical_region(),
+            x_exact.get_fids()
+        );
+        const Legion::Future gram = x_exact.dot(b);
+        const BlockScalars<double> block =
+            gram.get_result<BlockScalars<double>>();
+        for (std::size_t c = 0; c < num_vectors; ++c) {
+            laplacian.matvec(
+                r.get_logical_region(),
+                r.get_fid(),
+                x_exact.get_vector(c).get_logical_region(),
+                x_exact.get_vector(c).get_fid()
+            );
+            r.axpy(Scalar{ctx, rt, -1.0}, b.get_vector(c));
+            const double b_norm_squared =
+                b.get_vector(c).dot(b.get_vector(c)).get_value();
+            assert(r.dot(r).get_value() <= 1.0e-24 * b_norm_squared);
+            for (std::size_t d = 0; d < num_vectors; ++d) {
+                const double expected =
+                    x_exact.get_vector(c).dot(b.get_vector(d)).get_value();
+                assert(
+                    std::abs(block(c, d) - expected) <=
+                    1.0e-12 * std::abs(expected) + 1.0e-12
+                );
+            }
+        }
+
+        // 2. Block CG against CG on the first column. The relative error is
+        // at most the condition number of A, which is less than n^2, times
+        // the relative residual.
+        const double bound =
+            static_cast<double>(n) * static_cast<double>(n) * tolerance;
+        y.constant_fill(0.0);
+        CG single{
+            ctx,
+            rt,
+            laplacian,
+            b.get_vector(0).get_logical_region(),
+            b.get_vector(0).get_fid(),
+            y.get_logical_region(),
+            y.get_fid(),
+            partition,
+            nullptr,
+            1};
+        const std::size_t single_iterations =
+            single.solve(static_cast<std::size_t>(n * n), tolerance);
+
+        x.constant_fill(0.0);
+        BlockCG solver{
+            ctx,
+            rt,
+            laplacian,
+            b.get_logical_region(),
+            b.get_fids(),
+            x.get_logical_region(),
+            x.get_fids(),
+            partition,
+            nullptr,
+            1};
+        const std::size_t iterations =
+            solver.solve(static_cast<std::size_t>(n * n), tolerance);
+        if (num_vectors == 1) {
+            assert(iterations <= single_iterations + 1);
+        } else {
+            assert(iterations < single_iterations);
+        }
+        for (std::size_t c = 0; c < num_vectors; ++c) {
+            Vector &x_c = x.get_vector(c);
+            const Vector &exact = x_exact.get_vector(c);
+            const double x_norm_squared = exact.dot(exact).get_value();
+            x_c.axpy(Scalar{ctx, rt, -1.0}, exact);
+            assert(x_c.dot(x_c).get_value() <= bound * bound * x_norm_squared);
+        }
+
+        // 3. b_{k - 1} = b_0, so the solutions of both columns are x_0.
+        if (num_vectors > 1) {
+            b.get_vector(num_vectors - 1).copy(b.get_vector(0));
+            x.constant_fill(0.0);
+            BlockCG dependent{
+                ctx,
+                rt,
+                laplacian,
+                b.get_logical_region(),
+                b.get_fids(),
+                x.get_logical_region(),
+                x.get_fids(),
+                partition,
+                nullptr,
+                1};
+            dependent.solve(static_cast<std::size_t>(n * n), tolerance);
+            for (std::size_t c = 0; c < num_vectors; ++c) {
+                Vector &x_c = x.get_vector(c);
+                const Vector &exact =
+                    x_exact.get_vector((c + 1 == num_vectors) ? 0 : c);
+                const double x_norm_squared = exact.dot(exact).get_value();
+                x_c.axpy(Scalar{ctx, rt, -1.0}, exact);
+                assert(
+                    x_c.dot(x_c).get_value() <=
+                    bound * bound * x_norm_squared
+                );
+            }
+        }
+    }
+
+    rt->destroy_index_partition(ctx, partition);
+    rt->destroy_logical_region(ctx, rowptr_region);
+    rt->destroy_logical_region(ctx, kernel_region);
+    rt->destroy_field_space(ctx, rowptr_field_space);
+    rt->destroy_field_space(ctx, kernel_field_space);
+    rt->destroy_index_space(ctx, color_space);
+    rt->destroy_index_space(ctx, kernel_space);
+    rt->destroy_index_space(ctx, grid_space);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    test_block_cg_csr_2d(ctx, rt, 32, 4, 8);
+    test_block_cg_csr_2d(ctx, rt, 32, 3, 1);
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_task<fill_vectors_task>(
+        FILL_VECTORS_TASK_ID, "fill_vectors", TaskFlags::LEAF
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
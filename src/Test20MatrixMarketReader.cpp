@@ -0,0 +1,236 @@
+#include <algorithm> // for std::shuffle
+#include <cassert>   // for assert
+#include <cstddef>   // for std::size_t, std::ptrdiff_t
+#include <fstream>   // for std::ofstream
+#include <random>    // for std::mt19937
+#include <string>    // for std::string, std::to_string
+#include <vector>    // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FILL_PERIODIC_VECTOR_TASK_ID, ...
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, ...
+#include "MatrixMarketReader.hpp"  // for MatrixMarketReader
+#include "Scalar.hpp"              // for Scalar
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FILL_PERIODIC_VECTOR_TASK_ID;
+using LegionSolvers::periodic_entry;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+const char *const LAPLACIAN_PATH = "Test20Laplacian.mtx";
+const char *const SKEW_PATH = "Test20Skew.mtx";
+const char *const RECTANGULAR_PATH = "Test20Rectangular.mtx";
+constexpr int N = 1'000;
+
+
+// Writes the entry lines of a Matrix Market file in a scrambled order, with
+// a comment and a blank line among them, CRLF line endings on every third
+// line, and no newline after the last one.
+void write_matrix_market(
+    const char *path,
+    const std::string &header,
+    std::vector<std::string> lines
+) {
+    std::mt19937 generator{20};
+    std::shuffle(lines.begin(), lines.end(), generator);
+    const auto middle = static_cast<std::ptrdiff_t>(lines.size() / 2);
+    lines.insert(lines.begin() + middle, "% comment");
+    const auto third = static_cast<std::ptrdiff_t>(lines.size() / 3);
+    lines.insert(lines.begin() + third, "");
+    std::ofstream file{path, std::ios::binary};
+    file << header;
+    for (std::size_t k = 0; k < lines.size(); ++k) {
+        file << lines[k];
+        if (k % 3 == 2) { file << '\r'; }
+        if (k + 1 < lines.size()) { file << '\n'; }
+    }
+}
+
+
+// Writes the n-by-n matrices of the test:
+//   1. the 1D Laplacian (entries 2 and -1), as a real symmetric matrix,
+//      each diagonal entry being split into two entries 1.5 and 0.5 to be
+//      summed, written in different styles;
+//   2. the skew-symmetric matrix with ones below the diagonal, as an
+//      integer matrix;
+//   3. the n-by-(n + 1) matrix with ones on the diagonal and above it, as a
+//      general pattern matrix.
+void write_test_matrices(int n) {
+    std::vector<std::string> laplacian;
+    std::vector<std::string> skew;
+    std::vector<std::string> rectangular;
+    for (int i = 1; i <= n; ++i) {
+        const std::string row = std::to_string(i);
+        laplacian.push_back(row + " " + row + " 1.5");
+        laplacian.push_back("  " + row + "\t" + row + " .5e0");
+        if (i < n) {
+            const std::string next = std::to_string(i + 1);
+            laplacian.push_back(
+                next + " " + row + ((i % 2 == 0) ? " -1" : " -1.0E+00")
+            );
+            skew.push_back(next + " " + row + " 1");
+        }
+        rectangular.push_back(row + " " + row);
+        rectangular.push_back(row + " " + std::to_string(i + 1));
+    }
+    const std::string size = std::to_string(n);
+    write_matrix_market(
+        LAPLACIAN_PATH,
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% written by Test20MatrixMarketReader\n" +
+            size + " " + size + " " + std::to_string(laplacian.size()) + "\n",
+        laplacian
+    );
+    write_matrix_market(
+        SKEW_PATH,
+        "%%MatrixMarket matrix coordinate integer skew-symmetric\n" + size +
+            " " + size + " " + std::to_string(skew.size()) + "\n",
+        skew
+    );
+    write_matrix_market(
+        RECTANGULAR_PATH,
+        "%%MatrixMarket matrix coordinate pattern general\n" + size + " " +
+            std::to_string(n + 1) + " " + std::to_string(rectangular.size()) +
+            "\n",
+        rectangular
+    );
+}
+
+
+// Reads the matrix A at path with num_readers reader tasks into num_pieces
+// pieces, and checks its number of nonzeros and ||A * x||^2, for x as
+// written by fill_periodic_vector_task, against the expected values, with A
+// both in CSR and in COO form. All entries are integers, so both products
+// are exact.
+void test_matrix_market(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const char *path,
+    int num_readers,
+    int num_pieces,
+    std::size_t num_nonzeros,
+    double norm_squared
+) {
+    using Reader = LegionSolvers::MatrixMarketReader<double, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 1, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const Reader reader{
+        ctx,
+        rt,
+        path,
+        static_cast<std::size_t>(num_readers),
+        static_cast<std::size_t>(num_pieces)};
+    assert(reader.get_num_nonzeros() == num_nonzeros);
+    const auto csr = reader.make_csr_matrix();
+    const auto coo = reader.make_coo_matrix();
+
+    const Legion::IndexPartition domain_partition = rt->create_equal_partition(
+        ctx, reader.get_domain_space(), reader.get_color_space()
+    );
+    {
+        Vector x{ctx, rt, domain_partition};
+        Vector y{ctx, rt, reader.get_range_partition()};
+        Vector z{ctx, rt, reader.get_range_partition()};
+
+        Legion::TaskLauncher launcher{
+            FILL_PERIODIC_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        csr->matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        coo->matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        assert(y.dot(y).get_value() == norm_squared);
+        z.axpy(Scalar{ctx, rt, -1.0}, y);
+        assert(z.dot(z).get_value() == 0.0);
+    }
+    rt->destroy_index_partition(ctx, domain_partition);
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    // ||A * x||^2 for the three matrices of write_test_matrices.
+    double laplacian = 0.0;
+    double skew = 0.0;
+    double rectangular = 0.0;
+    for (int i = 0; i < N; ++i) {
+        const double left = (i > 0) ? periodic_entry(i - 1) : 0.0;
+        const double right = (i + 1 < N) ? periodic_entry(i + 1) : 0.0;
+        const double y_laplacian = 2.0 * periodic_entry(i) - left - right;
+        const double y_skew = left - right;
+        const double y_rectangular = periodic_entry(i) + periodic_entry(i + 1);
+        laplacian += y_laplacian * y_laplacian;
+        skew += y_skew * y_skew;
+        rectangular += y_rectangular * y_rectangular;
+    }
+
+    for (const int num_readers : {1, 4, 64}) {
+        for (const int num_pieces : {1, 3}) {
+            test_matrix_market(
+                ctx,
+                rt,
+                LAPLACIAN_PATH,
+                num_readers,
+                num_pieces,
+                3 * N - 2,
+                laplacian
+            );
+            test_matrix_market(
+                ctx, rt, SKEW_PATH, num_readers, num_pieces, 2 * N - 2, skew
+            );
+            test_matrix_market(
+                ctx,
+                rt,
+                RECTANGULAR_PATH,
+                num_readers,
+                num_pieces,
+                2 * N,
+                rectangular
+            );
+        }
+    }
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    write_test_matrices(N);
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
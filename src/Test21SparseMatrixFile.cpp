@@ -0,0 +1,194 @@
+#include <cassert>  // for assert
+#include <cstddef>  // for std::size_t
+#include <cstring>  // for std::memcpy
+#include <fstream>  // for std::ifstream, std::ofstream
+#include <iterator> // for std::istreambuf_iterator
+#include <string>   // for std::string, std::to_string
+#include <vector>   // for std::vector
+
+#include <legion.h> // for Legion::*
+
+#include "DistributedVector.hpp"   // for DistributedVector
+#include "ExampleSystems.hpp"      // for FILL_PERIODIC_VECTOR_TASK_ID
+#include "LegionSolversMapper.hpp" // for mapper_registration_callback
+#include "LegionUtilities.hpp"     // for preregister_task, ...
+#include "MatrixMarketReader.hpp"  // for MatrixMarketReader
+#include "Scalar.hpp"              // for Scalar
+#include "SparseMatrixFile.hpp"    // for write_sparse_matrix_file, ...
+#include "TaskRegistration.hpp"    // for preregister_tasks
+
+using LegionSolvers::FILL_PERIODIC_VECTOR_TASK_ID;
+
+enum TaskIDs : Legion::TaskID {
+    TOP_LEVEL_TASK_ID,
+};
+
+const char *const MATRIX_MARKET_PATH = "Test21Matrix.mtx";
+const char *const BINARY_PATH = "Test21Matrix.bin";
+const char *const REWRITTEN_PATH = "Test21Rewritten.bin";
+constexpr int NUM_ROWS = 1'000;
+constexpr int NUM_COLS = 700;
+constexpr int NUM_PIECES = 3;
+
+
+// Writes a NUM_ROWS-by-NUM_COLS general real matrix with two nonzeros in
+// every row except every fifth, which is empty. All entries are multiples
+// of 1/4 of small magnitude, so that products with x are exact.
+void write_test_matrix() {
+    std::vector<std::string> lines;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        if (i % 5 == 0) { continue; }
+        const std::string row = std::to_string(i + 1);
+        const double value = static_cast<double>(i % 11 - 5) + 0.25;
+        lines.push_back(
+            row + " " + std::to_string(7 * i % NUM_COLS + 1) + " " +
+            std::to_string(value)
+        );
+        lines.push_back(
+            row + " " + std::to_string((13 * i + 5) % NUM_COLS + 1) + " " +
+            std::to_string(-2.0 * value)
+        );
+    }
+    std::ofstream file{MATRIX_MARKET_PATH, std::ios::binary};
+    file << "%%MatrixMarket matrix coordinate real general\n"
+         << NUM_ROWS << " " << NUM_COLS << " " << lines.size() << "\n";
+    for (const std::string &line : lines) { file << line << "\n"; }
+}
+
+
+std::string file_contents(const char *path) {
+    std::ifstream file{path, std::ios::binary};
+    assert(file);
+    return std::string{
+        std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+
+// Loads the binary file written from expected into num_pieces pieces (0 for
+// the partition hint), and checks that it holds the same matrix, both in
+// CSR and in COO form, by comparing products with x.
+void test_sparse_matrix_file(
+    Legion::Context ctx,
+    Legion::Runtime *rt,
+    const LegionSolvers::CSRMatrix<double, 1, int> &expected,
+    std::size_t num_nonzeros,
+    std::size_t num_pieces
+) {
+    using Reader = LegionSolvers::SparseMatrixFileReader<double, int>;
+    using Vector = LegionSolvers::DistributedVector<double, 1, int>;
+    using Scalar = LegionSolvers::Scalar<double>;
+
+    const Reader reader{ctx, rt, BINARY_PATH, num_pieces};
+    assert(reader.get_header().num_rows == NUM_ROWS);
+    assert(reader.get_header().num_cols == NUM_COLS);
+    assert(reader.get_num_nonzeros() == num_nonzeros);
+    assert(
+        rt->get_index_space_domain(ctx, reader.get_color_space())
+            .get_volume() == ((num_pieces == 0) ? NUM_PIECES : num_pieces)
+    );
+    const auto csr = reader.make_csr_matrix();
+    const auto coo = reader.make_coo_matrix();
+
+    const Legion::IndexPartition domain_partition = rt->create_equal_partition(
+        ctx, reader.get_domain_space(), reader.get_color_space()
+    );
+    {
+        Vector x{ctx, rt, domain_partition};
+        Vector y{ctx, rt, reader.get_range_partition()};
+        Vector z{ctx, rt, reader.get_range_partition()};
+        Vector w{ctx, rt, reader.get_range_partition()};
+
+        Legion::TaskLauncher launcher{
+            FILL_PERIODIC_VECTOR_TASK_ID, Legion::TaskArgument{}};
+        launcher.map_id = LegionSolvers::LEGION_SOLVERS_MAPPER_ID;
+        launcher
+            .add_region_requirement(Legion::RegionRequirement{
+                x.get_logical_region(),
+                LEGION_WRITE_DISCARD,
+                LEGION_EXCLUSIVE,
+                x.get_logical_region()})
+            .add_field(x.get_fid());
+        rt->execute_task(ctx, launcher);
+
+        expected.matvec(
+            y.get_logical_region(),
+            y.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        csr->matvec(
+            z.get_logical_region(),
+            z.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        coo->matvec(
+            w.get_logical_region(),
+            w.get_fid(),
+            x.get_logical_region(),
+            x.get_fid()
+        );
+        assert(y.dot(y).get_value() > 0.0);
+        z.axpy(Scalar{ctx, rt, -1.0}, y);
+        assert(z.dot(z).get_value() == 0.0);
+        w.axpy(Scalar{ctx, rt, -1.0}, y);
+        assert(w.dot(w).get_value() == 0.0);
+    }
+    rt->destroy_index_partition(ctx, domain_partition);
+
+    // Writing the attached matrix back with the same partition reproduces
+    // the file byte for byte.
+    if (num_pieces == 0) {
+        LegionSolvers::write_sparse_matrix_file(ctx, rt, REWRITTEN_PATH, *csr);
+        assert(file_contents(REWRITTEN_PATH) == file_contents(BINARY_PATH));
+    }
+}
+
+
+void top_level_task(
+    const Legion::Task *,
+    const std::vector<Legion::PhysicalRegion> &,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    using LegionSolvers::SparseMatrixFileHeader;
+    using LegionSolvers::is_sparse_matrix_file_header;
+
+    const LegionSolvers::MatrixMarketReader<double, int> source{
+        ctx, rt, MATRIX_MARKET_PATH, 4, NUM_PIECES};
+    const auto expected = source.make_csr_matrix();
+    LegionSolvers::write_sparse_matrix_file(ctx, rt, BINARY_PATH, *expected);
+
+    // The file is tagged with its entry and index types.
+    const std::string contents = file_contents(BINARY_PATH);
+    const std::size_t size = contents.size();
+    assert(size >= sizeof(SparseMatrixFileHeader));
+    SparseMatrixFileHeader header;
+    std::memcpy(&header, contents.data(), sizeof(SparseMatrixFileHeader));
+    assert((is_sparse_matrix_file_header<double, int>(header, size)));
+    assert(!(is_sparse_matrix_file_header<float, int>(header, size)));
+    assert(!(is_sparse_matrix_file_header<double, long long>(header, size)));
+    assert(header.num_pieces == NUM_PIECES);
+
+    for (const std::size_t num_pieces : {0, 1, 4}) {
+        test_sparse_matrix_file(
+            ctx, rt, *expected, source.get_num_nonzeros(), num_pieces
+        );
+    }
+}
+
+
+int main(int argc, char **argv) {
+    using LegionSolvers::TaskFlags;
+    write_test_matrix();
+    LegionSolvers::preregister_tasks(false);
+    LegionSolvers::preregister_task<top_level_task>(
+        TOP_LEVEL_TASK_ID, "top_level", TaskFlags::REPLICABLE | TaskFlags::INNER
+    );
+    LegionSolvers::preregister_example_system_tasks(false);
+    Legion::Runtime::set_top_level_task_id(TOP_LEVEL_TASK_ID);
+    Legion::Runtime::add_registration_callback(
+        LegionSolvers::mapper_registration_callback
+    );
+    return Legion::Runtime::start(argc, argv);
+}
@@ -1,15 +1,22 @@
 #include "UtilityTasks.hpp"
 
+#include <cstdint>  // for std::uint32_t
 #include <iostream> // for std::cout, std::endl
 
 #include "LibraryOptions.hpp" // for LEGION_SOLVERS_USE_*
+#include "PackedScalars.hpp"  // for PackedScalars
+#include "ScalarProgram.hpp"  // for ScalarProgram, evaluate_scalar_program
 
 using LegionSolvers::AddScalarTask;
 using LegionSolvers::DivideScalarTask;
+using LegionSolvers::EvaluateScalarProgramTask;
 using LegionSolvers::MultiplyScalarTask;
 using LegionSolvers::NegateScalarTask;
+using LegionSolvers::PackedScalars;
 using LegionSolvers::PrintScalarTask;
+using LegionSolvers::ScalarProgram;
 using LegionSolvers::SubtractScalarTask;
+using LegionSolvers::UnpackScalarTask;
 
 
 template <typename T>
@@ -95,6 +102,36 @@ T DivideScalarTask<T>::task_body(
 }
 
 
+template <typename T>
+T UnpackScalarTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->futures.size() == 1);
+    assert(task->arglen == sizeof(std::uint32_t));
+    const std::uint32_t index = *static_cast<const std::uint32_t *>(task->args);
+    assert(index < LEGION_SOLVERS_MAX_PACKED_SCALARS);
+    Legion::Future x = task->futures[0];
+    return x.get_result<PackedScalars<T>>().values[index];
+}
+
+
+template <typename T>
+T EvaluateScalarProgramTask<T>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+) {
+    assert(task->arglen == sizeof(ScalarProgram<T>));
+    const ScalarProgram<T> &program =
+        *static_cast<const ScalarProgram<T> *>(task->args);
+    return LegionSolvers::evaluate_scalar_program(program, task->futures);
+}
+
+
 #ifdef LEGION_SOLVERS_USE_FLOAT
 template int PrintScalarTask<float>::task_body(
     const Legion::Task *task,
@@ -132,6 +169,18 @@ template float DivideScalarTask<float>::task_body(
     Legion::Context ctx,
     Legion::Runtime *rt
 );
+template float UnpackScalarTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+template float EvaluateScalarProgramTask<float>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
 #endif // LEGION_SOLVERS_USE_FLOAT
 
 
@@ -172,4 +221,16 @@ template double DivideScalarTask<double>::task_body(
     Legion::Context ctx,
     Legion::Runtime *rt
 );
+template double UnpackScalarTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
+template double EvaluateScalarProgramTask<double>::task_body(
+    const Legion::Task *task,
+    const std::vector<Legion::PhysicalRegion> &regions,
+    Legion::Context ctx,
+    Legion::Runtime *rt
+);
 #endif // LEGION_SOLVERS_USE_DOUBLE
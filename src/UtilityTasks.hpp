@@ -135,6 +135,54 @@ struct DivideScalarTask
 }; // struct DivideScalarTask
 
 
+// Extracts one component of a PackedScalars<T> future, as returned by
+// MultiUpdateDotTask. The task argument is the std::uint32_t index.
+template <typename T>
+struct UnpackScalarTask
+    : public TaskT<UNPACK_SCALAR_TASK_BLOCK_ID, UnpackScalarTask, T> {
+
+    static constexpr const char *task_base_name = "unpack_scalar";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = T;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct UnpackScalarTask
+
+
+// Evaluates the ScalarProgram<T> passed as the task argument on the task
+// futures. Scalar<T> launches one of these per expression it materializes.
+template <typename T>
+struct EvaluateScalarProgramTask : public TaskT<
+                                       EVALUATE_SCALAR_PROGRAM_TASK_BLOCK_ID,
+                                       EvaluateScalarProgramTask,
+                                       T> {
+
+    static constexpr const char *task_base_name = "evaluate_scalar_program";
+
+    static constexpr const TaskFlags flags =
+        TaskFlags::LEAF | TaskFlags::IDEMPOTENT | TaskFlags::REPLICABLE;
+
+    using return_type = T;
+
+    static return_type task_body(
+        const Legion::Task *task,
+        const std::vector<Legion::PhysicalRegion> &regions,
+        Legion::Context ctx,
+        Legion::Runtime *rt
+    );
+
+}; // struct EvaluateScalarProgramTask
+
+
 } // namespace LegionSolvers
 
 #endif // LEGION_SOLVERS_UTILITY_TASKS_HPP_INCLUDED
@@ -0,0 +1,465 @@
+#ifndef LEGION_SOLVERS_VECTOR_KERNELS_HPP_INCLUDED
+#define LEGION_SOLVERS_VECTOR_KERNELS_HPP_INCLUDED
+
+#include <algorithm> // for std::copy, std::min
+#include <cmath>     // for std::fma
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint8_t, std::uint64_t
+
+#include <legion.h> // for Legion::Rect
+
+#include "LibraryOptions.hpp" // for LEGION_SOLVERS_DOT_BLOCK_SIZE, ...
+#include "SIMDUtilities.hpp"  // for SIMDPack
+
+#ifdef LEGION_SOLVERS_USE_OPENMP
+    #include <omp.h> // for omp_get_max_threads, omp_get_thread_num, ...
+#endif // LEGION_SOLVERS_USE_OPENMP
+
+namespace LegionSolvers {
+
+
+// Returns true if every accessor stores the points of rect contiguously and
+// in the same order, so that a single linear index addresses the same point
+// in all of them. Such rects can be processed by the dense_* kernels below
+// on raw pointers obtained from accessor.ptr(rect.lo).
+template <int DIM, typename COORD_T, typename... ACCESSOR_TS>
+bool is_dense_rect(
+    const Legion::Rect<DIM, COORD_T> &rect, const ACCESSOR_TS &...accessors
+) {
+    return (accessors.accessor.is_dense_col_major(rect) && ...) ||
+           (accessors.accessor.is_dense_row_major(rect) && ...);
+}
+
+
+// Number of ranges that for_each_thread_range may pass to its body.
+inline int max_thread_ranges(bool parallel) {
+#ifdef LEGION_SOLVERS_USE_OPENMP
+    if (parallel) { return omp_get_max_threads(); }
+#endif // LEGION_SOLVERS_USE_OPENMP
+    return 1;
+}
+
+
+// Splits [0, n) into one contiguous range per thread and calls
+// body(thread, begin, end) on each, in an OpenMP parallel region if parallel
+// is true and OpenMP support is enabled, and otherwise once on all of [0, n).
+// Range boundaries fall on multiples of LEGION_SOLVERS_DOT_BLOCK_SIZE, so
+// results blocked on that size do not depend on the number of threads.
+template <typename BODY>
+void for_each_thread_range(bool parallel, std::size_t n, const BODY &body) {
+#ifdef LEGION_SOLVERS_USE_OPENMP
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+    const std::size_t num_blocks = (n + B - 1) / B;
+    if (parallel && (num_blocks > 1)) {
+        #pragma omp parallel
+        {
+            const std::size_t t = omp_get_thread_num();
+            const std::size_t num_threads = omp_get_num_threads();
+            const std::size_t begin =
+                std::min(n, (num_blocks * t / num_threads) * B);
+            const std::size_t end =
+                std::min(n, (num_blocks * (t + 1) / num_threads) * B);
+            if (begin < end) { body(static_cast<int>(t), begin, end); }
+        }
+        return;
+    }
+#endif // LEGION_SOLVERS_USE_OPENMP
+    body(0, std::size_t{0}, n);
+}
+
+
+template <typename ENTRY_T>
+void dense_scal(std::size_t n, ENTRY_T alpha, ENTRY_T *x) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    const Pack a = Pack::broadcast(alpha);
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) { (a * Pack::load(x + i)).store(x + i); }
+    for (; i < n; ++i) { x[i] = alpha * x[i]; }
+}
+
+
+// y[i] = alpha * x[i] + y[i]
+template <typename ENTRY_T>
+void dense_axpy(std::size_t n, ENTRY_T alpha, const ENTRY_T *x, ENTRY_T *y) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    const Pack a = Pack::broadcast(alpha);
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        fmadd(a, Pack::load(x + i), Pack::load(y + i)).store(y + i);
+    }
+    for (; i < n; ++i) { y[i] = std::fma(alpha, x[i], y[i]); }
+}
+
+
+// y[i] = x[i], converted from another entry type
+template <typename ENTRY_T, typename SOURCE_T>
+void dense_convert(std::size_t n, const SOURCE_T *x, ENTRY_T *y) {
+    for (std::size_t i = 0; i < n; ++i) { y[i] = static_cast<ENTRY_T>(x[i]); }
+}
+
+
+// y[i] = alpha * x[i] + y[i], with x converted from another entry type
+template <typename ENTRY_T, typename SOURCE_T>
+void dense_axpy_convert(
+    std::size_t n, ENTRY_T alpha, const SOURCE_T *x, ENTRY_T *y
+) {
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = std::fma(alpha, static_cast<ENTRY_T>(x[i]), y[i]);
+    }
+}
+
+
+// y[i] = x[i] + alpha * y[i]
+template <typename ENTRY_T>
+void dense_xpay(std::size_t n, ENTRY_T alpha, const ENTRY_T *x, ENTRY_T *y) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    const Pack a = Pack::broadcast(alpha);
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        fmadd(a, Pack::load(y + i), Pack::load(x + i)).store(y + i);
+    }
+    for (; i < n; ++i) { y[i] = std::fma(alpha, y[i], x[i]); }
+}
+
+
+// z[i] = alpha * y[i] + z[i]; y[i] = x[i] + beta * y[i]
+template <typename ENTRY_T>
+void dense_xpay_axpy(
+    std::size_t n,
+    ENTRY_T beta,
+    ENTRY_T alpha,
+    const ENTRY_T *x,
+    ENTRY_T *y,
+    ENTRY_T *z
+) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    const Pack b = Pack::broadcast(beta);
+    const Pack a = Pack::broadcast(alpha);
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        const Pack y_old = Pack::load(y + i);
+        fmadd(a, y_old, Pack::load(z + i)).store(z + i);
+        fmadd(b, y_old, Pack::load(x + i)).store(y + i);
+    }
+    for (; i < n; ++i) {
+        const ENTRY_T y_old = y[i];
+        z[i] = std::fma(alpha, y_old, z[i]);
+        y[i] = std::fma(beta, y_old, x[i]);
+    }
+}
+
+
+enum class DotProductMode : std::uint8_t {
+    // Several independent SIMD accumulators within cache-sized blocks, with
+    // block sums combined pairwise. Error grows as O(log(n)) * eps.
+    BLOCKED,
+    // Error-free transformations (TwoProd/TwoSum) applied lane-wise, as in
+    // the Dot2 algorithm of Ogita, Rump and Oishi. The result is as accurate
+    // as if computed in twice the working precision and then rounded, so
+    // the error bound does not grow with n.
+    COMPENSATED,
+}; // enum class DotProductMode
+
+
+// Sums a stream of partial sums by pairwise (binary tree) combination using
+// O(log(n)) storage: slot k holds the sum of 2^k consecutive partials.
+template <typename ENTRY_T>
+class PairwiseSum {
+
+    ENTRY_T slots[64];
+    std::uint64_t count;
+
+  public:
+
+    PairwiseSum() : count(0) {}
+
+    void add(ENTRY_T x) {
+        int k = 0;
+        for (std::uint64_t c = count; c & 1; c >>= 1, ++k) { x += slots[k]; }
+        slots[k] = x;
+        ++count;
+    }
+
+    ENTRY_T sum() const {
+        ENTRY_T result = static_cast<ENTRY_T>(0);
+        for (int k = 0; k < 64; ++k) {
+            if ((count >> k) & 1) { result += slots[k]; }
+        }
+        return result;
+    }
+
+}; // class PairwiseSum
+
+
+// Scalar counterparts of SIMDPack fmadd, so that the error-free
+// transformations below apply equally to packs and to single entries.
+inline float fmadd(float a, float b, float c) { return std::fma(a, b, c); }
+inline double fmadd(double a, double b, double c) { return std::fma(a, b, c); }
+
+
+// Error-free transformations: a + b == s + e and a * b == p + e exactly.
+template <typename T>
+inline void two_sum(T a, T b, T &s, T &e) {
+    s = a + b;
+    const T z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+template <typename T>
+inline void two_prod(T a, T b, T &p, T &e) {
+    p = a * b;
+    e = fmadd(a, b, T{} - p);
+}
+
+
+// Returns the sum of v[i] * w[i] for i < n, computed with four independent
+// SIMD accumulators to break the loop-carried dependency on a single sum.
+template <typename ENTRY_T>
+ENTRY_T dense_dot(std::size_t n, const ENTRY_T *v, const ENTRY_T *w) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    Pack acc0 = Pack::zero();
+    Pack acc1 = Pack::zero();
+    Pack acc2 = Pack::zero();
+    Pack acc3 = Pack::zero();
+    std::size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        acc0 = fmadd(Pack::load(v + i), Pack::load(w + i), acc0);
+        acc1 = fmadd(Pack::load(v + i + W), Pack::load(w + i + W), acc1);
+        acc2 = fmadd(
+            Pack::load(v + i + 2 * W), Pack::load(w + i + 2 * W), acc2
+        );
+        acc3 = fmadd(
+            Pack::load(v + i + 3 * W), Pack::load(w + i + 3 * W), acc3
+        );
+    }
+    for (; i + W <= n; i += W) {
+        acc0 = fmadd(Pack::load(v + i), Pack::load(w + i), acc0);
+    }
+    ENTRY_T result = ((acc0 + acc1) + (acc2 + acc3)).sum();
+    for (; i < n; ++i) { result = std::fma(v[i], w[i], result); }
+    return result;
+}
+
+
+// Dot2 over v[0:n] and w[0:n], added to (sum, compensation). On return,
+// sum + compensation approximates the exact result with a relative error of
+// about eps, plus a term of order (n * eps)^2 times the condition number.
+template <typename ENTRY_T>
+void dense_dot_compensated(
+    std::size_t n,
+    const ENTRY_T *v,
+    const ENTRY_T *w,
+    ENTRY_T &sum,
+    ENTRY_T &compensation
+) {
+    using Pack = SIMDPack<ENTRY_T>;
+    constexpr std::size_t W = Pack::width;
+    Pack s0 = Pack::zero();
+    Pack s1 = Pack::zero();
+    Pack c0 = Pack::zero();
+    Pack c1 = Pack::zero();
+    std::size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+        Pack p0, p1, ep0, ep1, es0, es1;
+        two_prod(Pack::load(v + i), Pack::load(w + i), p0, ep0);
+        two_prod(Pack::load(v + i + W), Pack::load(w + i + W), p1, ep1);
+        two_sum(s0, p0, s0, es0);
+        two_sum(s1, p1, s1, es1);
+        c0 = c0 + (es0 + ep0);
+        c1 = c1 + (es1 + ep1);
+    }
+    for (; i + W <= n; i += W) {
+        Pack p0, ep0, es0;
+        two_prod(Pack::load(v + i), Pack::load(w + i), p0, ep0);
+        two_sum(s0, p0, s0, es0);
+        c0 = c0 + (es0 + ep0);
+    }
+    ENTRY_T lanes[2 * W];
+    s0.store(lanes);
+    s1.store(lanes + W);
+    ENTRY_T c = (c0 + c1).sum();
+    ENTRY_T s = static_cast<ENTRY_T>(0);
+    for (std::size_t j = 0; j < 2 * W; ++j) {
+        ENTRY_T e;
+        two_sum(s, lanes[j], s, e);
+        c += e;
+    }
+    for (; i < n; ++i) {
+        ENTRY_T p, ep, es;
+        two_prod(v[i], w[i], p, ep);
+        two_sum(s, p, s, es);
+        c += es + ep;
+    }
+    ENTRY_T e;
+    two_sum(sum, s, sum, e);
+    compensation += c + e;
+}
+
+
+// Accumulates a dot product over any number of dense ranges and individual
+// points, using the summation strategy selected by DotProductMode. Both
+// strategies work on blocks of LEGION_SOLVERS_DOT_BLOCK_SIZE entries. In
+// COMPENSATED mode, block sums are added to a running sum with TwoSum, and
+// the per-block compensation terms are summed pairwise, so that no single
+// floating-point accumulator absorbs more than one block of rounding errors.
+template <typename ENTRY_T>
+class DotProductAccumulator {
+
+    const DotProductMode mode;
+    PairwiseSum<ENTRY_T> block_sums; // compensation terms if COMPENSATED
+    ENTRY_T sum;
+    ENTRY_T pending;
+    ENTRY_T pending_compensation;
+    std::size_t num_pending;
+
+    void add_block(ENTRY_T block_sum, ENTRY_T block_compensation) {
+        ENTRY_T e;
+        two_sum(sum, block_sum, sum, e);
+        block_sums.add(block_compensation + e);
+    }
+
+    void flush_pending() {
+        if (mode == DotProductMode::COMPENSATED) {
+            add_block(pending, pending_compensation);
+        } else {
+            block_sums.add(pending);
+        }
+        pending = static_cast<ENTRY_T>(0);
+        pending_compensation = static_cast<ENTRY_T>(0);
+        num_pending = 0;
+    }
+
+  public:
+
+    explicit DotProductAccumulator(DotProductMode mode)
+        : mode(mode), sum(static_cast<ENTRY_T>(0)),
+          pending(static_cast<ENTRY_T>(0)),
+          pending_compensation(static_cast<ENTRY_T>(0)), num_pending(0) {}
+
+    void add_dense(std::size_t n, const ENTRY_T *v, const ENTRY_T *w) {
+        constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+        for (std::size_t i = 0; i < n; i += B) {
+            const std::size_t len = std::min(B, n - i);
+            if (mode == DotProductMode::COMPENSATED) {
+                ENTRY_T s = static_cast<ENTRY_T>(0);
+                ENTRY_T c = static_cast<ENTRY_T>(0);
+                dense_dot_compensated(len, v + i, w + i, s, c);
+                add_block(s, c);
+            } else {
+                block_sums.add(dense_dot(len, v + i, w + i));
+            }
+        }
+    }
+
+    void add(ENTRY_T v, ENTRY_T w) {
+        if (mode == DotProductMode::COMPENSATED) {
+            ENTRY_T p, ep, es;
+            two_prod(v, w, p, ep);
+            two_sum(pending, p, pending, es);
+            pending_compensation += es + ep;
+        } else {
+            pending = std::fma(v, w, pending);
+        }
+        if (++num_pending == LEGION_SOLVERS_DOT_BLOCK_SIZE) { flush_pending(); }
+    }
+
+    // Adds everything accumulated by other, which must use the same mode.
+    void merge(const DotProductAccumulator &other) {
+        if (mode == DotProductMode::COMPENSATED) {
+            ENTRY_T s, e;
+            two_sum(other.sum, other.pending, s, e);
+            add_block(
+                s, other.block_sums.sum() + (other.pending_compensation + e)
+            );
+        } else {
+            block_sums.add(other.result());
+        }
+    }
+
+    ENTRY_T result() const {
+        if (mode == DotProductMode::COMPENSATED) {
+            ENTRY_T s, e;
+            two_sum(sum, pending, s, e);
+            return s + (block_sums.sum() + (pending_compensation + e));
+        } else {
+            return block_sums.sum() + pending;
+        }
+    }
+
+}; // class DotProductAccumulator
+
+
+// Adds the dot product of x[i][0:n] and y[j][0:n] to
+// result[i * LEGION_SOLVERS_MAX_BLOCK_SIZE + j] for every i < k and j < m,
+// one block of LEGION_SOLVERS_DOT_BLOCK_SIZE entries at a time, so that the
+// blocks of the k + m vectors are read from memory once and from cache by
+// all k * m products. If symmetric, x and y are the same k = m vectors and
+// only the upper triangle (j >= i) is accumulated.
+template <typename ENTRY_T>
+void dense_block_dot(
+    std::size_t n,
+    std::size_t k,
+    const ENTRY_T *const *x,
+    std::size_t m,
+    const ENTRY_T *const *y,
+    bool symmetric,
+    ENTRY_T *result
+) {
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+    constexpr std::size_t S = LEGION_SOLVERS_MAX_BLOCK_SIZE;
+    for (std::size_t p = 0; p < n; p += B) {
+        const std::size_t len = std::min(B, n - p);
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = (symmetric ? i : 0); j < m; ++j) {
+                result[i * S + j] += dense_dot(len, x[i] + p, y[j] + p);
+            }
+        }
+    }
+}
+
+
+// Sets y[j][0:n] = y[j][0:n] + sum over i < k of
+// coefficients[i * LEGION_SOLVERS_MAX_BLOCK_SIZE + j] * x[i][0:n] for every
+// j < m, block by block as in dense_block_dot. If xpay, there are k = m
+// vectors x, and y[j] = x[j] + sum over i of coefficients(i, j) * y[i]
+// instead; each block of y is then first saved to scratch, which must hold
+// m * LEGION_SOLVERS_DOT_BLOCK_SIZE entries.
+template <typename ENTRY_T>
+void dense_block_update(
+    std::size_t n,
+    std::size_t k,
+    const ENTRY_T *const *x,
+    std::size_t m,
+    ENTRY_T *const *y,
+    const ENTRY_T *coefficients,
+    bool xpay,
+    ENTRY_T *scratch
+) {
+    constexpr std::size_t B = LEGION_SOLVERS_DOT_BLOCK_SIZE;
+    constexpr std::size_t S = LEGION_SOLVERS_MAX_BLOCK_SIZE;
+    for (std::size_t p = 0; p < n; p += B) {
+        const std::size_t len = std::min(B, n - p);
+        if (xpay) {
+            for (std::size_t j = 0; j < m; ++j) {
+                std::copy(y[j] + p, y[j] + p + len, scratch + j * B);
+                std::copy(x[j] + p, x[j] + p + len, y[j] + p);
+            }
+        }
+        for (std::size_t j = 0; j < m; ++j) {
+            for (std::size_t i = 0; i < k; ++i) {
+                const ENTRY_T *source = xpay ? (scratch + i * B) : (x[i] + p);
+                dense_axpy(len, coefficients[i * S + j], source, y[j] + p);
+            }
+        }
+    }
+}
+
+
+} // namespace LegionSolvers
+
+#endif // LEGION_SOLVERS_VECTOR_KERNELS_HPP_INCLUDED